@@ -0,0 +1,205 @@
+/* config.h.  Generated from config.h.in by configure.  */
+/* config.h.in.  Generated from configure.ac by autoheader.  */
+
+/* Define if debugging is turned on */
+/* #undef G_DEBUG */
+
+/* Define if NaN/Inf checking should be performed */
+#define G_NAN_CHECK 1
+
+/* Define if profiling is turned on */
+/* #undef G_PROFILE */
+
+/* Define if range checking should be performed */
+#define G_RANGE_CHECK 1
+
+/* Define if small memory optimization is selected */
+#define G_SMALL_MEMORY 1
+
+/* Define to 1 if you have the <dlfcn.h> header file. */
+#define HAVE_DLFCN_H 1
+
+/* Define to 1 if you have the <inttypes.h> header file. */
+#define HAVE_INTTYPES_H 1
+
+/* Define if cfitsio library is available */
+/* #undef HAVE_LIBCFITSIO */
+
+/* Define if readline library is available */
+/* #undef HAVE_LIBREADLINE */
+
+/* Define if OpenMP is enabled */
+#define HAVE_OPENMP 1
+
+/* Define if OpenMP Darwin kluge is needed */
+/* #undef HAVE_OPENMP_DARWIN_KLUGE */
+
+/* Define to 1 if you have the file `pyext/gammalib/app.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_APP_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/app_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_APP_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/base.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_BASE_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/base_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_BASE_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/com.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_COM_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/com_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_COM_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/cta.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_CTA_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/cta_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_CTA_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/fits.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_FITS_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/fits_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_FITS_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/lat.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_LAT_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/lat_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_LAT_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/linalg.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_LINALG_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/linalg_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_LINALG_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/model.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_MODEL_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/model_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_MODEL_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/mwl.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_MWL_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/mwl_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_MWL_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/numerics.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_NUMERICS_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/numerics_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_NUMERICS_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/obs.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_OBS_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/obs_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_OBS_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/opt.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_OPT_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/opt_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_OPT_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/sky.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_SKY_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/sky_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_SKY_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/support.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_SUPPORT_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/support_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_SUPPORT_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/test.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_TEST_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/test_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_TEST_WRAP_CPP */
+
+/* Define to 1 if you have the file `pyext/gammalib/xml.py'. */
+/* #undef HAVE_PYEXT_GAMMALIB_XML_PY */
+
+/* Define to 1 if you have the file `pyext/gammalib/xml_wrap.cpp'. */
+/* #undef HAVE_PYEXT_GAMMALIB_XML_WRAP_CPP */
+
+/* Define if Python bindings are built */
+/* #undef HAVE_PYTHON */
+
+/* Define to 1 if you have the <stdint.h> header file. */
+#define HAVE_STDINT_H 1
+
+/* Define to 1 if you have the <stdio.h> header file. */
+#define HAVE_STDIO_H 1
+
+/* Define to 1 if you have the <stdlib.h> header file. */
+#define HAVE_STDLIB_H 1
+
+/* Define to 1 if you have the <strings.h> header file. */
+#define HAVE_STRINGS_H 1
+
+/* Define to 1 if you have the <string.h> header file. */
+#define HAVE_STRING_H 1
+
+/* Define to 1 if you have the <sys/stat.h> header file. */
+#define HAVE_SYS_STAT_H 1
+
+/* Define to 1 if you have the <sys/types.h> header file. */
+#define HAVE_SYS_TYPES_H 1
+
+/* Define to 1 if you have the <unistd.h> header file. */
+#define HAVE_UNISTD_H 1
+
+/* Define to the sub-directory where libtool stores uninstalled libraries. */
+#define LT_OBJDIR ".libs/"
+
+/* Name of package */
+#define PACKAGE "gammalib"
+
+/* Define to the address where bug reports for this package should be sent. */
+#define PACKAGE_BUGREPORT "jurgen.knodlseder@irap.omp.eu"
+
+/* Define to the full name of this package. */
+#define PACKAGE_NAME "gammalib"
+
+/* Location where library is installed */
+#define PACKAGE_PREFIX "/usr/local/gamma"
+
+/* Define to the full name and version of this package. */
+#define PACKAGE_STRING "gammalib 0.8.0"
+
+/* Define to the one symbol short name of this package. */
+#define PACKAGE_TARNAME "gammalib"
+
+/* Define to the home page for this package. */
+#define PACKAGE_URL ""
+
+/* Define to the version of this package. */
+#define PACKAGE_VERSION "0.8.0"
+
+/* Define to 1 if all of the C90 standard headers exist (not just the ones
+   required in a freestanding environment). This macro is provided for
+   backward compatibility; new code need not use it. */
+#define STDC_HEADERS 1
+
+/* Version number of package */
+#define VERSION "0.8.0"
+
+/* Define to empty if `const' does not conform to ANSI C. */
+/* #undef const */
+
+/* Define to `__inline__' or `__inline' if that's what the C compiler
+   calls it, or to nothing if 'inline' is not supported under any name.  */
+#ifndef __cplusplus
+/* #undef inline */
+#endif
+
+/* Define to `unsigned int' if <sys/types.h> does not define. */
+/* #undef size_t */
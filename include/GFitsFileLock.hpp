@@ -0,0 +1,81 @@
+/***************************************************************************
+ *              GFitsFileLock.hpp - Thread lock for FITS file              *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsFileLock.hpp
+ * @brief Thread lock for FITS file class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GFITSFILELOCK_HPP
+#define GFITSFILELOCK_HPP
+
+/* __ Includes ___________________________________________________________ */
+
+
+/***********************************************************************//**
+ * @class GFitsFileLock
+ *
+ * @brief Thread lock for FITS file
+ *
+ * All HDUs and table columns of a FITS file share the cfitsio file
+ * structure, which holds the current HDU position and the I/O buffers of
+ * the file. cfitsio also shares this structure among all handles that open
+ * the same file within a process. Two threads that access the same file,
+ * for example by loading different columns of a table in parallel, would
+ * hence race on the HDU position and the I/O buffers.
+ *
+ * A GFitsFileLock serialises the access to a FITS file. The lock is
+ * acquired on construction and released on destruction, hence it protects
+ * the scope in which it is declared:
+ *
+ *     {
+ *         GFitsFileLock lock(m_fitsfile);
+ *         // move to HDU and read data
+ *     }
+ *
+ * There is one lock per cfitsio file structure, hence threads that access
+ * different files are not serialised. Also, data that are memory mapped
+ * (see GFitsMmap) are decoded without any lock. Locks are only acquired
+ * if OpenMP is available.
+ *
+ * The lock is recursive: a thread that holds the lock of a file may
+ * acquire it again, hence methods that lock a file may call other methods
+ * that lock the same file. Every method that calls cfitsio on a file that
+ * is attached holds the lock. Opening and closing of files is serialised
+ * separately, as the file structure is only known once a file is open.
+ ***************************************************************************/
+class GFitsFileLock {
+
+public:
+    // Constructors and destructors
+    explicit GFitsFileLock(const void* fitsfile);
+    ~GFitsFileLock(void);
+
+private:
+    // Locks can not be copied
+    GFitsFileLock(const GFitsFileLock& lock);
+    GFitsFileLock& operator= (const GFitsFileLock& lock);
+
+    // Private members
+    void* m_lock;   //!< Acquired lock (NULL if none)
+};
+
+#endif /* GFITSFILELOCK_HPP */
@@ -115,6 +115,9 @@ protected:
     virtual void data_close(void) = 0;
     virtual void data_connect(void* vptr) = 0;
 
+    // Virtual protected methods
+    virtual void data_map(void);
+
     // Protected data area
     void*        m_fitsfile;    //!< FITS file pointer pointing on actual HDU
     int          m_hdunum;      //!< HDU number (starting from 0)
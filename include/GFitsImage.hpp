@@ -28,7 +28,11 @@
 #define GFITSIMAGE_HPP
 
 /* __ Includes ___________________________________________________________ */
+#include <vector>
+#include <list>
+#include <map>
 #include "GFitsHDU.hpp"
+#include "GFitsMmap.hpp"
 
 
 /***********************************************************************//**
@@ -37,6 +41,17 @@
  * @brief Abstract interface for the FITS image classes.
  *
  * This class defines the abstract interface for a FITS image.
+ *
+ * By default, all image pixels are loaded into memory on first access.
+ * Alternatively, pixels may be loaded on demand by setting a plane cache
+ * budget using the cache_budget() method. In that case, read access to
+ * pixels through the pixel() methods only loads the image planes (the
+ * first two image axes) that are touched, and keeps the most recently used
+ * planes in a cache that does not exceed the budget. The plane() and
+ * region() methods read a single image plane or a rectangular sub-region
+ * of the image from the FITS file without loading the full image.
+ *
+ * The plane cache may be accessed from several threads at the same time.
  ***************************************************************************/
 class GFitsImage : public GFitsHDU {
 
@@ -73,6 +88,16 @@ public:
     int         naxis(void) const;
     int         naxes(int axis) const;
     int         anynul(void) const;
+    bool        ismapped(void) const { return m_mmap.is_open(); }
+    void        compression(const std::string& type);
+    std::string compression(void) const;
+    int         planes(void) const;
+    std::vector<double> plane(const int& iplane) const;
+    std::vector<double> region(const std::vector<int>& first,
+                               const std::vector<int>& last) const;
+    void        cache_budget(const double& mbytes);
+    double      cache_budget(void) const { return m_cache_budget; }
+    bool        islazy(void) const;
     void        nulval(const void* value);
     void*       nulval(void);
     std::string print(void) const;
@@ -86,11 +111,26 @@ protected:
     void  data_save(void);
     void  data_close(void);
     void  data_connect(void* vptr);
+    void  data_map(void);
+    double mapped_pixel(const int& offset) const;
     void  init_image_header(void);
     void  open_image(void* vptr);
     void  load_image(int datatype, const void* pixels,
                      const void* nulval, int* anynul);
     void  save_image(int datatype, const void* pixels);
+    void  set_compression(void);
+    bool  ondisk(void) const;
+    int   plane_size(void) const;
+    void  read_pixels(const long* fpixel, const long* lpixel,
+                      double* pixels) const;
+    void  read_plane(const int& iplane, double* pixels) const;
+    bool  nulval_value(double* value) const;
+    double cached_pixel(const int& offset) const;
+    std::vector<double> cached_plane(const int& iplane) const;
+    const std::vector<double>* cache_find(const int& iplane) const;
+    const std::vector<double>& cache_insert(const int& iplane,
+                                            std::vector<double>& pixels) const;
+    void  clear_cache(void) const;
     void  fetch_data(void);
     int   offset(const int& ix) const;
     int   offset(const int& ix, const int& iy) const;
@@ -103,7 +143,7 @@ protected:
     virtual void  release_data(void) = 0;
     virtual void  alloc_nulval(const void* value) = 0;
     virtual void* ptr_data(void) = 0;
-    virtual void* ptr_nulval(void) = 0;
+    virtual void* ptr_nulval(void) const = 0;
 
     // Protected data area
     int   m_bitpix;      //!< Number of Bits/pixel
@@ -111,6 +151,18 @@ protected:
     long* m_naxes;       //!< Number of pixels in each dimension
     int   m_num_pixels;  //!< Number of image pixels
     int   m_anynul;      //!< Number of NULLs encountered
+    GFitsMmap m_mmap;    //!< Memory mapped image data (optional)
+    int   m_compression; //!< Tile compression algorithm (0 = none)
+
+    // Plane cache for on demand loading
+    struct cache_entry {
+        std::vector<double>      pixels; //!< Plane pixels
+        std::list<int>::iterator order;  //!< Position in usage order
+    };
+    typedef std::map<int, cache_entry> cache_type;
+    double                 m_cache_budget; //!< Plane cache budget in MB (0 = off)
+    mutable cache_type     m_cache;        //!< Cached image planes
+    mutable std::list<int> m_cache_order;  //!< Cached planes, most recent first
 };
 
 #endif /* GFITSIMAGE_HPP */
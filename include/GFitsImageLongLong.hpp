@@ -90,7 +90,7 @@ private:
     void  load_data(void) const;
     void  alloc_nulval(const void* value);
     void* ptr_data(void) { return m_pixels; }
-    void* ptr_nulval(void) { return m_nulval; }
+    void* ptr_nulval(void) const { return m_nulval; }
 
     // Private data area
     long long* m_pixels;      //!< Pixels
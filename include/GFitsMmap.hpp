@@ -0,0 +1,102 @@
+/***************************************************************************
+ *              GFitsMmap.hpp - Memory mapped FITS data region             *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsMmap.hpp
+ * @brief Memory mapped FITS data region class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GFITSMMAP_HPP
+#define GFITSMMAP_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include "GBase.hpp"
+
+
+/***********************************************************************//**
+ * @class GFitsMmap
+ *
+ * @brief Memory mapped FITS data region
+ *
+ * This class maps a region of an uncompressed FITS file read-only into
+ * memory. Pages of the region are only read from disk when they are
+ * accessed, and they are shared with all other mappings of the same file,
+ * including mappings in other processes.
+ *
+ * Values are decoded from the big-endian FITS representation on access
+ * using the real() method, which takes the FITS data type and the byte
+ * position of the value within the region.
+ *
+ * Only uncompressed FITS files on disk can be mapped. If a file can not
+ * be mapped (for example because it is gzip compressed, or because the
+ * platform does not support memory mapping), the region is left unmapped
+ * and is_open() returns false. Clients should then fall back to reading
+ * the data through cfitsio.
+ *
+ * Copying a mapped region maps the same region again, so that each
+ * instance owns its mapping.
+ ***************************************************************************/
+class GFitsMmap : public GBase {
+
+public:
+    // Constructors and destructors
+    GFitsMmap(void);
+    explicit GFitsMmap(const std::string& filename,
+                       const long long&   offset,
+                       const long long&   size);
+    GFitsMmap(const GFitsMmap& map);
+    virtual ~GFitsMmap(void);
+
+    // Operators
+    GFitsMmap& operator= (const GFitsMmap& map);
+
+    // Methods
+    void               clear(void);
+    GFitsMmap*         clone(void) const;
+    void               open(const std::string& filename,
+                            const long long&   offset,
+                            const long long&   size);
+    void               close(void);
+    bool               is_open(void) const { return (m_data != NULL); }
+    const std::string& filename(void) const { return m_filename; }
+    const long long&   offset(void) const { return m_offset; }
+    const long long&   size(void) const { return m_size; }
+    const char*        data(void) const { return m_data; }
+    double             real(const int& type, const long long& pos) const;
+    std::string        print(void) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GFitsMmap& map);
+    void free_members(void);
+
+    // Protected members
+    std::string m_filename;  //!< Name of mapped file
+    long long   m_offset;    //!< Byte offset of region in file
+    long long   m_size;      //!< Size of region in bytes
+    void*       m_base;      //!< Start of mapping (page aligned)
+    long long   m_length;    //!< Length of mapping in bytes
+    const char* m_data;      //!< Start of region
+};
+
+#endif /* GFITSMMAP_HPP */
@@ -84,6 +84,7 @@ protected:
     void  data_save(void);
     void  data_close(void);
     void  data_connect(void* vptr);
+    void  data_map(void);
     char* get_ttype(const int& colnum) const;
     char* get_tform(const int& colnum) const;
     char* get_tunit(const int& colnum) const;
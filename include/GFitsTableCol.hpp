@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 #include "GBase.hpp"
+#include "GFitsMmap.hpp"
 
 
 /***********************************************************************//**
@@ -39,11 +40,18 @@
  * @brief Abstract interface for FITS table column
  *
  * This class implements a FITS table column. Vector columns are supported.
+ *
+ * The values() methods copy a range of rows of any numerical column into
+ * a typed buffer (double, float or long long) using a single call, which
+ * avoids the virtual real() or integer() call per column element. Either
+ * all vector elements of the rows or a single vector element per row can
+ * be copied.
  ***************************************************************************/
 class GFitsTableCol : public GBase {
 
     // Friend classes
     friend class GFitsTable;
+    friend class GFitsTableColReader;
 
 public:
     // Constructors and destructors
@@ -79,6 +87,16 @@ public:
     int              number(void) const;
     int              length(void) const;
     int              anynul(void) const;
+    void             release(void);
+    bool             ismapped(void) const { return m_mmap.is_open(); }
+    void             load_rows(const int& row, const int& nrows,
+                               double* values) const;
+    void             values(const int& row, const int& nrows,
+                            double* buffer, const int& inx = -1) const;
+    void             values(const int& row, const int& nrows,
+                            float* buffer, const int& inx = -1) const;
+    void             values(const int& row, const int& nrows,
+                            long long* buffer, const int& inx = -1) const;
     std::string      print(void) const;
 
 protected:
@@ -100,12 +118,17 @@ protected:
     mutable int      m_size;     //!< Size of allocated data area (0 if not loaded)
     int              m_anynul;   //!< Number of NULLs encountered
     void*            m_fitsfile; //!< FITS file pointer associated with column
+    GFitsMmap        m_mmap;     //!< Memory mapped table data (optional)
+    long long        m_mmap_col; //!< Byte offset of column in table row
+    long long        m_mmap_row; //!< Length of table row in bytes
+    mutable int      m_fd;       //!< File descriptor for read-ahead (-1 = none)
 
     // Protected pure virtual methods
     virtual std::string ascii_format(void) const = 0;
     virtual std::string binary_format(void) const = 0;
     virtual void        alloc_data(void) = 0;
     virtual void        init_data(void) = 0;
+    virtual void        release_data(void) = 0;
     virtual void*       ptr_data(void) = 0;
     virtual void*       ptr_nulval(void) = 0;
 
@@ -115,6 +138,15 @@ protected:
     virtual void        load_column(void);
     virtual void        save_column(void);
     virtual int         offset(const int& row, const int& inx) const;
+    void                prefetch_rows(const int& row, const int& nrows) const;
+    void                map(const std::string& filename,
+                            const long long&   start,
+                            const long long&   rowlength,
+                            const long long&   colstart);
+    double              mapped_real(const int& row, const int& inx) const;
+    void                copy_values(const int& row, const int& nrows,
+                                    const int& inx, const int& type,
+                                    void* buffer) const;
 
 protected:
     // Private methods
@@ -122,6 +154,7 @@ protected:
     void copy_members(const GFitsTableCol& column);
     void free_members(void);
     void connect(void* vptr);
+    void close_fd(void) const;
 };
 
 #endif /* GFITSTABLECOL_HPP */
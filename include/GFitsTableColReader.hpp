@@ -0,0 +1,112 @@
+/***************************************************************************
+ *        GFitsTableColReader.hpp - FITS table column chunk reader         *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsTableColReader.hpp
+ * @brief FITS table column chunk reader class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GFITSTABLECOLREADER_HPP
+#define GFITSTABLECOLREADER_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include "GBase.hpp"
+#include "GFitsTableCol.hpp"
+
+
+/***********************************************************************//**
+ * @class GFitsTableColReader
+ *
+ * @brief FITS table column chunk reader
+ *
+ * This class traverses a FITS table column in chunks of rows, holding only
+ * a single chunk of column values in memory at a time. This allows to
+ * process columns that are too large to be loaded entirely into memory.
+ *
+ * The reader is used as follows:
+ *
+ *     GFitsTableColReader reader(column, 10000);
+ *     while (reader.next()) {
+ *         for (int i = 0; i < reader.rows(); ++i) {
+ *             double value = reader(i);
+ *             ...
+ *         }
+ *     }
+ *
+ * The first row of the current chunk in the column is returned by the
+ * row() method, the number of rows in the current chunk by the rows()
+ * method. Column values are accessed by the operator(), using row indices
+ * relative to the start of the chunk.
+ *
+ * If prefetching is enabled (the default), the reader announces the next
+ * chunk to the operating system before returning the current one, so that
+ * the next chunk can be read ahead from disk while the current chunk is
+ * processed.
+ *
+ * The reader does not own the column. The column needs to stay alive and
+ * attached to its FITS file as long as the reader is used.
+ ***************************************************************************/
+class GFitsTableColReader : public GBase {
+
+public:
+    // Constructors and destructors
+    GFitsTableColReader(void);
+    explicit GFitsTableColReader(const GFitsTableCol* column,
+                                 const int&           chunk = 100000);
+    GFitsTableColReader(const GFitsTableColReader& reader);
+    virtual ~GFitsTableColReader(void);
+
+    // Operators
+    GFitsTableColReader& operator= (const GFitsTableColReader& reader);
+    double               operator()(const int& row, const int& inx = 0) const;
+
+    // Methods
+    void                 clear(void);
+    GFitsTableColReader* clone(void) const;
+    void                 chunk(const int& chunk);
+    int                  chunk(void) const { return m_chunk; }
+    void                 prefetch(const bool& prefetch) { m_prefetch = prefetch; }
+    bool                 prefetch(void) const { return m_prefetch; }
+    bool                 next(void);
+    void                 rewind(void);
+    int                  row(void) const { return m_row; }
+    int                  rows(void) const { return m_rows; }
+    const double*        data(void) const;
+    std::string          print(void) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GFitsTableColReader& reader);
+    void free_members(void);
+
+    // Protected members
+    const GFitsTableCol* m_column;    //!< Column (not owned)
+    int                  m_chunk;     //!< Maximum number of rows per chunk
+    bool                 m_prefetch;  //!< Announce next chunk to the OS
+    int                  m_row;       //!< First row of current chunk
+    int                  m_rows;      //!< Number of rows in current chunk
+    std::vector<double>  m_data;      //!< Values of current chunk
+};
+
+#endif /* GFITSTABLECOLREADER_HPP */
@@ -0,0 +1,124 @@
+/***************************************************************************
+ *           GFitsTableWriter.hpp - Streaming FITS table writer            *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsTableWriter.hpp
+ * @brief Streaming FITS table writer class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GFITSTABLEWRITER_HPP
+#define GFITSTABLEWRITER_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include "GBase.hpp"
+#include "GFitsTable.hpp"
+#include "GFitsTableCol.hpp"
+
+
+/***********************************************************************//**
+ * @class GFitsTableWriter
+ *
+ * @brief Streaming FITS table writer
+ *
+ * This class appends blocks of rows to a binary table extension of an
+ * existing FITS file, without holding the entire table in memory.
+ *
+ * The writer is used as follows:
+ *
+ *     GFitsTableWriter writer("events.fits", "EVENTS");
+ *     for (...) {
+ *         GFitsBinTable block(nrows);
+ *         ...
+ *         writer.write(block);
+ *     }
+ *     writer.close();
+ *
+ * The table extension needs to exist in the file, and each block needs to
+ * have the same columns, in the same order, as the table extension. A
+ * table extension with the column definitions but without any rows can be
+ * created by saving an empty table.
+ *
+ * Each block is encoded into the big-endian FITS row format in memory,
+ * with the columns encoded in parallel. The encoded block is written to
+ * disk while the next block is encoded, hence encoding and disk writing
+ * overlap. The last block is written by flush() or close(), which is
+ * also called when the writer is destroyed.
+ *
+ * The writer uses its own cfitsio file handle. The file should therefore
+ * not be modified through other handles while the writer is open. A copy
+ * of a writer inherits the settings but is not attached to any file.
+ ***************************************************************************/
+class GFitsTableWriter : public GBase {
+
+public:
+    // Constructors and destructors
+    GFitsTableWriter(void);
+    explicit GFitsTableWriter(const std::string& filename,
+                              const std::string& extname);
+    GFitsTableWriter(const GFitsTableWriter& writer);
+    virtual ~GFitsTableWriter(void);
+
+    // Operators
+    GFitsTableWriter& operator= (const GFitsTableWriter& writer);
+
+    // Methods
+    void              clear(void);
+    GFitsTableWriter* clone(void) const;
+    void              open(const std::string& filename,
+                           const std::string& extname);
+    void              write(const GFitsTable& block);
+    void              flush(void);
+    void              close(void);
+    bool              is_open(void) const { return (m_fitsfile != NULL); }
+    int               rows(void) const { return m_rows+m_pending; }
+    void              threads(const int& threads) { m_threads = threads; }
+    int               threads(void) const { return m_threads; }
+    std::string       print(void) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GFitsTableWriter& writer);
+    void free_members(void);
+    void check_block(const GFitsTable& block) const;
+    void encode_column(const GFitsTableCol& column, const int& icol,
+                       const int& nrows, unsigned char* buffer) const;
+    int  write_pending(void);
+
+    // Protected members
+    std::string                m_filename;  //!< FITS file name
+    std::string                m_extname;   //!< Table extension name
+    int                        m_threads;   //!< Number of threads (0=all)
+    void*                      m_fitsfile;  //!< Own FITS file pointer
+    int                        m_rows;      //!< Rows written to disk
+    long long                  m_rowlength; //!< Length of table row in bytes
+    std::vector<int>           m_type;      //!< Column types in file
+    std::vector<int>           m_repeat;    //!< Column repeat values in file
+    std::vector<int>           m_width;     //!< Column element widths in file
+    std::vector<long long>     m_start;     //!< Column byte offsets in row
+    std::vector<unsigned char> m_buffer;    //!< Block being encoded
+    std::vector<unsigned char> m_data;      //!< Encoded block pending write
+    int                        m_pending;   //!< Rows in pending block
+};
+
+#endif /* GFITSTABLEWRITER_HPP */
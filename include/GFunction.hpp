@@ -40,6 +40,8 @@
  * of derivatives. This class has no members. The only pure virtual method
  * that needs to be implemented by the derived class is the eval() method
  * that provides function evaluation at a given value x, e.g. y=eval(x).
+ * Derived classes may in addition implement the batch eval() method that
+ * evaluates the function for several values of x in a single call.
  ***************************************************************************/
 class GFunction {
 
@@ -55,6 +57,7 @@ public:
 
     // Methods
     virtual double eval(double x) = 0;
+    virtual void   eval(const int& num, const double* x, double* values);
 
 protected:
     // Protected methods
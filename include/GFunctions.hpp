@@ -0,0 +1,72 @@
+/***************************************************************************
+ *    GFunctions.hpp  -  Single parameter functions abstract base class    *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2012 by Jurgen Knodlseder                                *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFunctions.hpp
+ * @brief GFunctions abstract virtual base class interface definition.
+ * @author J. Knodlseder
+ */
+
+#ifndef GFUNCTIONS_HPP
+#define GFUNCTIONS_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include "GVector.hpp"
+
+
+/***********************************************************************//**
+ * @class GFunctions
+ *
+ * @brief GFunctions class interface defintion.
+ *
+ * This class implements the abstract interface for a set of one parameter
+ * functions that share the same argument, such as a function and its
+ * derivatives with respect to some parameters. It allows the simultaneous
+ * integration of all functions (see GIntegrals) so that intermediate
+ * results that are common to all functions need to be computed only once.
+ * This class has no members. The pure virtual methods that need to be
+ * implemented by the derived class are the size() method that returns the
+ * number of functions and the eval() method that returns the values of all
+ * functions at a given value x in a vector.
+ ***************************************************************************/
+class GFunctions {
+
+public:
+
+    // Constructors and destructors
+    GFunctions(void);
+    GFunctions(const GFunctions& func);
+    virtual ~GFunctions(void);
+
+    // Operators
+    GFunctions& operator= (const GFunctions& func);
+
+    // Methods
+    virtual int     size(void) const = 0;
+    virtual GVector eval(double x) = 0;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GFunctions& func);
+    void free_members(void);
+};
+
+#endif /* GFUNCTIONS_HPP */
@@ -39,7 +39,12 @@
  * @brief GIntegral class interface defintion.
  *
  * This class allows to perform integration using various methods. The
- * integrand is implemented by a derived class of GIntegrand.
+ * integrand is implemented by a derived class of GFunction.
+ *
+ * The romb() method performs Romberg integration, the gkq() method
+ * performs adaptive Gauss-Kronrod integration. After integration, the
+ * number of function evaluations and the estimated absolute error can be
+ * retrieved using the calls() and error() methods.
  ***************************************************************************/
 class GIntegral : public GBase {
 
@@ -61,6 +66,8 @@ public:
     void             eps(const double& eps) { m_eps=eps; }
     void             silent(const bool& silent) { m_silent=silent; }
     const int&       iter(void) const { return m_iter; }
+    const int&       calls(void) const { return m_calls; }
+    const double&    error(void) const { return m_error; }
     const int&       max_iter(void) const { return m_max_iter; }
     const double&    eps(void) const { return m_eps; }
     const bool&      silent(void) const { return m_silent; }
@@ -68,6 +75,7 @@ public:
     const GFunction* kernel(void) const { return m_kernel; }
     double           romb(double a, double b, int k = 5);
     double           trapzd(double a, double b, int n = 1, double result = 0.0);
+    double           gkq(double a, double b, int n = 15);
     std::string      print(void) const;
 
 protected:
@@ -76,12 +84,15 @@ protected:
     void   copy_members(const GIntegral& integral);
     void   free_members(void);
     double polint(double* xa, double* ya, int n, double x, double *dy);
+    double gk(double a, double b, int n, double* error);
 
     // Protected data area
     GFunction* m_kernel;       //!< Pointer to function kernel
     double     m_eps;          //!< Integration precision
     int        m_max_iter;     //!< Maximum number of iterations
     int        m_iter;         //!< Number of iterations used
+    int        m_calls;        //!< Number of function evaluations used
+    double     m_error;        //!< Estimated absolute integration error
     bool       m_silent;       //!< Suppress integration warnings
 };
 
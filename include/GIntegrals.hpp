@@ -0,0 +1,93 @@
+/***************************************************************************
+ *          GIntegrals.hpp  -  Integration class for set of functions      *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2012 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GIntegrals.hpp
+ * @brief Integration class for set of functions interface definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GINTEGRALS_HPP
+#define GINTEGRALS_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include "GBase.hpp"
+#include "GVector.hpp"
+#include "GFunctions.hpp"
+
+
+/***********************************************************************//**
+ * @class GIntegrals
+ *
+ * @brief GIntegrals class interface defintion.
+ *
+ * This class allows to integrate a set of functions that share the same
+ * argument in a single pass. All functions are evaluated at the same
+ * nodes, hence computations that are common to all functions are only done
+ * once. A typical use case is the integration of a function together with
+ * its parameter gradients. The integrand is implemented by a derived class
+ * of GFunctions.
+ ***************************************************************************/
+class GIntegrals : public GBase {
+
+public:
+
+    // Constructors and destructors
+    explicit GIntegrals(void);
+    explicit GIntegrals(GFunctions* kernel);
+    GIntegrals(const GIntegrals& integral);
+    virtual ~GIntegrals(void);
+
+    // Operators
+    GIntegrals& operator=(const GIntegrals& integral);
+
+    // Methods
+    void              clear(void);
+    GIntegrals*       clone(void) const;
+    void              max_iter(const int& max_iter) { m_max_iter=max_iter; }
+    void              eps(const double& eps) { m_eps=eps; }
+    void              silent(const bool& silent) { m_silent=silent; }
+    const int&        iter(void) const { return m_iter; }
+    const int&        max_iter(void) const { return m_max_iter; }
+    const double&     eps(void) const { return m_eps; }
+    const bool&       silent(void) const { return m_silent; }
+    void              kernel(GFunctions* kernel) { m_kernel=kernel; }
+    const GFunctions* kernel(void) const { return m_kernel; }
+    GVector           romb(double a, double b, int k = 5);
+    GVector           trapzd(double a, double b, int n, const GVector& result);
+    std::string       print(void) const;
+
+protected:
+    // Protected methods
+    void   init_members(void);
+    void   copy_members(const GIntegrals& integral);
+    void   free_members(void);
+    double polint(double* xa, double* ya, int n, double x, double *dy);
+
+    // Protected data area
+    GFunctions* m_kernel;       //!< Pointer to function kernel
+    double      m_eps;          //!< Integration precision
+    int         m_max_iter;     //!< Maximum number of iterations
+    int         m_iter;         //!< Number of iterations used
+    bool        m_silent;       //!< Suppress integration warnings
+};
+
+#endif /* GINTEGRALS_HPP */
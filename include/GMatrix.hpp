@@ -99,6 +99,8 @@ public:
     std::string print(void) const;
 
     // Other methods
+    void        add_col(const double* values, const int* rows,
+                        int number, const int& col);
     GMatrix     extract_lower_triangle(void) const;
     GMatrix     extract_upper_triangle(void) const;
     void        eulerx(const double& angle);
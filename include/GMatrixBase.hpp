@@ -66,6 +66,8 @@ public:
     virtual void         transpose(void) = 0;
     virtual void         invert(void) = 0;
     virtual void         add_col(const GVector& vector, const int& col) = 0;
+    virtual void         add_col(const double* values, const int* rows,
+                                 int number, const int& col) = 0;
     virtual void         insert_col(const GVector& vector, const int& col) = 0;
     virtual GVector      extract_row(const int& row) const = 0;
     virtual GVector      extract_col(const int& col) const = 0;
@@ -50,7 +50,11 @@ class GObservation;
  * model evaluation: eval() and eval_gradients().
  * The eval() method evaluates the model for a given event and observation.
  * In addition, eval_gradients() also sets the parameter gradients of the
- * model.
+ * model. A block version of eval_gradients() evaluates the model and its
+ * parameter gradients for a contiguous range of events of an observation
+ * in a single call. Derived classes may overload this method to amortise
+ * the per-event overhead; by default it loops over the single event
+ * method.
  *
  * This abstract virtual base class implements the methods that handle the
  * model name and the applicable instruments. It also implements friend
@@ -91,6 +95,13 @@ public:
     virtual void        write(GXmlElement& xml) const = 0;
     virtual std::string print(void) const = 0;
 
+    // Virtual methods
+    virtual void        eval_gradients(const GObservation& obs,
+                                       const int&          ibegin,
+                                       const int&          iend,
+                                       double*             values,
+                                       double*             gradients) const;
+
     // Implemented methods
     int                 size(void) const { return m_pars.size(); }
     std::string         name(void) const { return m_name; }
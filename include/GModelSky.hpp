@@ -108,6 +108,13 @@ public:
     virtual void        write(GXmlElement& xml) const;
     virtual std::string print(void) const;
 
+    // Overloaded virtual base class methods
+    virtual void        eval_gradients(const GObservation& obs,
+                                       const int&          ibegin,
+                                       const int&          iend,
+                                       double*             values,
+                                       double*             gradients) const;
+
     // Other methods
     GModelSpatial*      spatial(void) const { return m_spatial; }
     GModelSpectral*     spectral(void) const { return m_spectral; }
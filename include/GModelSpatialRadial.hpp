@@ -71,6 +71,7 @@ public:
     // Implemented virtual methods
     virtual double eval(const GSkyDir& srcDir) const;
     virtual double eval_gradients(const GSkyDir& srcDir) const;
+    virtual double theta_max_gradient(const int& ipar) const;
     virtual void   read(const GXmlElement& xml);
     virtual void   write(GXmlElement& xml) const;
 
@@ -73,6 +73,12 @@ public:
     virtual void            write(GXmlElement& xml) const = 0;
     virtual std::string     print(void) const = 0;
 
+    // Virtual methods
+    virtual void            eval_gradients(const int&     num,
+                                           const GEnergy* srcEng,
+                                           double*        values,
+                                           double*        gradients) const;
+
     // Methods
     int  size(void) const;
     void autoscale(void);
@@ -75,6 +75,12 @@ public:
     virtual void                write(GXmlElement& xml) const;
     virtual std::string         print(void) const;
 
+    // Overloaded virtual methods
+    virtual void                eval_gradients(const int&     num,
+                                               const GEnergy* srcEng,
+                                               double*        values,
+                                               double*        gradients) const;
+
     // Other methods
     double norm(void) const { return m_norm.value(); }
     double index(void) const { return m_index.value(); }
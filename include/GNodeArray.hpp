@@ -46,11 +46,20 @@
  * Nodes are allocated either from a double precision array, a GVector object
  * or a std::vector using the nodes() method. Alternatively, the node array
  * may be built on the fly using the append() method.
- * Interpolation can be either performed using the interpolate() method
+ * Interpolation can be either performed using the interpolate() methods
  * or using the set_value(). In the latter case, the node indices and
  * weighting factors can be recovered using inx_left(), inx_right(),
  * wgt_left() and wgt_right().
  * If the nodes are equally spaced, interpolation is more rapid.
+ *
+ * The interpolate() methods do not modify the node array, hence a node
+ * array may be shared by several threads as long as only these methods
+ * are used. The set_value() method stores the indices and weighting
+ * factors in the node array, and is therefore not thread safe. For
+ * batches of values, interpolate() returns the indices and weighting
+ * factors for all values in one call; if the values are sorted in
+ * ascending order, the search for a value starts from the indices of the
+ * preceeding value.
  ***************************************************************************/
 class GNodeArray : public GBase {
 
@@ -78,6 +87,14 @@ public:
     void          append(const double& node);
     double        interpolate(const double& value,
                               const std::vector<double>& vector) const;
+    void          interpolate(const double& value,
+                              int*          inx,
+                              double*       wgt) const;
+    void          interpolate(const int&    num,
+                              const double* values,
+                              int*          inx,
+                              double*       wgt,
+                              const bool&   sorted = false) const;
     void          set_value(const double& value) const;
     const int&    inx_left(void) const { return m_inx_left; }
     const int&    inx_right(void) const { return m_inx_right; }
@@ -91,6 +108,9 @@ private:
     void copy_members(const GNodeArray& array);
     void free_members(void);
     void setup(void) const;
+    void check_setup(void) const;
+    int  search(const double& value) const;
+    int  search(const double& value, const int& hint) const;
     
     // Node values
     std::vector<double> m_node;                   //!< Array of nodes
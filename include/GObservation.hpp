@@ -32,6 +32,7 @@
 #include "GBase.hpp"
 #include "GEvents.hpp"
 #include "GResponse.hpp"
+#include "GResponseCache.hpp"
 #include "GPointing.hpp"
 #include "GModels.hpp"
 #include "GTime.hpp"
@@ -85,6 +86,9 @@ public:
     // Virtual methods
     virtual double        model(const GModels& models, const GEvent& event,
                                 GVector* gradient = NULL) const;
+    virtual void          model(const GModels& models, const int& ibegin,
+                                const int& iend, double* values,
+                                double* gradients = NULL) const;
     virtual double        npred(const GModels& models, GVector* gradient = NULL) const;
 
     // Implemented methods
@@ -98,13 +102,20 @@ public:
     const std::string&    statistics(void) const { return m_statistics; }
 
     // Other methods
-    virtual double model_grad(const GModel& model, const GEvent& event, int ipar) const;
-    virtual double npred_grad(const GModel& model, int ipar) const;
+    virtual GObservation* shallow_clone(const bool& share_events = true) const;
+    void            use_irf_cache(const bool& use);
+    GResponseCache* irf_cache(void) const { return m_irf_cache; }
+    virtual double  model_grad(const GModel& model, const GEvent& event, int ipar) const;
+    virtual double  npred_grad(const GModel& model, int ipar) const;
 
 protected:
+    // Protected constructors
+    GObservation(const GObservation& obs, const bool& share_events);
+
     // Protected methods
     void init_members(void);
-    void copy_members(const GObservation& obs);
+    void copy_members(const GObservation& obs,
+                      const bool&         share_events = false);
     void free_members(void);
 
 
@@ -176,10 +187,13 @@ protected:
     };
 
     // Protected data area
-    std::string m_name;         //!< Name of observation
-    std::string m_id;           //!< Observation identifier
-    std::string m_statistics;   //!< Optimizer statistics (default=poisson)
-    GEvents*    m_events;       //!< Pointer to event container
+    std::string     m_name;          //!< Name of observation
+    std::string     m_id;            //!< Observation identifier
+    std::string     m_statistics;    //!< Optimizer statistics (default=poisson)
+    GEvents*        m_events;        //!< Pointer to event container
+    bool            m_shared_events; //!< Event container is not owned
+    GResponseCache* m_irf_cache;     //!< Response cache (NULL if unused)
+    bool            m_shared_cache;  //!< Response cache is not owned
 };
 
 #endif /* GOBSERVATION_HPP */
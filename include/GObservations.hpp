@@ -36,6 +36,7 @@
 #include "GOptimizer.hpp"
 #include "GOptimizerFunction.hpp"
 #include "GModels.hpp"
+#include "GMatrix.hpp"
 
 
 /***********************************************************************//**
@@ -74,6 +75,11 @@
  * class. The models() method allows setting and retrieving the list of
  * models, as well as loading of models from an XML file.
  *
+ * Reading of observations can be parallelised over observations using
+ * the load_threads() method. The load_budget() method limits the total
+ * size of the files that are read at the same time, and the load_times()
+ * method returns the time that was needed to read each observation.
+ *
  * Based on the list of models, the optimize() method will optimize all
  * model parameters that are marked as free in the list of models. The
  * npred() method returns the total number of events that are prediced
@@ -112,6 +118,11 @@ public:
     void           save(const std::string& filename) const;
     void           read(const GXml& xml);
     void           write(GXml& xml) const;
+    void           load_threads(const int& threads);
+    int            load_threads(void) const { return m_load_threads; }
+    void           load_budget(const double& budget);
+    double         load_budget(void) const { return m_load_budget; }
+    const std::vector<double>& load_times(void) const { return m_load_times; }
     void           models(const GModels& models) { m_models=models;} //!< @brief Set model container
     void           models(const std::string& filename);
     const GModels& models(void) { return m_models; } //!< @brief Return model container
@@ -145,7 +156,7 @@ public:
                               const GOptimizerPars& pars);
         void poisson_unbinned(const GObservation&   obs,
                               const GOptimizerPars& pars,
-                              GSparseMatrix&        covar,
+                              GMatrixBase&          covar,
                               GVector&              mgrad,
                               double&               value,
                               GVector&              gradient);
@@ -153,7 +164,7 @@ public:
                             const GOptimizerPars& pars);
         void poisson_binned(const GObservation&   obs,
                             const GOptimizerPars& pars,
-                            GSparseMatrix&        covar,
+                            GMatrixBase&          covar,
                             GVector&              mgrad,
                             double&               value,
                             double&               npred,
@@ -162,17 +173,60 @@ public:
                              const GOptimizerPars& pars);
         void gaussian_binned(const GObservation&   obs,
                              const GOptimizerPars& pars,
-                             GSparseMatrix&        covar,
+                             GMatrixBase&          covar,
                              GVector&              mgrad,
                              double&               value,
                              double&               npred,
                              GVector&              gradient);
 
     protected:
+        // Protected enumerators
+        enum Kernel {
+            POISSON_UNBINNED,
+            POISSON_BINNED,
+            GAUSSIAN_BINNED
+        };
+
         // Protected methods
         void           init_members(void);
         void           copy_members(const optimizer& fct);
         void           free_members(void);
+        void           eval_range(const Kernel&         kernel,
+                                  const GObservation&   obs,
+                                  const GOptimizerPars& pars,
+                                  const int&            ibegin,
+                                  const int&            iend,
+                                  GMatrixBase&          covar,
+                                  GVector&              gradient,
+                                  double&               value,
+                                  double&               npred,
+                                  GVector&              wrk_grad);
+        void           poisson_unbinned_range(const GObservation&   obs,
+                                              const GOptimizerPars& pars,
+                                              const int&            ibegin,
+                                              const int&            iend,
+                                              GMatrixBase&          covar,
+                                              GVector&              gradient,
+                                              double&               value,
+                                              GVector&              wrk_grad);
+        void           poisson_binned_range(const GObservation&   obs,
+                                            const GOptimizerPars& pars,
+                                            const int&            ibegin,
+                                            const int&            iend,
+                                            GMatrixBase&          covar,
+                                            GVector&              gradient,
+                                            double&               value,
+                                            double&               npred,
+                                            GVector&              wrk_grad);
+        void           gaussian_binned_range(const GObservation&   obs,
+                                             const GOptimizerPars& pars,
+                                             const int&            ibegin,
+                                             const int&            iend,
+                                             GMatrixBase&          covar,
+                                             GVector&              gradient,
+                                             double&               value,
+                                             double&               npred,
+                                             GVector&              wrk_grad);
 
         // Protected data members
         double         m_value;       //!< Function value
@@ -193,11 +247,15 @@ protected:
     void init_members(void);
     void copy_members(const GObservations& obs);
     void free_members(void);
+    double load_size(const GXmlElement& obs) const;
 
     // Protected members
-    std::vector<GObservation*> m_obs;    //!< List of observations
-    GModels                    m_models; //!< List of models
-    GObservations::optimizer   m_fct;    //!< Optimizer function
+    std::vector<GObservation*> m_obs;          //!< List of observations
+    GModels                    m_models;       //!< List of models
+    GObservations::optimizer   m_fct;          //!< Optimizer function
+    int                        m_load_threads; //!< Number of threads for reading
+    double                     m_load_budget;  //!< Size budget for reading (MB)
+    std::vector<double>        m_load_times;   //!< Reading times (seconds)
 };
 
 #endif /* GOBSERVATIONS_HPP */
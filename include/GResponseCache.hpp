@@ -0,0 +1,98 @@
+/***************************************************************************
+ *            GResponseCache.hpp - Instrument response cache class         *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2012 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GResponseCache.hpp
+ * @brief Instrument response cache class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GRESPONSECACHE_HPP
+#define GRESPONSECACHE_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include "GBase.hpp"
+#include "GModelSpatial.hpp"
+
+
+/***********************************************************************//**
+ * @class GResponseCache
+ *
+ * @brief Instrument response cache class
+ *
+ * This class caches instrument response function values for contiguous
+ * ranges of events of an observation. Values are stored per source and
+ * per event range, together with the spatial model parameters for which
+ * they were computed. A cached value is only returned if the spatial model
+ * parameters are unchanged, hence the cache is automatically invalidated
+ * when the spatial model changes.
+ *
+ * The cache is meant for sources with a fixed spatial shape during a
+ * maximum likelihood fit, for which the response values of all events
+ * do not change between optimizer iterations. Access to the cache is
+ * thread safe.
+ ***************************************************************************/
+class GResponseCache : public GBase {
+
+public:
+    // Constructors and destructors
+    GResponseCache(void);
+    GResponseCache(const GResponseCache& cache);
+    virtual ~GResponseCache(void);
+
+    // Operators
+    GResponseCache& operator= (const GResponseCache& cache);
+
+    // Methods
+    void            clear(void);
+    GResponseCache* clone(void) const;
+    int             size(void) const;
+    bool            get(const std::string&   name,
+                        const int&           ibegin,
+                        const int&           iend,
+                        const GModelSpatial& spatial,
+                        double*              irfs) const;
+    void            set(const std::string&   name,
+                        const int&           ibegin,
+                        const int&           iend,
+                        const GModelSpatial& spatial,
+                        const double*        irfs);
+    std::string     print(void) const;
+
+protected:
+    // Protected methods
+    void init_members(void);
+    void copy_members(const GResponseCache& cache);
+    void free_members(void);
+
+    // Protected types
+    typedef std::pair<std::string,int>                  key_type;
+    typedef std::map<key_type, std::vector<double> >    cache_type;
+
+    // Protected members
+    cache_type m_pars;   //!< Spatial model parameters of cached ranges
+    cache_type m_irfs;   //!< Cached response values
+};
+
+#endif /* GRESPONSECACHE_HPP */
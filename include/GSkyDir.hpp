@@ -46,6 +46,12 @@
  * systems (in units of radians), and conversion is performed (and stored)
  * if requested. Coordinates can be given and returned in radians or in
  * degrees. Note that the epoch for celestial coordinates is fixed to J2000.
+ *
+ * In addition, the class stores the celestial unit vector of the sky
+ * direction, which is set whenever the coordinates are set. Angular
+ * distances are computed from the dot product of the unit vectors, which
+ * avoids any trigonometric function except for the final arccos. Use
+ * cos_dist() if the cosine of the distance is sufficient.
  ***************************************************************************/
 class GSkyDir : public GBase {
 
@@ -66,6 +72,8 @@ public:
     void        clear(void);
     GSkyDir*    clone(void) const;
     void        radec(const double& ra, const double& dec);
+    void        radec(const double& ra, const double& dec,
+                      const double& x, const double& y, const double& z);
     void        radec_deg(const double& ra, const double& dec);
     void        lb(const double& l, const double& b);
     void        lb_deg(const double& l, const double& b);
@@ -80,8 +88,12 @@ public:
     double      dec(void) const;
     double      dec_deg(void) const;
     GVector     celvector(void) const;
+    double      cos_dist(const GSkyDir& dir) const;
     double      dist(const GSkyDir& dir) const;
     double      dist_deg(const GSkyDir& dir) const;
+    void        cos_dist(const int& num, const GSkyDir* dirs,
+                         double* cosdist) const;
+    void        dist(const int& num, const GSkyDir* dirs, double* dist) const;
     double      posang(const GSkyDir& dir) const;
     double      posang_deg(const GSkyDir& dir) const;
     std::string print(void) const;
@@ -91,6 +103,7 @@ private:
     void init_members(void);
     void copy_members(const GSkyDir& dir);
     void free_members(void);
+    void set_vector(void);
     void equ2gal(void) const;
     void gal2equ(void) const;
     void euler(const int& type, const double& xin, const double &yin,
@@ -103,6 +116,9 @@ private:
     double m_b;          //!< Galactic latitude in radians
     double m_ra;         //!< Right Ascension in radians
     double m_dec;        //!< Declination in radians
+    double m_x;          //!< Celestial unit vector x component
+    double m_y;          //!< Celestial unit vector y component
+    double m_z;          //!< Celestial unit vector z component
 };
 
 #endif /* GSKYDIR_HPP */
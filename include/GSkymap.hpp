@@ -29,12 +29,14 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <string>
+#include <vector>
 #include "GBase.hpp"
 #include "GWcs.hpp"
 #include "GSkyDir.hpp"
 #include "GSkyPixel.hpp"
 #include "GFits.hpp"
 #include "GFitsTable.hpp"
+#include "GFitsTableCol.hpp"
 #include "GFitsBinTable.hpp"
 #include "GFitsImage.hpp"
 #include "GFitsImageDouble.hpp"
@@ -59,6 +61,22 @@
  * the preferred access method for WCS maps. Conversion methods between the
  * index or sky pixel and the true physical sky direction are provided by the
  * pix2dir() and dir2pix() methods.
+ *
+ * For maps that cover only part of the sky, pixels may be stored in sparse
+ * storage. The pixels of each map are then grouped in tiles of contiguous
+ * pixel indices, and only tiles that hold at least one pixel are allocated.
+ * Non-const pixel access allocates the tile of the pixel, while const
+ * access returns 0 for pixels in unallocated tiles. Tiles are allocated
+ * in a critical section, hence distinct pixels of a sparse map may be
+ * written from several threads at the same time. Sparse HEALPix maps are
+ * read and written using the partial-sky convention (INDXSCHM=EXPLICIT).
+ * Note that pixels() returns a NULL pointer for sparse maps.
+ *
+ * Pixels are always held in double precision in memory. The data type of
+ * the FITS output can be selected using the bitpix() method, following
+ * the FITS BITPIX convention (-64: double, -32: float, 32: 32-bit integer).
+ * The output type defaults to double precision, also for maps that were
+ * read from FITS files of another data type.
  ***************************************************************************/
 class GSkymap : public GBase {
 
@@ -68,11 +86,12 @@ public:
     explicit GSkymap(const std::string& filename);
     explicit GSkymap(const std::string& wcs, const std::string& coords,
                      const int& nside, const std::string& order,
-                     const int nmaps = 1);
+                     const int nmaps = 1, const bool sparse = false);
     explicit GSkymap(const std::string& wcs, const std::string& coords,
                      double const& x, double const& y,
                      double const& dx, double const& dy,
-                     const int& nx, const int& ny, const int nmaps = 1);
+                     const int& nx, const int& ny, const int nmaps = 1,
+                     const bool sparse = false);
     GSkymap(const GSkymap& map);
     virtual ~GSkymap(void);
 
@@ -93,6 +112,16 @@ public:
     GSkyPixel     dir2xy(const GSkyDir& dir) const;
     double        omega(const GSkyPixel& pix) const;
 
+    // Pixel array methods
+    void          pix2dir(const int& num, const int* pix,
+                          double* lon, double* lat) const;
+    void          dir2pix(const int& num, const double* lon,
+                          const double* lat, int* pix) const;
+    void          xy2dir(const int& num, const double* x, const double* y,
+                         double* lon, double* lat) const;
+    void          dir2xy(const int& num, const double* lon, const double* lat,
+                         double* x, double* y) const;
+
     // Sky direction methods
     double        operator() (const GSkyDir& dir, const int& map = 0) const;
 
@@ -112,6 +141,12 @@ public:
     GWcs*         wcs(void) const { return m_wcs; }
     void          wcs(const GWcs& wcs);
     double*       pixels(void) const { return m_pixels; }
+    bool          issparse(void) const { return m_sparse; }
+    void          sparse(void);
+    void          dense(void);
+    int           nstored(void) const;
+    int           bitpix(void) const { return m_bitpix; }
+    void          bitpix(const int& bitpix);
     bool          isinmap(const GSkyDir& dir) const;
     bool          isinmap(const GSkyPixel& pixel) const;
     std::string   print(void) const;
@@ -122,16 +157,29 @@ private:
     void              alloc_pixels(void);
     void              copy_members(const GSkymap& map);
     void              free_members(void);
+    int               ntiles(void) const;
+    double*           sparse_pixel(const int& pixel, const int& map);
+    const double*     sparse_pixel(const int& pixel, const int& map) const;
     void              set_wcs(const std::string& wcs, const std::string& coords,
                               const double& crval1, const double& crval2,
                               const double& crpix1, const double& crpix2,
                               const double& cdelt1, const double& cdelt2,
                               const GMatrix& cd, const GVector& pv2);
     void              read_healpix(const GFitsTable* hdu);
+    void              read_healpix_explicit(const GFitsTable* hdu);
     void              read_wcs(const GFitsImage* hdu);
     void              alloc_wcs(const GFitsImage* hdu);
     GFitsBinTable*    create_healpix_hdu(void) const;
-    GFitsImageDouble* create_wcs_hdu(void) const;
+    GFitsBinTable*    create_healpix_hdu(const int& first,
+                                         const int& nrows) const;
+    GFitsBinTable*    create_healpix_explicit_hdu(void) const;
+    GFitsImage*       create_wcs_hdu(void) const;
+    GFitsTableCol*    alloc_column(const std::string& name, const int& rows,
+                                   const int& number) const;
+    void              set_value(GFitsTableCol* column, const int& row,
+                                const int& inx, const double& value) const;
+    void              set_value(GFitsImage* image, const int& pix,
+                                const double& value) const;
 
     // Private data area
     int     m_num_pixels;   //!< Number of pixels (used for pixel allocation)
@@ -140,6 +188,11 @@ private:
     int     m_num_y;        //!< Number of pixels in y direction (only 2D)
     GWcs*   m_wcs;          //!< Pointer to WCS projection
     double* m_pixels;       //!< Pointer to skymap pixels
+    int     m_bitpix;       //!< Pixel data type for FITS output
+
+    // Sparse storage
+    bool                 m_sparse;  //!< Pixels are stored in tiles
+    std::vector<double*> m_tiles;   //!< Pixel tiles of all maps (sparse only)
 };
 
 #endif /* GSKYMAP_HPP */
@@ -89,6 +89,8 @@ public:
     virtual void        transpose(void) { return; }
     virtual void        invert(void);
     virtual void        add_col(const GVector& vector, const int& col);
+    virtual void        add_col(const double* values, const int* rows,
+                                int number, const int& col);
     virtual void        insert_col(const GVector& vector, const int& col);
     virtual GVector     extract_row(const int& row) const;
     virtual GVector     extract_col(const int& col) const;
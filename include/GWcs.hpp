@@ -73,6 +73,14 @@ public:
     // Virtual methods
     virtual std::string coordsys(void) const;
     virtual void        coordsys(const std::string& coordsys);
+    virtual void        pix2dir(const int& num, const int* pix,
+                                double* lon, double* lat) const;
+    virtual void        dir2pix(const int& num, const double* lon,
+                                const double* lat, int* pix) const;
+    virtual void        xy2dir(const int& num, const double* x, const double* y,
+                               double* lon, double* lat) const;
+    virtual void        dir2xy(const int& num, const double* lon, const double* lat,
+                               double* x, double* y) const;
 
 protected:
     // Protected methods
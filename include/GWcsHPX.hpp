@@ -28,6 +28,7 @@
 #define GWCSHPX_HPP
 
 /* __ Includes ___________________________________________________________ */
+#include <vector>
 #include "GWcs.hpp"
 #include "GFitsHDU.hpp"
 #include "GSkyDir.hpp"
@@ -42,6 +43,13 @@
  * The HealPix projection class has been implemented by adapting code from
  * the HealPix library (version 2.1). For more information about HEALPix, see
  * http://healpix.jpl.nasa.gov
+ *
+ * Besides the pixel to sky conversions, the class implements hierarchical
+ * queries that return only the pixels within a disc or a convex polygon,
+ * neighbour lookup, conversion between RING and NESTED pixel indices, and
+ * the NESTED up- and down-grading of pixels to other resolutions. For maps
+ * with up to 12*512*512 pixels, ring/nest conversions are done using
+ * tables that are computed at the first conversion.
  ***************************************************************************/
 class GWcsHPX : public GWcs {
 
@@ -70,13 +78,29 @@ public:
     virtual int         dir2pix(const GSkyDir& dir) const;
     virtual GSkyDir     xy2dir(const GSkyPixel& pix) const;
     virtual GSkyPixel   dir2xy(const GSkyDir& dir) const;
+    virtual void        pix2dir(const int& num, const int* pix,
+                                double* lon, double* lat) const;
+    virtual void        dir2pix(const int& num, const double* lon,
+                                const double* lat, int* pix) const;
     virtual std::string print(void) const;
+    using GWcs::xy2dir;
+    using GWcs::dir2xy;
 
     // Additional class specific methods
     int          npix(void) const;
     int          nside(void) const;
     std::string  ordering(void) const;
     void         ordering(const std::string& ordering);
+    std::vector<int> query_disc(const GSkyDir& dir, const double& radius,
+                                const bool& inclusive = false) const;
+    std::vector<int> query_polygon(const std::vector<GSkyDir>& vertices) const;
+    std::vector<int> neighbours(const int& pix) const;
+    int              ring2nest(const int& pix) const;
+    int              nest2ring(const int& pix) const;
+    void             ring2nest(const int& num, const int* ring, int* nest) const;
+    void             nest2ring(const int& num, const int* nest, int* ring) const;
+    int              parent(const int& pix, const int& nside) const;
+    std::vector<int> children(const int& pix, const int& nside) const;
 
 private:
     // Private methods
@@ -86,7 +110,7 @@ private:
     virtual bool compare(const GWcs& wcs) const;
     void         std2nat(GVector *coord) const { return; }
     void         nat2std(GVector *coord) const { return; }
-    int          nside2order(int nside);
+    int          nside2order(int nside) const;
     void         pix2xy(const int& ipix, int* x, int* y) const;
     int          xy2pix(int x, int y) const;
     void         pix2ang_ring(int ipix, double* theta, double* phi) const;
@@ -94,6 +118,18 @@ private:
     int          ang2pix_z_phi_ring(double z, double phi) const;
     int          ang2pix_z_phi_nest(double z, double phi) const;
     unsigned int isqrt(unsigned int arg) const;
+    int          ring_above(const double& z) const;
+    double       ring2z(const int& ring) const;
+    void         ring_info(const int& ring, int* startpix, int* ringpix,
+                           bool* shifted) const;
+    void         ring2xyf(const int& pix, int* ix, int* iy, int* face) const;
+    int          xyf2ring(const int& ix, const int& iy, const int& face) const;
+    void         nest2xyf(const int& pix, int* ix, int* iy, int* face) const;
+    int          xyf2nest(const int& ix, const int& iy, const int& face) const;
+    void         dir2vec(const GSkyDir& dir, double* vec) const;
+    void         query_ring(const double& theta, const double& phi,
+                            const double& radius, std::vector<int>& pixels) const;
+    bool         set_tables(void) const;
 
     // NEW VERSION
     void prj_set(void);
@@ -114,6 +150,11 @@ private:
     double   m_fact1;        //!<
     double   m_fact2;        //!<
     double   m_omega;        //!< Solid angle of pixel
+
+    // Ring/nest conversion tables
+    mutable bool             m_has_tables; //!< Conversion tables exist
+    mutable std::vector<int> m_ring2nest;  //!< Nested index of ring pixels
+    mutable std::vector<int> m_nest2ring;  //!< Ring index of nested pixels
 };
 
 #endif /* GWCSHPX_HPP */
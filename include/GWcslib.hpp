@@ -75,6 +75,12 @@ public:
     virtual int         dir2pix(const GSkyDir& dir) const;
     virtual GSkyDir     xy2dir(const GSkyPixel& pix) const;
     virtual GSkyPixel   dir2xy(const GSkyDir& dir) const;
+    virtual void        xy2dir(const int& num, const double* x, const double* y,
+                               double* lon, double* lat) const;
+    virtual void        dir2xy(const int& num, const double* lon, const double* lat,
+                               double* x, double* y) const;
+    using GWcs::pix2dir;
+    using GWcs::dir2pix;
 
     // Other methods
     void   set(const std::string& coords,
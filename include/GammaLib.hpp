@@ -53,8 +53,10 @@
 #include "GSymMatrix.hpp"
 #include "GSparseMatrix.hpp"
 #include "GIntegral.hpp"
+#include "GIntegrals.hpp"
 #include "GDerivative.hpp"
 #include "GFunction.hpp"
+#include "GFunctions.hpp"
 #include "GNumerics.hpp"
 
 /* __ FITS module ________________________________________________________ */
@@ -88,6 +90,10 @@
 #include "GFitsTableDoubleCol.hpp"
 #include "GFitsTableCFloatCol.hpp"
 #include "GFitsTableCDoubleCol.hpp"
+#include "GFitsTableColReader.hpp"
+#include "GFitsTableWriter.hpp"
+#include "GFitsMmap.hpp"
+#include "GFitsFileLock.hpp"
 
 /* __ XML module _________________________________________________________ */
 #include "GXml.hpp"
@@ -158,6 +164,7 @@
 #include "GInstDir.hpp"
 #include "GPointing.hpp"
 #include "GResponse.hpp"
+#include "GResponseCache.hpp"
 #include "GPhotons.hpp"
 #include "GPhoton.hpp"
 #include "GSource.hpp"
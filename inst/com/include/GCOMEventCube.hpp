@@ -98,6 +98,8 @@ protected:
     virtual void set_times(void);
     void         init_bin(void);
     void         set_bin(const int& index);
+    void         set_bin(const int& index, GCOMEventBin* bin,
+                         GCOMInstDir* dir) const;
 
     // Protected members
     GCOMEventBin         m_bin;        //!< Actual event bin
@@ -44,9 +44,48 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_BIN_RING 16 //!< Number of event bins per thread for const access
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Local data _________________________________________________________ */
+// Ring of event bins of a thread for const bin access, together with the
+// instrument directions of the bins. The bins are handed out in turn, hence
+// a bin is only overwritten after G_BIN_RING further const accesses from
+// the same thread.
+struct GCOMEventCubeBinRing {
+    GCOMEventBin  bins[G_BIN_RING];
+    GCOMInstDir   dirs[G_BIN_RING];
+    int           next;
+};
+
+// Pool of all event bin rings. A ring is allocated on the first const bin
+// access of a thread and registered in the pool, which releases all rings
+// at program exit.
+class GCOMEventCubeBinPool {
+public:
+    ~GCOMEventCubeBinPool(void) {
+        for (int i = 0; i < m_rings.size(); ++i) {
+            delete m_rings[i];
+        }
+        m_rings.clear();
+    }
+    GCOMEventCubeBinRing* allocate(void) {
+        GCOMEventCubeBinRing* ring = new GCOMEventCubeBinRing;
+        ring->next = 0;
+        #pragma omp critical(GCOMEventCube_bin_pool)
+        m_rings.push_back(ring);
+        return ring;
+    }
+private:
+    std::vector<GCOMEventCubeBinRing*> m_rings;
+};
+static GCOMEventCubeBinPool  g_bin_pool;
+static GCOMEventCubeBinRing* g_bin_ring = NULL;
+#ifdef _OPENMP
+#pragma omp threadprivate(g_bin_ring)
+#endif
+
 
 
 /*==========================================================================
@@ -224,17 +263,29 @@ GCOMEventBin* GCOMEventCube::operator[](const int& index)
  * @param[in] index Event index [0,...,size()-1].
  * @return Const pointer to event bin.
  *
- * Returns pointer to an event bin. Note that the returned pointer is in
- * fact always the same, but the method sets the pointers within the
- * event bin so that they point to the appropriate information.
+ * Returns pointer to an event bin. The event bin is taken from a ring of
+ * G_BIN_RING event bins of the calling thread, hence the event cube is not
+ * modified and can be accessed from several threads at the same time. The
+ * returned pointer remains valid for the next G_BIN_RING-1 (=15) const
+ * accesses to event cubes from the same thread.
  ***************************************************************************/
 const GCOMEventBin* GCOMEventCube::operator[](const int& index) const
 {
-    // Set event bin (circumvent const correctness)
-    ((GCOMEventCube*)this)->set_bin(index);
+    // Allocate event bin ring of thread if required
+    if (g_bin_ring == NULL) {
+        g_bin_ring = g_bin_pool.allocate();
+    }
+
+    // Get next event bin and instrument direction of ring
+    GCOMEventBin* bin = &(g_bin_ring->bins[g_bin_ring->next]);
+    GCOMInstDir*  dir = &(g_bin_ring->dirs[g_bin_ring->next]);
+    g_bin_ring->next  = (g_bin_ring->next + 1) % G_BIN_RING;
+
+    // Set event bin
+    set_bin(index, bin, dir);
 
     // Return pointer
-    return (&m_bin);
+    return bin;
 }
 
 
@@ -686,13 +737,32 @@ void GCOMEventCube::set_scatter_directions(void)
     m_dirs.reserve(npix());
     m_omega.reserve(npix());
 
+    // Compute sky coordinates of all pixels with a single transformation
+    int                 num = npsi() * nchi();
+    std::vector<double> x(num);
+    std::vector<double> y(num);
+    std::vector<double> lon(num);
+    std::vector<double> lat(num);
+    for (int iy = 0, i = 0; iy < npsi(); ++iy) {
+        for (int ix = 0; ix < nchi(); ++ix, ++i) {
+            x[i] = double(ix);
+            y[i] = double(iy);
+        }
+    }
+    m_map.xy2dir(num, &x[0], &y[0], &lon[0], &lat[0]);
+    bool equatorial = (m_map.wcs()->coordsys() == "EQU");
+
     // Set pixel directions and solid angles
-    for (int iy = 0; iy < npsi(); ++iy) {
-        for (int ix = 0; ix < nchi(); ++ix) {
-            GSkyPixel pixel = GSkyPixel(double(ix), double(iy));
-            m_dirs.push_back(m_map.xy2dir(pixel));
-            m_omega.push_back(m_map.omega(pixel));
+    for (int i = 0; i < num; ++i) {
+        GSkyDir dir;
+        if (equatorial) {
+            dir.radec_deg(lon[i], lat[i]);
+        }
+        else {
+            dir.lb_deg(lon[i], lat[i]);
         }
+        m_dirs.push_back(dir);
+        m_omega.push_back(m_map.omega(GSkyPixel(x[i], y[i])));
     }
 
     // Return
@@ -828,6 +898,34 @@ void GCOMEventCube::init_bin(void)
  * as if they were stored in an array.
  ***************************************************************************/
 void GCOMEventCube::set_bin(const int& index)
+{
+    // Set event bin of cube
+    set_bin(index, &m_bin, &m_dir);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set event bin
+ *
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[in] bin Event bin.
+ * @param[in] dir Instrument direction of event bin.
+ *
+ * @exception GException::out_of_range
+ *            Event index is outside valid range.
+ * @exception GCOMException::no_dirs
+ *            Sky directions and solid angles vectors have not been set up.
+ *
+ * Sets the instrument direction @p dir and the pointers in the event bin
+ * @p bin so that they refer to the event cube bin @p index. Any memory
+ * that was allocated by the event bin is released. The event cube itself
+ * is not modified.
+ ***************************************************************************/
+void GCOMEventCube::set_bin(const int& index, GCOMEventBin* bin,
+                            GCOMInstDir* dir) const
 {
     // Optionally check if the index is valid
     #if defined(G_RANGE_CHECK)
@@ -845,16 +943,26 @@ void GCOMEventCube::set_bin(const int& index)
     int ipix = index % npix();
     int iphi = index / npix();
 
+    // Release memory of event bin if it was allocated
+    if (bin->m_alloc) {
+        bin->free_members();
+    }
+
     // Set indices
-    m_bin.m_index = index;
+    bin->m_index = index;
 
     // Set instrument direction
-    m_dir.dir(m_dirs[ipix]);
-    m_dir.phibar(m_phi[iphi]);
-    
+    dir->dir(m_dirs[ipix]);
+    dir->phibar(m_phi[iphi]);
+
     // Set pointers
-    m_bin.m_counts = &(m_map.pixels()[index]);
-    m_bin.m_omega  = &(m_omega[ipix]);
+    bin->m_counts = &(m_map.pixels()[index]);
+    bin->m_dir    = dir;
+    bin->m_omega  = const_cast<double*>(&(m_omega[ipix]));
+    bin->m_time   = const_cast<GTime*>(&m_time);
+    bin->m_ontime = const_cast<double*>(&m_ontime);
+    bin->m_energy = const_cast<GEnergy*>(&m_energy);
+    bin->m_ewidth = const_cast<GEnergy*>(&m_ewidth);
 
     // Return
     return;
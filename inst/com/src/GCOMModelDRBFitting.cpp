@@ -285,12 +285,14 @@ double GCOMModelDRBFitting::eval(const GEvent&       event,
             // Update evaluation cache
             update_cache();
 
-            // Set node array for linear interpolation
-            m_nodes.set_value(phibar);
+            // Get indices and weights for linear interpolation
+            int    inx[2];
+            double wgt[2];
+            m_nodes.interpolate(phibar, inx, wgt);
 
             // Get scale factor
-            scale = m_values[m_nodes.inx_left()].value()  * m_nodes.wgt_left() +
-                    m_values[m_nodes.inx_right()].value() * m_nodes.wgt_right();
+            scale = m_values[inx[0]].value() * wgt[0] +
+                    m_values[inx[1]].value() * wgt[1];
 
         } // endelse: performed linear interpolation
 
@@ -391,14 +393,14 @@ double GCOMModelDRBFitting::eval_gradients(const GEvent&       event,
             // Update evaluation cache
             update_cache();
 
-            // Set node array for linear interpolation
-            m_nodes.set_value(phibar);
-
             // Get indices and weights for interpolation
-            int    inx_left  = m_nodes.inx_left();
-            int    inx_right = m_nodes.inx_right();
-            double wgt_left  = m_nodes.wgt_left();
-            double wgt_right = m_nodes.wgt_right();
+            int    inx[2];
+            double wgt[2];
+            m_nodes.interpolate(phibar, inx, wgt);
+            int    inx_left  = inx[0];
+            int    inx_right = inx[1];
+            double wgt_left  = wgt[0];
+            double wgt_right = wgt[1];
 
             // Get scale factor
             scale = m_values[inx_left].value()  * wgt_left +
@@ -96,6 +96,7 @@ protected:
     virtual void set_energies(void);
     virtual void set_times(void);
     void         set_bin(const int& index);
+    void         set_bin(const int& index, GCTAEventBin* bin) const;
 
     // Protected members
     GSkymap                  m_map;        //!< Counts map stored as sky map
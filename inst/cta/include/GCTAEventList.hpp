@@ -44,6 +44,32 @@
  * @brief CTA event atom container class
  *
  * This class is a container class for CTA event atoms.
+ *
+ * Events can be stored either as an array of GCTAEventAtom objects (the
+ * default) or in a columnar layout that only keeps the event direction,
+ * energy and time in contiguous arrays. Together with the event direction
+ * the celestial unit vector is stored, and together with the energy its
+ * log10, so that no trigonometric or logarithmic functions need to be
+ * evaluated when an event is accessed. The columnar layout reduces the
+ * memory footprint of large event lists several-fold and keeps the data
+ * that are needed for the unbinned likelihood computation close together
+ * in memory. All other event attributes are not kept in the columnar
+ * layout. The layout is selected using the columnar() method, which should
+ * be called before reading the events.
+ *
+ * In the columnar layout, the const access operator returns a pointer to a
+ * proxy event atom that is filled on demand. Each thread cycles through a
+ * ring of 16 proxies, hence the returned pointer remains valid for the
+ * next 15 accesses to columnar event lists from the same thread, but not
+ * longer. The proxies are read-only copies; the non-const access operator
+ * throws an exception for columnar event lists. Use event() to fill an
+ * event atom that is owned by the caller.
+ *
+ * The event columns that are read from a FITS file can be restricted using
+ * the columns() method. The TIME, RA, DEC and ENERGY columns are always
+ * read, and in the columnar layout no other columns are read. Columns are
+ * read one after the other, and the memory of a column is released once
+ * its values have been copied into the event list.
  ***************************************************************************/
 class GCTAEventList : public GEventList {
 
@@ -61,12 +87,12 @@ public:
     // Implemented pure virtual base class methods
     virtual void           clear(void);
     virtual GCTAEventList* clone(void) const;
-    virtual int            size(void) const { return m_events.size(); }
+    virtual int            size(void) const;
     virtual void           load(const std::string& filename);
     virtual void           save(const std::string& filename, bool clobber = false) const;
     virtual void           read(const GFits& file);
     virtual void           write(GFits& file) const;
-    virtual int            number(void) const { return m_events.size(); }
+    virtual int            number(void) const { return size(); }
     virtual void           roi(const GRoi& roi);
     virtual const GCTARoi& roi(void) const { return m_roi; }
     std::string            print(void) const;
@@ -74,6 +100,11 @@ public:
     // Implement other methods
     void                   append(const GCTAEventAtom& event);
     void                   reserve(const int& number);
+    void                   columnar(const bool& columnar);
+    void                   event(const int& index, GCTAEventAtom* event) const;
+    const bool&            columnar(void) const { return m_columnar; }
+    void                   columns(const std::vector<std::string>& columns);
+    const std::vector<std::string>& columns(void) const { return m_columns; }
 
 protected:
     // Protected methods
@@ -86,14 +117,31 @@ protected:
     void         read_events_v0(const GFitsTable* hdu);
     void         read_events_v1(const GFitsTable* hdu);
     void         read_events_hillas(const GFitsTable* hdu);
+    bool         selected(const std::string& colname) const;
     void         read_ds_ebounds(const GFitsHDU* hdu);
     void         read_ds_roi(const GFitsHDU* hdu);
     void         write_events(GFitsBinTable* hdu) const;
+    void         fill_events(GFitsBinTable* hdu, const int& first,
+                             const int& nrows) const;
     void         write_ds_keys(GFitsHDU* hdu) const;
+    void         append_columnar(const GCTAEventAtom& event);
+    void         set_columnar_dir(const int& index, const double& ra,
+                                  const double& dec);
+    GCTAEventAtom* proxy(const int& index) const;
 
     // Protected members
-    GCTARoi                    m_roi;     //!< Region of interest
-    std::vector<GCTAEventAtom> m_events;  //!< Events
+    GCTARoi                             m_roi;      //!< Region of interest
+    std::vector<GCTAEventAtom>          m_events;   //!< Events
+    bool                                m_columnar; //!< Columnar storage
+    std::vector<std::string>            m_columns;  //!< Selected columns (all if empty)
+    std::vector<double>                 m_ra;       //!< Right Ascension (rad)
+    std::vector<double>                 m_dec;      //!< Declination (rad)
+    std::vector<double>                 m_dirx;     //!< Celestial unit vector x
+    std::vector<double>                 m_diry;     //!< Celestial unit vector y
+    std::vector<double>                 m_dirz;     //!< Celestial unit vector z
+    std::vector<double>                 m_energy;   //!< Energy (MeV)
+    std::vector<double>                 m_log10e;   //!< log10 of energy (MeV)
+    std::vector<double>                 m_time;     //!< Time (native seconds)
 };
 
 #endif /* GCTAEVENTLIST_HPP */
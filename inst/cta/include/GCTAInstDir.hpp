@@ -61,6 +61,8 @@ public:
     // Other methods
     void         dir(const GSkyDir& dir) { m_dir=dir; }
     void         radec(const double& ra, const double& dec) { m_dir.radec(ra,dec); }
+    void         radec(const double& ra, const double& dec,
+                       const double& x, const double& y, const double& z) { m_dir.radec(ra,dec,x,y,z); }
     void         radec_deg(const double& ra, const double& dec) { m_dir.radec_deg(ra,dec); }
     void         lb(const double& l, const double& b) { m_dir.lb(l,b); }
     void         lb_deg(const double& l, const double& b) { m_dir.lb_deg(l,b); }
@@ -0,0 +1,112 @@
+/***************************************************************************
+ *            GCTAIrfCache.hpp - CTA instrument response cache             *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTAIrfCache.hpp
+ * @brief CTA instrument response cache class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GCTAIRFCACHE_HPP
+#define GCTAIRFCACHE_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include "GBase.hpp"
+#include "GCTAAeff.hpp"
+#include "GCTAPsf.hpp"
+
+
+/***********************************************************************//**
+ * @class GCTAIrfCache
+ *
+ * @brief CTA instrument response cache
+ *
+ * The cache keeps one fully processed copy of each effective area and
+ * point spread function that has been loaded in the process. The cache is
+ * shared by all GCTAIrfCache instances, hence
+ *
+ *     GCTAIrfCache cache;
+ *     GCTAAeff*    aeff = cache.aeff(filename);
+ *     ...
+ *     cache.release(aeff);
+ *
+ * parses a response file only once, however many observations use it.
+ * Cache entries are identified by the file name together with the size,
+ * modification time and inode of the file, so that a modified or replaced
+ * file is reloaded.
+ *
+ * Responses that are stored in response tables (GCTAAeff2D and GCTAPsf2D)
+ * are not modified on evaluation, hence all clients share the cached
+ * response. All other responses hold interpolation caches that are updated
+ * on evaluation, or may be modified by their client, hence each client gets
+ * its own copy of them. The cache counts the clients of each entry, and an
+ * entry is dropped once its last client has released it. Responses must be
+ * returned using release(), and duplicated using copy().
+ *
+ * In addition, response tables can be persisted in a preprocessed binary
+ * form in a local cache directory (see GCTAResponseTable::save_binary()).
+ * The directory is taken from the GAMMALIB_IRFCACHE environment variable or
+ * set using directory(); the directory must exist. If no directory is set,
+ * nothing is persisted.
+ ***************************************************************************/
+class GCTAIrfCache : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTAIrfCache(void);
+    GCTAIrfCache(const GCTAIrfCache& cache);
+    virtual ~GCTAIrfCache(void);
+
+    // Operators
+    GCTAIrfCache& operator= (const GCTAIrfCache& cache);
+
+    // Methods
+    void          clear(void);
+    GCTAIrfCache* clone(void) const;
+    int           size(void) const;
+    GCTAAeff*     aeff(const std::string& filename);
+    GCTAPsf*      psf(const std::string& filename);
+    GCTAAeff*     copy(const GCTAAeff* aeff);
+    GCTAPsf*      copy(const GCTAPsf* psf);
+    void          release(GBase* irf);
+    void          purge(void);
+    void          directory(const std::string& dirname);
+    std::string   directory(void) const;
+    std::string   cachefile(const std::string& filename,
+                            const std::string& extname) const;
+    std::string   print(void) const;
+
+protected:
+    // Protected methods
+    void        init_members(void);
+    void        copy_members(const GCTAIrfCache& cache);
+    void        free_members(void);
+    std::string stamp(const std::string& filename) const;
+    GCTAAeff*   load_aeff(const std::string& filename) const;
+    GCTAPsf*    load_psf(const std::string& filename) const;
+    GBase*      acquire(const std::string& key);
+    GBase*      insert(const std::string& key, GBase* irf);
+    GBase*      duplicate(const GBase* irf);
+    GBase*      use(const std::string& key);
+    bool        shared(const GBase* irf) const;
+};
+
+#endif /* GCTAIRFCACHE_HPP */
@@ -42,6 +42,8 @@
 #include "GCTAPointing.hpp"
 #include "GCTAResponse.hpp"
 #include "GCTAResponseTable.hpp"
+#include "GCTAIrfCache.hpp"
+#include "GCTARadialTemplate.hpp"
 #include "GCTAModelRadial.hpp"
 #include "GCTAModelRadialRegistry.hpp"
 #include "GCTAModelRadialGauss.hpp"
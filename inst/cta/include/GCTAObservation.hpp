@@ -69,8 +69,13 @@ public:
     virtual void             write(GXmlElement& xml) const;
     virtual std::string      print(void) const;
 
+    // Overloaded base class methods
+    virtual GCTAObservation* shallow_clone(const bool& share_events = true) const;
+
     // Other methods
-    void        load_unbinned(const std::string& filename);
+    void        load_unbinned(const std::string& filename,
+                              const std::vector<std::string>& columns =
+                                    std::vector<std::string>());
     void        load_binned(const std::string& filename);
     void        save(const std::string& filename, bool clobber) const;
     void        response(const std::string& irfname, std::string caldb = "");
@@ -88,6 +93,9 @@ public:
     void        eventfile(const std::string& filename) { m_eventfile = filename; }
 
 protected:
+    // Protected constructors
+    GCTAObservation(const GCTAObservation& obs, const bool& share_events);
+
     // Protected methods
     void init_members(void);
     void copy_members(const GCTAObservation& obs);
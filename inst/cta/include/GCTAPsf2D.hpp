@@ -41,7 +41,9 @@
  * @brief CTA 2D point spread function class
  *
  * This class implements the CTA point spread function response as function
- * of energy and offset angle.
+ * of energy and offset angle. The PSF parameters are computed on each call
+ * and not cached, hence an instance can be evaluated concurrently and is
+ * shared by all clients of the instrument response cache.
  ***************************************************************************/
 class GCTAPsf2D : public GCTAPsf {
 
@@ -83,28 +85,28 @@ public:
     std::string print(void) const;
 
 private:
+    // PSF parameters for a given energy and offset angle
+    struct pars {
+        double norm;    //!< Global normalization
+        double norm2;   //!< Gaussian 2 normalization
+        double norm3;   //!< Gaussian 3 normalization
+        double sigma1;  //!< Gaussian 1 sigma
+        double sigma2;  //!< Gaussian 2 sigma
+        double sigma3;  //!< Gaussian 3 sigma
+        double width1;  //!< Gaussian 1 width
+        double width2;  //!< Gaussian 2 width
+        double width3;  //!< Gaussian 3 width
+    };
+
     // Methods
     void init_members(void);
     void copy_members(const GCTAPsf2D& psf);
     void free_members(void);
-    void update(const double& logE, const double& theta) const;
+    pars parameters(const double& logE, const double& theta) const;
 
     // Members
     std::string       m_filename;   //!< Name of Aeff response file
     GCTAResponseTable m_psf;        //!< PSF response table
-
-    // Precomputation cache
-    mutable double    m_par_logE;   //!< Cache energy
-    mutable double    m_par_theta;  //!< Cache offset angle
-    mutable double    m_norm;       //!< Global normalization
-    mutable double    m_norm2;      //!< Gaussian 2 normalization
-    mutable double    m_norm3;      //!< Gaussian 3 normalization
-    mutable double    m_sigma1;     //!< Gaussian 1 sigma
-    mutable double    m_sigma2;     //!< Gaussian 2 sigma
-    mutable double    m_sigma3;     //!< Gaussian 3 sigma
-    mutable double    m_width1;     //!< Gaussian 1 width
-    mutable double    m_width2;     //!< Gaussian 2 width
-    mutable double    m_width3;     //!< Gaussian 3 width
 };
 
 #endif /* GCTAPSF2D_HPP */
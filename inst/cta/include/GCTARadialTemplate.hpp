@@ -0,0 +1,117 @@
+/***************************************************************************
+ *       GCTARadialTemplate.hpp - CTA radial model response template       *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTARadialTemplate.hpp
+ * @brief CTA radial model response template class definition
+ * @author Juergen Knoedlseder
+ */
+
+#ifndef GCTARADIALTEMPLATE_HPP
+#define GCTARADIALTEMPLATE_HPP
+
+/* __ Includes ___________________________________________________________ */
+#include <string>
+#include <vector>
+#include "GBase.hpp"
+
+
+/***********************************************************************//**
+ * @class GCTARadialTemplate
+ *
+ * @brief CTA radial model response template class
+ *
+ * This class holds the instrument response of a radial source model,
+ * i.e. the source model convolved with the point spread function and
+ * multiplied by the effective area, on a regular grid of
+ *
+ *   - the angular distance zeta between event and model centre,
+ *   - the azimuth angle omega0 of the pointing in the model system, which
+ *     for a given model centre determines the offset angle of the event,
+ *   - the logarithm of the photon energy.
+ *
+ * The response is obtained from the grid by trilinear interpolation.
+ *
+ * The grid is organised in rows of zeta values for a given omega0 and
+ * energy. The rows are filled on demand by the client using the fill()
+ * method, hence the template is built lazily for the energies and
+ * azimuth angles that are actually needed. The rows() method returns the
+ * rows that are needed to interpolate the response at a given azimuth
+ * angle and energy.
+ ***************************************************************************/
+class GCTARadialTemplate : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTARadialTemplate(void);
+    GCTARadialTemplate(const double& zeta_max,
+                       const double& emin,
+                       const double& emax,
+                       const int&    nzeta,
+                       const int&    nomega,
+                       const int&    neng);
+    GCTARadialTemplate(const GCTARadialTemplate& tpl);
+    virtual ~GCTARadialTemplate(void);
+
+    // Operators
+    GCTARadialTemplate& operator= (const GCTARadialTemplate& tpl);
+
+    // Methods
+    void                clear(void);
+    GCTARadialTemplate* clone(void) const;
+    int                 size(void) const { return m_filled.size(); }
+    int                 nzeta(void) const { return m_nzeta; }
+    int                 nomega(void) const { return m_nomega; }
+    int                 neng(void) const { return m_neng; }
+    double              zeta(const int& index) const;
+    double              omega(const int& row) const;
+    double              logE(const int& row) const;
+    bool                contains(const double& logE) const;
+    void                rows(const double& omega0,
+                             const double& logE,
+                             int*          rows) const;
+    bool                isfilled(const int& row) const;
+    void                fill(const int& row, const std::vector<double>& values);
+    double              interpolate(const double& zeta,
+                                    const double& omega0,
+                                    const double& logE) const;
+    std::string         print(void) const;
+
+protected:
+    // Protected methods
+    void   init_members(void);
+    void   copy_members(const GCTARadialTemplate& tpl);
+    void   free_members(void);
+    double interpolate_row(const int& row, const double& zeta) const;
+
+    // Protected members
+    int                 m_nzeta;      //!< Number of zeta nodes
+    int                 m_nomega;     //!< Number of omega0 nodes
+    int                 m_neng;       //!< Number of energy nodes
+    double              m_zeta_max;   //!< Maximum zeta (radians)
+    double              m_dzeta;      //!< Zeta node spacing (radians)
+    double              m_domega;     //!< Omega0 node spacing (radians)
+    double              m_logE_min;   //!< log10 of minimum energy (TeV)
+    double              m_dlogE;      //!< log10 energy node spacing
+    std::vector<double> m_values;     //!< Response values
+    std::vector<int>    m_filled;     //!< Row filled flags
+};
+
+#endif /* GCTARADIALTEMPLATE_HPP */
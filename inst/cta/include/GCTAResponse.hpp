@@ -30,6 +30,8 @@
 /* __ Includes ___________________________________________________________ */
 #include <cmath>
 #include <vector>
+#include <map>
+#include <string>
 #include "GMatrix.hpp"
 #include "GEvent.hpp"
 #include "GModelSky.hpp"
@@ -54,6 +56,7 @@
 #include "GCTAAeff.hpp"
 #include "GCTAPsf.hpp"
 #include "GCTAEdisp.hpp"
+#include "GCTARadialTemplate.hpp"
 
 /* __ Type definitions ___________________________________________________ */
 
@@ -65,6 +68,17 @@ class GCTAObservation;
  * @class GCTAResponse
  *
  * @brief Interface for the CTA instrument response function
+ *
+ * For radial source models with fixed parameters, the response can be
+ * interpolated from a template of the model convolved with the point
+ * spread function instead of being integrated for every event (see
+ * radial_templates() and GCTARadialTemplate). Templates are built lazily
+ * per source and are discarded whenever the instrument response or the
+ * integration precision changes.
+ *
+ * The IRF integrals of radial and elliptical source models use Romberg
+ * integration by default. Adaptive Gauss-Kronrod quadrature can be
+ * selected instead using gauss_kronrod().
  ***************************************************************************/
 class GCTAResponse : public GResponse {
 
@@ -113,7 +127,7 @@ public:
     void            caldb(const std::string& caldb);
     std::string     caldb(void) const { return m_caldb; }
     void            load(const std::string& rspname);
-    void            eps(const double& eps) { m_eps=eps; }
+    void            eps(const double& eps) { m_eps=eps; m_templates.clear(); }
     const double&   eps(void) const { return m_eps; }
     std::string     rmffile(void) const { return m_rmffile; }
     void            load_aeff(const std::string& filename);
@@ -122,9 +136,16 @@ public:
     void            offset_sigma(const double& sigma);
     double          offset_sigma(void) const;
     const GCTAAeff* aeff(void) const { return m_aeff; }
-    void            aeff(GCTAAeff* aeff) { m_aeff=aeff; }
+    void            aeff(GCTAAeff* aeff) { m_aeff=aeff; m_templates.clear(); }
     const GCTAPsf*  psf(void) const { return m_psf; }
-    void            psf(GCTAPsf* psf) { m_psf=psf; }
+    void            psf(GCTAPsf* psf) { m_psf=psf; m_templates.clear(); }
+    void            radial_templates(const bool& use) { m_use_templates=use; }
+    const bool&     radial_templates(void) const { return m_use_templates; }
+    void            gauss_kronrod(const bool& use) { m_use_gkq=use; m_templates.clear(); }
+    const bool&     gauss_kronrod(void) const { return m_use_gkq; }
+    void            radial_template_nodes(const int& nzeta,
+                                          const int& nomega,
+                                          const int& neng);
 
     // Low-level response methods
     double aeff(const double& theta,
@@ -165,6 +186,26 @@ private:
     void init_members(void);
     void copy_members(const GCTAResponse& rsp);
     void free_members(void);
+    double irf_radial_integral(const GModelSpatialRadial* model,
+                               const double&              zenith,
+                               const double&              azimuth,
+                               const double&              srcLogEng,
+                               const double&              obsLogEng,
+                               const double&              zeta,
+                               const double&              lambda,
+                               const double&              omega0,
+                               const double&              eta,
+                               const std::vector<int>&    pars) const;
+    double irf_radial_template(const GSource&             source,
+                               const GModelSpatialRadial* model,
+                               const GObservation&        obs,
+                               const double&              zenith,
+                               const double&              azimuth,
+                               const double&              srcLogEng,
+                               const double&              zeta,
+                               const double&              lambda,
+                               const double&              omega0,
+                               bool*                      valid) const;
 
     // Private data members
     std::string         m_caldb;        //!< Name of or path to the calibration database
@@ -174,6 +215,12 @@ private:
     GCTAAeff*           m_aeff;         //!< Effective area
     GCTAPsf*            m_psf;          //!< Point spread function
     GCTAEdisp*          m_edisp;        //!< Energy dispersion
+    bool                m_use_templates; //!< Use radial model templates
+    bool                m_use_gkq;      //!< Use Gauss-Kronrod quadrature
+    int                 m_tpl_nzeta;    //!< Template zeta nodes
+    int                 m_tpl_nomega;   //!< Template omega0 nodes
+    int                 m_tpl_neng;     //!< Template energy nodes per decade
+    mutable std::map<std::string, GCTARadialTemplate> m_templates; //!< Radial model templates
 };
 
 #endif /* GCTARESPONSE_HPP */
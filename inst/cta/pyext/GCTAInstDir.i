@@ -47,6 +47,8 @@ public:
     GCTAInstDir* clone(void) const;
     void         dir(const GSkyDir& dir);
     void         radec(const double& ra, const double& dec);
+    void         radec(const double& ra, const double& dec,
+                       const double& x, const double& y, const double& z);
     void         radec_deg(const double& ra, const double& dec);
     void         lb(const double& l, const double& b);
     void         lb_deg(const double& l, const double& b);
@@ -0,0 +1,71 @@
+/***************************************************************************
+ *             GCTAIrfCache.i - CTA instrument response cache              *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTAIrfCache.i
+ * @brief CTA instrument response cache class Python interface definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GCTAIrfCache.hpp"
+#include "GTools.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GCTAIrfCache
+ *
+ * @brief CTA instrument response cache
+ *
+ * Only the cache management methods are exposed. Responses are obtained
+ * from the cache through GCTAResponse.
+ ***************************************************************************/
+class GCTAIrfCache : public GBase {
+
+public:
+    // Constructors and destructors
+    GCTAIrfCache(void);
+    GCTAIrfCache(const GCTAIrfCache& cache);
+    virtual ~GCTAIrfCache(void);
+
+    // Methods
+    void          clear(void);
+    GCTAIrfCache* clone(void) const;
+    int           size(void) const;
+    void          purge(void);
+    void          directory(const std::string& dirname);
+    std::string   directory(void) const;
+    std::string   cachefile(const std::string& filename,
+                            const std::string& extname) const;
+};
+
+
+/***********************************************************************//**
+ * @brief GCTAIrfCache class extension
+ ***************************************************************************/
+%extend GCTAIrfCache {
+    char *__str__() {
+        return tochar(self->print());
+    }
+    GCTAIrfCache copy() {
+        return (*self);
+    }
+};
@@ -55,7 +55,9 @@ public:
     virtual void             write(GXmlElement& xml) const;
 
     // Other methods
-    void        load_unbinned(const std::string& filename);
+    void        load_unbinned(const std::string& filename,
+                              const std::vector<std::string>& columns =
+                                    std::vector<std::string>());
     void        load_binned(const std::string& filename);
     void        save(const std::string& filename, bool clobber) const;
     void        response(const std::string& irfname, std::string caldb = "");
@@ -84,6 +84,13 @@ public:
     void            aeff(GCTAAeff* aeff);
     const GCTAPsf*  psf(void) const;
     void            psf(GCTAPsf* psf);
+    void            radial_templates(const bool& use);
+    const bool&     radial_templates(void) const;
+    void            gauss_kronrod(const bool& use);
+    const bool&     gauss_kronrod(void) const;
+    void            radial_template_nodes(const int& nzeta,
+                                          const int& nomega,
+                                          const int& neng);
 
     // Low-level response methods
     double aeff(const double& theta,
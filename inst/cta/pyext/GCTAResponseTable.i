@@ -71,6 +71,8 @@ public:
     void               scale(const int& index, const double& scale);
     void               read(const GFitsTable* hdu);
     void               write(GFitsTable* hdu) const;
+    bool               load_binary(const std::string& filename);
+    bool               save_binary(const std::string& filename) const;
 };
 
 
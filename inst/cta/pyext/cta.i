@@ -58,6 +58,7 @@
 %include "GCTAPointing.i"
 %include "GCTAResponse.i"
 %include "GCTAResponseTable.i"
+%include "GCTAIrfCache.i"
 %include "GCTAAeff.i"
 %include "GCTAAeffPerfTable.i"
 %include "GCTAAeffArf.i"
@@ -31,6 +31,7 @@
 #include "GTools.hpp"
 #include "GFitsTable.hpp"
 #include "GCTAAeff2D.hpp"
+#include "GCTAIrfCache.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 
@@ -239,14 +240,29 @@ GCTAAeff2D* GCTAAeff2D::clone(void) const
  ***************************************************************************/
 void GCTAAeff2D::load(const std::string& filename)
 {
-    // Open FITS file
-    GFits fits(filename);
+    // Get name of binary cache file
+    std::string cachefile = GCTAIrfCache().cachefile(filename, "EFFECTIVE AREA");
 
-    // Read effective area from file
-    read(&fits);
+    // Load preprocessed effective area from binary cache file. If this
+    // fails then read effective area from FITS file and store it in the
+    // binary cache file.
+    if (cachefile.empty() || !m_aeff.load_binary(cachefile)) {
 
-    // Close FITS file
-    fits.close();
+        // Open FITS file
+        GFits fits(filename);
+
+        // Read effective area from file
+        read(&fits);
+
+        // Close FITS file
+        fits.close();
+
+        // Store effective area in binary cache file
+        if (!cachefile.empty()) {
+            m_aeff.save_binary(cachefile);
+        }
+
+    } // endif: effective area was not found in binary cache file
 
     // Store filename
     m_filename = filename;
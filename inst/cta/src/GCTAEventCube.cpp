@@ -43,9 +43,46 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_BIN_RING 16 //!< Number of event bins per thread for const access
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Local data _________________________________________________________ */
+// Ring of event bins of a thread for const bin access. The bins are handed
+// out in turn, hence a bin is only overwritten after G_BIN_RING further
+// const accesses from the same thread.
+struct GCTAEventCubeBinRing {
+    GCTAEventBin  bins[G_BIN_RING];
+    int           next;
+};
+
+// Pool of all event bin rings. A ring is allocated on the first const bin
+// access of a thread and registered in the pool, which releases all rings
+// at program exit.
+class GCTAEventCubeBinPool {
+public:
+    ~GCTAEventCubeBinPool(void) {
+        for (int i = 0; i < m_rings.size(); ++i) {
+            delete m_rings[i];
+        }
+        m_rings.clear();
+    }
+    GCTAEventCubeBinRing* allocate(void) {
+        GCTAEventCubeBinRing* ring = new GCTAEventCubeBinRing;
+        ring->next = 0;
+        #pragma omp critical(GCTAEventCube_bin_pool)
+        m_rings.push_back(ring);
+        return ring;
+    }
+private:
+    std::vector<GCTAEventCubeBinRing*> m_rings;
+};
+static GCTAEventCubeBinPool  g_bin_pool;
+static GCTAEventCubeBinRing* g_bin_ring = NULL;
+#ifdef _OPENMP
+#pragma omp threadprivate(g_bin_ring)
+#endif
+
 
 
 /*==========================================================================
@@ -190,15 +227,28 @@ GCTAEventBin* GCTAEventCube::operator[](const int& index)
  *
  * @param[in] index Event index [0,...,size()-1].
  *
- * Returns pointer to an event bin.
+ * Returns pointer to an event bin. The event bin is taken from a ring of
+ * G_BIN_RING event bins of the calling thread, hence the event cube is not
+ * modified and can be accessed from several threads at the same time. The
+ * returned pointer remains valid for the next G_BIN_RING-1 (=15) const
+ * accesses to event cubes from the same thread.
  ***************************************************************************/
 const GCTAEventBin* GCTAEventCube::operator[](const int& index) const
 {
-    // Set event bin (circumvent const correctness)
-    (const_cast<GCTAEventCube*>(this))->set_bin(index);
+    // Allocate event bin ring of thread if required
+    if (g_bin_ring == NULL) {
+        g_bin_ring = g_bin_pool.allocate();
+    }
+
+    // Get next event bin of ring
+    GCTAEventBin* bin = &(g_bin_ring->bins[g_bin_ring->next]);
+    g_bin_ring->next  = (g_bin_ring->next + 1) % G_BIN_RING;
+
+    // Set event bin
+    set_bin(index, bin);
 
     // Return pointer
-    return (&m_bin);
+    return bin;
 }
 
 
@@ -651,13 +701,32 @@ void GCTAEventCube::set_directions(void)
     m_dirs.reserve(npix());
     m_omega.reserve(npix());
 
+    // Compute sky coordinates of all pixels with a single transformation
+    int                 num = ny() * nx();
+    std::vector<double> x(num);
+    std::vector<double> y(num);
+    std::vector<double> lon(num);
+    std::vector<double> lat(num);
+    for (int iy = 0, i = 0; iy < ny(); ++iy) {
+        for (int ix = 0; ix < nx(); ++ix, ++i) {
+            x[i] = double(ix);
+            y[i] = double(iy);
+        }
+    }
+    m_map.xy2dir(num, &x[0], &y[0], &lon[0], &lat[0]);
+    bool equatorial = (m_map.wcs()->coordsys() == "EQU");
+
     // Set pixel directions and solid angles
-    for (int iy = 0; iy < ny(); ++iy) {
-        for (int ix = 0; ix < nx(); ++ix) {
-            GSkyPixel pixel = GSkyPixel(double(ix), double(iy));
-            m_dirs.push_back(GCTAInstDir(m_map.xy2dir(pixel)));
-            m_omega.push_back(m_map.omega(pixel));
+    for (int i = 0; i < num; ++i) {
+        GSkyDir dir;
+        if (equatorial) {
+            dir.radec_deg(lon[i], lat[i]);
         }
+        else {
+            dir.lb_deg(lon[i], lat[i]);
+        }
+        m_dirs.push_back(GCTAInstDir(dir));
+        m_omega.push_back(m_map.omega(GSkyPixel(x[i], y[i])));
     }
 
     // Return
@@ -752,6 +821,33 @@ void GCTAEventCube::set_times(void)
  * as if they were stored in an array.
  ***************************************************************************/
 void GCTAEventCube::set_bin(const int& index)
+{
+    // Set event bin of cube
+    set_bin(index, &m_bin);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set event bin
+ *
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[in] bin Event bin.
+ *
+ * @exception GException::out_of_range
+ *            Event index is outside valid range.
+ * @exception GCTAException::no_energies
+ *            Energy vectors have not been set up.
+ * @exception GCTAException::no_dirs
+ *            Sky directions and solid angles vectors have not been set up.
+ *
+ * Sets up the pointers in the event bin @p bin so that they point to the
+ * attributes of the event cube bin @p index. The event cube itself is not
+ * modified.
+ ***************************************************************************/
+void GCTAEventCube::set_bin(const int& index, GCTAEventBin* bin) const
 {
     // Optionally check if the index is valid
     #if defined(G_RANGE_CHECK)
@@ -772,13 +868,13 @@ void GCTAEventCube::set_bin(const int& index)
     int ieng = index / npix();
 
     // Set pointers
-    m_bin.m_counts = &(m_map.pixels()[index]);
-    m_bin.m_energy = &(m_energies[ieng]);
-    m_bin.m_time   = &m_time;
-    m_bin.m_dir    = &(m_dirs[ipix]);
-    m_bin.m_omega  = &(m_omega[ipix]);
-    m_bin.m_ewidth = &(m_ewidth[ieng]);
-    m_bin.m_ontime = &m_ontime;
+    bin->m_counts = &(m_map.pixels()[index]);
+    bin->m_energy = const_cast<GEnergy*>(&(m_energies[ieng]));
+    bin->m_time   = const_cast<GTime*>(&m_time);
+    bin->m_dir    = const_cast<GCTAInstDir*>(&(m_dirs[ipix]));
+    bin->m_omega  = const_cast<double*>(&(m_omega[ipix]));
+    bin->m_ewidth = const_cast<GEnergy*>(&(m_ewidth[ieng]));
+    bin->m_ontime = const_cast<double*>(&m_ontime);
 
     // Return
     return;
@@ -28,6 +28,7 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cmath>
 #include "GCTAEventList.hpp"
 #include "GCTAException.hpp"
 #include "GTools.hpp"
@@ -38,11 +39,18 @@
 #include "GFitsTableULongCol.hpp"
 #include "GFitsTableShortCol.hpp"
 #include "GFitsTableStringCol.hpp"
+#include "GFitsTableWriter.hpp"
 #include "GTime.hpp"
 #include "GTimeReference.hpp"
 
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* __ Method name definitions ____________________________________________ */
 #define G_OPERATOR                          "GCTAEventList::operator[](int&)"
+#define G_EVENT                  "GCTAEventList::event(int&, GCTAEventAtom*)"
 #define G_ROI                                     "GCTAEventList::roi(GRoi&)"
 #define G_READ_DS_EBOUNDS         "GCTAEventList::read_ds_ebounds(GFitsHDU*)"
 #define G_READ_DS_ROI                 "GCTAEventList::read_ds_roi(GFitsHDU*)"
@@ -50,9 +58,47 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_SAVE_BLOCK 100000 //!< Number of events per block for streamed saving
+#define G_PROXY_RING        16 //!< Number of proxy event atoms per thread
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Local data _________________________________________________________ */
+// Ring of proxy event atoms of a thread for columnar event access. The
+// proxies are handed out in turn, hence a proxy is only overwritten after
+// G_PROXY_RING further accesses from the same thread.
+struct GCTAEventListProxyRing {
+    GCTAEventAtom atoms[G_PROXY_RING];
+    int           next;
+};
+
+// Pool of all proxy rings. A ring is allocated on the first columnar access
+// of a thread and registered in the pool, which releases all rings at
+// program exit.
+class GCTAEventListProxyPool {
+public:
+    ~GCTAEventListProxyPool(void) {
+        for (int i = 0; i < m_rings.size(); ++i) {
+            delete m_rings[i];
+        }
+        m_rings.clear();
+    }
+    GCTAEventListProxyRing* allocate(void) {
+        GCTAEventListProxyRing* ring = new GCTAEventListProxyRing;
+        ring->next = 0;
+        #pragma omp critical(GCTAEventList_proxy_pool)
+        m_rings.push_back(ring);
+        return ring;
+    }
+private:
+    std::vector<GCTAEventListProxyRing*> m_rings;
+};
+static GCTAEventListProxyPool  g_proxy_pool;
+static GCTAEventListProxyRing* g_proxy_ring = NULL;
+#ifdef _OPENMP
+#pragma omp threadprivate(g_proxy_ring)
+#endif
+
 
 /*==========================================================================
  =                                                                         =
@@ -146,8 +192,12 @@ GCTAEventList& GCTAEventList::operator=(const GCTAEventList& list)
  *
  * @exception GException::out_of_range
  *            Event index outside valid range.
+ * @exception GException::feature_not_implemented
+ *            Write access to columnar event list.
  *
- * Returns pointer to an event atom.
+ * Returns pointer to an event atom. For columnar storage no event atoms
+ * exist that could be modified, hence an exception is thrown. Use the
+ * const access operator for read access to columnar event lists.
  ***************************************************************************/
 GCTAEventAtom* GCTAEventList::operator[](const int& index)
 {
@@ -157,8 +207,15 @@ GCTAEventAtom* GCTAEventList::operator[](const int& index)
         throw GException::out_of_range(G_OPERATOR, index, 0, size()-1);
     #endif
 
+    // Refuse write access to columnar storage
+    if (m_columnar) {
+        throw GException::feature_not_implemented(G_OPERATOR,
+              "Write access to columnar event list is not supported, use"
+              " const access instead.");
+    }
+
     // Return pointer
-    return (&(m_events[index]));
+    return &(m_events[index]);
 }
 
 
@@ -170,7 +227,10 @@ GCTAEventAtom* GCTAEventList::operator[](const int& index)
  * @exception GException::out_of_range
  *            Event index outside valid range.
  *
- * Returns pointer to an event atom.
+ * Returns pointer to an event atom. For columnar storage, a pointer to
+ * a proxy event atom of the calling thread is returned, which remains
+ * valid for the next G_PROXY_RING-1 (=15) accesses to columnar event lists
+ * from the same thread.
  ***************************************************************************/
 const GCTAEventAtom* GCTAEventList::operator[](const int& index) const
 {
@@ -181,7 +241,7 @@ const GCTAEventAtom* GCTAEventList::operator[](const int& index) const
     #endif
 
     // Return pointer
-    return (&(m_events[index]));
+    return (m_columnar ? proxy(index) : &(m_events[index]));
 }
 
 
@@ -194,10 +254,15 @@ const GCTAEventAtom* GCTAEventList::operator[](const int& index) const
 /***********************************************************************//**
  * @brief Clear object
  *
- * This method properly resets the object to an initial state.
+ * This method properly resets the object to an initial state. The event
+ * storage layout and the column selection are kept.
  ***************************************************************************/
 void GCTAEventList::clear(void)
 {
+    // Save event storage layout and column selection
+    bool                     columnar = m_columnar;
+    std::vector<std::string> columns  = m_columns;
+
     // Free class members (base and derived classes, derived class first)
     free_members();
     this->GEventList::free_members();
@@ -208,6 +273,10 @@ void GCTAEventList::clear(void)
     this->GEventList::init_members();
     init_members();
 
+    // Restore event storage layout and column selection
+    m_columnar = columnar;
+    m_columns  = columns;
+
     // Return
     return;
 }
@@ -222,6 +291,16 @@ GCTAEventList* GCTAEventList::clone(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return number of events in list
+ ***************************************************************************/
+int GCTAEventList::size(void) const
+{
+    // Return number of events
+    return (m_columnar ? m_time.size() : m_events.size());
+}
+
+
 /***********************************************************************//**
  * @brief Load events from event FITS file.
  *
@@ -260,17 +339,52 @@ void GCTAEventList::load(const std::string& filename)
  * @param[in] clobber Overwrite existing FITS file (default=false).
  *
  * Write the CTA event list into FITS file.
+ *
+ * Large event lists are not copied into a FITS table in memory. Instead,
+ * the file is created with an empty events table, and the events are then
+ * streamed into that table in blocks of G_SAVE_BLOCK events using a
+ * GFitsTableWriter, which encodes each block while the previous block is
+ * written to disk.
  ***************************************************************************/
 void GCTAEventList::save(const std::string& filename, bool clobber) const
 {
     // Create empty FITS file
     GFits fits;
 
-    // Write event list
-    write(fits);
-    
-    // Save FITS file
-    fits.saveto(filename, clobber);
+    // Small event lists are written through a FITS table in memory
+    if (size() <= G_SAVE_BLOCK) {
+
+        // Write event list
+        write(fits);
+
+        // Save FITS file
+        fits.saveto(filename, clobber);
+
+    }
+
+    // ... otherwise stream events into file
+    else {
+
+        // Write empty events table and GTI
+        GFitsBinTable events;
+        events.extname("EVENTS");
+        fill_events(&events, 0, 0);
+        write_ds_keys(&events);
+        fits.append(events);
+        gti().write(&fits);
+        fits.saveto(filename, clobber);
+
+        // Append events block by block
+        GFitsTableWriter writer(filename, "EVENTS");
+        for (int first = 0; first < size(); first += G_SAVE_BLOCK) {
+            int nrows = (size()-first < G_SAVE_BLOCK) ? size()-first : G_SAVE_BLOCK;
+            GFitsBinTable block(nrows);
+            fill_events(&block, first, nrows);
+            writer.write(block);
+        }
+        writer.close();
+
+    } // endelse: events were streamed
 
     // Return
     return;
@@ -419,6 +533,8 @@ std::string GCTAEventList::print(void) const
     // Append header
     result.append("=== GCTAEventList ===");
     result.append("\n"+parformat("Number of events")+str(size()));
+    result.append("\n"+parformat("Event storage"));
+    result.append((m_columnar) ? "columnar" : "event atoms");
     
     // Append GTI intervals
     result.append("\n"+parformat("Time interval"));
@@ -455,12 +571,18 @@ std::string GCTAEventList::print(void) const
  *
  * @param[in] event Event.
  *
- * Appends an event atom to the event list.
+ * Appends an event atom to the event list. For columnar storage, only the
+ * event direction, energy and time are kept.
  ***************************************************************************/
 void GCTAEventList::append(const GCTAEventAtom& event)
 {
     // Append event
-    m_events.push_back(event);
+    if (m_columnar) {
+        append_columnar(event);
+    }
+    else {
+        m_events.push_back(event);
+    }
 
     // Return
     return;
@@ -477,7 +599,133 @@ void GCTAEventList::append(const GCTAEventAtom& event)
 void GCTAEventList::reserve(const int& number)
 {
     // Reserve space
-    m_events.reserve(number);
+    if (m_columnar) {
+        m_ra.reserve(number);
+        m_dec.reserve(number);
+        m_dirx.reserve(number);
+        m_diry.reserve(number);
+        m_dirz.reserve(number);
+        m_energy.reserve(number);
+        m_log10e.reserve(number);
+        m_time.reserve(number);
+    }
+    else {
+        m_events.reserve(number);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set event storage layout
+ *
+ * @param[in] columnar Use columnar event storage?
+ *
+ * Selects between the storage of events as event atoms and the columnar
+ * storage of event direction, energy and time. Any events in the list are
+ * converted into the new layout. Event attributes other than direction,
+ * energy and time are lost when converting into the columnar layout.
+ ***************************************************************************/
+void GCTAEventList::columnar(const bool& columnar)
+{
+    // Continue only if the layout changes
+    if (columnar != m_columnar) {
+
+        // Convert event atoms into columns
+        if (columnar) {
+            m_columnar = true;
+            reserve(m_events.size());
+            for (int i = 0; i < m_events.size(); ++i) {
+                append_columnar(m_events[i]);
+            }
+            std::vector<GCTAEventAtom>().swap(m_events);
+        }
+
+        // ... otherwise convert columns into event atoms
+        else {
+            std::vector<GCTAEventAtom> events(size());
+            for (int i = 0; i < size(); ++i) {
+                event(i, &(events[i]));
+            }
+            m_events.swap(events);
+            std::vector<double>().swap(m_ra);
+            std::vector<double>().swap(m_dec);
+            std::vector<double>().swap(m_dirx);
+            std::vector<double>().swap(m_diry);
+            std::vector<double>().swap(m_dirz);
+            std::vector<double>().swap(m_energy);
+            std::vector<double>().swap(m_log10e);
+            std::vector<double>().swap(m_time);
+            m_columnar = false;
+        }
+
+    } // endif: layout changed
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Fill event atom
+ *
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[out] event Event atom.
+ *
+ * @exception GException::out_of_range
+ *            Event index outside valid range.
+ *
+ * Fills an event atom that is owned by the caller with the event @p index.
+ * For columnar storage, only the event direction, energy and time are set.
+ * Other than the pointer returned by the access operator, the event atom
+ * remains valid on subsequent accesses to the event list.
+ ***************************************************************************/
+void GCTAEventList::event(const int& index, GCTAEventAtom* event) const
+{
+    // Optionally check if the index is valid
+    #if defined(G_RANGE_CHECK)
+    if (index < 0 || index >= size())
+        throw GException::out_of_range(G_EVENT, index, 0, size()-1);
+    #endif
+
+    // Fill event atom from columns
+    if (m_columnar) {
+        event->m_dir.radec(m_ra[index], m_dec[index],
+                           m_dirx[index], m_diry[index], m_dirz[index]);
+        event->m_energy.MeV(m_energy[index], m_log10e[index]);
+        event->m_time.secs(m_time[index]);
+    }
+
+    // ... otherwise copy event atom
+    else {
+        *event = m_events[index];
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set event columns to be read
+ *
+ * @param[in] columns Names of event columns to be read.
+ *
+ * Selects the event columns that are read from a FITS file by the next
+ * call to load() or read(). The TIME, RA, DEC and ENERGY columns are
+ * always read. If @p columns is empty, all event columns are read. Event
+ * attributes of columns that are not read are set to 0.
+ *
+ * To read only the TIME, RA, DEC and ENERGY columns, specify any of these
+ * columns. In the columnar layout, only these columns are read in any
+ * case.
+ ***************************************************************************/
+void GCTAEventList::columns(const std::vector<std::string>& columns)
+{
+    // Set column selection
+    m_columns = columns;
 
     // Return
     return;
@@ -498,6 +746,16 @@ void GCTAEventList::init_members(void)
     // Initialise members
     m_roi.clear();
     m_events.clear();
+    m_columnar = false;
+    m_columns.clear();
+    m_ra.clear();
+    m_dec.clear();
+    m_dirx.clear();
+    m_diry.clear();
+    m_dirz.clear();
+    m_energy.clear();
+    m_log10e.clear();
+    m_time.clear();
 
     // Return
     return;
@@ -512,8 +770,18 @@ void GCTAEventList::init_members(void)
 void GCTAEventList::copy_members(const GCTAEventList& list)
 {
     // Copy members
-    m_roi    = list.m_roi;
-    m_events = list.m_events;
+    m_roi      = list.m_roi;
+    m_events   = list.m_events;
+    m_columnar = list.m_columnar;
+    m_columns  = list.m_columns;
+    m_ra       = list.m_ra;
+    m_dec      = list.m_dec;
+    m_dirx     = list.m_dirx;
+    m_diry     = list.m_diry;
+    m_dirz     = list.m_dirz;
+    m_energy   = list.m_energy;
+    m_log10e   = list.m_log10e;
+    m_time     = list.m_time;
 
     // Return
     return;
@@ -543,6 +811,14 @@ void GCTAEventList::read_events(const GFitsTable* table)
 {
     // Clear existing events
     m_events.clear();
+    m_ra.clear();
+    m_dec.clear();
+    m_dirx.clear();
+    m_diry.clear();
+    m_dirz.clear();
+    m_energy.clear();
+    m_log10e.clear();
+    m_time.clear();
 
     // Continue only if HDU is valid
     if (table != NULL) {
@@ -563,8 +839,11 @@ void GCTAEventList::read_events(const GFitsTable* table)
                 read_events_v0(table);
             }
 
-            // Read (optional) Hillas parameters
-            read_events_hillas(table);
+            // Read (optional) Hillas parameters. Hillas parameters are
+            // not kept for columnar storage.
+            if (!m_columnar) {
+                read_events_hillas(table);
+            }
 
         } // endif: there were events
 
@@ -600,7 +879,7 @@ void GCTAEventList::read_events_v0(const GFitsTable* table)
         if (num > 0) {
 
             // Reserve data
-            m_events.reserve(num);
+            reserve(num);
 
             // Get column pointers
             GFitsTableULongCol*  ptr_eid         = (GFitsTableULongCol*)&(*table)["EVENT_ID"];
@@ -644,7 +923,7 @@ void GCTAEventList::read_events_v0(const GFitsTable* table)
                 event.m_shwidth     = 0.0;
                 event.m_shlength    = 0.0;
                 event.m_energy_err  = (*ptr_energy_err)(i);
-                m_events.push_back(event);
+                append(event);
             }
 
         } // endif: there were events
@@ -663,6 +942,13 @@ void GCTAEventList::read_events_v0(const GFitsTable* table)
  *
  * This method reads the CTA event list from a FITS table HDU into memory.
  *
+ * The table is read column by column using GFitsTableCol::values(), which
+ * copies the column values without loading columns that are not yet in
+ * memory. The peak memory use is hence given by the event list plus a
+ * single column buffer, and columns of the table are left unchanged.
+ * Only the TIME, RA, DEC and ENERGY columns and the columns for which
+ * selected() returns true are read.
+ *
  * @todo Implement agreed column format
  ***************************************************************************/
 void GCTAEventList::read_events_v1(const GFitsTable* table)
@@ -679,55 +965,193 @@ void GCTAEventList::read_events_v1(const GFitsTable* table)
         // If there are events then load them
         if (num > 0) {
 
-            // Reserve data
-            m_events.reserve(num);
+            // Allocate events
+            if (m_columnar) {
+                m_ra.assign(num, 0.0);
+                m_dec.assign(num, 0.0);
+                m_dirx.assign(num, 0.0);
+                m_diry.assign(num, 0.0);
+                m_dirz.assign(num, 0.0);
+                m_energy.assign(num, 0.0);
+                m_log10e.assign(num, 0.0);
+                m_time.assign(num, 0.0);
+            }
+            else {
+                m_events.assign(num, GCTAEventAtom());
+            }
 
-            // Get column pointers
-            GFitsTableULongCol*  ptr_eid         = (GFitsTableULongCol*)&(*table)["EVENT_ID"];
-            GFitsTableULongCol*  ptr_oid         = (GFitsTableULongCol*)&(*table)["OBS_ID"];
-            GFitsTableDoubleCol* ptr_time        = (GFitsTableDoubleCol*)&(*table)["TIME"];
-            GFitsTableShortCol*  ptr_multip      = (GFitsTableShortCol*)&(*table)["MULTIP"];
-            GFitsTableFloatCol*  ptr_ra          = (GFitsTableFloatCol*)&(*table)["RA"];
-            GFitsTableFloatCol*  ptr_dec         = (GFitsTableFloatCol*)&(*table)["DEC"];
-            GFitsTableFloatCol*  ptr_dir_err     = (GFitsTableFloatCol*)&(*table)["DIR_ERR"];
-            GFitsTableFloatCol*  ptr_detx        = (GFitsTableFloatCol*)&(*table)["DETX"];
-            GFitsTableFloatCol*  ptr_dety        = (GFitsTableFloatCol*)&(*table)["DETY"];
-            GFitsTableFloatCol*  ptr_alt         = (GFitsTableFloatCol*)&(*table)["ALT"];
-            GFitsTableFloatCol*  ptr_az          = (GFitsTableFloatCol*)&(*table)["AZ"];
-            GFitsTableFloatCol*  ptr_corex       = (GFitsTableFloatCol*)&(*table)["COREX"];
-            GFitsTableFloatCol*  ptr_corey       = (GFitsTableFloatCol*)&(*table)["COREY"];
-            GFitsTableFloatCol*  ptr_core_err    = (GFitsTableFloatCol*)&(*table)["CORE_ERR"];
-            GFitsTableFloatCol*  ptr_xmax        = (GFitsTableFloatCol*)&(*table)["XMAX"];
-            GFitsTableFloatCol*  ptr_xmax_err    = (GFitsTableFloatCol*)&(*table)["XMAX_ERR"];
-            GFitsTableFloatCol*  ptr_shw         = (GFitsTableFloatCol*)&(*table)["SHWIDTH"];
-            GFitsTableFloatCol*  ptr_shl         = (GFitsTableFloatCol*)&(*table)["SHLENGTH"];
-            GFitsTableFloatCol*  ptr_energy      = (GFitsTableFloatCol*)&(*table)["ENERGY"];
-            GFitsTableFloatCol*  ptr_energy_err  = (GFitsTableFloatCol*)&(*table)["ENERGY_ERR"];
+            // Allocate buffers for bulk column copies
+            std::vector<double>    values(num);
+            std::vector<double>    values2(num);
+            std::vector<long long> ivalues(num);
 
-            // Copy data from columns into GCTAEventAtom objects
-            GCTAEventAtom event;
+            // TIME
+            (*table)["TIME"].values(0, num, &(values[0]));
             for (int i = 0; i < num; ++i) {
-                event.m_time.set((*ptr_time)(i), m_gti.reference());
-                event.m_dir.radec_deg((*ptr_ra)(i), (*ptr_dec)(i));
-                event.m_energy.TeV((*ptr_energy)(i));
-                event.m_event_id    = (*ptr_eid)(i);
-                event.m_obs_id      = (*ptr_oid)(i);
-                event.m_multip      = (*ptr_multip)(i);
-                event.m_telmask     = 0;
-                event.m_dir_err     = (*ptr_dir_err)(i);
-                event.m_detx        = (*ptr_detx)(i);
-                event.m_dety        = (*ptr_dety)(i);
-                event.m_alt         = (*ptr_alt)(i);
-                event.m_az          = (*ptr_az)(i);
-                event.m_corex       = (*ptr_corex)(i);
-                event.m_corey       = (*ptr_corey)(i);
-                event.m_core_err    = (*ptr_core_err)(i);
-                event.m_xmax        = (*ptr_xmax)(i);
-                event.m_xmax_err    = (*ptr_xmax_err)(i);
-                event.m_shwidth     = (*ptr_shw)(i);
-                event.m_shlength    = (*ptr_shl)(i);
-                event.m_energy_err  = (*ptr_energy_err)(i);
-                m_events.push_back(event);
+                GTime time;
+                time.set(values[i], m_gti.reference());
+                if (m_columnar) {
+                    m_time[i] = time.secs();
+                }
+                else {
+                    m_events[i].m_time = time;
+                }
+            }
+
+            // RA and DEC
+            (*table)["RA"].values(0, num, &(values[0]));
+            (*table)["DEC"].values(0, num, &(values2[0]));
+            for (int i = 0; i < num; ++i) {
+                if (m_columnar) {
+                    GSkyDir dir;
+                    dir.radec_deg(values[i], values2[i]);
+                    set_columnar_dir(i, dir.ra(), dir.dec());
+                }
+                else {
+                    m_events[i].m_dir.radec_deg(values[i], values2[i]);
+                }
+            }
+
+            // ENERGY
+            (*table)["ENERGY"].values(0, num, &(values[0]));
+            for (int i = 0; i < num; ++i) {
+                GEnergy energy;
+                energy.TeV(values[i]);
+                if (m_columnar) {
+                    m_energy[i] = energy.MeV();
+                    m_log10e[i] = energy.log10MeV();
+                }
+                else {
+                    m_events[i].m_energy = energy;
+                }
+            }
+
+            // EVENT_ID
+            if (selected("EVENT_ID")) {
+                (*table)["EVENT_ID"].values(0, num, &(ivalues[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_event_id = ivalues[i];
+                }
+            }
+
+            // OBS_ID
+            if (selected("OBS_ID")) {
+                (*table)["OBS_ID"].values(0, num, &(ivalues[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_obs_id = ivalues[i];
+                }
+            }
+
+            // MULTIP
+            if (selected("MULTIP")) {
+                (*table)["MULTIP"].values(0, num, &(ivalues[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_multip = ivalues[i];
+                }
+            }
+
+            // DIR_ERR
+            if (selected("DIR_ERR")) {
+                (*table)["DIR_ERR"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_dir_err = values[i];
+                }
+            }
+
+            // DETX
+            if (selected("DETX")) {
+                (*table)["DETX"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_detx = values[i];
+                }
+            }
+
+            // DETY
+            if (selected("DETY")) {
+                (*table)["DETY"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_dety = values[i];
+                }
+            }
+
+            // ALT
+            if (selected("ALT")) {
+                (*table)["ALT"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_alt = values[i];
+                }
+            }
+
+            // AZ
+            if (selected("AZ")) {
+                (*table)["AZ"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_az = values[i];
+                }
+            }
+
+            // COREX
+            if (selected("COREX")) {
+                (*table)["COREX"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_corex = values[i];
+                }
+            }
+
+            // COREY
+            if (selected("COREY")) {
+                (*table)["COREY"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_corey = values[i];
+                }
+            }
+
+            // CORE_ERR
+            if (selected("CORE_ERR")) {
+                (*table)["CORE_ERR"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_core_err = values[i];
+                }
+            }
+
+            // XMAX
+            if (selected("XMAX")) {
+                (*table)["XMAX"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_xmax = values[i];
+                }
+            }
+
+            // XMAX_ERR
+            if (selected("XMAX_ERR")) {
+                (*table)["XMAX_ERR"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_xmax_err = values[i];
+                }
+            }
+
+            // SHWIDTH
+            if (selected("SHWIDTH")) {
+                (*table)["SHWIDTH"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_shwidth = values[i];
+                }
+            }
+
+            // SHLENGTH
+            if (selected("SHLENGTH")) {
+                (*table)["SHLENGTH"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_shlength = values[i];
+                }
+            }
+
+            // ENERGY_ERR
+            if (selected("ENERGY_ERR")) {
+                (*table)["ENERGY_ERR"].values(0, num, &(values[0]));
+                for (int i = 0; i < num; ++i) {
+                    m_events[i].m_energy_err = values[i];
+                }
             }
 
         } // endif: there were events
@@ -747,8 +1171,8 @@ void GCTAEventList::read_events_v1(const GFitsTable* table)
  * This method reads the Hillas reconstruction information for CTA events
  * from an EVENTS file. It searches for the columns HIL_MSW, HIL_MSW_ERR,
  * HIL_MSL, and HIL_MSL_ERR in the FITS table and extracts the relevant
- * columns from the FITS file. If a column is not found, no action is
- * performed.
+ * columns from the FITS file. If a column is not found or not selected
+ * (see selected()), no action is performed.
  *
  * @todo Verify consistency of event list size
  ***************************************************************************/
@@ -766,39 +1190,38 @@ void GCTAEventList::read_events_hillas(const GFitsTable* table)
         // Continue only if there are events
         if (num > 0) {
 
+            // Allocate buffer for bulk column copies
+            std::vector<double> values(num);
+
             // HIL_MSW
-            if (table->hascolumn("HIL_MSW")) {
-                GFitsTableFloatCol* ptr =
-                     (GFitsTableFloatCol*)&(*table)["HIL_MSW"];
+            if (table->hascolumn("HIL_MSW") && selected("HIL_MSW")) {
+                (*table)["HIL_MSW"].values(0, num, &(values[0]));
                 for (int i = 0; i < num; ++i) {
-                    m_events[i].m_hil_msw = (*ptr)(i);
+                    m_events[i].m_hil_msw = values[i];
                 }
             }
 
             // HIL_MSW_ERR
-            if (table->hascolumn("HIL_MSW_ERR")) {
-                GFitsTableFloatCol* ptr =
-                     (GFitsTableFloatCol*)&(*table)["HIL_MSW_ERR"];
+            if (table->hascolumn("HIL_MSW_ERR") && selected("HIL_MSW_ERR")) {
+                (*table)["HIL_MSW_ERR"].values(0, num, &(values[0]));
                 for (int i = 0; i < num; ++i) {
-                    m_events[i].m_hil_msw_err = (*ptr)(i);
+                    m_events[i].m_hil_msw_err = values[i];
                 }
             }
 
             // HIL_MSL
-            if (table->hascolumn("HIL_MSL")) {
-                GFitsTableFloatCol* ptr =
-                     (GFitsTableFloatCol*)&(*table)["HIL_MSL"];
+            if (table->hascolumn("HIL_MSL") && selected("HIL_MSL")) {
+                (*table)["HIL_MSL"].values(0, num, &(values[0]));
                 for (int i = 0; i < num; ++i) {
-                    m_events[i].m_hil_msl = (*ptr)(i);
+                    m_events[i].m_hil_msl = values[i];
                 }
             }
 
             // HIL_MSL_ERR
-            if (table->hascolumn("HIL_MSL_ERR")) {
-                GFitsTableFloatCol* ptr =
-                     (GFitsTableFloatCol*)&(*table)["HIL_MSL_ERR"];
+            if (table->hascolumn("HIL_MSL_ERR") && selected("HIL_MSL_ERR")) {
+                (*table)["HIL_MSL_ERR"].values(0, num, &(values[0]));
                 for (int i = 0; i < num; ++i) {
-                    m_events[i].m_hil_msl_err = (*ptr)(i);
+                    m_events[i].m_hil_msl_err = values[i];
                 }
             }
 
@@ -1000,94 +1423,122 @@ void GCTAEventList::write_events(GFitsBinTable* hdu) const
 
         // If there are events then write them now
         if (size() > 0) {
+            fill_events(hdu, 0, size());
+        }
 
-            // Allocate columns
-            GFitsTableULongCol  col_eid         = GFitsTableULongCol("EVENT_ID", size());
-            GFitsTableULongCol  col_oid         = GFitsTableULongCol("OBS_ID", size());
-            GFitsTableDoubleCol col_time        = GFitsTableDoubleCol("TIME", size());
-            GFitsTableDoubleCol col_live        = GFitsTableDoubleCol("TLIVE", size());
-            GFitsTableShortCol  col_multip      = GFitsTableShortCol("MULTIP", size());
-            GFitsTableBitCol    col_telmask     = GFitsTableBitCol("TELMASK", size(), 100);
-            GFitsTableFloatCol  col_ra          = GFitsTableFloatCol("RA", size());
-            GFitsTableFloatCol  col_dec         = GFitsTableFloatCol("DEC", size());
-            GFitsTableFloatCol  col_direrr      = GFitsTableFloatCol("DIR_ERR", size());
-            GFitsTableFloatCol  col_detx        = GFitsTableFloatCol("DETX", size());
-            GFitsTableFloatCol  col_dety        = GFitsTableFloatCol("DETY", size());
-            GFitsTableFloatCol  col_alt         = GFitsTableFloatCol("ALT", size());
-            GFitsTableFloatCol  col_az          = GFitsTableFloatCol("AZ", size());
-            GFitsTableFloatCol  col_corex       = GFitsTableFloatCol("COREX", size());
-            GFitsTableFloatCol  col_corey       = GFitsTableFloatCol("COREY", size());
-            GFitsTableFloatCol  col_core_err    = GFitsTableFloatCol("CORE_ERR", size());
-            GFitsTableFloatCol  col_xmax        = GFitsTableFloatCol("XMAX", size());
-            GFitsTableFloatCol  col_xmax_err    = GFitsTableFloatCol("XMAX_ERR", size());
-            GFitsTableFloatCol  col_shw         = GFitsTableFloatCol("SHWIDTH", size());
-            GFitsTableFloatCol  col_shl         = GFitsTableFloatCol("SHLENGTH", size());
-            GFitsTableFloatCol  col_energy      = GFitsTableFloatCol("ENERGY", size());
-            GFitsTableFloatCol  col_energy_err  = GFitsTableFloatCol("ENERGY_ERR", size());
-            GFitsTableFloatCol  col_hil_msw     = GFitsTableFloatCol("HIL_MSW", size());
-            GFitsTableFloatCol  col_hil_msw_err = GFitsTableFloatCol("HIL_MSW_ERR", size());
-            GFitsTableFloatCol  col_hil_msl     = GFitsTableFloatCol("HIL_MSL", size());
-            GFitsTableFloatCol  col_hil_msl_err = GFitsTableFloatCol("HIL_MSL_ERR", size());
-
-            // Fill columns
-            for (int i = 0; i < size(); ++i) {
-                col_eid(i)         = m_events[i].m_event_id;
-                col_oid(i)         = m_events[i].m_obs_id;
-                col_time(i)        = m_events[i].time().convert(m_gti.reference());
-                col_live(i)        = 0.0;
-                col_multip(i)      = 0;
-                //col_telmask
-                col_ra(i)          = m_events[i].dir().ra_deg();
-                col_dec(i)         = m_events[i].dir().dec_deg();
-                col_direrr(i)      = m_events[i].m_dir_err;
-                col_detx(i)        = m_events[i].m_detx;
-                col_dety(i)        = m_events[i].m_dety;
-                col_alt(i)         = m_events[i].m_alt;
-                col_az(i)          = m_events[i].m_az;
-                col_corex(i)       = m_events[i].m_corex;
-                col_corey(i)       = m_events[i].m_corey;
-                col_core_err(i)    = m_events[i].m_core_err;
-                col_xmax(i)        = m_events[i].m_xmax;
-                col_xmax_err(i)    = m_events[i].m_xmax_err;
-                col_shw(i)         = m_events[i].m_shwidth;
-                col_shl(i)         = m_events[i].m_shlength;
-                col_energy(i)      = m_events[i].energy().TeV();
-                col_energy_err(i)  = m_events[i].m_energy_err;
-                col_hil_msw(i)     = m_events[i].m_hil_msw;
-                col_hil_msw_err(i) = m_events[i].m_hil_msw_err;
-                col_hil_msl(i)     = m_events[i].m_hil_msl;
-                col_hil_msl_err(i) = m_events[i].m_hil_msl_err;
-            } // endfor: looped over rows
-
-            // Append columns to table
-            hdu->append_column(col_eid);
-            hdu->append_column(col_oid);
-            hdu->append_column(col_time);
-            hdu->append_column(col_live);
-            hdu->append_column(col_multip);
-            hdu->append_column(col_telmask);
-            hdu->append_column(col_ra);
-            hdu->append_column(col_dec);
-            hdu->append_column(col_direrr);
-            hdu->append_column(col_detx);
-            hdu->append_column(col_dety);
-            hdu->append_column(col_alt);
-            hdu->append_column(col_az);
-            hdu->append_column(col_corex);
-            hdu->append_column(col_corey);
-            hdu->append_column(col_core_err);
-            hdu->append_column(col_xmax);
-            hdu->append_column(col_xmax_err);
-            hdu->append_column(col_shw);
-            hdu->append_column(col_shl);
-            hdu->append_column(col_energy);
-            hdu->append_column(col_energy_err);
-            hdu->append_column(col_hil_msw);
-            hdu->append_column(col_hil_msw_err);
-            hdu->append_column(col_hil_msl);
-            hdu->append_column(col_hil_msl_err);
-        
-        } // endif: there were events to write
+    } // endif: HDU was valid
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Fill range of CTA events into FITS table columns
+ *
+ * @param[in] hdu FITS table HDU.
+ * @param[in] first Index of first event.
+ * @param[in] nrows Number of events.
+ *
+ * Appends the event columns holding the events [first,first+nrows) to
+ * the FITS table. For @p nrows=0, columns without rows are appended, which
+ * defines the layout of an event table that is then filled by streaming.
+ *
+ * @todo The TELMASK column is allocated with a dummy length of 100.
+ ***************************************************************************/
+void GCTAEventList::fill_events(GFitsBinTable* hdu,
+                                const int&     first,
+                                const int&     nrows) const
+{
+    // Continue only if HDU is valid
+    if (hdu != NULL) {
+
+        // Allocate columns
+        GFitsTableULongCol  col_eid         = GFitsTableULongCol("EVENT_ID", nrows);
+        GFitsTableULongCol  col_oid         = GFitsTableULongCol("OBS_ID", nrows);
+        GFitsTableDoubleCol col_time        = GFitsTableDoubleCol("TIME", nrows);
+        GFitsTableDoubleCol col_live        = GFitsTableDoubleCol("TLIVE", nrows);
+        GFitsTableShortCol  col_multip      = GFitsTableShortCol("MULTIP", nrows);
+        GFitsTableBitCol    col_telmask     = GFitsTableBitCol("TELMASK", nrows, 100);
+        GFitsTableFloatCol  col_ra          = GFitsTableFloatCol("RA", nrows);
+        GFitsTableFloatCol  col_dec         = GFitsTableFloatCol("DEC", nrows);
+        GFitsTableFloatCol  col_direrr      = GFitsTableFloatCol("DIR_ERR", nrows);
+        GFitsTableFloatCol  col_detx        = GFitsTableFloatCol("DETX", nrows);
+        GFitsTableFloatCol  col_dety        = GFitsTableFloatCol("DETY", nrows);
+        GFitsTableFloatCol  col_alt         = GFitsTableFloatCol("ALT", nrows);
+        GFitsTableFloatCol  col_az          = GFitsTableFloatCol("AZ", nrows);
+        GFitsTableFloatCol  col_corex       = GFitsTableFloatCol("COREX", nrows);
+        GFitsTableFloatCol  col_corey       = GFitsTableFloatCol("COREY", nrows);
+        GFitsTableFloatCol  col_core_err    = GFitsTableFloatCol("CORE_ERR", nrows);
+        GFitsTableFloatCol  col_xmax        = GFitsTableFloatCol("XMAX", nrows);
+        GFitsTableFloatCol  col_xmax_err    = GFitsTableFloatCol("XMAX_ERR", nrows);
+        GFitsTableFloatCol  col_shw         = GFitsTableFloatCol("SHWIDTH", nrows);
+        GFitsTableFloatCol  col_shl         = GFitsTableFloatCol("SHLENGTH", nrows);
+        GFitsTableFloatCol  col_energy      = GFitsTableFloatCol("ENERGY", nrows);
+        GFitsTableFloatCol  col_energy_err  = GFitsTableFloatCol("ENERGY_ERR", nrows);
+        GFitsTableFloatCol  col_hil_msw     = GFitsTableFloatCol("HIL_MSW", nrows);
+        GFitsTableFloatCol  col_hil_msw_err = GFitsTableFloatCol("HIL_MSW_ERR", nrows);
+        GFitsTableFloatCol  col_hil_msl     = GFitsTableFloatCol("HIL_MSL", nrows);
+        GFitsTableFloatCol  col_hil_msl_err = GFitsTableFloatCol("HIL_MSL_ERR", nrows);
+
+        // Fill columns
+        for (int i = 0; i < nrows; ++i) {
+            const GCTAEventAtom* event = (*this)[first+i];
+            col_eid(i)         = event->m_event_id;
+            col_oid(i)         = event->m_obs_id;
+            col_time(i)        = event->time().convert(m_gti.reference());
+            col_live(i)        = 0.0;
+            col_multip(i)      = 0;
+            //col_telmask
+            col_ra(i)          = event->dir().ra_deg();
+            col_dec(i)         = event->dir().dec_deg();
+            col_direrr(i)      = event->m_dir_err;
+            col_detx(i)        = event->m_detx;
+            col_dety(i)        = event->m_dety;
+            col_alt(i)         = event->m_alt;
+            col_az(i)          = event->m_az;
+            col_corex(i)       = event->m_corex;
+            col_corey(i)       = event->m_corey;
+            col_core_err(i)    = event->m_core_err;
+            col_xmax(i)        = event->m_xmax;
+            col_xmax_err(i)    = event->m_xmax_err;
+            col_shw(i)         = event->m_shwidth;
+            col_shl(i)         = event->m_shlength;
+            col_energy(i)      = event->energy().TeV();
+            col_energy_err(i)  = event->m_energy_err;
+            col_hil_msw(i)     = event->m_hil_msw;
+            col_hil_msw_err(i) = event->m_hil_msw_err;
+            col_hil_msl(i)     = event->m_hil_msl;
+            col_hil_msl_err(i) = event->m_hil_msl_err;
+        } // endfor: looped over rows
+
+        // Append columns to table
+        hdu->append_column(col_eid);
+        hdu->append_column(col_oid);
+        hdu->append_column(col_time);
+        hdu->append_column(col_live);
+        hdu->append_column(col_multip);
+        hdu->append_column(col_telmask);
+        hdu->append_column(col_ra);
+        hdu->append_column(col_dec);
+        hdu->append_column(col_direrr);
+        hdu->append_column(col_detx);
+        hdu->append_column(col_dety);
+        hdu->append_column(col_alt);
+        hdu->append_column(col_az);
+        hdu->append_column(col_corex);
+        hdu->append_column(col_corey);
+        hdu->append_column(col_core_err);
+        hdu->append_column(col_xmax);
+        hdu->append_column(col_xmax_err);
+        hdu->append_column(col_shw);
+        hdu->append_column(col_shl);
+        hdu->append_column(col_energy);
+        hdu->append_column(col_energy_err);
+        hdu->append_column(col_hil_msw);
+        hdu->append_column(col_hil_msw_err);
+        hdu->append_column(col_hil_msl);
+        hdu->append_column(col_hil_msl_err);
 
     } // endif: HDU was valid
 
@@ -1154,6 +1605,125 @@ void GCTAEventList::write_ds_keys(GFitsHDU* hdu) const
 }
 
 
+/***********************************************************************//**
+ * @brief Check whether an optional event column should be read
+ *
+ * @param[in] colname Column name.
+ * @return True if column should be read.
+ *
+ * Returns false for all columns in the columnar layout, since only the
+ * TIME, RA, DEC and ENERGY columns are kept in that layout. Otherwise,
+ * returns true if no column selection was specified, or if @p colname
+ * is part of the column selection.
+ ***************************************************************************/
+bool GCTAEventList::selected(const std::string& colname) const
+{
+    // Initialise flag
+    bool select = !m_columnar;
+
+    // If a column selection was specified then check whether the column
+    // is part of the selection
+    if (select && !m_columns.empty()) {
+        select = false;
+        for (int i = 0; i < m_columns.size(); ++i) {
+            if (m_columns[i] == colname) {
+                select = true;
+                break;
+            }
+        }
+    }
+
+    // Return flag
+    return select;
+}
+
+
+/***********************************************************************//**
+ * @brief Append event atom to columnar event storage
+ *
+ * @param[in] event Event.
+ ***************************************************************************/
+void GCTAEventList::append_columnar(const GCTAEventAtom& event)
+{
+    // Allocate event
+    int index = size();
+    m_ra.push_back(0.0);
+    m_dec.push_back(0.0);
+    m_dirx.push_back(0.0);
+    m_diry.push_back(0.0);
+    m_dirz.push_back(0.0);
+
+    // Set event direction, energy and time
+    set_columnar_dir(index, event.m_dir.ra(), event.m_dir.dec());
+    m_energy.push_back(event.m_energy.MeV());
+    m_log10e.push_back(event.m_energy.log10MeV());
+    m_time.push_back(event.m_time.secs());
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set event direction in columnar event storage
+ *
+ * @param[in] index Event index [0,...,size()-1].
+ * @param[in] ra Right Ascension (radians).
+ * @param[in] dec Declination (radians).
+ *
+ * Sets the equatorial coordinates and the celestial unit vector of the
+ * event @p index.
+ ***************************************************************************/
+void GCTAEventList::set_columnar_dir(const int& index, const double& ra,
+                                     const double& dec)
+{
+    // Set equatorial coordinates
+    m_ra[index]  = ra;
+    m_dec[index] = dec;
+
+    // Set celestial unit vector
+    double cosdec = std::cos(m_dec[index]);
+    m_dirx[index] = cosdec * std::cos(m_ra[index]);
+    m_diry[index] = cosdec * std::sin(m_ra[index]);
+    m_dirz[index] = std::sin(m_dec[index]);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return proxy event atom for columnar event storage
+ *
+ * @param[in] index Event index [0,...,size()-1].
+ *
+ * Fills the next proxy event atom of the calling thread with the
+ * direction, energy and time of the requested event and returns a pointer
+ * to it. The proxies are held in a thread-local ring of G_PROXY_RING event
+ * atoms that is allocated on the first access of a thread, hence the event
+ * list can be accessed from any number of threads, including threads of
+ * nested parallel regions and threads that were not created by OpenMP.
+ * The rings are released at program exit.
+ ***************************************************************************/
+GCTAEventAtom* GCTAEventList::proxy(const int& index) const
+{
+    // Allocate proxy ring of thread if required
+    if (g_proxy_ring == NULL) {
+        g_proxy_ring = g_proxy_pool.allocate();
+    }
+
+    // Get next proxy event atom of ring
+    GCTAEventAtom* proxy = &(g_proxy_ring->atoms[g_proxy_ring->next]);
+    g_proxy_ring->next   = (g_proxy_ring->next + 1) % G_PROXY_RING;
+
+    // Set proxy event atom
+    event(index, proxy);
+
+    // Return proxy
+    return proxy;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                                Friends                                  =
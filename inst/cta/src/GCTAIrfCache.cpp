@@ -0,0 +1,898 @@
+/***************************************************************************
+ *            GCTAIrfCache.cpp - CTA instrument response cache             *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTAIrfCache.cpp
+ * @brief CTA instrument response cache class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#if defined(HAVE_SYS_STAT_H)
+#include <sys/stat.h>
+#endif
+#include <cstdlib>         // std::getenv() function
+#include <cstdio>
+#include <map>
+#include <vector>
+#include <utility>
+#include "GTools.hpp"
+#include "GException.hpp"
+#include "GFits.hpp"
+#include "GCTAIrfCache.hpp"
+#include "GCTAAeff2D.hpp"
+#include "GCTAAeffArf.hpp"
+#include "GCTAAeffPerfTable.hpp"
+#include "GCTAPsf2D.hpp"
+#include "GCTAPsfVector.hpp"
+#include "GCTAPsfPerfTable.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+/* __ Local data _________________________________________________________ */
+// Cached responses. Each entry holds the cached response and the number of
+// clients that use the response.
+static std::map<std::string, std::pair<GBase*, int> > g_irfs;
+
+// Responses that are in use, together with the key of the cached response
+// they stem from. Shared responses are the cached responses themselves,
+// all other responses are copies of them.
+static std::map<const GBase*, std::string> g_users;
+
+// Cache directory for binary response tables
+static bool        g_has_directory = false;
+static std::string g_directory;
+
+
+/*==========================================================================
+ =                                                                         =
+ =                        Constructors/destructors                         =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GCTAIrfCache::GCTAIrfCache(void) : GBase()
+{
+    // Initialise class members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] cache Instrument response cache.
+ ***************************************************************************/
+GCTAIrfCache::GCTAIrfCache(const GCTAIrfCache& cache) : GBase(cache)
+{
+    // Initialise class members
+    init_members();
+
+    // Copy members
+    copy_members(cache);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GCTAIrfCache::~GCTAIrfCache(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                                Operators                                =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] cache Instrument response cache.
+ * @return Instrument response cache.
+ ***************************************************************************/
+GCTAIrfCache& GCTAIrfCache::operator= (const GCTAIrfCache& cache)
+{
+    // Execute only if object is not identical
+    if (this != &cache) {
+
+        // Free members
+        free_members();
+
+        // Initialise members
+        init_members();
+
+        // Copy members
+        copy_members(cache);
+
+    } // endif: object was not identical
+
+    // Return
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear instance
+ *
+ * The cache content is shared by all instances and is not affected by this
+ * method. Use purge() to drop unused cache entries.
+ ***************************************************************************/
+void GCTAIrfCache::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone instance
+ *
+ * @return Pointer to deep copy of instrument response cache.
+ ***************************************************************************/
+GCTAIrfCache* GCTAIrfCache::clone(void) const
+{
+    return new GCTAIrfCache(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of cached responses
+ *
+ * @return Number of cached responses.
+ ***************************************************************************/
+int GCTAIrfCache::size(void) const
+{
+    // Get number of cached responses
+    int size = 0;
+    #pragma omp critical(GCTAIrfCache)
+    {
+        size = g_irfs.size();
+    }
+
+    // Return size
+    return size;
+}
+
+
+/***********************************************************************//**
+ * @brief Return effective area
+ *
+ * @param[in] filename Effective area filename.
+ * @return Pointer to effective area.
+ *
+ * Returns the effective area that is stored in @p filename. The file is
+ * only loaded if the effective area is not yet in the cache. The effective
+ * area has to be returned using release().
+ ***************************************************************************/
+GCTAAeff* GCTAIrfCache::aeff(const std::string& filename)
+{
+    // Build cache key
+    std::string key = "AEFF:" + filename + ":" + stamp(filename);
+
+    // Get cached effective area
+    GBase* irf = acquire(key);
+
+    // If effective area was not cached then load it and insert it into the
+    // cache
+    if (irf == NULL) {
+        irf = insert(key, load_aeff(filename));
+    }
+
+    // Return effective area
+    return (dynamic_cast<GCTAAeff*>(irf));
+}
+
+
+/***********************************************************************//**
+ * @brief Return point spread function
+ *
+ * @param[in] filename Point spread function filename.
+ * @return Pointer to point spread function.
+ *
+ * Returns the point spread function that is stored in @p filename. The
+ * file is only loaded if the point spread function is not yet in the cache.
+ * The point spread function has to be returned using release().
+ ***************************************************************************/
+GCTAPsf* GCTAIrfCache::psf(const std::string& filename)
+{
+    // Build cache key
+    std::string key = "PSF:" + filename + ":" + stamp(filename);
+
+    // Get cached point spread function
+    GBase* irf = acquire(key);
+
+    // If point spread function was not cached then load it and insert it
+    // into the cache
+    if (irf == NULL) {
+        irf = insert(key, load_psf(filename));
+    }
+
+    // Return point spread function
+    return (dynamic_cast<GCTAPsf*>(irf));
+}
+
+
+/***********************************************************************//**
+ * @brief Copy effective area
+ *
+ * @param[in] aeff Pointer to effective area (may be NULL).
+ * @return Pointer to copy of effective area (NULL if @p aeff is NULL).
+ *
+ * Returns a copy of the effective area. If the effective area was obtained
+ * from the cache, the copy is accounted to the same cache entry, and an
+ * effective area that is shared is returned itself.
+ ***************************************************************************/
+GCTAAeff* GCTAIrfCache::copy(const GCTAAeff* aeff)
+{
+    // Return copy
+    return (dynamic_cast<GCTAAeff*>(duplicate(aeff)));
+}
+
+
+/***********************************************************************//**
+ * @brief Copy point spread function
+ *
+ * @param[in] psf Pointer to point spread function (may be NULL).
+ * @return Pointer to copy of point spread function (NULL if @p psf is NULL).
+ *
+ * Returns a copy of the point spread function. If the point spread
+ * function was obtained from the cache, the copy is accounted to the same
+ * cache entry, and a point spread function that is shared is returned
+ * itself.
+ ***************************************************************************/
+GCTAPsf* GCTAIrfCache::copy(const GCTAPsf* psf)
+{
+    // Return copy
+    return (dynamic_cast<GCTAPsf*>(duplicate(psf)));
+}
+
+
+/***********************************************************************//**
+ * @brief Release response
+ *
+ * @param[in] irf Pointer to response (may be NULL).
+ *
+ * Returns a response that was obtained using aeff(), psf() or copy(). If
+ * the response was obtained from the cache, the reference count of the
+ * cache entry is decremented. Once the last client has released the
+ * response, the cache entry is dropped and the cached response is
+ * deleted. Responses that are not shared are deleted on release.
+ ***************************************************************************/
+void GCTAIrfCache::release(GBase* irf)
+{
+    // Continue only if pointer is valid
+    if (irf != NULL) {
+
+        // Initialise deletion flag and cached response to be dropped
+        bool   remove  = true;
+        GBase* dropped = NULL;
+
+        // Remove response from the responses that are in use
+        #pragma omp critical(GCTAIrfCache)
+        {
+            std::map<const GBase*, std::string>::iterator user = g_users.find(irf);
+            if (user != g_users.end()) {
+                std::map<std::string, std::pair<GBase*, int> >::iterator entry =
+                    g_irfs.find(user->second);
+                if (entry != g_irfs.end()) {
+                    entry->second.second--;
+                    remove = (entry->second.first != irf);
+                    if (entry->second.second < 1) {
+                        dropped = entry->second.first;
+                        g_users.erase(dropped);
+                        g_irfs.erase(entry);
+                    }
+                }
+                if (remove) {
+                    g_users.erase(irf);
+                }
+            }
+        }
+
+        // Delete response unless it is shared
+        if (remove) {
+            delete irf;
+        }
+
+        // Delete cached response if it is no longer in use
+        if (dropped != NULL) {
+            delete dropped;
+        }
+
+    } // endif: pointer was valid
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Drop unused cache entries
+ *
+ * Deletes all cached responses that are no longer in use. Binary response
+ * tables in the cache directory are kept.
+ ***************************************************************************/
+void GCTAIrfCache::purge(void)
+{
+    // Collect unused cache entries
+    std::vector<GBase*> unused;
+    #pragma omp critical(GCTAIrfCache)
+    {
+        std::map<std::string, std::pair<GBase*, int> >::iterator entry = g_irfs.begin();
+        while (entry != g_irfs.end()) {
+            if (entry->second.second < 1) {
+                unused.push_back(entry->second.first);
+                g_users.erase(entry->second.first);
+                g_irfs.erase(entry++);
+            }
+            else {
+                ++entry;
+            }
+        }
+    }
+
+    // Delete unused responses
+    for (int i = 0; i < unused.size(); ++i) {
+        delete unused[i];
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set cache directory
+ *
+ * @param[in] dirname Cache directory name (empty to disable persistence).
+ *
+ * Sets the directory in which binary response tables are stored. This
+ * overrides the GAMMALIB_IRFCACHE environment variable for all instances.
+ ***************************************************************************/
+void GCTAIrfCache::directory(const std::string& dirname)
+{
+    // Set cache directory
+    #pragma omp critical(GCTAIrfCache)
+    {
+        g_directory     = dirname;
+        g_has_directory = true;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return cache directory
+ *
+ * @return Cache directory name (empty if no directory was set).
+ *
+ * Returns the directory that was set using directory(const std::string&),
+ * or otherwise the value of the GAMMALIB_IRFCACHE environment variable.
+ ***************************************************************************/
+std::string GCTAIrfCache::directory(void) const
+{
+    // Get cache directory
+    std::string dirname;
+    #pragma omp critical(GCTAIrfCache)
+    {
+        if (g_has_directory) {
+            dirname = g_directory;
+        }
+        else {
+            char* ptr = std::getenv("GAMMALIB_IRFCACHE");
+            if (ptr != NULL) {
+                dirname = std::string(ptr);
+            }
+        }
+    }
+
+    // Return cache directory
+    return dirname;
+}
+
+
+/***********************************************************************//**
+ * @brief Return binary cache file name for response table
+ *
+ * @param[in] filename Response filename.
+ * @param[in] extname Name of response table extension.
+ * @return Binary cache file name (empty if no persistence).
+ *
+ * Builds the name of the file that holds the preprocessed response table
+ * @p extname of the response file @p filename. The name encodes the
+ * response file name, its size, modification time and inode, hence an
+ * updated response file results in a new cache file. An empty string is
+ * returned if no cache directory is set or if the response file does not
+ * exist.
+ ***************************************************************************/
+std::string GCTAIrfCache::cachefile(const std::string& filename,
+                                    const std::string& extname) const
+{
+    // Initialise cache file name
+    std::string cachefile;
+
+    // Get cache directory and file stamp
+    std::string dirname = directory();
+    std::string fstamp  = stamp(filename);
+
+    // Continue only if a cache directory exists and the file has a stamp
+    if (!dirname.empty() && !fstamp.empty()) {
+
+        // Compute 64-bit FNV-1a hash of file and extension name
+        std::string        name = filename + "[" + extname + "]";
+        unsigned long long hash = 14695981039346656037ULL;
+        for (int i = 0; i < name.length(); ++i) {
+            hash ^= (unsigned char)name[i];
+            hash *= 1099511628211ULL;
+        }
+
+        // Build cache file name
+        char buffer[20];
+        std::sprintf(buffer, "%016llx", hash);
+        cachefile = dirname + "/" + std::string(buffer) + "_" + fstamp + ".rsp";
+
+    } // endif: cache directory and file stamp existed
+
+    // Return cache file name
+    return cachefile;
+}
+
+
+/***********************************************************************//**
+ * @brief Print instrument response cache information
+ *
+ * @return Content of instrument response cache.
+ ***************************************************************************/
+std::string GCTAIrfCache::print(void) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Get directory name
+    std::string dirname = directory();
+
+    // Append header
+    result.append("=== GCTAIrfCache ===");
+
+    // Append cache entries
+    #pragma omp critical(GCTAIrfCache)
+    {
+        result.append("\n"+parformat("Number of responses")+str((int)g_irfs.size()));
+        std::map<std::string, std::pair<GBase*, int> >::const_iterator entry;
+        for (entry = g_irfs.begin(); entry != g_irfs.end(); ++entry) {
+            result.append("\n"+parformat(entry->first));
+            result.append(str(entry->second.second)+" users");
+            if (shared(entry->second.first)) {
+                result.append(" (shared)");
+            }
+        }
+    }
+
+    // Append cache directory
+    result.append("\n"+parformat("Cache directory"));
+    result.append((dirname.empty()) ? "None" : dirname);
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GCTAIrfCache::init_members(void)
+{
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] cache Instrument response cache.
+ ***************************************************************************/
+void GCTAIrfCache::copy_members(const GCTAIrfCache& cache)
+{
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GCTAIrfCache::free_members(void)
+{
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return file stamp
+ *
+ * @param[in] filename File name.
+ * @return File stamp (empty if file does not exist).
+ *
+ * Returns a string that encodes the size, modification time and inode of a
+ * file, so that a file that is replaced by another file of same size and
+ * modification time is recognised.
+ ***************************************************************************/
+std::string GCTAIrfCache::stamp(const std::string& filename) const
+{
+    // Initialise stamp
+    std::string stamp;
+
+    // Build stamp from file size, modification time and inode
+    #if defined(HAVE_SYS_STAT_H)
+    struct stat info;
+    if (::stat(filename.c_str(), &info) == 0) {
+        char buffer[60];
+        std::sprintf(buffer, "%llx_%llx_%llx",
+                     (unsigned long long)info.st_size,
+                     (unsigned long long)info.st_mtime,
+                     (unsigned long long)info.st_ino);
+        stamp = std::string(buffer);
+    }
+    #endif
+
+    // Return stamp
+    return stamp;
+}
+
+
+/***********************************************************************//**
+ * @brief Load effective area
+ *
+ * @param[in] filename Effective area filename.
+ * @return Pointer to effective area.
+ *
+ * Allocates an effective area instance and loads the effective area
+ * information from a response file. The following response file formats
+ * are supported:
+ *
+ * (1) A CTA performance table. This is an ASCII file which specifies the
+ *     on-axis effective area as function of energy.
+ *
+ * (2) A ARF FITS file. This is a FITS file which stores the effective area
+ *     in a vector.
+ *
+ * (3) A CTA response table. This is a FITS file which specifies the
+ *     effective area as function of energy and offset angle.
+ *
+ * First, the method checks whether the file is a FITS file or not. If the
+ * file is not a FITS file, it is assumed that the file is an ASCII
+ * performance table. If the file is a FITS file, the extension names are
+ * used to distinguish between a CTA response table ("EFFECTIVE AREA") and
+ * an ARF ("SPECRESP").
+ *
+ * @todo Implement a method that checks if a file is a FITS file instead
+ *       of using try-catch.
+ ***************************************************************************/
+GCTAAeff* GCTAIrfCache::load_aeff(const std::string& filename) const
+{
+    // Initialise effective area
+    GCTAAeff* aeff = NULL;
+
+    // Try opening the file as a FITS file
+    try {
+
+        // Open FITS file
+        GFits file(filename);
+
+        // If file contains an "EFFECTIVE AREA" extension then load it
+        // as CTA response table
+        if (file.hashdu("EFFECTIVE AREA")) {
+            file.close();
+            aeff = new GCTAAeff2D(filename);
+        }
+
+        // ... else if file contains a "SPECRESP" extension then load it
+        // as ARF
+        else if (file.hashdu("SPECRESP")) {
+            file.close();
+            aeff = new GCTAAeffArf(filename);
+        }
+
+    }
+
+    // If FITS file opening failed then assume that we have a performance
+    // table
+    catch (GException::fits_open_error &e) {
+        aeff = new GCTAAeffPerfTable(filename);
+    }
+
+    // Return effective area
+    return aeff;
+}
+
+
+/***********************************************************************//**
+ * @brief Load point spread function
+ *
+ * @param[in] filename Point spread function filename.
+ * @return Pointer to point spread function.
+ *
+ * Allocates a point spread function instance and loads the point spread
+ * function information from a response file. The following response file
+ * formats are supported:
+ *
+ * (1) A CTA performance table. This is an ASCII file which specifies the
+ *     on-axis point spread function as function of energy.
+ *
+ * (2) A PSF vector, stored in a format similar to an ARF vector.
+ *
+ * (3) A CTA response table, where PSF parameters are given as function of
+ *     energy and offset angle ("POINT SPREAD FUNCTION" extension).
+ *
+ * @todo Implement a method that checks if a file is a FITS file instead
+ *       of using try-catch.
+ ***************************************************************************/
+GCTAPsf* GCTAIrfCache::load_psf(const std::string& filename) const
+{
+    // Initialise point spread function
+    GCTAPsf* psf = NULL;
+
+    // Try opening the file as a FITS file
+    try {
+
+        // Open FITS file
+        GFits file(filename);
+
+        // If file contains a "POINT SPREAD FUNCTION" extension then load it
+        // as CTA response table
+        if (file.hashdu("POINT SPREAD FUNCTION")) {
+            file.close();
+            psf = new GCTAPsf2D(filename);
+        }
+
+        // ... else load it has PSF vector
+        else {
+            file.close();
+            psf = new GCTAPsfVector(filename);
+        }
+
+    }
+
+    // If FITS file opening failed then assume that we have a performance
+    // table
+    catch (GException::fits_open_error &e) {
+        psf = new GCTAPsfPerfTable(filename);
+    }
+
+    // Return point spread function
+    return psf;
+}
+
+
+/***********************************************************************//**
+ * @brief Signal if response is shared
+ *
+ * @param[in] irf Pointer to response.
+ * @return True if response is shared by all its clients.
+ *
+ * Responses that are not modified once they have been loaded are shared
+ * by all clients. This applies to effective areas and point spread
+ * functions that are stored in response tables, which are the largest
+ * responses. All other responses are copied for each client, as they either
+ * hold interpolation caches that are updated on evaluation, or they may be
+ * modified by their client (for example the offset angle dependence of an
+ * ARF).
+ ***************************************************************************/
+bool GCTAIrfCache::shared(const GBase* irf) const
+{
+    // Return
+    return (dynamic_cast<const GCTAAeff2D*>(irf) != NULL ||
+            dynamic_cast<const GCTAPsf2D*>(irf)  != NULL);
+}
+
+
+/***********************************************************************//**
+ * @brief Return cached response
+ *
+ * @param[in] key Cache key.
+ * @return Pointer to cached response (NULL if not cached).
+ ***************************************************************************/
+GBase* GCTAIrfCache::acquire(const std::string& key)
+{
+    // Initialise response
+    GBase* irf = NULL;
+
+    // Get cached response and account it to the cache entry
+    #pragma omp critical(GCTAIrfCache)
+    {
+        if (g_irfs.find(key) != g_irfs.end()) {
+            irf = use(key);
+        }
+    }
+
+    // Return response
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Insert response into cache and return it
+ *
+ * @param[in] key Cache key.
+ * @param[in] irf Pointer to loaded response (may be NULL).
+ * @return Pointer to cached response (NULL if @p irf is NULL).
+ *
+ * Inserts a freshly loaded response into the cache, which takes ownership
+ * of it. If another thread has inserted the same response meanwhile, the
+ * response is discarded and the cached response is used instead.
+ ***************************************************************************/
+GBase* GCTAIrfCache::insert(const std::string& key, GBase* irf)
+{
+    // Initialise response and discarded response
+    GBase* response = NULL;
+    GBase* discard  = NULL;
+
+    // Continue only if pointer is valid
+    if (irf != NULL) {
+
+        // Insert response, get cached response and account it to the
+        // cache entry
+        #pragma omp critical(GCTAIrfCache)
+        {
+            if (g_irfs.find(key) == g_irfs.end()) {
+                g_irfs.insert(std::make_pair(key, std::make_pair(irf, 0)));
+            }
+            else {
+                discard = irf;
+            }
+            response = use(key);
+        }
+
+        // Delete discarded response
+        if (discard != NULL) {
+            delete discard;
+        }
+
+    } // endif: pointer was valid
+
+    // Return response
+    return response;
+}
+
+
+/***********************************************************************//**
+ * @brief Duplicate response
+ *
+ * @param[in] irf Pointer to response (may be NULL).
+ * @return Pointer to copy of response (NULL if @p irf is NULL).
+ *
+ * Returns a copy of the response. The response itself is copied, and not
+ * the cached response, as the response may have been modified by its
+ * client (for example the offset angle dependence of an ARF). Shared
+ * responses are not copied; their reference count is incremented instead.
+ ***************************************************************************/
+GBase* GCTAIrfCache::duplicate(const GBase* irf)
+{
+    // Initialise copy
+    GBase* copy = NULL;
+
+    // Continue only if pointer is valid
+    if (irf != NULL) {
+
+        // If the response stems from the cache then account the copy to
+        // the same cache entry
+        #pragma omp critical(GCTAIrfCache)
+        {
+            std::map<const GBase*, std::string>::iterator source = g_users.find(irf);
+            if (source != g_users.end()) {
+                std::map<std::string, std::pair<GBase*, int> >::iterator entry =
+                    g_irfs.find(source->second);
+                if (entry != g_irfs.end()) {
+                    copy = (entry->second.first == irf) ? entry->second.first
+                                                        : irf->clone();
+                    entry->second.second++;
+                    g_users[copy] = source->second;
+                }
+            }
+        }
+
+        // ... otherwise copy response
+        if (copy == NULL) {
+            copy = irf->clone();
+        }
+
+    } // endif: pointer was valid
+
+    // Return copy
+    return copy;
+}
+
+
+/***********************************************************************//**
+ * @brief Use cached response
+ *
+ * @param[in] key Cache key of an existing cache entry.
+ * @return Pointer to response.
+ *
+ * Returns the cached response if it is shared, and a copy of it otherwise,
+ * and accounts the response to the cache entry. The method has to be
+ * called from within the GCTAIrfCache critical section.
+ ***************************************************************************/
+GBase* GCTAIrfCache::use(const std::string& key)
+{
+    // Get cache entry
+    std::map<std::string, std::pair<GBase*, int> >::iterator entry =
+        g_irfs.find(key);
+
+    // Get shared response or copy of cached response
+    GBase* irf = entry->second.first;
+    if (!shared(irf)) {
+        irf = irf->clone();
+    }
+
+    // Account response to cache entry
+    entry->second.second++;
+    g_users[irf] = key;
+
+    // Return response
+    return irf;
+}
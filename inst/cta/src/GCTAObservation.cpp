@@ -131,6 +131,27 @@ GCTAObservation::GCTAObservation(const GCTAObservation& obs) : GObservation(obs)
 }
 
 
+/***********************************************************************//**
+ * @brief Working copy constructor
+ *
+ * @param[in] obs CTA observation.
+ * @param[in] share_events Reference the event container of @p obs?
+ ***************************************************************************/
+GCTAObservation::GCTAObservation(const GCTAObservation& obs,
+                                 const bool&            share_events) :
+                                 GObservation(obs, share_events)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(obs);
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Destructor
  ***************************************************************************/
@@ -214,6 +235,21 @@ GCTAObservation* GCTAObservation::clone(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Clone working copy of instance
+ *
+ * @param[in] share_events Reference the event container?
+ *
+ * Returns a working copy that references the response cache and optionally
+ * the event container of the observation (see
+ * GObservation::shallow_clone()).
+ ***************************************************************************/
+GCTAObservation* GCTAObservation::shallow_clone(const bool& share_events) const
+{
+    return new GCTAObservation(*this, share_events);
+}
+
+
 /***********************************************************************//**
  * @brief Set response function
  *
@@ -734,8 +770,15 @@ std::string GCTAObservation::print(void) const
  * @brief Load data for unbinned analysis
  *
  * @param[in] filename Event FITS file name.
+ * @param[in] columns Names of event columns to be read (default: all).
+ *
+ * Loads the event list from the EVENTS extension of a FITS file. Only the
+ * TIME, RA, DEC and ENERGY columns and the specified @p columns are read
+ * (see GCTAEventList::columns). If @p columns is empty, all event columns
+ * are read.
  ***************************************************************************/
-void GCTAObservation::load_unbinned(const std::string& filename)
+void GCTAObservation::load_unbinned(const std::string&              filename,
+                                    const std::vector<std::string>& columns)
 {
     // Delete any existing event container (do not call clear() as we do not
     // want to delete the response function)
@@ -748,6 +791,9 @@ void GCTAObservation::load_unbinned(const std::string& filename)
     // Assign event list as the observation's event container
     m_events = events;
 
+    // Set event columns to be read
+    events->columns(columns);
+
     // Open FITS file
     GFits file(filename);
 
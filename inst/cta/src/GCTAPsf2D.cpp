@@ -31,6 +31,7 @@
 #include <cmath>
 #include "GTools.hpp"
 #include "GCTAPsf2D.hpp"
+#include "GCTAIrfCache.hpp"
 #include "GCTAException.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -39,6 +40,7 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_PSF2D_NPARS 6             //!< Number of PSF response parameters
 
 /* __ Debug definitions __________________________________________________ */
 
@@ -178,24 +180,24 @@ double GCTAPsf2D::operator()(const double& delta,
     // Initialise PSF value
     double psf = 0.0;
 
-    // Update the parameter cache
-    update(logE, theta);
+    // Compute PSF parameters
+    pars par = parameters(logE, theta);
 
     // Continue only if normalization is positive
-    if (m_norm > 0.0) {
+    if (par.norm > 0.0) {
 
         // Compute distance squared
         double delta2 = delta * delta;
 
         // Compute Psf value
-        psf = std::exp(m_width1 * delta2);
-        if (m_norm2 > 0.0) {
-            psf += std::exp(m_width2 * delta2) * m_norm2;
+        psf = std::exp(par.width1 * delta2);
+        if (par.norm2 > 0.0) {
+            psf += std::exp(par.width2 * delta2) * par.norm2;
         }
-        if (m_norm3 > 0.0) {
-            psf += std::exp(m_width3 * delta2) * m_norm3;
+        if (par.norm3 > 0.0) {
+            psf += std::exp(par.width3 * delta2) * par.norm3;
         }
-        psf *= m_norm;
+        psf *= par.norm;
 
     } // endif: normalization was positive
     
@@ -254,28 +256,51 @@ GCTAPsf2D* GCTAPsf2D::clone(void) const
  ***************************************************************************/
 void GCTAPsf2D::load(const std::string& filename)
 {
-    // Open PSF FITS file
-    GFits file(filename);
+    // Get name of binary cache file
+    std::string cachefile = GCTAIrfCache().cachefile(filename, "POINT SPREAD FUNCTION");
 
-    // Get PSF table
-    GFitsTable* table = file.table("POINT SPREAD FUNCTION");
+    // Load preprocessed PSF table from binary cache file. If this fails
+    // then read PSF table from FITS file and store it in the binary cache
+    // file.
+    if (cachefile.empty() || !m_psf.load_binary(cachefile)) {
 
-    // Read PSF table
-    m_psf.read(table);
+        // Open PSF FITS file
+        GFits file(filename);
 
-    // Set energy axis to logarithmic scale
-    m_psf.axis_log10(0);
+        // Get PSF table
+        GFitsTable* table = file.table("POINT SPREAD FUNCTION");
 
-    // Set offset angle axis to radians
-    m_psf.axis_radians(1);
+        // Read PSF table
+        m_psf.read(table);
 
-    // Convert sigma parameters to radians
-    m_psf.scale(1, deg2rad);
-    m_psf.scale(3, deg2rad);
-    m_psf.scale(5, deg2rad);
+        // Check number of PSF parameters
+        if (m_psf.size() != G_PSF2D_NPARS) {
+            std::string message = "PSF table has "+str(m_psf.size())+
+                                  " parameters (expected "+str(G_PSF2D_NPARS)+
+                                  ").";
+            throw GCTAException::bad_rsp_table_format(G_LOAD, message);
+        }
+
+        // Set energy axis to logarithmic scale
+        m_psf.axis_log10(0);
+
+        // Set offset angle axis to radians
+        m_psf.axis_radians(1);
+
+        // Convert sigma parameters to radians
+        m_psf.scale(1, deg2rad);
+        m_psf.scale(3, deg2rad);
+        m_psf.scale(5, deg2rad);
+
+        // Close PSF FITS file
+        file.close();
+
+        // Store PSF table in binary cache file
+        if (!cachefile.empty()) {
+            m_psf.save_binary(cachefile);
+        }
 
-    // Close PSF FITS file
-    file.close();
+    } // endif: PSF table was not found in binary cache file
 
     // Store filename
     m_filename = filename;
@@ -318,21 +343,21 @@ double GCTAPsf2D::mc(GRan&         ran,
                      const double& azimuth,
                      const bool&   etrue) const
 {
-    // Update the parameter cache
-    update(logE, theta);
+    // Compute PSF parameters
+    pars par = parameters(logE, theta);
 
     // Select in which Gaussian we are
-    double sigma = m_sigma1;
-    double sum1  = m_sigma1;
-    double sum2  = m_sigma2 * m_norm2;
-    double sum3  = m_sigma3 * m_norm3;
+    double sigma = par.sigma1;
+    double sum1  = par.sigma1;
+    double sum2  = par.sigma2 * par.norm2;
+    double sum3  = par.sigma3 * par.norm3;
     double sum   = sum1 + sum2 + sum3;
     double u     = ran.uniform() * sum;
     if (u >= sum2) {
-        sigma = m_sigma3;
+        sigma = par.sigma3;
     }
     else if (u >= sum1) {
-        sigma = m_sigma2;
+        sigma = par.sigma2;
     }
 
     // Now draw from the selected Gaussian
@@ -364,13 +389,13 @@ double GCTAPsf2D::delta_max(const double& logE,
                             const double& azimuth,
                             const bool&   etrue) const
 {
-    // Update the parameter cache
-    update(logE, theta);
+    // Compute PSF parameters
+    pars par = parameters(logE, theta);
 
     // Compute maximum sigma
-    double sigma = m_sigma1;
-    if (m_sigma2 > sigma) sigma = m_sigma2;
-    if (m_sigma3 > sigma) sigma = m_sigma3;
+    double sigma = par.sigma1;
+    if (par.sigma2 > sigma) sigma = par.sigma2;
+    if (par.sigma3 > sigma) sigma = par.sigma3;
 
     // Compute maximum PSF radius
     double radius = 5.0 * sigma;
@@ -414,17 +439,6 @@ void GCTAPsf2D::init_members(void)
     // Initialise members
     m_filename.clear();
     m_psf.clear();
-    m_par_logE  = -1.0e30;
-    m_par_theta = -1.0;
-    m_norm      = 1.0;
-    m_norm2     = 0.0;
-    m_norm3     = 0.0;
-    m_sigma1    = 0.0;
-    m_sigma2    = 0.0;
-    m_sigma3    = 0.0;
-    m_width1    = 0.0;
-    m_width2    = 0.0;
-    m_width3    = 0.0;
 
     // Return
     return;
@@ -439,19 +453,8 @@ void GCTAPsf2D::init_members(void)
 void GCTAPsf2D::copy_members(const GCTAPsf2D& psf)
 {
     // Copy members
-    m_filename  = psf.m_filename;
-    m_psf       = psf.m_psf;
-    m_par_logE  = psf.m_par_logE;
-    m_par_theta = psf.m_par_theta;
-    m_norm      = psf.m_norm;
-    m_norm2     = psf.m_norm2;
-    m_norm3     = psf.m_norm3;
-    m_sigma1    = psf.m_sigma1;
-    m_sigma2    = psf.m_sigma2;
-    m_sigma3    = psf.m_sigma3;
-    m_width1    = psf.m_width1;
-    m_width2    = psf.m_width2;
-    m_width3    = psf.m_width3;
+    m_filename = psf.m_filename;
+    m_psf      = psf.m_psf;
 
     // Return
     return;
@@ -469,69 +472,67 @@ void GCTAPsf2D::free_members(void)
 
 
 /***********************************************************************//**
- * @brief Update PSF parameter cache
+ * @brief Compute PSF parameters
  *
  * @param[in] logE Log10 of the true photon energy (TeV).
  * @param[in] theta Offset angle in camera system (rad).
+ * @return PSF parameters.
  *
- * This method updates the PSF parameter cache.
+ * Interpolates the PSF response table at the given energy and offset angle
+ * and derives the Gaussian widths and normalizations from it.
  ***************************************************************************/
-void GCTAPsf2D::update(const double& logE, const double& theta) const
+GCTAPsf2D::pars GCTAPsf2D::parameters(const double& logE,
+                                      const double& theta) const
 {
-    // Only compute PSF parameters if arguments have changed
-    if (logE != m_par_logE || theta != m_par_theta) {
-
-        // Save parameters
-        m_par_logE  = logE;
-        m_par_theta = theta;
-
-        // Interpolate response parameters
-        std::vector<double> pars = m_psf(logE, theta);
-
-        // Set Gaussian sigmas
-        m_sigma1 = pars[1];
-        m_sigma2 = pars[3];
-        m_sigma3 = pars[5];
-
-        // Set width parameters
-        double sigma1 = m_sigma1 * m_sigma1;
-        double sigma2 = m_sigma2 * m_sigma2;
-        double sigma3 = m_sigma3 * m_sigma3;
-
-        // Compute Gaussian 1
-        if (sigma1 > 0.0) {
-            m_width1 = -0.5 / sigma1;
-        }
-        else {
-            m_width1 = 0.0;
-        }
-
-        // Compute Gaussian 2
-        if (sigma2 > 0.0) {
-            m_width2 = -0.5 / sigma2;
-            m_norm2  = pars[2];
-        }
-        else {
-            m_width2 = 0.0;
-            m_norm2  = 0.0;
-        }
-
-        // Compute Gaussian 3
-        if (sigma3 > 0.0) {
-            m_width3 = -0.5 / sigma3;
-            m_norm3  = pars[4];
-        }
-        else {
-            m_width3 = 0.0;
-            m_norm3  = 0.0;
-        }
+    // Initialise PSF parameters
+    pars par;
+
+    // Interpolate response parameters
+    double table[G_PSF2D_NPARS];
+    m_psf.lookup(logE, theta, table);
+
+    // Set Gaussian sigmas
+    par.sigma1 = table[1];
+    par.sigma2 = table[3];
+    par.sigma3 = table[5];
+
+    // Set width parameters
+    double sigma1 = par.sigma1 * par.sigma1;
+    double sigma2 = par.sigma2 * par.sigma2;
+    double sigma3 = par.sigma3 * par.sigma3;
+
+    // Compute Gaussian 1
+    if (sigma1 > 0.0) {
+        par.width1 = -0.5 / sigma1;
+    }
+    else {
+        par.width1 = 0.0;
+    }
 
-        // Compute global normalization parameter
-        double integral = twopi * (sigma1 + sigma2*m_norm2 + sigma3*m_norm3);
-        m_norm = (integral > 0.0) ? 1.0 / integral : 0.0;
+    // Compute Gaussian 2
+    if (sigma2 > 0.0) {
+        par.width2 = -0.5 / sigma2;
+        par.norm2  = table[2];
+    }
+    else {
+        par.width2 = 0.0;
+        par.norm2  = 0.0;
+    }
 
+    // Compute Gaussian 3
+    if (sigma3 > 0.0) {
+        par.width3 = -0.5 / sigma3;
+        par.norm3  = table[4];
+    }
+    else {
+        par.width3 = 0.0;
+        par.norm3  = 0.0;
     }
 
-    // Return
-    return;
+    // Compute global normalization parameter
+    double integral = twopi * (sigma1 + sigma2*par.norm2 + sigma3*par.norm3);
+    par.norm = (integral > 0.0) ? 1.0 / integral : 0.0;
+
+    // Return PSF parameters
+    return par;
 }
@@ -0,0 +1,543 @@
+/***************************************************************************
+ *       GCTARadialTemplate.cpp - CTA radial model response template       *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GCTARadialTemplate.cpp
+ * @brief CTA radial model response template class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <cmath>
+#include "GCTARadialTemplate.hpp"
+#include "GException.hpp"
+#include "GTools.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_CONSTRUCT "GCTARadialTemplate::GCTARadialTemplate(double&, double&,"\
+                                          " double&, int&, int&, int&)"
+#define G_FILL   "GCTARadialTemplate::fill(int&, std::vector<double>&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                         Constructors/destructors                        =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GCTARadialTemplate::GCTARadialTemplate(void)
+{
+    // Initialise class members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Grid constructor
+ *
+ * @param[in] zeta_max Maximum distance between event and model centre
+ *                     (radians).
+ * @param[in] emin log10 of minimum energy (TeV).
+ * @param[in] emax log10 of maximum energy (TeV).
+ * @param[in] nzeta Number of zeta nodes (>=2).
+ * @param[in] nomega Number of omega0 nodes (>=1).
+ * @param[in] neng Number of energy nodes (>=2).
+ *
+ * @exception GException::invalid_argument
+ *            Invalid grid specified.
+ *
+ * Allocates an empty template with nzeta zeta nodes in [0,zeta_max],
+ * nomega azimuth nodes in [0,pi] and neng logarithmic energy nodes in
+ * [emin,emax]. A single azimuth node can be used if the model centre
+ * coincides with the pointing direction.
+ ***************************************************************************/
+GCTARadialTemplate::GCTARadialTemplate(const double& zeta_max,
+                                       const double& emin,
+                                       const double& emax,
+                                       const int&    nzeta,
+                                       const int&    nomega,
+                                       const int&    neng)
+{
+    // Throw an exception if the grid is invalid
+    if (zeta_max <= 0.0 || emax <= emin || nzeta < 2 || nomega < 1 ||
+        neng < 2) {
+        throw GException::invalid_argument(G_CONSTRUCT,
+              "Invalid template grid (zeta_max="+str(zeta_max)+
+              ", emin="+str(emin)+", emax="+str(emax)+
+              ", nzeta="+str(nzeta)+", nomega="+str(nomega)+
+              ", neng="+str(neng)+").");
+    }
+
+    // Initialise class members
+    init_members();
+
+    // Set grid
+    m_nzeta    = nzeta;
+    m_nomega   = nomega;
+    m_neng     = neng;
+    m_zeta_max = zeta_max;
+    m_dzeta    = zeta_max / double(nzeta-1);
+    m_domega   = (nomega > 1) ? pi / double(nomega-1) : 0.0;
+    m_logE_min = emin;
+    m_dlogE    = (emax - emin) / double(neng-1);
+
+    // Allocate rows
+    m_values.assign(nzeta*nomega*neng, 0.0);
+    m_filled.assign(nomega*neng, 0);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] tpl Radial response template.
+ ***************************************************************************/
+GCTARadialTemplate::GCTARadialTemplate(const GCTARadialTemplate& tpl)
+{
+    // Initialise class members
+    init_members();
+
+    // Copy members
+    copy_members(tpl);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GCTARadialTemplate::~GCTARadialTemplate(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                                Operators                                =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] tpl Radial response template.
+ * @return Radial response template.
+ ***************************************************************************/
+GCTARadialTemplate& GCTARadialTemplate::operator= (const GCTARadialTemplate& tpl)
+{
+    // Execute only if object is not identical
+    if (this != &tpl) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members
+        init_members();
+
+        // Copy members
+        copy_members(tpl);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear radial response template
+ ***************************************************************************/
+void GCTARadialTemplate::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone radial response template
+ *
+ * @return Pointer to deep copy of radial response template.
+ ***************************************************************************/
+GCTARadialTemplate* GCTARadialTemplate::clone(void) const
+{
+    return new GCTARadialTemplate(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Return zeta value of node
+ *
+ * @param[in] index Zeta node index [0,...,nzeta()-1].
+ * @return Distance between event and model centre (radians).
+ ***************************************************************************/
+double GCTARadialTemplate::zeta(const int& index) const
+{
+    // Return zeta
+    return (index * m_dzeta);
+}
+
+
+/***********************************************************************//**
+ * @brief Return azimuth angle of row
+ *
+ * @param[in] row Row index [0,...,size()-1].
+ * @return Azimuth angle of pointing in model system (radians).
+ ***************************************************************************/
+double GCTARadialTemplate::omega(const int& row) const
+{
+    // Return omega0
+    return ((row % m_nomega) * m_domega);
+}
+
+
+/***********************************************************************//**
+ * @brief Return energy of row
+ *
+ * @param[in] row Row index [0,...,size()-1].
+ * @return log10 of energy (TeV).
+ ***************************************************************************/
+double GCTARadialTemplate::logE(const int& row) const
+{
+    // Return log10 energy
+    return (m_logE_min + (row / m_nomega) * m_dlogE);
+}
+
+
+/***********************************************************************//**
+ * @brief Check if energy is covered by template
+ *
+ * @param[in] logE log10 of energy (TeV).
+ * @return True if energy is covered by template.
+ ***************************************************************************/
+bool GCTARadialTemplate::contains(const double& logE) const
+{
+    // Return containment flag
+    return (m_neng > 1 && logE >= m_logE_min &&
+            logE <= m_logE_min + (m_neng-1) * m_dlogE);
+}
+
+
+/***********************************************************************//**
+ * @brief Return rows needed for interpolation
+ *
+ * @param[in] omega0 Azimuth angle of pointing in model system (radians).
+ * @param[in] logE log10 of energy (TeV).
+ * @param[out] rows Row indices (4 elements).
+ *
+ * Returns the indices of the four rows that bracket the azimuth angle
+ * omega0 and the energy logE. The energy must be covered by the template.
+ ***************************************************************************/
+void GCTARadialTemplate::rows(const double& omega0,
+                              const double& logE,
+                              int*          rows) const
+{
+    // Get left energy node
+    int ieng = int((logE - m_logE_min) / m_dlogE);
+    if (ieng > m_neng-2) {
+        ieng = m_neng-2;
+    }
+    if (ieng < 0) {
+        ieng = 0;
+    }
+
+    // Get left and right omega0 nodes
+    int iomega = 0;
+    int jomega = 0;
+    if (m_nomega > 1) {
+        iomega = int(omega0 / m_domega);
+        if (iomega > m_nomega-2) {
+            iomega = m_nomega-2;
+        }
+        if (iomega < 0) {
+            iomega = 0;
+        }
+        jomega = iomega + 1;
+    }
+
+    // Set rows
+    rows[0] = ieng     * m_nomega + iomega;
+    rows[1] = ieng     * m_nomega + jomega;
+    rows[2] = (ieng+1) * m_nomega + iomega;
+    rows[3] = (ieng+1) * m_nomega + jomega;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Check if row has been filled
+ *
+ * @param[in] row Row index [0,...,size()-1].
+ * @return True if row has been filled.
+ ***************************************************************************/
+bool GCTARadialTemplate::isfilled(const int& row) const
+{
+    // Return flag
+    return (m_filled[row] != 0);
+}
+
+
+/***********************************************************************//**
+ * @brief Fill row
+ *
+ * @param[in] row Row index [0,...,size()-1].
+ * @param[in] values Response values at the zeta nodes (nzeta() elements).
+ *
+ * @exception GException::out_of_range
+ *            Row index is out of range.
+ * @exception GException::invalid_argument
+ *            Number of values does not correspond to number of zeta nodes.
+ *
+ * Stores the response values for the azimuth angle omega(row) and the
+ * energy logE(row) at the zeta nodes zeta(0),...,zeta(nzeta()-1) and
+ * flags the row as filled.
+ ***************************************************************************/
+void GCTARadialTemplate::fill(const int& row, const std::vector<double>& values)
+{
+    // Throw an exception if row is out of range
+    if (row < 0 || row >= size()) {
+        throw GException::out_of_range(G_FILL, row, 0, size()-1);
+    }
+
+    // Throw an exception if the number of values is invalid
+    if (values.size() != m_nzeta) {
+        throw GException::invalid_argument(G_FILL,
+              "Expected "+str(m_nzeta)+" values but "+str(values.size())+
+              " values were specified.");
+    }
+
+    // Store values
+    double* ptr = &(m_values[row * m_nzeta]);
+    for (int i = 0; i < m_nzeta; ++i) {
+        ptr[i] = values[i];
+    }
+
+    // Flag row as filled
+    m_filled[row] = 1;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Interpolate response
+ *
+ * @param[in] zeta Distance between event and model centre (radians).
+ * @param[in] omega0 Azimuth angle of pointing in model system (radians).
+ * @param[in] logE log10 of energy (TeV).
+ * @return Response value.
+ *
+ * Returns the response by trilinear interpolation of the template. The
+ * rows returned by rows() for omega0 and logE need to be filled. The
+ * response vanishes beyond the maximum zeta of the template.
+ ***************************************************************************/
+double GCTARadialTemplate::interpolate(const double& zeta,
+                                       const double& omega0,
+                                       const double& logE) const
+{
+    // Initialise response
+    double value = 0.0;
+
+    // Continue only if zeta is within template
+    if (zeta <= m_zeta_max) {
+
+        // Get rows
+        int irows[4];
+        rows(omega0, logE, irows);
+
+        // Compute energy weight
+        double weng = (logE - this->logE(irows[0])) / m_dlogE;
+
+        // Compute azimuth weight
+        double womega = (m_nomega > 1)
+                        ? (omega0 - omega(irows[0])) / m_domega : 0.0;
+
+        // Interpolate
+        double v0 = (1.0-womega) * interpolate_row(irows[0], zeta) +
+                    womega       * interpolate_row(irows[1], zeta);
+        double v1 = (1.0-womega) * interpolate_row(irows[2], zeta) +
+                    womega       * interpolate_row(irows[3], zeta);
+        value     = (1.0-weng) * v0 + weng * v1;
+
+    } // endif: zeta was within template
+
+    // Return response
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Print radial response template information
+ *
+ * @return String containing radial response template information.
+ ***************************************************************************/
+std::string GCTARadialTemplate::print(void) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Count filled rows
+    int nfilled = 0;
+    for (int i = 0; i < m_filled.size(); ++i) {
+        if (m_filled[i] != 0) {
+            nfilled++;
+        }
+    }
+
+    // Append information
+    result.append("=== GCTARadialTemplate ===");
+    result.append("\n"+parformat("Number of zeta nodes")+str(m_nzeta));
+    result.append("\n"+parformat("Number of omega0 nodes")+str(m_nomega));
+    result.append("\n"+parformat("Number of energy nodes")+str(m_neng));
+    result.append("\n"+parformat("Maximum zeta")+str(m_zeta_max*rad2deg)+" deg");
+    result.append("\n"+parformat("Filled rows")+str(nfilled)+" of "+str(size()));
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GCTARadialTemplate::init_members(void)
+{
+    // Initialise members
+    m_nzeta    = 0;
+    m_nomega   = 0;
+    m_neng     = 0;
+    m_zeta_max = 0.0;
+    m_dzeta    = 0.0;
+    m_domega   = 0.0;
+    m_logE_min = 0.0;
+    m_dlogE    = 0.0;
+    m_values.clear();
+    m_filled.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] tpl Radial response template.
+ ***************************************************************************/
+void GCTARadialTemplate::copy_members(const GCTARadialTemplate& tpl)
+{
+    // Copy members
+    m_nzeta    = tpl.m_nzeta;
+    m_nomega   = tpl.m_nomega;
+    m_neng     = tpl.m_neng;
+    m_zeta_max = tpl.m_zeta_max;
+    m_dzeta    = tpl.m_dzeta;
+    m_domega   = tpl.m_domega;
+    m_logE_min = tpl.m_logE_min;
+    m_dlogE    = tpl.m_dlogE;
+    m_values   = tpl.m_values;
+    m_filled   = tpl.m_filled;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GCTARadialTemplate::free_members(void)
+{
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Linearly interpolate response within a row
+ *
+ * @param[in] row Row index.
+ * @param[in] zeta Distance between event and model centre (radians).
+ * @return Response value.
+ ***************************************************************************/
+double GCTARadialTemplate::interpolate_row(const int& row, const double& zeta) const
+{
+    // Get left zeta node
+    int i = int(zeta / m_dzeta);
+    if (i > m_nzeta-2) {
+        i = m_nzeta-2;
+    }
+
+    // Compute weight
+    double w = zeta / m_dzeta - double(i);
+
+    // Interpolate
+    const double* ptr = &(m_values[row * m_nzeta + i]);
+    double value      = (1.0-w) * ptr[0] + w * ptr[1];
+
+    // Return value
+    return value;
+}
@@ -31,9 +31,11 @@
 #include <cmath>
 #include <vector>
 #include <string>
+#include <sstream>
 #include "GFits.hpp"
 #include "GTools.hpp"
 #include "GIntegral.hpp"
+#include "GIntegrals.hpp"
 #include "GCaldb.hpp"
 #include "GModelSpatialRadial.hpp"
 #include "GModelSpatialElliptical.hpp"
@@ -46,6 +48,7 @@
 #include "GCTAException.hpp"
 #include "GCTASupport.hpp"
 #include "GCTADir.hpp"
+#include "GCTAIrfCache.hpp"
 #include "GCTAAeff2D.hpp"
 #include "GCTAAeffArf.hpp"
 #include "GCTAAeffPerfTable.hpp"
@@ -73,6 +76,8 @@
 #define G_NPRED_DIFFUSE               "GCTAResponse::npred_diffuse(GSource&,"\
                                                             " GObservation&)"
 #define G_READ           "GCTAResponse::read_performance_table(std::string&)"
+#define G_RADIAL_TEMPLATE_NODES   "GCTAResponse::radial_template_nodes(int&,"\
+                                                            " int&, int&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -605,64 +610,25 @@ void GCTAResponse::load(const std::string& irfname)
  *
  * @param[in] filename Effective area filename.
  *
- * This method allocates an effective area instance and load the effective
- * area information from a response file. The following response file formats
- * are supported:
- *
- * (1) A CTA performance table. This is an ASCII file which specifies the
- *     on-axis effective area as function of energy.
- *
- * (2) A ARF FITS file. This is a FITS file which stores the effective area
- *     in a vector.
- *
- * (3) A CTA response table. This is a FITS file which specifies the
- *     effective area as function of energy and offset angle.
- *
- * This method examines the file, and depending on the detected format,
- * allocates the appropriate effective area class and loads the data.
- *
- * First, the method checks whether the file is a FITS file or not. If the
- * file is not a FITS file, it is assumed that the file is an ASCII
- * performance table. If the file is a FITS file, the number of rows found
- * in the table is used to distinguish between an ARF (multiple rows) and
- * a CTA response table (single row).
- *
- * @todo Implement a method that checks if a file is a FITS file instead
- *       of using try-catch.
+ * This method obtains the effective area from the CTA instrument response
+ * cache, which loads the response file only if the effective area has not
+ * yet been loaded in the process. See GCTAIrfCache::load_aeff() for the
+ * supported response file formats.
  ***************************************************************************/
 void GCTAResponse::load_aeff(const std::string& filename)
 {
+    // Allocate instrument response cache
+    GCTAIrfCache cache;
+
     // Free any existing effective area instance
-    if (m_aeff != NULL) delete m_aeff;
+    cache.release(m_aeff);
     m_aeff = NULL;
-    
-    // Try opening the file as a FITS file
-    try {
-    
-        // Open FITS file
-        GFits file(filename);
-
-        // If file contains an "EFFECTIVE AREA" extension then load it
-        // as CTA response table
-        if (file.hashdu("EFFECTIVE AREA")) {
-            file.close();
-            m_aeff = new GCTAAeff2D(filename);
-        }
 
-        // ... else if file contains a "SPECRESP" extension then load it
-        // as ARF
-        else if (file.hashdu("SPECRESP")) {
-            file.close();
-            m_aeff = new GCTAAeffArf(filename);
-        }
-
-    }
+    // Discard radial model templates
+    m_templates.clear();
 
-    // If FITS file opening failed then assume that we have a performance
-    // table
-    catch (GException::fits_open_error &e) {
-        m_aeff = new GCTAAeffPerfTable(filename);
-    }
+    // Get effective area
+    m_aeff = cache.aeff(filename);
 
     // Return
     return;
@@ -674,58 +640,25 @@ void GCTAResponse::load_aeff(const std::string& filename)
  *
  * @param[in] filename FITS file name.
  *
- * This method loads CTA PSF information from a FITS table. Two FITS file
- * formats are supported by the method:
- *
- * (1) A PSF vector, stored in a format similar to an ARF vector. It is
- * expected that this format is only a preliminary format that will
- * disappear in the future (m_psf_version=-9).
- *
- * (2) A PSF response table, where PSF parameters are given as function of
- * energy, offset angle, and eventually some other parameters. This format
- * is expected to be the definitive response format for CTA
- * (m_psf_version=-8).
- *
- * This method examines the FITS file, and depending on the detected format,
- * calls the relevant methods. Detection is done by the number of rows that
- * are found in the table. A single row means that we deal with a response
- * table, while multiple rows mean that we deal with a response vector.
- *
- * @todo Implement a method that checks if a file is a FITS file instead
- *       of using try-catch.
+ * This method obtains the point spread function from the CTA instrument
+ * response cache, which loads the response file only if the point spread
+ * function has not yet been loaded in the process. See
+ * GCTAIrfCache::load_psf() for the supported response file formats.
  ***************************************************************************/
 void GCTAResponse::load_psf(const std::string& filename)
 {
+    // Allocate instrument response cache
+    GCTAIrfCache cache;
+
     // Free any existing point spread function instance
-    if (m_psf != NULL) delete m_psf;
+    cache.release(m_psf);
     m_psf = NULL;
-    
-    // Try opening the file as a FITS file
-    try {
-    
-        // Open FITS file
-        GFits file(filename);
-
-        // If file contains a "POINT SPREAD FUNCTION" extension then load it
-        // as CTA response table
-        if (file.hashdu("POINT SPREAD FUNCTION")) {
-            file.close();
-            m_psf = new GCTAPsf2D(filename);
-        }
 
-        // ... else load it has PSF vector 
-        else {
-            file.close();
-            m_psf = new GCTAPsfVector(filename);
-        }
+    // Discard radial model templates
+    m_templates.clear();
 
-    }
-
-    // If FITS file opening failed then assume that we have a performance
-    // table
-    catch (GException::fits_open_error &e) {
-        m_psf = new GCTAPsfPerfTable(filename);
-    }
+    // Get point spread function
+    m_psf = cache.psf(filename);
 
     // Return
     return;
@@ -756,6 +689,9 @@ void GCTAResponse::offset_sigma(const double& sigma)
         prf->sigma(sigma);
     }
 
+    // Discard radial model templates
+    m_templates.clear();
+
     // Return
     return;
 }
@@ -793,6 +729,44 @@ double GCTAResponse::offset_sigma(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Set number of radial model template nodes
+ *
+ * @param[in] nzeta Number of nodes in distance from model centre (>=2).
+ * @param[in] nomega Number of nodes in pointing azimuth angle (>=2).
+ * @param[in] neng Number of energy nodes per decade (>=1).
+ *
+ * @exception GException::invalid_argument
+ *            Invalid number of nodes specified.
+ *
+ * Sets the number of nodes of the radial model templates, which
+ * determines the accuracy of the interpolated IRF values (see
+ * irf_radial_template). Existing templates are discarded.
+ ***************************************************************************/
+void GCTAResponse::radial_template_nodes(const int& nzeta,
+                                         const int& nomega,
+                                         const int& neng)
+{
+    // Throw an exception if the number of nodes is invalid
+    if (nzeta < 2 || nomega < 2 || neng < 1) {
+        throw GException::invalid_argument(G_RADIAL_TEMPLATE_NODES,
+              "Invalid number of template nodes (nzeta="+str(nzeta)+
+              ", nomega="+str(nomega)+", neng="+str(neng)+").");
+    }
+
+    // Set number of nodes
+    m_tpl_nzeta  = nzeta;
+    m_tpl_nomega = nomega;
+    m_tpl_neng   = neng;
+
+    // Discard existing templates
+    m_templates.clear();
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print CTA response information
  ***************************************************************************/
@@ -867,6 +841,19 @@ std::string GCTAResponse::print(void) const
  * direction). Given the slow variation of the PSF shape over the field of
  * view, this approximation should be fine. It helps in fact a lot in
  * speeding up the computations.
+ *
+ * If the model has free parameters with analytical gradients (see
+ * GModelSpatialRadial::eval_gradients), the gradients of the IRF value
+ * with respect to these parameters are integrated in the same pass as
+ * the IRF value and stored as factor gradients in the model parameters.
+ * This avoids the repeated integrations that are needed for numerical
+ * gradients. If the integration extends to the model boundary theta_max(),
+ * the boundary term of the gradients is added (see
+ * GModelSpatialRadial::theta_max_gradient).
+ *
+ * If radial model templates are enabled (see radial_templates()) and all
+ * model parameters are fixed, the IRF value is interpolated from a
+ * template of the model convolved with the IRF (see irf_radial_template).
  ***************************************************************************/
 double GCTAResponse::irf_radial(const GEvent&       event,
                                 const GSource&      source,
@@ -934,69 +921,42 @@ double GCTAResponse::irf_radial(const GEvent&       event,
     double srcLogEng = srcEng.log10TeV();
     double obsLogEng = obsEng.log10TeV();
 
-    // Assign the observed theta angle (eta) as the true theta angle
-    // between the source and the pointing directions. This is a (not
-    // too bad) approximation which helps to speed up computations.
-    // If we want to do this correctly, however, we would need to move
-    // the psf_dummy_sigma down to the integration kernel, and we would
-    // need to make sure that psf_delta_max really gives the absolute
-    // maximum (this is certainly less critical)
-    double theta = eta;
-    double phi   = 0.0; //TODO: Implement IRF Phi dependence
-
-    // Get maximum PSF and source radius in radians.
-    double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
-    double src_max   = model->theta_max();
-
-    // Set radial model zenith angle range
-    double rho_min = (zeta > delta_max) ? zeta - delta_max : 0.0;
-    double rho_max = zeta + delta_max;
-    if (rho_max > src_max) {
-        rho_max = src_max;
+    // Collect free model parameters that have analytical gradients and
+    // reset their gradients (circumvent const correctness for setting the
+    // gradients)
+    GModelSpatialRadial* ptr = const_cast<GModelSpatialRadial*>(model);
+    std::vector<int>     pars;
+    for (int i = 0; i < model->size(); ++i) {
+        if ((*model)[i].hasgrad()) {
+            (*ptr)[i].factor_gradient(0.0);
+            if ((*model)[i].isfree()) {
+                pars.push_back(i);
+            }
+        }
     }
 
-    // Initialise IRF value
-    double irf = 0.0;
-
-    // Perform zenith angle integration if interval is valid
-    if (rho_max > rho_min) {
-
-        // Setup integration kernel
-        cta_irf_radial_kern_rho integrand(this,
-                                          model,
-                                          zenith,
-                                          azimuth,
-                                          srcLogEng,
-                                          obsLogEng,
-                                          zeta,
-                                          lambda,
-                                          omega0,
-                                          delta_max);
-
-        // Integrate over zenith angle
-        GIntegral integral(&integrand);
-        integral.eps(m_eps);
-        irf = integral.romb(rho_min, rho_max);
-
-        // Compile option: Check for NaN/Inf
-        #if defined(G_NAN_CHECK)
-        if (isnotanumber(irf) || isinfinite(irf)) {
-            std::cout << "*** ERROR: GCTAResponse::irf_radial:";
-            std::cout << " NaN/Inf encountered";
-            std::cout << " (irf=" << irf;
-            std::cout << ", rho_min=" << rho_min;
-            std::cout << ", rho_max=" << rho_max;
-            std::cout << ", omega0=" << omega0 << ")";
-            std::cout << std::endl;
+    // If radial model templates are enabled and no gradients are needed
+    // then try to interpolate the IRF from the source template
+    if (m_use_templates && pars.empty()) {
+        bool   valid = false;
+        double irf   = irf_radial_template(source, model, obs, zenith, azimuth,
+                                           srcLogEng, zeta, lambda, omega0,
+                                           &valid);
+        if (valid) {
+            return irf;
         }
-        #endif
     }
 
+    // Integrate IRF
+    double irf = irf_radial_integral(model, zenith, azimuth, srcLogEng,
+                                     obsLogEng, zeta, lambda, omega0, eta,
+                                     pars);
+
     // Compile option: Show integration results
     #if defined(G_DEBUG_IRF_RADIAL)
     std::cout << "GCTAResponse::irf_radial:";
-    std::cout << " rho_min=" << rho_min;
-    std::cout << " rho_max=" << rho_max;
+    std::cout << " zeta=" << zeta;
+    std::cout << " omega0=" << omega0;
     std::cout << " irf=" << irf << std::endl;
     #endif
 
@@ -1144,9 +1104,7 @@ double GCTAResponse::irf_elliptical(const GEvent&       event,
                                               delta_max);
 
         // Integrate over zenith angle
-        GIntegral integral(&integrand);
-        integral.eps(m_eps);
-        irf = integral.romb(rho_min, rho_max);
+        irf = cta_integrate(this, &integrand, rho_min, rho_max);
 
         // Compile option: Check for NaN/Inf
         #if defined(G_NAN_CHECK)
@@ -2087,6 +2045,12 @@ void GCTAResponse::init_members(void)
     m_aeff  = NULL;
     m_psf   = NULL;
     m_edisp = NULL;
+    m_use_templates = false;
+    m_use_gkq       = false;
+    m_tpl_nzeta     = 80;
+    m_tpl_nomega    = 5;
+    m_tpl_neng      = 10;
+    m_templates.clear();
     
     // Return
     return;
@@ -2105,10 +2069,20 @@ void GCTAResponse::copy_members(const GCTAResponse& rsp)
     m_rspname = rsp.m_rspname;
     m_rmffile = rsp.m_rmffile;
     m_eps     = rsp.m_eps;
-
-    // Clone members
-    m_aeff  = (rsp.m_aeff  != NULL) ? rsp.m_aeff->clone()  : NULL;
-    m_psf   = (rsp.m_psf   != NULL) ? rsp.m_psf->clone()   : NULL;
+    m_use_templates = rsp.m_use_templates;
+    m_use_gkq       = rsp.m_use_gkq;
+    m_tpl_nzeta     = rsp.m_tpl_nzeta;
+    m_tpl_nomega    = rsp.m_tpl_nomega;
+    m_tpl_neng      = rsp.m_tpl_neng;
+    m_templates     = rsp.m_templates;
+
+    // Clone members. Effective area and point spread function are copied
+    // through the instrument response cache so that shared responses are
+    // not duplicated and copies of cached responses are accounted to the
+    // cache.
+    GCTAIrfCache cache;
+    m_aeff  = cache.copy(rsp.m_aeff);
+    m_psf   = cache.copy(rsp.m_psf);
     m_edisp = (rsp.m_edisp != NULL) ? rsp.m_edisp->clone() : NULL;
 
     // Return
@@ -2122,8 +2096,9 @@ void GCTAResponse::copy_members(const GCTAResponse& rsp)
 void GCTAResponse::free_members(void)
 {
     // Free memory
-    if (m_aeff  != NULL) delete m_aeff;
-    if (m_psf   != NULL) delete m_psf;
+    GCTAIrfCache cache;
+    cache.release(m_aeff);
+    cache.release(m_psf);
     if (m_edisp != NULL) delete m_edisp;
 
     // Initialise pointers
@@ -2134,3 +2109,296 @@ void GCTAResponse::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Integrate IRF for radial source model
+ *
+ * @param[in] model Radial model.
+ * @param[in] zenith Zenith angle of pointing (radians).
+ * @param[in] azimuth Azimuth angle of pointing (radians).
+ * @param[in] srcLogEng log10 of true photon energy (TeV).
+ * @param[in] obsLogEng log10 of measured photon energy (TeV).
+ * @param[in] zeta Distance between event and model centre (radians).
+ * @param[in] lambda Distance between model centre and pointing (radians).
+ * @param[in] omega0 Azimuth angle of pointing in model system (radians).
+ * @param[in] eta Distance between event and pointing (radians).
+ * @param[in] pars Indices of parameters with analytical gradients.
+ * @return IRF value.
+ *
+ * Integrates the model times IRF over the true photon arrival direction
+ * (see irf_radial). If @p pars is not empty, the gradients with respect
+ * to the specified model parameters are integrated in the same pass and
+ * stored as factor gradients in the model parameters.
+ ***************************************************************************/
+double GCTAResponse::irf_radial_integral(const GModelSpatialRadial* model,
+                                         const double&              zenith,
+                                         const double&              azimuth,
+                                         const double&              srcLogEng,
+                                         const double&              obsLogEng,
+                                         const double&              zeta,
+                                         const double&              lambda,
+                                         const double&              omega0,
+                                         const double&              eta,
+                                         const std::vector<int>&    pars) const
+{
+    // Assign the observed theta angle (eta) as the true theta angle
+    // between the source and the pointing directions. This is a (not
+    // too bad) approximation which helps to speed up computations.
+    // If we want to do this correctly, however, we would need to move
+    // the psf_dummy_sigma down to the integration kernel, and we would
+    // need to make sure that psf_delta_max really gives the absolute
+    // maximum (this is certainly less critical)
+    double theta = eta;
+    double phi   = 0.0; //TODO: Implement IRF Phi dependence
+
+    // Get maximum PSF and source radius in radians.
+    double delta_max = psf_delta_max(theta, phi, zenith, azimuth, srcLogEng);
+    double src_max   = model->theta_max();
+
+    // Set radial model zenith angle range
+    double rho_min = (zeta > delta_max) ? zeta - delta_max : 0.0;
+    double rho_max = zeta + delta_max;
+    bool   src_end = (rho_max > src_max);
+    if (src_end) {
+        rho_max = src_max;
+    }
+
+    // Initialise IRF value
+    double irf = 0.0;
+
+    // Perform zenith angle integration if interval is valid
+    if (rho_max > rho_min) {
+
+        // Setup integration kernel
+        cta_irf_radial_kern_rho integrand(this,
+                                          model,
+                                          zenith,
+                                          azimuth,
+                                          srcLogEng,
+                                          obsLogEng,
+                                          zeta,
+                                          lambda,
+                                          omega0,
+                                          delta_max);
+
+        // If there are no parameter gradients then integrate over zenith
+        // angle ...
+        if (pars.empty()) {
+            irf = cta_integrate(this, &integrand, rho_min, rho_max);
+        }
+
+        // ... otherwise integrate IRF and parameter gradients over zenith
+        // angle in a single pass and set the parameter gradients
+        // (circumvent const correctness). If the integration ends at the
+        // model boundary, the boundary term K(rho_max) d(rho_max)/dp is
+        // added to the gradients.
+        else {
+            GModelSpatialRadial* ptr = const_cast<GModelSpatialRadial*>(model);
+            cta_irf_radial_kern_rho_grad integrands(integrand, model, pars);
+            GIntegrals integral(&integrands);
+            integral.eps(m_eps);
+            GVector irfs     = integral.romb(rho_min, rho_max);
+            double  boundary = (src_end) ? integrand.eval(rho_max) : 0.0;
+            irf              = irfs[0];
+            for (int i = 0; i < pars.size(); ++i) {
+                double grad = irfs[i+1];
+                if (boundary != 0.0) {
+                    grad += boundary * model->theta_max_gradient(pars[i]);
+                }
+                (*ptr)[pars[i]].factor_gradient(grad);
+            }
+        }
+
+        // Compile option: Check for NaN/Inf
+        #if defined(G_NAN_CHECK)
+        if (isnotanumber(irf) || isinfinite(irf)) {
+            std::cout << "*** ERROR: GCTAResponse::irf_radial:";
+            std::cout << " NaN/Inf encountered";
+            std::cout << " (irf=" << irf;
+            std::cout << ", rho_min=" << rho_min;
+            std::cout << ", rho_max=" << rho_max;
+            std::cout << ", omega0=" << omega0 << ")";
+            std::cout << std::endl;
+        }
+        #endif
+    }
+
+    // Return IRF value
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Interpolate IRF for radial source model from template
+ *
+ * @param[in] source Source.
+ * @param[in] model Radial model of source.
+ * @param[in] obs Observation.
+ * @param[in] zenith Zenith angle of pointing (radians).
+ * @param[in] azimuth Azimuth angle of pointing (radians).
+ * @param[in] srcLogEng log10 of true photon energy (TeV).
+ * @param[in] zeta Distance between event and model centre (radians).
+ * @param[in] lambda Distance between model centre and pointing (radians).
+ * @param[in] omega0 Azimuth angle of pointing in model system (radians).
+ * @param[out] valid Signals whether the IRF could be interpolated.
+ * @return IRF value.
+ *
+ * For a given source and observation the IRF of a radial model depends
+ * only on the distance zeta between event and model centre, on the
+ * azimuth angle omega0 of the pointing in the model system, which fixes
+ * the offset angle of the event, and on the photon energy. If all model
+ * parameters are fixed and the response has no energy dispersion, the
+ * IRF is thus interpolated from a GCTARadialTemplate that spans the
+ * energy range of the events of the observation. The template is
+ * created at the first call for a source and its rows are integrated
+ * using irf_radial_integral() when they are first needed.
+ *
+ * Templates are identified by the source name, the model parameters, the
+ * distance between model centre and pointing and the energy range of the
+ * events, hence a template is never modified once it is in use, apart from the
+ * lazy filling of its rows. Template creation and row filling are done
+ * in a critical section, which makes the method thread safe.
+ *
+ * If the IRF can not be interpolated, @p valid is set to false and the
+ * IRF needs to be integrated by the client.
+ ***************************************************************************/
+double GCTAResponse::irf_radial_template(const GSource&             source,
+                                         const GModelSpatialRadial* model,
+                                         const GObservation&        obs,
+                                         const double&              zenith,
+                                         const double&              azimuth,
+                                         const double&              srcLogEng,
+                                         const double&              zeta,
+                                         const double&              lambda,
+                                         const double&              omega0,
+                                         bool*                      valid) const
+{
+    // Initialise IRF value and validity flag
+    double irf = 0.0;
+    *valid     = false;
+
+    // Get events of observation (no template can be built without events)
+    const GEvents* events = NULL;
+    try {
+        events = obs.events();
+    }
+    catch (GException::no_events& e) {
+        events = NULL;
+    }
+
+    // Continue only if there is no energy dispersion, the model has no
+    // free parameters and the observation has an energy range
+    bool fixed = !hasedisp() && events != NULL && events->ebounds().size() > 0;
+    for (int i = 0; i < model->size() && fixed; ++i) {
+        fixed = !(*model)[i].isfree();
+    }
+    if (!fixed) {
+        return irf;
+    }
+
+    // Build template key from source name, model parameters, distance
+    // to pointing and energy range, so that a template is reused only if
+    // it was built for identical conditions
+    std::ostringstream stream;
+    stream.precision(17);
+    stream << source.name();
+    for (int i = 0; i < model->size(); ++i) {
+        stream << ":" << (*model)[i].value();
+    }
+    stream << ":" << lambda;
+    stream << ":" << events->ebounds().emin().MeV();
+    stream << ":" << events->ebounds().emax().MeV();
+    std::string key = stream.str();
+
+    // Get template and rows needed for interpolation. The template is
+    // created if it does not yet exist.
+    GCTARadialTemplate* tpl = NULL;
+    int                 rows[4];
+    bool                filled[4];
+    #pragma omp critical(GCTAResponse_irf_radial_template)
+    {
+        std::map<std::string, GCTARadialTemplate>::iterator it =
+            m_templates.find(key);
+        if (it == m_templates.end()) {
+
+            // Determine template energy range and number of energy nodes
+            double emin  = events->ebounds().emin().log10TeV();
+            double emax  = events->ebounds().emax().log10TeV();
+            int    neng  = int((emax-emin) * m_tpl_neng + 0.5) + 1;
+            if (neng < 2) {
+                neng = 2;
+            }
+
+            // Determine maximum zeta from model radius and largest PSF
+            // radius in the energy range
+            double delta_max = psf_delta_max(lambda, 0.0, zenith, azimuth, emin);
+            double delta     = psf_delta_max(lambda, 0.0, zenith, azimuth, emax);
+            if (delta > delta_max) {
+                delta_max = delta;
+            }
+            double zeta_max = model->theta_max() + delta_max;
+
+            // A single azimuth node is needed if the model centre is at
+            // the pointing direction
+            int nomega = (lambda > 0.0) ? m_tpl_nomega : 1;
+
+            // Insert template
+            it = m_templates.insert(std::make_pair(key,
+                      GCTARadialTemplate(zeta_max, emin, emax,
+                                         m_tpl_nzeta, nomega, neng))).first;
+
+        } // endif: template did not exist
+
+        // Get template and rows
+        tpl = &(it->second);
+        if (tpl->contains(srcLogEng)) {
+            tpl->rows(omega0, srcLogEng, rows);
+            for (int k = 0; k < 4; ++k) {
+                filled[k] = tpl->isfilled(rows[k]);
+            }
+        }
+        else {
+            tpl = NULL;
+        }
+    } // end omp critical
+
+    // Continue only if energy is covered by template
+    if (tpl != NULL) {
+
+        // Fill missing rows by integrating the IRF at the zeta nodes
+        std::vector<int> none;
+        for (int k = 0; k < 4; ++k) {
+            if (!filled[k]) {
+                double              logE  = tpl->logE(rows[k]);
+                double              omega = tpl->omega(rows[k]);
+                std::vector<double> values(tpl->nzeta(), 0.0);
+                for (int i = 0; i < tpl->nzeta(); ++i) {
+                    double z       = tpl->zeta(i);
+                    double cos_eta = std::cos(lambda) * std::cos(z) +
+                                     std::sin(lambda) * std::sin(z) *
+                                     std::cos(omega);
+                    double eta     = arccos(cos_eta);
+                    values[i]      = irf_radial_integral(model, zenith,
+                                                         azimuth, logE, logE,
+                                                         z, lambda, omega,
+                                                         eta, none);
+                }
+                #pragma omp critical(GCTAResponse_irf_radial_template)
+                {
+                    if (!tpl->isfilled(rows[k])) {
+                        tpl->fill(rows[k], values);
+                    }
+                }
+            }
+        }
+
+        // Interpolate IRF
+        irf    = tpl->interpolate(zeta, omega0, srcLogEng);
+        *valid = true;
+
+    } // endif: energy was covered by template
+
+    // Return IRF value
+    return irf;
+}
@@ -29,6 +29,8 @@
 #include <config.h>
 #endif
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include "GTools.hpp"
 #include "GException.hpp"
 #include "GFitsTableFloatCol.hpp"
@@ -55,6 +57,8 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_BINARY_MAGIC   "GCTARSP1"     //!< Binary response table file tag
+#define G_BINARY_ORDER   0x01020304     //!< Binary file byte order marker
 
 /* __ Debug definitions __________________________________________________ */
 
@@ -215,14 +219,8 @@ std::vector<double> GCTAResponseTable::operator()(const double& arg) const
     // Initialise result vector
     std::vector<double> result(num);
     
-    // Set indices and weighting factors for interpolation
-    update(arg);
-
-    // Perform 1D interpolation
-    for (int i = 0; i < num; ++i) {
-        result[i] = m_wgt_left  * m_pars[i][m_inx_left] +
-                    m_wgt_right * m_pars[i][m_inx_right];
-    }
+    // Interpolate parameters
+    lookup(arg, &(result[0]));
     
     // Return result vector
     return result;
@@ -263,16 +261,8 @@ std::vector<double> GCTAResponseTable::operator()(const double& arg1,
     // Initialise result vector
     std::vector<double> result(num);
 
-    // Set indices and weighting factors for interpolation
-    update(arg1, arg2);
-
-    // Perform 2D interpolation
-    for (int i = 0; i < num; ++i) {
-        result[i] = m_wgt1 * m_pars[i][m_inx1] +
-                    m_wgt2 * m_pars[i][m_inx2] +
-                    m_wgt3 * m_pars[i][m_inx3] +
-                    m_wgt4 * m_pars[i][m_inx4];
-    }
+    // Interpolate parameters
+    lookup(arg1, arg2, &(result[0]));
     
     // Return result vector
     return result;
@@ -306,12 +296,14 @@ double GCTAResponseTable::operator()(const int& index, const double& arg) const
     }
     #endif
     
-    // Set indices and weighting factors for interpolation
-    update(arg);
+    // Get indices and weighting factors for interpolation
+    int    inx[2];
+    double wgt[2];
+    weights(arg, inx, wgt);
 
     // Perform 1D interpolation
-    double result = m_wgt_left  * m_pars[index][m_inx_left] +
-                    m_wgt_right * m_pars[index][m_inx_right];
+    const std::vector<double>& par = m_pars[index];
+    double result = wgt[0] * par[inx[0]] + wgt[1] * par[inx[1]];
     
     // Return result
     return result;
@@ -347,14 +339,15 @@ double GCTAResponseTable::operator()(const int& index, const double& arg1,
     }
     #endif
 
-    // Set indices and weighting factors for interpolation
-    update(arg1, arg2);
+    // Get indices and weighting factors for interpolation
+    int    inx[4];
+    double wgt[4];
+    weights(arg1, arg2, inx, wgt);
 
     // Perform 2D interpolation
-    double result = m_wgt1 * m_pars[index][m_inx1] +
-                    m_wgt2 * m_pars[index][m_inx2] +
-                    m_wgt3 * m_pars[index][m_inx3] +
-                    m_wgt4 * m_pars[index][m_inx4];
+    const std::vector<double>& par = m_pars[index];
+    double result = wgt[0] * par[inx[0]] + wgt[1] * par[inx[1]] +
+                    wgt[2] * par[inx[2]] + wgt[3] * par[inx[3]];
     
     // Return result
     return result;
@@ -690,6 +683,100 @@ void GCTAResponseTable::scale(const int& index, const double& scale)
 }
 
 
+/***********************************************************************//**
+ * @brief Linearly interpolate all parameters of a 1D table
+ *
+ * @param[in] arg Value.
+ * @param[out] pars Interpolated response parameters (size() elements).
+ *
+ * Evaluates all response parameters at a given value for a one-dimensional
+ * table and writes them into the caller-owned array @p pars. Contrary to
+ * operator()(const double&), the method allocates no memory. It does not
+ * modify the table, hence it may be called concurrently from several
+ * threads.
+ ***************************************************************************/
+void GCTAResponseTable::lookup(const double& arg, double* pars) const
+{
+    // Get indices and weighting factors for interpolation
+    int    inx[2];
+    double wgt[2];
+    weights(arg, inx, wgt);
+
+    // Perform 1D interpolation
+    for (int i = 0; i < m_npars; ++i) {
+        const std::vector<double>& par = m_pars[i];
+        pars[i] = wgt[0] * par[inx[0]] + wgt[1] * par[inx[1]];
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Bilinearly interpolate all parameters of a 2D table
+ *
+ * @param[in] arg1 Value for first axis.
+ * @param[in] arg2 Value for second axis.
+ * @param[out] pars Interpolated response parameters (size() elements).
+ *
+ * Evaluates all response parameters at a given pair of values for a
+ * two-dimensional table and writes them into the caller-owned array
+ * @p pars. The interpolation indices and weights are computed only once
+ * for all parameters. Contrary to operator()(const double&, const double&),
+ * the method allocates no memory. It does not modify the table, hence it
+ * may be called concurrently from several threads.
+ ***************************************************************************/
+void GCTAResponseTable::lookup(const double& arg1, const double& arg2,
+                               double* pars) const
+{
+    // Get indices and weighting factors for interpolation
+    int    inx[4];
+    double wgt[4];
+    weights(arg1, arg2, inx, wgt);
+
+    // Perform 2D interpolation
+    for (int i = 0; i < m_npars; ++i) {
+        const std::vector<double>& par = m_pars[i];
+        pars[i] = wgt[0] * par[inx[0]] + wgt[1] * par[inx[1]] +
+                  wgt[2] * par[inx[2]] + wgt[3] * par[inx[3]];
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Bilinearly interpolate all parameters of a 2D table for a batch
+ *        of values
+ *
+ * @param[in] num Number of value pairs.
+ * @param[in] arg1 Values for first axis (num elements).
+ * @param[in] arg2 Values for second axis (num elements).
+ * @param[out] pars Interpolated response parameters (num*size() elements).
+ *
+ * Evaluates all response parameters for @p num pairs of values. The
+ * parameters for the pair k are stored in pars[k*size()],...,
+ * pars[k*size()+size()-1]. The method allocates no memory and does not
+ * modify the table, hence it may be called concurrently from several
+ * threads.
+ ***************************************************************************/
+void GCTAResponseTable::lookup(const int&    num,
+                               const double* arg1,
+                               const double* arg2,
+                               double*       pars) const
+{
+    // Loop over value pairs
+    for (int k = 0; k < num; ++k) {
+        lookup(arg1[k], arg2[k], pars + k*m_npars);
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Read response table from FITS table HDU
  *
@@ -774,6 +861,194 @@ void GCTAResponseTable::write(GFitsTable* hdu) const
 }
 
 
+/***********************************************************************//**
+ * @brief Load response table from binary file
+ *
+ * @param[in] filename Binary file name.
+ * @return True if the response table was loaded, false otherwise.
+ *
+ * Loads a response table that has been saved using save_binary(). The
+ * binary file holds the table in the form it has after all axis and
+ * parameter transformations, hence no further processing is needed.
+ *
+ * The method never throws an exception. If the file does not exist, or if
+ * it has not been written by save_binary() on a machine with the same byte
+ * order, the method returns false and the response table is left empty.
+ ***************************************************************************/
+bool GCTAResponseTable::load_binary(const std::string& filename)
+{
+    // Clear instance
+    clear();
+
+    // Open binary file. Return if file could not be opened.
+    std::FILE* fptr = std::fopen(filename.c_str(), "rb");
+    if (fptr == NULL) {
+        return false;
+    }
+
+    // Read and check header
+    char magic[sizeof(G_BINARY_MAGIC)-1];
+    int  order = 0;
+    bool ok    = (std::fread(magic, 1, sizeof(magic), fptr) == sizeof(magic)) &&
+                 (std::memcmp(magic, G_BINARY_MAGIC, sizeof(magic)) == 0) &&
+                 (std::fread(&order, sizeof(int), 1, fptr) == 1) &&
+                 (order == G_BINARY_ORDER);
+
+    // Read table dimensions
+    ok = ok && (std::fread(&m_naxes,     sizeof(int), 1, fptr) == 1) &&
+               (std::fread(&m_npars,     sizeof(int), 1, fptr) == 1) &&
+               (std::fread(&m_nelements, sizeof(int), 1, fptr) == 1) &&
+               (m_naxes >= 0) && (m_npars >= 0) && (m_nelements >= 0);
+
+    // Read column names
+    for (int i = 0; ok && i < 2*m_naxes+m_npars; ++i) {
+        int length = 0;
+        ok = (std::fread(&length, sizeof(int), 1, fptr) == 1) && (length >= 0);
+        if (ok) {
+            std::vector<char> buffer(length+1, '\0');
+            ok = (std::fread(&buffer[0], 1, length, fptr) == (size_t)length);
+            std::string name(&buffer[0], length);
+            if (i < m_naxes) {
+                m_colname_lo.push_back(name);
+            }
+            else if (i < 2*m_naxes) {
+                m_colname_hi.push_back(name);
+            }
+            else {
+                m_colname_par.push_back(name);
+            }
+        }
+    }
+
+    // Read axes
+    for (int i = 0; ok && i < m_naxes; ++i) {
+        int nbins  = 0;
+        int nnodes = 0;
+        ok = (std::fread(&nbins, sizeof(int), 1, fptr) == 1) && (nbins > 0);
+        if (ok) {
+            std::vector<double> axis_lo(nbins);
+            std::vector<double> axis_hi(nbins);
+            ok = (std::fread(&axis_lo[0], sizeof(double), nbins, fptr) == (size_t)nbins) &&
+                 (std::fread(&axis_hi[0], sizeof(double), nbins, fptr) == (size_t)nbins) &&
+                 (std::fread(&nnodes, sizeof(int), 1, fptr) == 1) && (nnodes > 0);
+            if (ok) {
+                std::vector<double> axis_nodes(nnodes);
+                ok = (std::fread(&axis_nodes[0], sizeof(double), nnodes, fptr) == (size_t)nnodes);
+                m_axis_lo.push_back(axis_lo);
+                m_axis_hi.push_back(axis_hi);
+                m_axis_nodes.push_back(GNodeArray(axis_nodes));
+            }
+        }
+    }
+
+    // Read parameters
+    for (int i = 0; ok && i < m_npars; ++i) {
+        std::vector<double> pars(m_nelements);
+        if (m_nelements > 0) {
+            ok = (std::fread(&pars[0], sizeof(double), m_nelements, fptr) ==
+                  (size_t)m_nelements);
+        }
+        m_pars.push_back(pars);
+    }
+
+    // Close file
+    std::fclose(fptr);
+
+    // Clear instance if file was not valid
+    if (!ok) {
+        clear();
+    }
+
+    // Return
+    return ok;
+}
+
+
+/***********************************************************************//**
+ * @brief Save response table into binary file
+ *
+ * @param[in] filename Binary file name.
+ * @return True if the response table was saved, false otherwise.
+ *
+ * Saves the response table in a flat binary format that can be loaded by
+ * load_binary() without any further processing. The data are written in
+ * the native byte order of the machine, as the file is meant as a local
+ * cache and not for data exchange.
+ *
+ * The file is first written under a temporary name and then renamed, so
+ * that concurrent readers never see a partially written file. The method
+ * never throws an exception; if the file could not be written it returns
+ * false.
+ ***************************************************************************/
+bool GCTAResponseTable::save_binary(const std::string& filename) const
+{
+    // Open temporary file. Return if file could not be opened.
+    std::string tmpname = filename + ".tmp";
+    std::FILE*  fptr    = std::fopen(tmpname.c_str(), "wb");
+    if (fptr == NULL) {
+        return false;
+    }
+
+    // Write header and table dimensions
+    int  order = G_BINARY_ORDER;
+    bool ok    = (std::fwrite(G_BINARY_MAGIC, 1, sizeof(G_BINARY_MAGIC)-1, fptr) ==
+                  sizeof(G_BINARY_MAGIC)-1) &&
+                 (std::fwrite(&order,       sizeof(int), 1, fptr) == 1) &&
+                 (std::fwrite(&m_naxes,     sizeof(int), 1, fptr) == 1) &&
+                 (std::fwrite(&m_npars,     sizeof(int), 1, fptr) == 1) &&
+                 (std::fwrite(&m_nelements, sizeof(int), 1, fptr) == 1);
+
+    // Write column names
+    for (int i = 0; ok && i < 2*m_naxes+m_npars; ++i) {
+        const std::string& name = (i < m_naxes)   ? m_colname_lo[i] :
+                                  (i < 2*m_naxes) ? m_colname_hi[i-m_naxes] :
+                                                    m_colname_par[i-2*m_naxes];
+        int length = name.length();
+        ok = (std::fwrite(&length, sizeof(int), 1, fptr) == 1) &&
+             (std::fwrite(name.c_str(), 1, length, fptr) == (size_t)length);
+    }
+
+    // Write axes
+    for (int i = 0; ok && i < m_naxes; ++i) {
+        int                 nbins  = m_axis_lo[i].size();
+        int                 nnodes = m_axis_nodes[i].size();
+        std::vector<double> axis_nodes(nnodes);
+        for (int k = 0; k < nnodes; ++k) {
+            axis_nodes[k] = m_axis_nodes[i][k];
+        }
+        ok = (nbins > 0) && (nnodes > 0) &&
+             (std::fwrite(&nbins, sizeof(int), 1, fptr) == 1) &&
+             (std::fwrite(&m_axis_lo[i][0], sizeof(double), nbins, fptr) == (size_t)nbins) &&
+             (std::fwrite(&m_axis_hi[i][0], sizeof(double), nbins, fptr) == (size_t)nbins) &&
+             (std::fwrite(&nnodes, sizeof(int), 1, fptr) == 1) &&
+             (std::fwrite(&axis_nodes[0], sizeof(double), nnodes, fptr) == (size_t)nnodes);
+    }
+
+    // Write parameters
+    for (int i = 0; ok && i < m_npars; ++i) {
+        ok = ((int)m_pars[i].size() == m_nelements);
+        if (ok && m_nelements > 0) {
+            ok = (std::fwrite(&m_pars[i][0], sizeof(double), m_nelements, fptr) ==
+                  (size_t)m_nelements);
+        }
+    }
+
+    // Close file
+    ok = (std::fclose(fptr) == 0) && ok;
+
+    // Move temporary file to its final name, or remove it if writing failed
+    if (ok) {
+        ok = (std::rename(tmpname.c_str(), filename.c_str()) == 0);
+    }
+    if (!ok) {
+        std::remove(tmpname.c_str());
+    }
+
+    // Return
+    return ok;
+}
+
+
 /***********************************************************************//**
  * @brief Print response table information
  *
@@ -836,20 +1111,6 @@ void GCTAResponseTable::init_members(void)
     m_axis_nodes.clear();
     m_pars.clear();
 
-    // Initialise cache
-    m_inx_left  = 0;
-    m_inx_right = 0;
-    m_wgt_left  = 0.0;
-    m_wgt_right = 0.0;
-    m_inx1      = 0;
-    m_inx2      = 0;
-    m_inx3      = 0;
-    m_inx4      = 0;
-    m_wgt1      = 0.0;
-    m_wgt2      = 0.0;
-    m_wgt3      = 0.0;
-    m_wgt4      = 0.0;
-
     // Return
     return;
 }
@@ -876,20 +1137,6 @@ void GCTAResponseTable::copy_members(const GCTAResponseTable& table)
     m_axis_nodes  = table.m_axis_nodes;
     m_pars        = table.m_pars;
 
-    // Copy cache
-    m_inx_left  = table.m_inx_left;
-    m_inx_right = table.m_inx_right;
-    m_wgt_left  = table.m_wgt_left;
-    m_wgt_right = table.m_wgt_right;
-    m_inx1      = table.m_inx1;
-    m_inx2      = table.m_inx2;
-    m_inx3      = table.m_inx3;
-    m_inx4      = table.m_inx4;
-    m_wgt1      = table.m_wgt1;
-    m_wgt2      = table.m_wgt2;
-    m_wgt3      = table.m_wgt3;
-    m_wgt4      = table.m_wgt4;
-
     // Return
     return;
 }
@@ -1117,9 +1364,11 @@ void GCTAResponseTable::read_axes(const GFitsTable* hdu)
             std::vector<double> axis_nodes(num);
 
             // Copy axis information into arrays
+            if (num > 0) {
+                col_lo->values(0, 1, &(axis_lo[0]));
+                col_hi->values(0, 1, &(axis_hi[0]));
+            }
             for (int k = 0; k < num; ++k) {
-                axis_lo[k]    = col_lo->real(0,k);
-                axis_hi[k]    = col_hi->real(0,k);
                 axis_nodes[k] = 0.5*(axis_lo[k] + axis_hi[k]);
             }
 
@@ -1193,8 +1442,8 @@ void GCTAResponseTable::read_pars(const GFitsTable* hdu)
             std::vector<double> pars(num);
 
             // Copy parameter values
-            for (int k = 0; k < num; ++k) {
-                pars[k] = col->real(0,k);
+            if (num > 0) {
+                col->values(0, 1, &(pars[0]));
             }
 
             // Push cube into storage
@@ -1210,78 +1459,65 @@ void GCTAResponseTable::read_pars(const GFitsTable* hdu)
 
 
 /***********************************************************************//**
- * @brief Update 1D cache
+ * @brief Compute 1D interpolation indices and weights
  *
  * @param[in] arg Argument.
+ * @param[out] inx Indices of the 2 table elements used for interpolation.
+ * @param[out] wgt Weights of the 2 table elements used for interpolation.
  *
- * Updates the 1D interpolation cache. The interpolation cache is composed
- * of two indices and weights that define 2 data values of the 2D table
+ * Computes the indices and weights of the two data values of the 1D table
  * that are used for linear interpolation.
- *
- * @todo Write down formula
- *
- * @todo Makes GNodeArray::set_value method const and use mutable members
  ***************************************************************************/
-void GCTAResponseTable::update(const double& arg) const
+void GCTAResponseTable::weights(const double& arg, int* inx, double* wgt) const
 {
-    // Get pointer to node array (circumvent const correctness)
-    GNodeArray* nodes = const_cast<GNodeArray*>(&(m_axis_nodes[0]));
+    // Set indices and weighting factors for linear interpolation
+    m_axis_nodes[0].interpolate(arg, inx, wgt);
 
-    // Set value for node array
-    nodes->set_value(arg);
-
-    // Set indices and weighting factors for interpolation
-    m_inx_left  = nodes->inx_left();
-    m_inx_right = nodes->inx_right();
-    m_wgt_left  = nodes->wgt_left();
-    m_wgt_right = nodes->wgt_right();
-    
     // Return
     return;
 }
 
 
 /***********************************************************************//**
- * @brief Update 2D cache
+ * @brief Compute 2D interpolation indices and weights
  *
  * @param[in] arg1 Argument for first axis.
  * @param[in] arg2 Argument for second axis.
+ * @param[out] inx Indices of the 4 table elements used for interpolation.
+ * @param[out] wgt Weights of the 4 table elements used for interpolation.
  *
- * Updates the 2D interpolation cache. The interpolation cache is composed
- * of four indices and weights that define 4 data values of the 2D table
- * that are used for bilinear interpolation.
- *
- * @todo Write down formula
- *
- * @todo Makes GNodeArray::set_value method const and use mutable members
+ * Computes the indices and weights of the four data values of the 2D table
+ * that are used for bilinear interpolation. The elements are ordered as
+ * upper left, lower left, upper right and lower right node.
  ***************************************************************************/
-void GCTAResponseTable::update(const double& arg1, const double& arg2) const
+void GCTAResponseTable::weights(const double& arg1, const double& arg2,
+                                int* inx, double* wgt) const
 {
-    // Get pointers to node arrays (circumvent const correctness)
-    GNodeArray* nodes1 = const_cast<GNodeArray*>(&(m_axis_nodes[0]));
-    GNodeArray* nodes2 = const_cast<GNodeArray*>(&(m_axis_nodes[1]));
-
-    // Set values for node arrays
-    nodes1->set_value(arg1);
-    nodes2->set_value(arg2);
+    // Get indices and weighting factors for both axes
+    int    inx1[2];
+    int    inx2[2];
+    double wgt1[2];
+    double wgt2[2];
+    m_axis_nodes[0].interpolate(arg1, inx1, wgt1);
+    m_axis_nodes[1].interpolate(arg2, inx2, wgt2);
 
     // Compute offsets
-    int size1        = axis(0);
-    int offset_left  = nodes2->inx_left()  * size1;
-    int offset_right = nodes2->inx_right() * size1;
+    int size1        = m_axis_nodes[0].size();
+    int offset_left  = inx2[0] * size1;
+    int offset_right = inx2[1] * size1;
 
     // Set indices for bi-linear interpolation
-    m_inx1 = nodes1->inx_left()  + offset_left;
-    m_inx2 = nodes1->inx_left()  + offset_right;
-    m_inx3 = nodes1->inx_right() + offset_left;
-    m_inx4 = nodes1->inx_right() + offset_right;
+    inx[0] = inx1[0] + offset_left;
+    inx[1] = inx1[0] + offset_right;
+    inx[2] = inx1[1] + offset_left;
+    inx[3] = inx1[1] + offset_right;
 
     // Set weighting factors for bi-linear interpolation
-    m_wgt1 = nodes1->wgt_left()  * nodes2->wgt_left();
-    m_wgt2 = nodes1->wgt_left()  * nodes2->wgt_right();
-    m_wgt3 = nodes1->wgt_right() * nodes2->wgt_left();
-    m_wgt4 = nodes1->wgt_right() * nodes2->wgt_right();
-    
+    wgt[0] = wgt1[0] * wgt2[0];
+    wgt[1] = wgt1[0] * wgt2[1];
+    wgt[2] = wgt1[1] * wgt2[0];
+    wgt[3] = wgt1[1] * wgt2[1];
+
     // Return
     return;
 }
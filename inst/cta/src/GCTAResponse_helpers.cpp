@@ -33,6 +33,7 @@
 #include "GCTASupport.hpp"
 #include "GTools.hpp"
 #include "GIntegral.hpp"
+#include "GIntegrals.hpp"
 #include "GVector.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -40,12 +41,57 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_GKQ_EPS_SCALE 100.0   //!< Gauss-Kronrod vs. Romberg precision ratio
 
 /* __ Debug definitions __________________________________________________ */
 
 /* __ Constants __________________________________________________________ */
 
 
+/*==========================================================================
+ =                                                                         =
+ =                   Helper functions for response computation             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Integrate kernel with the integration method of the response
+ *
+ * @param[in] rsp CTA response.
+ * @param[in] kernel Integration kernel.
+ * @param[in] min Lower integration boundary.
+ * @param[in] max Upper integration boundary.
+ * @return Integral of kernel.
+ *
+ * Integrates the kernel using Romberg integration at the precision of the
+ * response (see GCTAResponse::eps). If Gauss-Kronrod quadrature is
+ * selected (see GCTAResponse::gauss_kronrod), the kernel is integrated
+ * using GIntegral::gkq. The Gauss-Kronrod error estimate is conservative,
+ * hence the precision is relaxed by G_GKQ_EPS_SCALE, which gives about
+ * the same accuracy as Romberg integration at the response precision.
+ ***************************************************************************/
+double cta_integrate(const GCTAResponse* rsp, GFunction* kernel,
+                     const double& min, const double& max)
+{
+    // Initialise integral
+    GIntegral integral(kernel);
+
+    // Integrate kernel
+    double result = 0.0;
+    if (rsp->gauss_kronrod()) {
+        integral.eps(rsp->eps() * G_GKQ_EPS_SCALE);
+        result = integral.gkq(min, max);
+    }
+    else {
+        integral.eps(rsp->eps());
+        result = integral.romb(min, max);
+    }
+
+    // Return result
+    return result;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =              Helper class methods for response computation              =
@@ -131,6 +177,60 @@ double cta_npsf_kern_rad_azsym::eval(double delta)
  * \f$IRF(\rho, \omega)\f$ is the instrument response function.
  ***************************************************************************/
 double cta_irf_radial_kern_rho::eval(double rho)
+{
+    // Initialise result
+    double irf = 0.0;
+
+    // Integrate IRF over azimuth angle
+    double omega = omega_integral(rho);
+
+    // Continue only if azimuthal integral is non-zero
+    if (omega != 0.0) {
+
+        // Evaluate sky model M(rho)
+        double model = m_model->eval(rho);
+
+        // Compute kernel value
+        double sin_rho = std::sin(rho);
+        irf            = omega * model * sin_rho;
+
+        // Compile option: Check for NaN/Inf
+        #if defined(G_NAN_CHECK)
+        if (isnotanumber(irf) || isinfinite(irf)) {
+            std::cout << "*** ERROR: cta_irf_radial_kern_rho";
+            std::cout << "(rho=" << rho << "):";
+            std::cout << " NaN/Inf encountered";
+            std::cout << " (irf=" << irf;
+            std::cout << ", omega=" << omega;
+            std::cout << ", model=" << model;
+            std::cout << ", sin_rho=" << sin_rho << ")";
+            std::cout << std::endl;
+        }
+        #endif
+
+    } // endif: azimuthal integral was non-zero
+
+    // Return result
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Azimuthal integral of IRF for radial model
+ *
+ * @param[in] rho Zenith angle with respect to model centre [radians].
+ * @return Azimuthal integral of IRF.
+ *
+ * Computes the azimuthal integral
+ *
+ * \f[\int_{\omega_{\rm min}}^{\omega_{\rm max}} 
+ *    IRF(\rho, \omega) d\omega\f]
+ *
+ * over the arc that lies within the PSF validity circle. The integral does
+ * not depend on the source model, hence it can be shared between the
+ * model and its parameter gradients (see cta_irf_radial_kern_rho_grad).
+ ***************************************************************************/
+double cta_irf_radial_kern_rho::omega_integral(double rho) const
 {
     // Compute half length of arc that lies within PSF validity circle
     // (in radians)
@@ -151,9 +251,6 @@ double cta_irf_radial_kern_rho::eval(double rho)
         double omega_min = -domega;
         double omega_max = +domega;
 
-        // Evaluate sky model M(rho)
-        double model = m_model->eval(rho);
-
         // Precompute cosine and sine terms for azimuthal integration
         double cos_rho = std::cos(rho);
         double sin_rho = std::sin(rho);
@@ -178,25 +275,57 @@ double cta_irf_radial_kern_rho::eval(double rho)
                                             sin_ph);
 
         // Integrate over phi
-        GIntegral integral(&integrand);
-        integral.eps(m_rsp->eps());
-        irf = integral.romb(omega_min, omega_max) * model * sin_rho;
+        irf = cta_integrate(m_rsp, &integrand, omega_min, omega_max);
 
-        // Compile option: Check for NaN/Inf
-        #if defined(G_NAN_CHECK)
-        if (isnotanumber(irf) || isinfinite(irf)) {
-            std::cout << "*** ERROR: cta_irf_radial_kern_rho";
-            std::cout << "(rho=" << rho << "):";
-            std::cout << " NaN/Inf encountered";
-            std::cout << " (irf=" << irf;
-            std::cout << ", domega=" << domega;
-            std::cout << ", model=" << model;
-            std::cout << ", sin_rho=" << sin_rho << ")";
-            std::cout << std::endl;
+    } // endif: arc length was positive
+
+    // Return result
+    return irf;
+}
+
+
+/***********************************************************************//**
+ * @brief Kernel for radial model zenith angle integration of IRF and
+ *        parameter gradients
+ *
+ * @param[in] rho Zenith angle with respect to model centre [radians].
+ * @return Kernel values for IRF and parameter gradients.
+ *
+ * This method evaluates the kernel \f$K(\rho)\f$ of
+ * cta_irf_radial_kern_rho::eval together with the kernels
+ *
+ * \f[K_i(\rho) = \sin \rho \times \frac{\partial M(\rho)}{\partial p_i}
+ *    \times \int_{\omega_{\rm min}}^{\omega_{\rm max}} 
+ *    IRF(\rho, \omega) d\omega\f]
+ *
+ * for the model parameters \f$p_i\f$ that have analytical gradients. The
+ * azimuthal integral is computed only once for the model and all
+ * gradients, and the gradients of \f$M(\rho)\f$ are taken from
+ * GModelSpatialRadial::eval_gradients. The first element of the returned
+ * vector is \f$K(\rho)\f$, followed by the \f$K_i(\rho)\f$.
+ ***************************************************************************/
+GVector cta_irf_radial_kern_rho_grad::eval(double rho)
+{
+    // Initialise result
+    GVector irf(size());
+
+    // Integrate IRF over azimuth angle
+    double omega = m_kernel.omega_integral(rho);
+
+    // Continue only if azimuthal integral is non-zero
+    if (omega != 0.0) {
+
+        // Evaluate sky model M(rho) and its gradients
+        double model = m_model->eval_gradients(rho);
+
+        // Compute kernel values
+        double fact = omega * std::sin(rho);
+        irf[0]      = fact * model;
+        for (int i = 0; i < m_pars.size(); ++i) {
+            irf[i+1] = fact * (*m_model)[m_pars[i]].factor_gradient();
         }
-        #endif
 
-    } // endif: arc length was positive
+    } // endif: azimuthal integral was non-zero
 
     // Return result
     return irf;
@@ -247,11 +376,12 @@ double cta_irf_radial_kern_rho::eval(double rho)
  ***************************************************************************/
 double cta_irf_radial_kern_omega::eval(double omega)
 {
-    // Compute PSF offset angle [radians]
-    double delta = std::acos(m_cos_psf + m_sin_psf * std::cos(omega));
+    // Compute PSF offset angle [radians] (protect against rounding errors
+    // that lead to arguments slightly larger than one)
+    double delta = arccos(m_cos_psf + m_sin_psf * std::cos(omega));
     
     // Compute observed photon offset angle in camera system [radians]
-    double offset = std::acos(m_cos_ph + m_sin_ph * std::cos(m_omega0 - omega));
+    double offset = arccos(m_cos_ph + m_sin_ph * std::cos(m_omega0 - omega));
     
     //TODO: Compute true photon azimuth angle in camera system [radians]
     double azimuth = 0.0;
@@ -29,6 +29,7 @@
 
 /* __ Includes ___________________________________________________________ */
 #include <cmath>
+#include <vector>
 #include "GCTAResponse.hpp"
 #include "GCTAObservation.hpp"
 #include "GMatrix.hpp"
@@ -37,11 +38,17 @@
 #include "GModelSpatialRadial.hpp"
 #include "GModelSpatialElliptical.hpp"
 #include "GFunction.hpp"
+#include "GFunctions.hpp"
+#include "GVector.hpp"
 
 /* __ Type definitions ___________________________________________________ */
 
 /* __ Forward declaration ________________________________________________ */
 
+/* __ Prototypes _________________________________________________________ */
+double cta_integrate(const GCTAResponse* rsp, GFunction* kernel,
+                     const double& min, const double& max);
+
 
 /***********************************************************************//**
  * @class cta_npsf_kern_rad_azsym
@@ -118,6 +125,7 @@ public:
                             m_delta_max(delta_max),
                             m_cos_delta_max(std::cos(delta_max)) { }
     double eval(double rho);
+    double omega_integral(double rho) const;
 protected:
     const GCTAResponse*        m_rsp;           //!< Pointer to CTA response
     const GModelSpatialRadial* m_model;         //!< Pointer to radial spatial model
@@ -137,6 +145,29 @@ protected:
 };
 
 
+/***********************************************************************//**
+ * @class cta_irf_radial_kern_rho_grad
+ *
+ * @brief Kernel for radial model zenith angle integration of IRF and
+ *        parameter gradients
+ ***************************************************************************/
+class cta_irf_radial_kern_rho_grad : public GFunctions {
+public:
+    cta_irf_radial_kern_rho_grad(const cta_irf_radial_kern_rho& kernel,
+                                 const GModelSpatialRadial*     model,
+                                 const std::vector<int>&        pars) :
+                                 m_kernel(kernel),
+                                 m_model(model),
+                                 m_pars(pars) { }
+    int     size(void) const { return m_pars.size()+1; }
+    GVector eval(double rho);
+protected:
+    cta_irf_radial_kern_rho    m_kernel;        //!< IRF integration kernel
+    const GModelSpatialRadial* m_model;         //!< Pointer to radial spatial model
+    std::vector<int>           m_pars;          //!< Parameters with gradients
+};
+
+
 /***********************************************************************//**
  * @class cta_irf_radial_kern_omega
  *
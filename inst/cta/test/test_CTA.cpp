@@ -29,12 +29,18 @@
 #include <config.h>
 #endif
 #include <stdlib.h>
+#include <cmath>
 #include <iostream>
 #include <unistd.h>
 #include "GCTALib.hpp"
 #include "GTools.hpp"
 #include "test_CTA.hpp"
 
+/* __ OpenMP section _____________________________________________________ */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* __ Namespaces _________________________________________________________ */
 
 /* __ Globals ____________________________________________________________ */
@@ -66,6 +72,9 @@ void TestGCTAResponse::set(void)
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_npsf), "Test integrated PSF");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_irf_diffuse), "Test diffuse IRF");
     append(static_cast<pfunction>(&TestGCTAResponse::test_response_npred_diffuse), "Test diffuse IRF integration");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_irf_radial_template), "Test radial model templates");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_table), "Test response table");
+    append(static_cast<pfunction>(&TestGCTAResponse::test_response_cache), "Test response cache");
 
     // Return
     return;
@@ -83,6 +92,9 @@ void TestGCTAObservation::set(void)
     // Append tests to test suite
     append(static_cast<pfunction>(&TestGCTAObservation::test_unbinned_obs), "Test unbinned observations");
     append(static_cast<pfunction>(&TestGCTAObservation::test_binned_obs), "Test binned observation");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_columnar_events), "Test columnar event list");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_projected_events), "Test event column selection");
+    append(static_cast<pfunction>(&TestGCTAObservation::test_cube_bins), "Test event cube bin access");
 
     // Return
     return;
@@ -360,6 +372,231 @@ void TestGCTAResponse::test_response_npred_diffuse(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test CTA IRF computation for radial models using templates
+ *
+ * Tests the interpolation of the IRF of a fixed disk model from a radial
+ * model template by comparing the interpolated IRF values to the
+ * integrated values for a set of events.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_irf_radial_template(void)
+{
+    // Setup CTA response
+    GCTAResponse rsp;
+    rsp.caldb(cta_caldb);
+    rsp.load(cta_irf);
+
+    // Setup observation with an empty event list that covers 0.1-100 TeV
+    GCTAObservation obs;
+    GCTAPointing    pnt;
+    GCTAEventList   list;
+    GSkyDir         pdir;
+    GEbounds        ebounds;
+    GEnergy         emin;
+    GEnergy         emax;
+    pdir.radec_deg(83.6, 22.0);
+    pnt.dir(pdir);
+    emin.TeV(0.1);
+    emax.TeV(100.0);
+    ebounds.append(emin, emax);
+    list.ebounds(ebounds);
+    obs.pointing(pnt);
+    obs.response(rsp);
+    obs.events(&list);
+    obs.ontime(1000.0);
+    obs.livetime(1000.0);
+    obs.deadc(1.0);
+
+    // Setup fixed disk model
+    GSkyDir centre;
+    centre.radec_deg(84.1, 22.3);
+    GModelSpatialRadialDisk disk(centre, 0.2);
+    for (int i = 0; i < disk.size(); ++i) {
+        disk[i].fix();
+    }
+
+    // Compare interpolated to integrated IRF values
+    const GResponse* response = obs.response();
+    GCTAResponse*    cta      = static_cast<GCTAResponse*>(obs.response());
+    for (int i = 0; i < 5; ++i) {
+        GCTAEventAtom event;
+        GCTAInstDir   dir;
+        GSkyDir       evtdir;
+        GEnergy       eng;
+        evtdir.radec_deg(83.9+0.1*i, 22.3);
+        dir.dir(evtdir);
+        eng.TeV(0.3+0.7*i);
+        event.dir(dir);
+        event.energy(eng);
+        GSource source("Disk", disk, eng, GTime());
+        cta->radial_templates(false);
+        double irf_direct = response->irf(event, source, obs);
+        cta->radial_templates(true);
+        double irf_tpl    = response->irf(event, source, obs);
+        test_value(irf_tpl, irf_direct, 0.01*irf_direct+1.0e-10,
+                   "Radial template IRF for event "+str(i));
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test CTA response table lookup
+ *
+ * Sets up a two-dimensional response table with two parameters that vary
+ * linearly with both axes, so that bilinear interpolation is exact, and
+ * checks that the operator() and the lookup() methods give consistent
+ * results.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_table(void)
+{
+    // Set table dimensions
+    const int nx = 10;
+    const int ny = 5;
+
+    // Setup axis and parameter columns
+    GFitsTableDoubleCol x_lo("X_LO", 1, nx);
+    GFitsTableDoubleCol x_hi("X_HI", 1, nx);
+    GFitsTableDoubleCol y_lo("Y_LO", 1, ny);
+    GFitsTableDoubleCol y_hi("Y_HI", 1, ny);
+    GFitsTableDoubleCol par1("PAR1", 1, nx*ny);
+    GFitsTableDoubleCol par2("PAR2", 1, nx*ny);
+    for (int ix = 0; ix < nx; ++ix) {
+        x_lo(0,ix) = double(ix);
+        x_hi(0,ix) = double(ix+1);
+    }
+    for (int iy = 0; iy < ny; ++iy) {
+        y_lo(0,iy) = 2.0*double(iy);
+        y_hi(0,iy) = 2.0*double(iy+1);
+    }
+    for (int iy = 0; iy < ny; ++iy) {
+        for (int ix = 0; ix < nx; ++ix) {
+            double x = double(ix) + 0.5;
+            double y = 2.0*double(iy) + 1.0;
+            par1(0,ix+iy*nx) = 1.0 + 2.0*x + 3.0*y;
+            par2(0,ix+iy*nx) = 4.0 - x + 0.5*y;
+        }
+    }
+    GFitsBinTable hdu(1);
+    hdu.append_column(x_lo);
+    hdu.append_column(x_hi);
+    hdu.append_column(y_lo);
+    hdu.append_column(y_hi);
+    hdu.append_column(par1);
+    hdu.append_column(par2);
+
+    // Setup response table
+    GCTAResponseTable table(&hdu);
+    test_value(table.axes(), 2, "Check number of axes");
+    test_value(table.size(), 2, "Check number of parameters");
+
+    // Check single argument lookups against the operators
+    const int num = 7;
+    double    arg1[num];
+    double    arg2[num];
+    double    batch[2*num];
+    for (int i = 0; i < num; ++i) {
+        arg1[i] = 0.7 + 1.2*double(i);
+        arg2[i] = 8.5 - 1.1*double(i);
+    }
+    table.lookup(num, arg1, arg2, batch);
+    for (int i = 0; i < num; ++i) {
+        double              pars[2];
+        std::vector<double> vector = table(arg1[i], arg2[i]);
+        table.lookup(arg1[i], arg2[i], pars);
+        double ref1 = 1.0 + 2.0*arg1[i] + 3.0*arg2[i];
+        double ref2 = 4.0 - arg1[i] + 0.5*arg2[i];
+        test_value(vector[0], ref1, 1.0e-10, "Check operator() for parameter 1");
+        test_value(vector[1], ref2, 1.0e-10, "Check operator() for parameter 2");
+        test_value(table(0, arg1[i], arg2[i]), ref1, 1.0e-10,
+                   "Check indexed operator()");
+        test_value(pars[0], ref1, 1.0e-10, "Check lookup() for parameter 1");
+        test_value(pars[1], ref2, 1.0e-10, "Check lookup() for parameter 2");
+        test_value(batch[2*i],   ref1, 1.0e-10, "Check batch lookup() for parameter 1");
+        test_value(batch[2*i+1], ref2, 1.0e-10, "Check batch lookup() for parameter 2");
+    }
+
+    // Check binary cache file round trip
+    const std::string binfile = "test_cta_response_table.rsp";
+    table.axis_log10(0);
+    table.scale(1, 2.0);
+    test_assert(table.save_binary(binfile), "Check saving of binary table");
+    GCTAResponseTable cached;
+    test_assert(cached.load_binary(binfile), "Check loading of binary table");
+    test_value(cached.axes(), 2, "Check number of axes of binary table");
+    test_value(cached.size(), 2, "Check number of parameters of binary table");
+    for (int i = 0; i < num; ++i) {
+        double logE = std::log10(arg1[i]);
+        test_value(cached(0, logE, arg2[i]), table(0, logE, arg2[i]), 1.0e-10,
+                   "Check parameter 1 of binary table");
+        test_value(cached(1, logE, arg2[i]), table(1, logE, arg2[i]), 1.0e-10,
+                   "Check parameter 2 of binary table");
+    }
+    test_assert(!cached.load_binary(datadir+"/crab.xml"),
+                "Check rejection of invalid binary table");
+    test_value(cached.size(), 0, "Check that invalid binary table is empty");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test CTA instrument response cache
+ *
+ * Checks that responses that use the same response file are loaded only
+ * once, that each response gets its own copy of a cached performance table
+ * (which holds an interpolation cache), and that cache entries are only
+ * dropped once they are no longer in use.
+ ***************************************************************************/
+void TestGCTAResponse::test_response_cache(void)
+{
+    // Drop unused cache entries
+    GCTAIrfCache cache;
+    cache.purge();
+    int size = cache.size();
+
+    // Setup response that outlives the responses it was copied from
+    GCTAResponse rsp3;
+    {
+        // Load responses using the same response file
+        GCTAResponse rsp1;
+        GCTAResponse rsp2;
+        rsp1.caldb(cta_caldb);
+        rsp1.load(cta_irf);
+        rsp2.caldb(cta_caldb);
+        rsp2.load(cta_irf);
+        rsp3 = rsp1;
+
+        // Check cache and response copies
+        test_value(cache.size(), size+2, "Check number of cached responses");
+        test_assert(rsp1.aeff() != rsp2.aeff() && rsp1.aeff() != rsp3.aeff(),
+                    "Check that effective areas are not shared");
+        test_assert(rsp1.psf() != rsp2.psf() && rsp1.psf() != rsp3.psf(),
+                    "Check that PSFs are not shared");
+        test_value((*rsp2.aeff())(0.0), (*rsp1.aeff())(0.0), 1.0e-10,
+                   "Check effective area of cached response");
+
+        // Check that entries in use are not purged
+        cache.purge();
+        test_value(cache.size(), size+2, "Check that used entries are kept");
+    }
+
+    // Check that entries are kept as long as a copy is in use
+    cache.purge();
+    test_value(cache.size(), size+2, "Check that copied entries are kept");
+
+    // Check that entries are dropped once no longer in use
+    rsp3.clear();
+    test_value(cache.size(), size, "Check that unused entries are dropped");
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test CTA response handling
  ***************************************************************************/
@@ -436,6 +673,35 @@ void TestGCTAObservation::test_unbinned_obs(void)
         test_try_failure(e);
     }
 
+    // Test parallel XML reading of several observations
+    test_try("Test parallel XML reading");
+    try {
+        GXml         xml(cta_unbin_xml);
+        GXmlElement* lib = xml.element("observation_list", 0);
+        lib->element("observation", 0)->attribute("id", "1");
+        GXmlElement  element(*lib->element("observation", 0));
+        for (int i = 0; i < 3; ++i) {
+            element.attribute("id", str(i+2));
+            lib->append(element);
+        }
+        GObservations list;
+        list.load_threads(4);
+        list.load_budget(0.001);
+        list.read(xml);
+        test_value(list.size(), 4, "Check number of observations");
+        test_value((int)list.load_times().size(), 4, "Check number of reading times");
+        for (int i = 0; i < list.size(); ++i) {
+            test_assert(list[i]->id() == str(i+1),
+                        "Check order of observation "+str(i));
+            test_value(list[i]->events()->size(), 4397,
+                       "Check number of events of observation "+str(i));
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
     // Exit test
     return;
  
@@ -482,6 +748,259 @@ void TestGCTAObservation::test_binned_obs(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test columnar event list storage
+ ***************************************************************************/
+void TestGCTAObservation::test_columnar_events(void)
+{
+    // Build event list
+    GCTAEventList list;
+    for (int i = 0; i < 10; ++i) {
+        GCTAEventAtom event;
+        GCTAInstDir   dir;
+        GEnergy       energy;
+        GTime         time;
+        dir.radec_deg(83.6331+0.1*i, 22.0145-0.1*i);
+        energy.TeV(0.1*(i+1));
+        time.secs(10.0*i);
+        event.dir(dir);
+        event.energy(energy);
+        event.time(time);
+        list.append(event);
+    }
+
+    // Convert into columnar storage
+    GCTAEventList columns = list;
+    columns.columnar(true);
+    test_assert(columns.columnar(), "Check columnar storage flag");
+    test_value(columns.size(), list.size(), "Check number of events");
+
+    // Check event access through proxies
+    const GCTAEventList& proxies = columns;
+    for (int i = 0; i < list.size(); ++i) {
+        test_value(proxies[i]->dir().ra_deg(), list[i]->dir().ra_deg(),
+                   1.0e-10, "Check Right Ascension of event "+str(i));
+        test_value(proxies[i]->dir().dec_deg(), list[i]->dir().dec_deg(),
+                   1.0e-10, "Check Declination of event "+str(i));
+        test_value(proxies[i]->energy().MeV(), list[i]->energy().MeV(),
+                   1.0e-10, "Check energy of event "+str(i));
+        test_value(proxies[i]->time().secs(), list[i]->time().secs(),
+                   1.0e-10, "Check time of event "+str(i));
+    }
+
+    // Check precomputed celestial unit vector and log10 of energy
+    test_value(proxies[3]->dir().dir().cos_dist(list[3]->dir().dir()), 1.0, 1.0e-12,
+               "Check celestial unit vector of event");
+    test_value(proxies[3]->energy().log10MeV(), list[3]->energy().log10MeV(),
+               1.0e-12, "Check log10 of energy of event");
+
+    // Check that caller owned event atoms remain valid
+    GCTAEventAtom first;
+    GCTAEventAtom last;
+    columns.event(0, &first);
+    columns.event(list.size()-1, &last);
+    test_value(first.energy().MeV(), list[0]->energy().MeV(), 1.0e-10,
+               "Check energy of caller owned first event");
+    test_value(last.energy().MeV(), list[list.size()-1]->energy().MeV(),
+               1.0e-10, "Check energy of caller owned last event");
+
+    // Check that several proxies can be held at the same time
+    const GCTAEventAtom* event0 = proxies[0];
+    const GCTAEventAtom* event1 = proxies[1];
+    test_assert(event0 != event1, "Check that proxies are distinct");
+    test_value(event0->energy().MeV(), list[0]->energy().MeV(), 1.0e-10,
+               "Check energy of first held proxy");
+    test_value(event1->energy().MeV(), list[1]->energy().MeV(), 1.0e-10,
+               "Check energy of second held proxy");
+
+    // Check that write access to columnar list is refused
+    test_try("Check write access to columnar event list");
+    try {
+        GCTAEventAtom* event = columns[0];
+        test_try_failure("Write access to columnar event list should throw"
+                         " an exception.");
+    }
+    catch (GException::feature_not_implemented &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check proxy access from nested parallel regions
+    int nerrors = 0;
+    #ifdef _OPENMP
+    omp_set_nested(1);
+    #endif
+    #pragma omp parallel num_threads(2) reduction(+:nerrors)
+    {
+        #pragma omp parallel num_threads(2) reduction(+:nerrors)
+        {
+            for (int k = 0; k < 1000; ++k) {
+                int                  i     = k % list.size();
+                const GCTAEventAtom* event = proxies[i];
+                if (std::abs(event->energy().MeV() -
+                             list[i]->energy().MeV()) > 1.0e-10) {
+                    nerrors++;
+                }
+            }
+        }
+    }
+    #ifdef _OPENMP
+    omp_set_nested(0);
+    #endif
+    test_value(nerrors, 0, "Check proxy access from nested threads");
+
+    // Append event to columnar list and convert back into event atoms
+    columns.append(*(list[0]));
+    columns.columnar(false);
+    test_assert(!columns.columnar(), "Check event atom storage flag");
+    test_value(columns.size(), list.size()+1, "Check number of events");
+    test_value(columns[list.size()]->energy().MeV(), list[0]->energy().MeV(),
+               1.0e-10, "Check energy of appended event");
+
+    // Exit test
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test reading of selected event columns
+ *
+ * Saves an event list into a FITS file and loads it back with different
+ * column selections.
+ ***************************************************************************/
+void TestGCTAObservation::test_projected_events(void)
+{
+    // Build event list
+    GCTAEventList list;
+    for (int i = 0; i < 10; ++i) {
+        GCTAEventAtom event;
+        GCTAInstDir   dir;
+        GEnergy       energy;
+        GTime         time;
+        dir.radec_deg(83.6331+0.1*i, 22.0145-0.1*i);
+        energy.TeV(0.1*(i+1));
+        time.secs(10.0*i);
+        event.dir(dir);
+        event.energy(energy);
+        event.time(time);
+        event.event_id(i+1);
+        list.append(event);
+    }
+
+    // Set filename
+    const std::string file = "test_cta_events_projected.fits";
+
+    // Save event list into FITS file
+    list.save(file, true);
+
+    // Set column selections
+    std::vector<std::string> required;
+    std::vector<std::string> event_id;
+    required.push_back("TIME");
+    event_id.push_back("EVENT_ID");
+
+    // Load all columns, required columns, and event identifiers
+    GCTAEventList all;
+    GCTAEventList minimal;
+    GCTAEventList ids;
+    GCTAEventList columnar;
+    minimal.columns(required);
+    ids.columns(event_id);
+    columnar.columnar(true);
+    test_try("Load event lists");
+    try {
+        all.load(file);
+        minimal.load(file);
+        ids.load(file);
+        columnar.load(file);
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+        return;
+    }
+    test_value(all.size(), list.size(), "Check number of events");
+    test_value(minimal.size(), list.size(), "Check number of events");
+    test_value(ids.size(), list.size(), "Check number of events");
+    test_value(columnar.size(), list.size(), "Check number of events");
+    test_assert(minimal.columns() == required, "Check column selection");
+
+    // Check events
+    for (int i = 0; i < list.size(); ++i) {
+        test_value(minimal[i]->dir().ra_deg(), all[i]->dir().ra_deg(),
+                   1.0e-10, "Check Right Ascension of event "+str(i));
+        test_value(minimal[i]->dir().dec_deg(), all[i]->dir().dec_deg(),
+                   1.0e-10, "Check Declination of event "+str(i));
+        test_value(minimal[i]->energy().MeV(), all[i]->energy().MeV(),
+                   1.0e-10, "Check energy of event "+str(i));
+        test_value(minimal[i]->time().secs(), all[i]->time().secs(),
+                   1.0e-10, "Check time of event "+str(i));
+        test_value(((const GCTAEventList&)columnar)[i]->energy().MeV(),
+                   all[i]->energy().MeV(),
+                   1.0e-10, "Check energy of columnar event "+str(i));
+        test_value(((const GCTAEventList&)columnar)[i]->time().secs(),
+                   all[i]->time().secs(),
+                   1.0e-10, "Check time of columnar event "+str(i));
+        test_value(int(all[i]->event_id()), i+1,
+                   "Check identifier of event "+str(i));
+        test_value(int(ids[i]->event_id()), i+1,
+                   "Check identifier of selected event "+str(i));
+        test_value(int(minimal[i]->event_id()), 0,
+                   "Check identifier of unselected event "+str(i));
+    }
+
+    // Exit test
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test const event cube bin access
+ *
+ * Checks that event bins obtained through the const access operator remain
+ * valid while further bins are accessed, and that an event cube can be
+ * accessed from several threads at the same time.
+ ***************************************************************************/
+void TestGCTAObservation::test_cube_bins(void)
+{
+    // Setup event cube with distinct counts in all bins
+    GSkymap map("CAR", "CEL", 0.0, 0.0, 1.0, 1.0, 5, 5, 3);
+    for (int k = 0; k < map.nmaps(); ++k) {
+        for (int i = 0; i < map.npix(); ++i) {
+            map(i, k) = double(k * map.npix() + i);
+        }
+    }
+    GGti gti;
+    gti.append(GTime(0.0), GTime(1800.0));
+    GEbounds ebounds(3, GEnergy(0.1, "TeV"), GEnergy(100.0, "TeV"));
+    GCTAEventCube        cube(map, ebounds, gti);
+    const GCTAEventCube& bins = cube;
+
+    // Check that several bins can be held at the same time
+    const GCTAEventBin* bin0 = bins[0];
+    const GCTAEventBin* bin1 = bins[1];
+    test_assert(bin0 != bin1, "Check that bins are distinct");
+    test_value(bin0->counts(), 0.0, 1.0e-10, "Check counts of first held bin");
+    test_value(bin1->counts(), 1.0, 1.0e-10, "Check counts of second held bin");
+
+    // Check bin access from several threads
+    int nerrors = 0;
+    #pragma omp parallel for reduction(+:nerrors)
+    for (int i = 0; i < bins.size(); ++i) {
+        const GCTAEventBin* bin = bins[i];
+        if (bin->counts() != double(i)) {
+            nerrors++;
+        }
+    }
+    test_value(nerrors, 0, "Check bin access from several threads");
+
+    // Exit test
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test unbinned optimizer
  ***************************************************************************/
@@ -51,6 +51,9 @@ public:
     void         test_response_npsf(void);
     void         test_response_irf_diffuse(void);
     void         test_response_npred_diffuse(void);
+    void         test_response_irf_radial_template(void);
+    void         test_response_table(void);
+    void         test_response_cache(void);
     void         test_response(void);
 };
 
@@ -72,6 +75,9 @@ public:
     virtual void set(void);
     void         test_unbinned_obs(void);
     void         test_binned_obs(void);
+    void         test_columnar_events(void);
+    void         test_projected_events(void);
+    void         test_cube_bins(void);
 };
 
 
@@ -0,0 +1,175 @@
+#! /usr/bin/env python
+# ==========================================================================
+# This script compares the IRF computation for radial models using radial
+# model templates to the direct IRF integration.
+#
+# Copyright (C) 2013 Jurgen Knodlseder
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# ==========================================================================
+from gammalib import *
+import time
+
+
+# ================ #
+# Set radial model #
+# ================ #
+def radial_model(type="Disk", ra=83.9, dec=22.2, radius=0.2, width=0.05):
+    """
+    Set radial model with fixed parameters.
+    """
+    # Set model centre
+    center = GSkyDir()
+    center.radec_deg(ra, dec)
+
+    # Set radial model
+    if type == "Gauss":
+        radial = GModelSpatialRadialGauss(center, radius)
+    elif type == "Shell":
+        radial = GModelSpatialRadialShell(center, radius, width)
+    else:
+        radial = GModelSpatialRadialDisk(center, radius)
+
+    # Fix all spatial parameters
+    for i in range(radial.size()):
+        radial[i].fix()
+
+    # Set spectral model
+    spectral = GModelSpectralPlaw(1.0, -2.0, 100.0)
+
+    # Set sky model
+    model = GModelSky(radial, spectral)
+
+    # Return model
+    return model
+
+
+# ========================== #
+# Set binned CTA observation #
+# ========================== #
+def observation(ra=83.6, dec=22.0, emin=0.1, emax=100.0,
+                binsz=0.02, npix=100, ebins=10, duration=1800.0):
+    """
+    Set binned CTA observation.
+    """
+    # Allocate observation
+    obs = GCTAObservation()
+
+    # Set response
+    obs.response("kb_E_50h_v3", "../caldb")
+
+    # Set pointing
+    dir = GSkyDir()
+    pnt = GCTAPointing()
+    dir.radec_deg(ra, dec)
+    pnt.dir(dir)
+    obs.pointing(pnt)
+
+    # Set events
+    ebounds = GEbounds(ebins, GEnergy(emin, "TeV"), GEnergy(emax, "TeV"))
+    gti     = GGti()
+    tmin    = GTime(0.0)
+    tmax    = GTime(duration)
+    gti.append(tmin, tmax)
+    map     = GSkymap("CAR", "CEL", ra, dec, -binsz, binsz, npix, npix, ebins)
+    cube    = GCTAEventCube(map, ebounds, gti)
+    obs.events(cube)
+
+    # Set ontime, livetime, and deadtime correction factor
+    obs.ontime(duration)
+    obs.livetime(duration)
+    obs.deadc(1.0)
+
+    # Return observation
+    return obs
+
+
+# ============== #
+# Evaluate model #
+# ============== #
+def evaluate(model, obs):
+    """
+    Evaluate model for all event bins and return values and CPU time.
+    """
+    # Evaluate model
+    values = []
+    tstart = time.clock()
+    for bin in obs.events():
+        values.append(model.eval(bin, obs))
+    elapsed = time.clock() - tstart
+
+    # Return values and CPU time
+    return values, elapsed
+
+
+# ================ #
+# Compare template #
+# ================ #
+def compare(type, nzeta=80, nomega=5, neng=10):
+    """
+    Compare template interpolation to direct integration.
+    """
+    # Set model and observation
+    model = radial_model(type=type)
+    obs   = observation()
+
+    # Compute direct IRF
+    obs.response().radial_templates(False)
+    direct, t_direct = evaluate(model, obs)
+
+    # Compute interpolated IRF (the first pass includes building the
+    # template)
+    obs.response().radial_templates(True)
+    obs.response().radial_template_nodes(nzeta, nomega, neng)
+    build, t_build = evaluate(model, obs)
+    interp, t_interp = evaluate(model, obs)
+
+    # Determine deviations relative to the model peak
+    peak    = max(direct)
+    maxdev  = 0.0
+    meandev = 0.0
+    for i in range(len(direct)):
+        dev      = abs(interp[i] - direct[i]) / peak
+        meandev += dev
+        if dev > maxdev:
+            maxdev = dev
+    meandev /= len(direct)
+
+    # Print results
+    print("%5s: direct %.3fs, template %.3fs (build) %.3fs (built), "
+          "max dev %.2e, mean dev %.2e (relative to peak)" %
+          (type, t_direct, t_build, t_interp, maxdev, meandev))
+
+    # Return
+    return
+
+
+#==========================#
+# Main routine entry point #
+#==========================#
+if __name__ == '__main__':
+    """
+    Compare radial model templates to direct IRF integration.
+    """
+    # Dump header
+    print("")
+    print("*******************************")
+    print("* Test radial model templates *")
+    print("*******************************")
+
+    # Compare models
+    compare("Gauss")
+    compare("Disk")
+    compare("Shell")
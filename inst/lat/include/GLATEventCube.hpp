@@ -80,7 +80,7 @@ public:
     void              ontime(const double& ontime) { m_ontime=ontime; }
     const GTime&      time(void) const { return m_time; }
     const GSkymap&    map(void) const { return m_map; }
-    const GNodeArray& enodes(void) { return m_enodes; }
+    const GNodeArray& enodes(void) const { return m_enodes; }
     const double&     ontime(void) const { return m_ontime; }
     int               nx(void) const { return m_map.nx(); }
     int               ny(void) const { return m_map.ny(); }
@@ -104,6 +104,7 @@ protected:
     virtual void set_energies(void);
     virtual void set_times(void);
     void         set_bin(const int& index);
+    void         set_bin(const int& index, GLATEventBin* bin) const;
 
     // Protected data area
     GLATEventBin             m_bin;          //!< Actual energy bin
@@ -70,6 +70,9 @@ public:
     virtual void             write(GXmlElement& xml) const;
     virtual std::string      print(void) const;
 
+    // Overloaded base class methods
+    virtual GLATObservation* shallow_clone(const bool& share_events = true) const;
+
     // Other methods
     void                     load_unbinned(const std::string& ft1name,
                                            const std::string& ft2name,
@@ -82,6 +85,9 @@ public:
     GLATLtCube*              ltcube(void) const;
 
 protected:
+    // Protected constructors
+    GLATObservation(const GLATObservation& obs, const bool& share_events);
+
     // Protected methods
     void init_members(void);
     void copy_members(const GLATObservation& obs);
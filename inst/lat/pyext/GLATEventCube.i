@@ -61,7 +61,7 @@ public:
     void              ontime(const double& ontime);
     const GTime&      time(void) const;
     const GSkymap&    map(void) const;
-    const GNodeArray& enodes(void);
+    const GNodeArray& enodes(void) const;
     const double&     ontime(void) const;
     int               nx(void) const;
     int               ny(void) const;
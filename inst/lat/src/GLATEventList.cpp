@@ -533,6 +533,9 @@ void GLATEventList::read_events(const GFitsTable& table)
                 m_events[i].m_difrsp = new double[num_difrsp];
             }
 
+            // Allocate buffer for column values
+            std::vector<double> difrsp(num);
+
             // Load diffuse columns
             for (int k = 0; k < num_difrsp; ++k) {
 
@@ -548,13 +551,12 @@ void GLATEventList::read_events(const GFitsTable& table)
                     m_difrsp_label.push_back("NONE");
                 }
 
-                // Get column pointer
-                GFitsTableFloatCol* ptr_dif = 
-                    static_cast<GFitsTableFloatCol*>(const_cast<GFitsTableCol*>(&table[std::string(keyword)]));
+                // Get column values
+                table[std::string(keyword)].values(0, num, &(difrsp[0]));
 
                 // Copy data from columns into GLATEventAtom objects
                 for (int i = 0; i < num; ++i) {
-                    m_events[i].m_difrsp[k] = (*ptr_dif)(i);
+                    m_events[i].m_difrsp[k] = difrsp[i];
                 }
 
             } // endfor: looped over diffuse columns
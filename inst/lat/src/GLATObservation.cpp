@@ -92,6 +92,27 @@ GLATObservation::GLATObservation(const GLATObservation& obs) : GObservation(obs)
 }
 
 
+/***********************************************************************//**
+ * @brief Working copy constructor
+ *
+ * @param[in] obs LAT observation.
+ * @param[in] share_events Reference the event container of @p obs?
+ ***************************************************************************/
+GLATObservation::GLATObservation(const GLATObservation& obs,
+                                 const bool&            share_events) :
+                                 GObservation(obs, share_events)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(obs);
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Destructor
  ***************************************************************************/
@@ -173,6 +194,21 @@ GLATObservation* GLATObservation::clone(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Clone working copy of instance
+ *
+ * @param[in] share_events Reference the event container?
+ *
+ * Returns a working copy that references the response cache and optionally
+ * the event container of the observation (see
+ * GObservation::shallow_clone()).
+ ***************************************************************************/
+GLATObservation* GLATObservation::shallow_clone(const bool& share_events) const
+{
+    return new GLATObservation(*this, share_events);
+}
+
+
 /***********************************************************************//**
  * @brief Set response function
  *
@@ -394,14 +394,15 @@ double GLATResponse::irf(const GLATEventBin& event,
     if (idiff != -1) {
 
         // Get srcmap indices and weighting factors
-        GNodeArray nodes = cube->enodes();
-        nodes.set_value(srcEng.log10MeV());
+        int    inx[2];
+        double wgt[2];
+        cube->enodes().interpolate(srcEng.log10MeV(), inx, wgt);
 
         // Compute diffuse response
         GSkymap* map    = cube->diffrsp(idiff);
         double*  pixels = map->pixels() + event.ipix();
-        rsp             = nodes.wgt_left()  * pixels[nodes.inx_left()  * map->npix()] +
-                          nodes.wgt_right() * pixels[nodes.inx_right() * map->npix()];
+        rsp             = wgt[0] * pixels[inx[0] * map->npix()] +
+                          wgt[1] * pixels[inx[1] * map->npix()];
 
         // Divide by solid angle and ontime since source maps are given in units of
         // counts/pixel/MeV.
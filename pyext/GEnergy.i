@@ -67,6 +67,7 @@ public:
     void     erg(const double& eng);
     void     keV(const double& eng);
     void     MeV(const double& eng);
+    void     MeV(const double& eng, const double& log10eng);
     void     GeV(const double& eng);
     void     TeV(const double& eng);
     void     log10keV(const double& eng);
@@ -163,6 +163,7 @@ public:
     void        save(bool clobber = false);
     void        saveto(const std::string& filename, bool clobber = false);
     void        close(void);
+    void        map(void);
     void        append(const GFitsHDU& hdu);
     bool        hashdu(const std::string& extname) const;
     bool        hashdu(int extno) const;
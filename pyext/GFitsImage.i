@@ -37,6 +37,9 @@
 #include "GFitsImageUShort.hpp"
 #include "GTools.hpp"
 %}
+%include "std_vector.i"
+%template(vectori) std::vector<int>;
+%template(vectord) std::vector<double>;
 
 /***********************************************************************//**
  * @brief Tuple to index conversion to provide pixel access.
@@ -122,6 +125,16 @@ public:
     int   naxis(void) const;
     int   naxes(int axis) const;
     int   anynul(void) const;
+    bool  ismapped(void) const;
+    void  compression(const std::string& type);
+    std::string compression(void) const;
+    int   planes(void) const;
+    std::vector<double> plane(const int& iplane) const;
+    std::vector<double> region(const std::vector<int>& first,
+                               const std::vector<int>& last) const;
+    void  cache_budget(const double& mbytes);
+    double cache_budget(void) const;
+    bool  islazy(void) const;
     void  nulval(const void* value);
     void* nulval(void);
 };
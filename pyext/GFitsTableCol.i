@@ -40,8 +40,6 @@
 #include "GTools.hpp"
 #include "GException.hpp"
 %}
-%include "std_vector.i"
-%template(vectori) std::vector<int>;
 
 
 /***********************************************************************//**
@@ -82,6 +80,8 @@ public:
     int              number(void) const;
     int              length(void) const;
     int              anynul(void) const;
+    bool             ismapped(void) const;
+    void             release(void);
 };
 
 
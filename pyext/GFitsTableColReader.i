@@ -0,0 +1,74 @@
+/***************************************************************************
+ *         GFitsTableColReader.i - FITS table column chunk reader          *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsTableColReader.i
+ * @brief FITS table column chunk reader class Python interface definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GFitsTableColReader.hpp"
+#include "GTools.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GFitsTableColReader
+ *
+ * @brief FITS table column chunk reader
+ ***************************************************************************/
+class GFitsTableColReader : public GBase {
+public:
+    // Constructors and destructors
+    GFitsTableColReader(void);
+    explicit GFitsTableColReader(const GFitsTableCol* column,
+                                 const int&           chunk = 100000);
+    GFitsTableColReader(const GFitsTableColReader& reader);
+    virtual ~GFitsTableColReader(void);
+
+    // Methods
+    void                 clear(void);
+    GFitsTableColReader* clone(void) const;
+    void                 chunk(const int& chunk);
+    int                  chunk(void) const;
+    void                 prefetch(const bool& prefetch);
+    bool                 prefetch(void) const;
+    bool                 next(void);
+    void                 rewind(void);
+    int                  row(void) const;
+    int                  rows(void) const;
+};
+
+
+/***********************************************************************//**
+ * @brief GFitsTableColReader class extension
+ ***************************************************************************/
+%extend GFitsTableColReader {
+    char *__str__() {
+        return tochar(self->print());
+    }
+    double __call__(const int& row, const int& inx = 0) {
+        return (*self)(row, inx);
+    }
+    GFitsTableColReader copy() {
+        return (*self);
+    }
+};
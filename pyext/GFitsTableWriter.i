@@ -0,0 +1,72 @@
+/***************************************************************************
+ *            GFitsTableWriter.i - Streaming FITS table writer             *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsTableWriter.i
+ * @brief Streaming FITS table writer class Python interface definition
+ * @author Juergen Knoedlseder
+ */
+%{
+/* Put headers and other declarations here that are needed for compilation */
+#include "GFitsTableWriter.hpp"
+#include "GTools.hpp"
+%}
+
+
+/***********************************************************************//**
+ * @class GFitsTableWriter
+ *
+ * @brief Streaming FITS table writer
+ ***************************************************************************/
+class GFitsTableWriter : public GBase {
+public:
+    // Constructors and destructors
+    GFitsTableWriter(void);
+    explicit GFitsTableWriter(const std::string& filename,
+                              const std::string& extname);
+    GFitsTableWriter(const GFitsTableWriter& writer);
+    virtual ~GFitsTableWriter(void);
+
+    // Methods
+    void              clear(void);
+    GFitsTableWriter* clone(void) const;
+    void              open(const std::string& filename,
+                           const std::string& extname);
+    void              write(const GFitsTable& block);
+    void              flush(void);
+    void              close(void);
+    bool              is_open(void) const;
+    int               rows(void) const;
+    void              threads(const int& threads);
+    int               threads(void) const;
+};
+
+
+/***********************************************************************//**
+ * @brief GFitsTableWriter class extension
+ ***************************************************************************/
+%extend GFitsTableWriter {
+    char *__str__() {
+        return tochar(self->print());
+    }
+    GFitsTableWriter copy() {
+        return (*self);
+    }
+};
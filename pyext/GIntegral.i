@@ -54,6 +54,8 @@ public:
     void             eps(const double& eps);
     void             silent(const bool& silent);
     const int&       iter(void) const;
+    const int&       calls(void) const;
+    const double&    error(void) const;
     const int&       max_iter(void) const;
     const double&    eps(void) const;
     const bool&      silent(void) const;
@@ -61,6 +63,7 @@ public:
     const GFunction* kernel(void) const;
     double           romb(double a, double b, int k = 5);
     double           trapzd(double a, double b, int n = 1, double result = 0.0);
+    double           gkq(double a, double b, int n = 15);
 };
 
 
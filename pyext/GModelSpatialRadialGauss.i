@@ -52,6 +52,7 @@ public:
     virtual double                    eval_gradients(const double& theta) const;
     virtual GSkyDir                   mc(GRan& ran) const;
     virtual double                    theta_max(void) const;
+    virtual double                    theta_max_gradient(const int& ipar) const;
     virtual void                      read(const GXmlElement& xml);
     virtual void                      write(GXmlElement& xml) const;
 
@@ -87,6 +87,7 @@ public:
     const std::string&    statistics(void) const;
 
     // Other methods
+    void           use_irf_cache(const bool& use);
     virtual double model_grad(const GModel& model, const GEvent& event, int ipar) const;
     virtual double npred_grad(const GModel& model, int ipar) const;
 };
@@ -58,6 +58,10 @@ public:
     void           save(const std::string& filename) const;
     void           read(const GXml& xml);
     void           write(GXml& xml) const;
+    void           load_threads(const int& threads);
+    int            load_threads(void) const;
+    void           load_budget(const double& budget);
+    double         load_budget(void) const;
     void           models(const GModels& models);
     void           models(const std::string& filename);
     const GModels& models(void);
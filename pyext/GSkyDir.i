@@ -47,6 +47,8 @@ public:
     void     clear(void);
     GSkyDir* clone(void) const;
     void     radec(const double& ra, const double& dec);
+    void     radec(const double& ra, const double& dec,
+                   const double& x, const double& y, const double& z);
     void     radec_deg(const double& ra, const double& dec);
     void     lb(const double& l, const double& b);
     void     lb_deg(const double& l, const double& b);
@@ -61,6 +63,7 @@ public:
     double   dec(void) const;
     double   dec_deg(void) const;
     GVector  celvector(void) const;
+    double   cos_dist(const GSkyDir& dir) const;
     double   dist(const GSkyDir& dir) const;
     double   dist_deg(const GSkyDir& dir) const;
     double   posang(const GSkyDir& dir) const;
@@ -113,11 +113,12 @@ public:
     explicit GSkymap(const std::string& filename);
     explicit GSkymap(const std::string& wcs, const std::string& coords,
                      const int& nside, const std::string& order,
-                     const int nmaps = 1);
+                     const int nmaps = 1, const bool sparse = false);
     explicit GSkymap(const std::string& wcs, const std::string& coords,
                      double const& x, double const& y,
                      double const& dx, double const& dy,
-                     const int& nx, const int& ny, const int nmaps = 1);
+                     const int& nx, const int& ny, const int nmaps = 1,
+                     const bool sparse = false);
     GSkymap(const GSkymap& map);
     virtual ~GSkymap(void);
 
@@ -142,6 +143,12 @@ public:
     GWcs*     wcs(void) const;
     void      wcs(const GWcs& wcs);
     double*   pixels(void) const;
+    bool      issparse(void) const;
+    void      sparse(void);
+    void      dense(void);
+    int       nstored(void) const;
+    int       bitpix(void) const;
+    void      bitpix(const int& bitpix);
     bool      isinmap(const GSkyDir& dir) const;
     bool      isinmap(const GSkyPixel& pixel) const;
 };
@@ -63,6 +63,13 @@ public:
     int          nside(void) const;
     std::string  ordering(void) const;
     void         ordering(const std::string& ordering);
+    std::vector<int> query_disc(const GSkyDir& dir, const double& radius,
+                                const bool& inclusive = false) const;
+    std::vector<int> neighbours(const int& pix) const;
+    int              ring2nest(const int& pix) const;
+    int              nest2ring(const int& pix) const;
+    int              parent(const int& pix, const int& nside) const;
+    std::vector<int> children(const int& pix, const int& nside) const;
 };
 
 
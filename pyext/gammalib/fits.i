@@ -76,3 +76,5 @@
 %include "GFitsTableDoubleCol.i"
 %include "GFitsTableCFloatCol.i"
 %include "GFitsTableCDoubleCol.i"
+%include "GFitsTableColReader.i"
+%include "GFitsTableWriter.i"
@@ -31,6 +31,7 @@
 #include <cstdio>
 #include "GException.hpp"
 #include "GFitsCfitsio.hpp"
+#include "GFitsFileLock.hpp"
 #include "GFits.hpp"
 #include "GFitsImageByte.hpp"
 #include "GFitsImageSByte.hpp"
@@ -251,25 +252,32 @@ void GFits::open(const std::string& filename, bool create)
     m_readwrite = true;
     m_created   = false;
 
-    // Try opening FITS file with readwrite access
+    // Open FITS file. Opening is serialised with the closing of FITS files
+    // since cfitsio shares the file structure among all handles of a file
     int status = 0;
-    status     = __ffopen(FHANDLE(m_fitsfile), fname.c_str(), 1, &status);
+    #pragma omp critical(GFits_open)
+    {
 
-    // If failed then try opening as readonly
-    if (status == 104 || status == 112) {
-        status      = 0;
-        status      = __ffopen(FHANDLE(m_fitsfile), fname.c_str(), 0, &status);
-        m_readwrite = false;
-    }
+        // Try opening FITS file with readwrite access
+        status = __ffopen(FHANDLE(m_fitsfile), fname.c_str(), 1, &status);
 
-    // If failed and if we are allowed to create a new FITS file then create
-    // FITS file now
-    if (create && status == 104) {
-        status      = 0;
-        status      = __ffinit(FHANDLE(m_fitsfile), fname.c_str(), &status);
-        m_readwrite = true;
-        m_created   = true;
-    }
+        // If failed then try opening as readonly
+        if (status == 104 || status == 112) {
+            status      = 0;
+            status      = __ffopen(FHANDLE(m_fitsfile), fname.c_str(), 0, &status);
+            m_readwrite = false;
+        }
+
+        // If failed and if we are allowed to create a new FITS file then
+        // create FITS file now
+        if (create && status == 104) {
+            status      = 0;
+            status      = __ffinit(FHANDLE(m_fitsfile), fname.c_str(), &status);
+            m_readwrite = true;
+            m_created   = true;
+        }
+
+    } // end of critical section
 
 	// Throw special exception if status=202 (keyword not found). This error
 	// may occur if the file is opened with an expression
@@ -286,6 +294,9 @@ void GFits::open(const std::string& filename, bool create)
     // Store FITS file attributes
     m_filename = fname;
 
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
     // Determine number of HDUs
     int num_hdu = 0;
     status = __ffthdu(FPTR(m_fitsfile), &num_hdu, &status);
@@ -360,6 +371,9 @@ void GFits::open(const std::string& filename, bool create)
  ***************************************************************************/
 void GFits::save(bool clobber)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
     // Debug header
     #if DEBUG
     std::cout << "GFits::save (size=" << size() << ") -->" << std::endl;
@@ -464,6 +478,34 @@ void GFits::saveto(const std::string& filename, bool clobber)
 }
 
 
+/***********************************************************************//**
+ * @brief Map data of all HDUs into memory
+ *
+ * Maps the data units of all HDUs of the opened FITS file read-only into
+ * memory. Data that are not yet loaded are then decoded directly from the
+ * mapped file when they are accessed through the GFitsTableCol::real(),
+ * GFitsTableCol::integer(), GFitsTableCol::load_rows() or pixel() methods,
+ * instead of being loaded entirely into memory. Pages of the file are
+ * only read from disk when they are accessed, and they are shared with
+ * all processes that map the same file.
+ *
+ * Memory mapping is supported for numerical columns of binary tables and
+ * for unscaled GFitsImageDouble and GFitsImageFloat images of uncompressed
+ * FITS files on disk. All other data, as well as data of compressed files,
+ * are read through cfitsio as before.
+ ***************************************************************************/
+void GFits::map(void)
+{
+    // Map data of all HDUs
+    for (int i = 0; i < m_hdu.size(); ++i) {
+        m_hdu[i]->data_map();
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Close FITS file
  *
@@ -921,6 +963,9 @@ void GFits::free_members(void)
     // If FITS file has been opened then close it now
     if (m_fitsfile != NULL) {
 
+        // Lock FITS file for this thread
+        GFitsFileLock lock(m_fitsfile);
+
         // Compile option: If there are no HDUs then delete the file (don't
         // worry about error)
         #if DELETE_EMPTY_FITS_FILES
@@ -933,7 +978,8 @@ void GFits::free_members(void)
 
         // Close the file
         int status = 0;
-        status     = __ffclos(FPTR(m_fitsfile), &status);
+        #pragma omp critical(GFits_open)
+        status = __ffclos(FPTR(m_fitsfile), &status);
         if (status == 252) {
             int new_status = 0;
             __ffdelt(FPTR(m_fitsfile), &new_status);
@@ -983,6 +1029,9 @@ void GFits::free_members(void)
  ***************************************************************************/
 GFitsImage* GFits::new_image(void)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
     // Initialise return value
     GFitsImage* image = NULL;
 
@@ -79,10 +79,12 @@
 #define __ffirow(A, B, C, D) ffirow(A, B, C, D)
 #define __ffopen(A, B, C, D) ffopen(A, B, C, D)
 #define __ffmahd(A, B, C, D) ffmahd(A, B, C, D)
+#define __ffmnhd(A, B, C, D, E) ffmnhd(A, B, C, D, E)
 #define __ffpcn(A, B, C, D, E, F, G, H, I) ffpcn(A, B, C, D, E, F, G, H, I)
 #define __ffpcom(A, B, C) ffpcom(A, B, C)
 #define __ffphis(A, B, C) ffphis(A, B, C)
 #define __ffpss(A, B, C, D, E, F) ffpss(A, B, C, D, E, F)
+#define __ffptbb(A, B, C, D, E, F) ffptbb(A, B, C, D, E, F)
 #define __ffsrow(A, B, C, D) ffsrow(A, B, C, D)
 #define __ffthdu(A, B, C) ffthdu(A, B, C)
 #define __ffuky(A, B, C, D, E, F) ffuky(A, B, C, D, E, F)
@@ -91,6 +93,11 @@
 #define __ffukyj(A, B, C, D, E) ffukyj(A, B, C, D, E)
 #define __ffukyl(A, B, C, D, E) ffukyl(A, B, C, D, E)
 #define __ffukys(A, B, C, D, E) ffukys(A, B, C, D, E)
+#define __ffgcmp(A, B, C) fits_get_compression_type(A, B, C)
+#define __ffiscmp(A, B) fits_is_compressed_image(A, B)
+#define __ffscmp(A, B, C) fits_set_compression_type(A, B, C)
+#define __ffsqnt(A, B, C) fits_set_quantize_level(A, B, C)
+#define __ffstil(A, B, C, D) fits_set_tile_dim(A, B, C, D)
 #define __TBIT        TBIT
 #define __TBYTE       TBYTE
 #define __TSBYTE      TSBYTE
@@ -107,6 +114,10 @@
 #define __TDOUBLE     TDOUBLE
 #define __TCOMPLEX    TCOMPLEX
 #define __TDBLCOMPLEX TDBLCOMPLEX
+#define __RICE_1      RICE_1
+#define __GZIP_1      GZIP_1
+#define __HCOMPRESS_1 HCOMPRESS_1
+#define __BINARY_TBL  BINARY_TBL
 
 /* __ Type definition ____________________________________________________ */
 typedef fitsfile __fitsfile;
@@ -145,11 +156,13 @@ typedef fitsfile __fitsfile;
 #define __ffinit(A, B, C) __dummy()
 #define __ffirow(A, B, C, D) __dummy()
 #define __ffmahd(A, B, C, D) __dummy()
+#define __ffmnhd(A, B, C, D, E) __dummy()
 #define __ffpcn(A, B, C, D, E, F, G, H, I) __dummy()
 #define __ffopen(A, B, C, D) __dummy()
 #define __ffpcom(A, B, C) __dummy()
 #define __ffphis(A, B, C) __dummy()
 #define __ffpss(A, B, C, D, E, F) __dummy()
+#define __ffptbb(A, B, C, D, E, F) __dummy()
 #define __ffsrow(A, B, C, D) __dummy()
 #define __ffthdu(A, B, C) __dummy()
 #define __ffuky(A, B, C, D, E, F) __dummy()
@@ -158,6 +171,11 @@ typedef fitsfile __fitsfile;
 #define __ffukyj(A, B, C, D, E) __dummy()
 #define __ffukyl(A, B, C, D, E) __dummy()
 #define __ffukys(A, B, C, D, E) __dummy()
+#define __ffgcmp(A, B, C) __dummy()
+#define __ffiscmp(A, B) __dummy()
+#define __ffscmp(A, B, C) __dummy()
+#define __ffsqnt(A, B, C) __dummy()
+#define __ffstil(A, B, C, D) __dummy()
 #define __TBIT          1
 #define __TBYTE        11
 #define __TSBYTE       12
@@ -174,6 +192,10 @@ typedef fitsfile __fitsfile;
 #define __TDOUBLE      82
 #define __TCOMPLEX     83
 #define __TDBLCOMPLEX 163
+#define __RICE_1       11
+#define __GZIP_1       21
+#define __HCOMPRESS_1  41
+#define __BINARY_TBL    2
 
 /* __ Type definition ____________________________________________________ */
 typedef struct {
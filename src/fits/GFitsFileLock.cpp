@@ -0,0 +1,126 @@
+/***************************************************************************
+ *              GFitsFileLock.cpp - Thread lock for FITS file              *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsFileLock.cpp
+ * @brief Thread lock for FITS file class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <map>
+#include "GFitsCfitsio.hpp"
+#include "GFitsFileLock.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+/* __ Local data _________________________________________________________ */
+#ifdef _OPENMP
+// Locks of all cfitsio file structures. Locks are never removed, as the
+// structure of a closed file may still be referenced by other handles.
+// The number of locks is bounded by the number of distinct addresses of
+// file structures.
+static std::map<const void*, omp_nest_lock_t*> g_fits_locks;
+#endif
+
+
+/*==========================================================================
+ =                                                                         =
+ =                         Constructors/destructors                        =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief FITS file constructor
+ *
+ * @param[in] fitsfile FITS file pointer.
+ *
+ * Acquires the lock of the cfitsio file structure the FITS file pointer
+ * refers to. The constructor blocks until no other thread holds the lock.
+ * The lock is recursive, hence a thread that already holds the lock of the
+ * file structure acquires it again without blocking. No lock is acquired
+ * if the FITS file pointer is NULL or if it is not attached to a file.
+ ***************************************************************************/
+GFitsFileLock::GFitsFileLock(const void* fitsfile)
+{
+    // Initialise lock
+    m_lock = NULL;
+
+    // Acquire lock of file structure
+    #ifdef _OPENMP
+    const void* key = (fitsfile != NULL) ? (const void*)FPTR(fitsfile)->Fptr : NULL;
+    if (key != NULL) {
+
+        // Get lock of file structure, creating it if necessary
+        omp_nest_lock_t* lock = NULL;
+        #pragma omp critical(GFitsFileLock_registry)
+        {
+            std::map<const void*, omp_nest_lock_t*>::iterator it = g_fits_locks.find(key);
+            if (it != g_fits_locks.end()) {
+                lock = it->second;
+            }
+            else {
+                lock = new omp_nest_lock_t;
+                omp_init_nest_lock(lock);
+                g_fits_locks[key] = lock;
+            }
+        }
+
+        // Acquire lock
+        omp_set_nest_lock(lock);
+        m_lock = lock;
+
+    } // endif: file structure existed
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ *
+ * Releases the lock.
+ ***************************************************************************/
+GFitsFileLock::~GFitsFileLock(void)
+{
+    // Release lock
+    #ifdef _OPENMP
+    if (m_lock != NULL) {
+        omp_unset_nest_lock((omp_nest_lock_t*)m_lock);
+    }
+    #endif
+
+    // Return
+    return;
+}
@@ -32,6 +32,7 @@
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GFitsCfitsio.hpp"
+#include "GFitsFileLock.hpp"
 #include "GFitsHDU.hpp"
 #include "GFitsHeaderCard.hpp"
 #include "GTools.hpp"
@@ -368,6 +369,9 @@ void GFitsHDU::connect(void* vptr)
  ***************************************************************************/
 void GFitsHDU::move_to_hdu(void)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
     // Throw an exception if FITS file is not open
     if (FPTR(m_fitsfile)->Fptr == NULL) {
         throw GException::fits_file_not_open(G_MOVE_TO_HDU, 
@@ -397,6 +401,9 @@ void GFitsHDU::move_to_hdu(void)
  ***************************************************************************/
 GFitsHDU::HDUType GFitsHDU::get_hdu_type(void) const
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
     // Initialise HDU type
     int type = 0;
 
@@ -436,6 +443,9 @@ GFitsHDU::HDUType GFitsHDU::get_hdu_type(void) const
  ***************************************************************************/
 void GFitsHDU::open(void* vptr, int hdunum)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(vptr);
+
     // Verify that FITS file pointer is valid
     if (vptr == NULL)
         throw GException::fits_file_not_open(G_OPEN,
@@ -489,6 +499,9 @@ void GFitsHDU::open(void* vptr, int hdunum)
  ***************************************************************************/
 void GFitsHDU::save(void)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
     // Debug header
     #if DEBUG
     std::cout << "GFitsHDU::save() -->" << std::endl;
@@ -589,6 +602,20 @@ std::string GFitsHDU::typecode(int type) const
 }
 
 
+/***********************************************************************//**
+ * @brief Map HDU data into memory
+ *
+ * Maps the data unit of the HDU read-only into memory. This default
+ * implementation does nothing. It is overloaded by the HDU types that
+ * support memory mapped data access.
+ ***************************************************************************/
+void GFitsHDU::data_map(void)
+{
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
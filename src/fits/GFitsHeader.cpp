@@ -30,6 +30,7 @@
 #endif
 #include "GException.hpp"
 #include "GFitsCfitsio.hpp"
+#include "GFitsFileLock.hpp"
 #include "GFitsHeader.hpp"
 #include "GTools.hpp"
 
@@ -185,6 +186,9 @@ int GFitsHeader::size(void) const
  ***************************************************************************/
 void GFitsHeader::open(void* vptr)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(vptr);
+
     // Move to HDU
     int status = 0;
     status     = __ffmahd(FPTR(vptr), (FPTR(vptr)->HDUposition)+1, NULL, &status);
@@ -231,6 +235,9 @@ void GFitsHeader::open(void* vptr)
  ***************************************************************************/
 void GFitsHeader::save(void* vptr)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(vptr);
+
     // Move to HDU
     int status = 0;
     status     = __ffmahd(FPTR(vptr), (FPTR(vptr)->HDUposition)+1, NULL, &status);
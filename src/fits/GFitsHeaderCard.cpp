@@ -33,6 +33,7 @@
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GFitsCfitsio.hpp"
+#include "GFitsFileLock.hpp"
 #include "GFitsHeaderCard.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -1043,6 +1044,9 @@ void GFitsHeaderCard::set_dtype(const std::string& value)
  ***************************************************************************/
 void GFitsHeaderCard::read(void* vptr, int keynum)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(vptr);
+
     // Move to HDU
     int status = 0;
     status     = __ffmahd(FPTR(vptr), (FPTR(vptr)->HDUposition)+1, NULL,
@@ -1079,6 +1083,9 @@ void GFitsHeaderCard::read(void* vptr, int keynum)
  ***************************************************************************/
 void GFitsHeaderCard::read(void* vptr, const std::string& keyname)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(vptr);
+
     // Move to HDU
     int status = 0;
     status     = __ffmahd(FPTR(vptr), (FPTR(vptr)->HDUposition)+1, NULL,
@@ -1120,6 +1127,9 @@ void GFitsHeaderCard::read(void* vptr, const std::string& keyname)
  ***************************************************************************/
 void GFitsHeaderCard::write(void* vptr)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(vptr);
+
     // Move to HDU
     int status = 0;
     status     = __ffmahd(FPTR(vptr), (FPTR(vptr)->HDUposition)+1, NULL,
@@ -28,8 +28,10 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <cstdlib>
 #include "GException.hpp"
 #include "GFitsCfitsio.hpp"
+#include "GFitsFileLock.hpp"
 #include "GFitsImage.hpp"
 #include "GTools.hpp"
 
@@ -38,6 +40,12 @@
 #define G_OPEN_IMAGE                                "GFitsImage::open(void*)"
 #define G_LOAD_IMAGE           "GFitsImage::load_image(int,void*,void*,int*)"
 #define G_SAVE_IMAGE                      "GFitsImage::save_image(int,void*)"
+#define G_DATA_MAP                                   "GFitsImage::data_map()"
+#define G_COMPRESSION                   "GFitsImage::compression(std::string&)"
+#define G_PLANE                                     "GFitsImage::plane(int&)"
+#define G_REGION      "GFitsImage::region(std::vector<int>&,std::vector<int>&)"
+#define G_CACHE_BUDGET                 "GFitsImage::cache_budget(double&)"
+#define G_READ_PIXELS           "GFitsImage::read_pixels(long*,long*,double*)"
 #define G_OFFSET_1D                                "GFitsImage::offset(int&)"
 #define G_OFFSET_2D                           "GFitsImage::offset(int&,int&)"
 #define G_OFFSET_3D                      "GFitsImage::offset(int&,int&,int&)"
@@ -46,6 +54,7 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_MAX_TILE_PIXELS 4194304   //!< Maximum number of pixels per tile
 
 /* __ Debug definitions __________________________________________________ */
 
@@ -427,6 +436,315 @@ void* GFitsImage::nulval(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Set tile compression algorithm
+ *
+ * @param[in] type Compression algorithm (NONE, RICE, GZIP or HCOMPRESS).
+ *
+ * @exception GException::invalid_argument
+ *            Invalid compression algorithm specified or lossy compression
+ *            algorithm specified for floating point image.
+ *
+ * Sets the algorithm that is used to tile-compress the image when it is
+ * written into a new FITS file HDU. The tile size is chosen automatically:
+ * each tile holds one image plane (the first two image axes), unless the
+ * plane exceeds G_MAX_TILE_PIXELS pixels, in which case each tile holds as
+ * many full image rows as fit into G_MAX_TILE_PIXELS pixels.
+ *
+ * Floating point images are not quantized, so that compression is
+ * lossless for all image types. cfitsio supports unquantized floating
+ * point pixels only for GZIP compression, hence RICE and HCOMPRESS are
+ * rejected for floating point images.
+ *
+ * Note that the compression only applies to HDUs that are newly created
+ * in a FITS file. An existing HDU keeps its compression.
+ ***************************************************************************/
+void GFitsImage::compression(const std::string& type)
+{
+    // Set compression type
+    std::string ctype = toupper(type);
+    if (ctype == "NONE") {
+        m_compression = 0;
+    }
+    else if (ctype == "RICE") {
+        m_compression = __RICE_1;
+    }
+    else if (ctype == "GZIP") {
+        m_compression = __GZIP_1;
+    }
+    else if (ctype == "HCOMPRESS") {
+        m_compression = __HCOMPRESS_1;
+    }
+    else {
+        throw GException::invalid_argument(G_COMPRESSION,
+              "Unknown compression algorithm \""+type+"\". Specify one of"
+              " NONE, RICE, GZIP or HCOMPRESS.");
+    }
+
+    // Reject lossy compression of floating point images
+    if (m_bitpix < 0 && m_compression != 0 && m_compression != __GZIP_1) {
+        m_compression = 0;
+        throw GException::invalid_argument(G_COMPRESSION,
+              ctype+" compression of floating point images requires"
+              " quantization. Specify GZIP for lossless compression of"
+              " floating point images.");
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return tile compression algorithm
+ *
+ * @return Compression algorithm (NONE, RICE, GZIP, HCOMPRESS or OTHER).
+ ***************************************************************************/
+std::string GFitsImage::compression(void) const
+{
+    // Set compression type
+    std::string type = "NONE";
+    if (m_compression == __RICE_1) {
+        type = "RICE";
+    }
+    else if (m_compression == __GZIP_1) {
+        type = "GZIP";
+    }
+    else if (m_compression == __HCOMPRESS_1) {
+        type = "HCOMPRESS";
+    }
+    else if (m_compression != 0) {
+        type = "OTHER";
+    }
+
+    // Return type
+    return type;
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of image planes
+ *
+ * @return Number of image planes.
+ *
+ * An image plane spans the first two image axes, and planes are counted
+ * over all remaining image axes. A one-dimensional image consists of a
+ * single plane.
+ ***************************************************************************/
+int GFitsImage::planes(void) const
+{
+    // Get number of pixels per plane
+    int size = plane_size();
+
+    // Return number of planes
+    return ((size > 0) ? m_num_pixels / size : 0);
+}
+
+
+/***********************************************************************//**
+ * @brief Return pixels of an image plane
+ *
+ * @param[in] iplane Plane index [0,...,planes()-1].
+ * @return Plane pixels.
+ *
+ * @exception GException::out_of_range
+ *            Plane index out of range.
+ *
+ * Returns the pixels of the specified image plane, with the first image
+ * axis varying fastest. If the image pixels have not been loaded into
+ * memory, only the requested plane is read from the FITS file. If a plane
+ * cache budget has been set, the plane is taken from (or put into) the
+ * plane cache.
+ ***************************************************************************/
+std::vector<double> GFitsImage::plane(const int& iplane) const
+{
+    // Throw an exception if plane index is out of range
+    int nplanes = planes();
+    if (iplane < 0 || iplane >= nplanes) {
+        throw GException::out_of_range(G_PLANE, iplane, 0, nplanes-1);
+    }
+
+    // Get number of pixels per plane
+    int size = plane_size();
+
+    // If pixels are loaded on demand then get plane from cache
+    if (islazy()) {
+        return (cached_plane(iplane));
+    }
+
+    // Allocate plane pixels
+    std::vector<double> pixels(size);
+
+    // If pixels are on disk then read plane from FITS file, otherwise
+    // copy plane from memory
+    if (ondisk()) {
+        read_plane(iplane, &(pixels[0]));
+    }
+    else {
+        int start = iplane * size;
+        for (int i = 0; i < size; ++i) {
+            pixels[i] = pixel(start+i);
+        }
+    }
+
+    // Return plane pixels
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Return pixels of a rectangular image region
+ *
+ * @param[in] first First pixel of region in every image axis.
+ * @param[in] last Last pixel of region in every image axis.
+ * @return Region pixels.
+ *
+ * @exception GException::invalid_argument
+ *            Region dimension differs from image dimension.
+ * @exception GException::out_of_range
+ *            Region exceeds image.
+ *
+ * Returns the pixels of the rectangular region [first,last] of the image,
+ * where pixel indices start from 0 and @p last is included in the region.
+ * The first image axis varies fastest in the returned pixels. If the image
+ * pixels have not been loaded into memory, only the requested region is
+ * read from the FITS file. Regions are not put into the plane cache.
+ ***************************************************************************/
+std::vector<double> GFitsImage::region(const std::vector<int>& first,
+                                       const std::vector<int>& last) const
+{
+    // Throw an exception if region dimension differs from image dimension
+    if ((int)first.size() != m_naxis || (int)last.size() != m_naxis) {
+        throw GException::invalid_argument(G_REGION,
+              "Region dimension ("+str((int)first.size())+","+
+              str((int)last.size())+") differs from image dimension ("+
+              str(m_naxis)+").");
+    }
+
+    // Check region and determine number of region pixels
+    int num = (m_naxis > 0) ? 1 : 0;
+    for (int i = 0; i < m_naxis; ++i) {
+        if (first[i] < 0 || first[i] >= m_naxes[i]) {
+            throw GException::out_of_range(G_REGION, first[i], 0, m_naxes[i]-1);
+        }
+        if (last[i] < first[i] || last[i] >= m_naxes[i]) {
+            throw GException::out_of_range(G_REGION, last[i], first[i],
+                                           m_naxes[i]-1);
+        }
+        num *= last[i] - first[i] + 1;
+    }
+
+    // Allocate region pixels
+    std::vector<double> pixels(num);
+
+    // Continue only if region is not empty
+    if (num > 0) {
+
+        // If pixels are on disk then read region from FITS file
+        if (ondisk()) {
+            long* fpixel = new long[m_naxis];
+            long* lpixel = new long[m_naxis];
+            for (int i = 0; i < m_naxis; ++i) {
+                fpixel[i] = first[i] + 1;
+                lpixel[i] = last[i]  + 1;
+            }
+            try {
+                read_pixels(fpixel, lpixel, &(pixels[0]));
+            }
+            catch (...) {
+                delete [] fpixel;
+                delete [] lpixel;
+                throw;
+            }
+            delete [] fpixel;
+            delete [] lpixel;
+        }
+
+        // ... otherwise copy region from memory
+        else {
+            std::vector<int> index = first;
+            for (int k = 0; k < num; ++k) {
+
+                // Compute pixel offset
+                int offset = 0;
+                int stride = 1;
+                for (int i = 0; i < m_naxis; ++i) {
+                    offset += index[i] * stride;
+                    stride *= m_naxes[i];
+                }
+
+                // Get pixel
+                pixels[k] = pixel(offset);
+
+                // Increment pixel index
+                for (int i = 0; i < m_naxis; ++i) {
+                    if (index[i] < last[i]) {
+                        index[i]++;
+                        break;
+                    }
+                    index[i] = first[i];
+                }
+
+            } // endfor: looped over region pixels
+        }
+
+    } // endif: region was not empty
+
+    // Return region pixels
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Set plane cache budget
+ *
+ * @param[in] mbytes Plane cache budget (MB).
+ *
+ * @exception GException::invalid_argument
+ *            Negative plane cache budget specified.
+ *
+ * Sets the memory budget of the plane cache. A positive budget enables
+ * on demand loading of the image pixels: as long as the image pixels have
+ * not been loaded into memory, read access through the pixel() methods
+ * only loads the image planes that are touched. The most recently used
+ * planes are kept in the cache as long as they fit into the budget, yet
+ * the cache always holds at least one plane. Any write access to the
+ * pixels loads the full image into memory, which empties the cache.
+ *
+ * A budget of zero (the default) disables on demand loading.
+ ***************************************************************************/
+void GFitsImage::cache_budget(const double& mbytes)
+{
+    // Throw an exception if budget is negative
+    if (mbytes < 0.0) {
+        throw GException::invalid_argument(G_CACHE_BUDGET,
+              "Plane cache budget "+str(mbytes)+" MB must not be negative.");
+    }
+
+    // Set budget and empty cache
+    m_cache_budget = mbytes;
+    clear_cache();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Signal if pixels are loaded on demand
+ *
+ * @return True if pixels are loaded on demand.
+ *
+ * Pixels are loaded on demand if a plane cache budget has been set and if
+ * the image pixels have not yet been loaded from the attached FITS file.
+ ***************************************************************************/
+bool GFitsImage::islazy(void) const
+{
+    // Return lazy flag
+    return (m_cache_budget > 0.0 && ondisk());
+}
+
+
 /***********************************************************************//**
  * @brief Print column information
  *
@@ -449,6 +767,13 @@ std::string GFitsImage::print(void) const
     result.append(parformat("Image type")+typecode(type())+"\n");
     result.append(parformat("Number of dimensions")+str(naxis())+"\n");
     result.append(parformat("Number of image pixels")+str(size()));
+    if (m_compression != 0) {
+        result.append("\n"+parformat("Tile compression")+compression());
+    }
+    if (m_cache_budget > 0.0) {
+        result.append("\n"+parformat("Plane cache budget")+str(m_cache_budget)+
+                      " MB ("+str((int)m_cache.size())+" planes cached)");
+    }
     for (int i = 0; i < naxis(); ++i) {
         result.append("\n"+parformat("Number of bins in "+str(i)) +
                       str(naxes(i)));
@@ -540,6 +865,90 @@ void GFitsImage::data_connect(void* vptr)
 }
 
 
+/***********************************************************************//**
+ * @brief Map image data into memory
+ *
+ * @exception GException::fits_error
+ *            FITS error.
+ *
+ * Maps the pixels of the image read-only into memory. Images with
+ * scaled pixel values (BSCALE different from 1 or BZERO different from 0)
+ * and tile-compressed images are not mapped. Pixel values that are not
+ * yet loaded into memory are then decoded directly from the mapped file.
+ ***************************************************************************/
+void GFitsImage::data_map(void)
+{
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
+    #if defined(HAVE_LIBCFITSIO)
+    // Continue only if the image is attached to a FITS file
+    if (FPTR(m_fitsfile)->Fptr != NULL && m_num_pixels > 0) {
+
+        // Move to HDU
+        int status = 0;
+        status     = __ffmahd(FPTR(m_fitsfile),
+                              (FPTR(m_fitsfile)->HDUposition)+1, NULL, &status);
+        if (status != 0) {
+            throw GException::fits_error(G_DATA_MAP, status);
+        }
+
+        // Check that image pixels are neither compressed nor scaled
+        FITSfile* file   = FPTR(m_fitsfile)->Fptr;
+        bool      scaled = (hascard("BSCALE") && real("BSCALE") != 1.0) ||
+                           (hascard("BZERO")  && real("BZERO")  != 0.0);
+
+        // Map image pixels
+        if (!file->compressimg && !scaled) {
+            long long size = (long long)(m_num_pixels) *
+                             (long long)(std::abs(m_bitpix) / 8);
+            m_mmap.open(file->filename, file->datastart, size);
+        }
+
+    } // endif: image was attached to FITS file
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return pixel value from memory mapped file
+ *
+ * @param[in] offset Pixel offset.
+ * @return Pixel value.
+ ***************************************************************************/
+double GFitsImage::mapped_pixel(const int& offset) const
+{
+    // Determine data type and size of a pixel
+    int type = __TBYTE;
+    switch (m_bitpix) {
+    case 16:
+        type = __TSHORT;
+        break;
+    case 32:
+        type = __TLONG;
+        break;
+    case 64:
+        type = __TLONGLONG;
+        break;
+    case -32:
+        type = __TFLOAT;
+        break;
+    case -64:
+        type = __TDOUBLE;
+        break;
+    default:
+        break;
+    }
+    long long bytes = (long long)(std::abs(m_bitpix) / 8);
+
+    // Return pixel value
+    return (m_mmap.real(type, (long long)(offset) * bytes));
+}
+
+
 /***********************************************************************//**
  * @brief Initialise image header
  *
@@ -587,6 +996,9 @@ void GFitsImage::init_image_header(void)
  ***************************************************************************/
 void GFitsImage::open_image(void* vptr)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(vptr);
+
     // Move to HDU
     int status = 0;
     status     = __ffmahd(FPTR(vptr), (FPTR(vptr)->HDUposition)+1, NULL, &status);
@@ -628,6 +1040,17 @@ void GFitsImage::open_image(void* vptr)
 
     } // endif: there is an image
 
+    // Get the tile compression algorithm
+    m_compression = 0;
+    #if defined(HAVE_LIBCFITSIO)
+    if (__ffiscmp(FPTR(m_fitsfile), &status)) {
+        status = __ffgcmp(FPTR(m_fitsfile), &m_compression, &status);
+        if (status != 0) {
+            throw GException::fits_error(G_OPEN_IMAGE, status);
+        }
+    }
+    #endif
+
     // Return
     return;
 }
@@ -645,10 +1068,19 @@ void GFitsImage::open_image(void* vptr)
  *            FITS error.
  *
  * Load image pixels from FITS file.
+ *
+ * The FITS file is locked while the image is loaded (see GFitsFileLock),
+ * hence images of the same file can be loaded from parallel threads.
+ * Tile-compressed images are decompressed serially by cfitsio: all cfitsio
+ * handles that are opened on the same file share one file structure, hence
+ * the tiles cannot be decompressed in parallel through separate handles.
  ***************************************************************************/
 void GFitsImage::load_image(int datatype, const void* pixels,
                             const void* nulval, int* anynul)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
     // Move to HDU
     move_to_hdu();
 
@@ -695,6 +1127,9 @@ void GFitsImage::load_image(int datatype, const void* pixels,
  ***************************************************************************/
 void GFitsImage::save_image(int datatype, const void* pixels)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
     // Throw an exception if FITS file is not open
     if (FPTR(m_fitsfile)->Fptr == NULL) {
         throw GException::fits_file_not_open(G_SAVE_IMAGE, 
@@ -709,6 +1144,7 @@ void GFitsImage::save_image(int datatype, const void* pixels)
     // If HDU does not yet exist in file then create it now
     if (status == 107) {
         status = 0;
+        set_compression();
         status = __ffcrim(FPTR(m_fitsfile), m_bitpix, m_naxis, m_naxes, &status);
         if (status != 0) {
             throw GException::fits_error(G_SAVE_IMAGE, status);
@@ -727,6 +1163,7 @@ void GFitsImage::save_image(int datatype, const void* pixels)
         throw GException::fits_error(G_SAVE_IMAGE, status);
     }
     if (num == 0) {
+        set_compression();
         status = __ffcrim(FPTR(m_fitsfile), m_bitpix, m_naxis, m_naxes, &status);
         if (status != 0) {
             throw GException::fits_error(G_SAVE_IMAGE, status);
@@ -755,6 +1192,423 @@ void GFitsImage::save_image(int datatype, const void* pixels)
 }
 
 
+/***********************************************************************//**
+ * @brief Set tile compression parameters for a new HDU
+ *
+ * @exception GException::fits_error
+ *            FITS error.
+ *
+ * Sets the compression algorithm, the tile dimensions and the
+ * quantization level that cfitsio applies to the next image HDU that is
+ * created in the FITS file. If no compression is requested, compression
+ * is explicitly switched off.
+ *
+ * The compression algorithm of an image that was loaded from a compressed
+ * HDU is kept unless another algorithm was set using compression().
+ * Floating point images that are GZIP compressed are written without
+ * quantization. Floating point images that were loaded from a RICE or
+ * HCOMPRESS compressed HDU were quantized already, and are written with
+ * the default quantization of cfitsio.
+ ***************************************************************************/
+void GFitsImage::set_compression(void)
+{
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
+    #if defined(HAVE_LIBCFITSIO)
+    // Get compression algorithm
+    int compression = m_compression;
+
+    // Set compression algorithm
+    int status = 0;
+    status     = __ffscmp(FPTR(m_fitsfile), compression, &status);
+
+    // Set tile dimensions and quantization level
+    if (compression != 0 && m_naxis > 0) {
+
+        // Set tile dimensions. A tile holds an image plane, or as many
+        // image rows as fit into the maximum tile size.
+        long* tile = new long[m_naxis];
+        for (int i = 0; i < m_naxis; ++i) {
+            tile[i] = 1;
+        }
+        tile[0] = m_naxes[0];
+        if (m_naxis > 1) {
+            if (m_naxes[0] * m_naxes[1] <= G_MAX_TILE_PIXELS) {
+                tile[1] = m_naxes[1];
+            }
+            else {
+                tile[1] = (G_MAX_TILE_PIXELS > m_naxes[0])
+                          ? G_MAX_TILE_PIXELS / m_naxes[0] : 1;
+            }
+        }
+        status = __ffstil(FPTR(m_fitsfile), m_naxis, tile, &status);
+        delete [] tile;
+
+        // Switch off quantization of GZIP compressed floating point images
+        if (m_bitpix < 0 && compression == __GZIP_1) {
+            status = __ffsqnt(FPTR(m_fitsfile), 0.0, &status);
+        }
+
+    } // endif: compression was requested
+
+    // Throw an exception in case of an error
+    if (status != 0) {
+        throw GException::fits_error(G_SAVE_IMAGE, status);
+    }
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Signal if image pixels are only on disk
+ *
+ * @return True if a FITS file is attached and the pixels are not loaded.
+ ***************************************************************************/
+bool GFitsImage::ondisk(void) const
+{
+    // Return flag
+    return (FPTR(m_fitsfile)->Fptr != NULL &&
+            const_cast<GFitsImage*>(this)->ptr_data() == NULL);
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of pixels per image plane
+ *
+ * @return Number of pixels per image plane.
+ ***************************************************************************/
+int GFitsImage::plane_size(void) const
+{
+    // Determine plane size
+    int size = 0;
+    if (m_naxis == 1) {
+        size = m_naxes[0];
+    }
+    else if (m_naxis > 1) {
+        size = m_naxes[0] * m_naxes[1];
+    }
+
+    // Return plane size
+    return size;
+}
+
+
+/***********************************************************************//**
+ * @brief Read rectangular region of pixels from FITS file
+ *
+ * @param[in] fpixel First pixel in every image axis (starting from 1).
+ * @param[in] lpixel Last pixel in every image axis (starting from 1).
+ * @param[out] pixels Region pixels.
+ *
+ * @exception GException::fits_error
+ *            FITS error.
+ *
+ * Reads a rectangular region of pixels as double precision values from
+ * the attached FITS file, without loading the full image. Undefined pixels
+ * are set to the nul value of the image (if any).
+ ***************************************************************************/
+void GFitsImage::read_pixels(const long* fpixel, const long* lpixel,
+                             double* pixels) const
+{
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
+    // Move to HDU
+    int status = 0;
+    status     = __ffmahd(FPTR(m_fitsfile), m_hdunum+1, NULL, &status);
+    if (status != 0) {
+        throw GException::fits_error(G_READ_PIXELS, status);
+    }
+
+    // Read pixels
+    long* inc = new long[m_naxis];
+    for (int i = 0; i < m_naxis; ++i) {
+        inc[i] = 1;
+    }
+    double  nulval     = 0.0;
+    double* ptr_nulval = (nulval_value(&nulval)) ? &nulval : NULL;
+    status             = __ffgsv(FPTR(m_fitsfile), __TDOUBLE, (long*)fpixel,
+                                 (long*)lpixel, inc, ptr_nulval, pixels, NULL,
+                                 &status);
+    delete [] inc;
+    if (status != 0) {
+        throw GException::fits_error(G_READ_PIXELS, status);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Get nul value as double precision value
+ *
+ * @param[out] value Nul value.
+ * @return True if a nul value is set for the image.
+ ***************************************************************************/
+bool GFitsImage::nulval_value(double* value) const
+{
+    // Get pointer to nul value
+    const void* ptr = ptr_nulval();
+
+    // Convert nul value
+    if (ptr != NULL) {
+        switch (type()) {
+        case __TBYTE:
+            *value = (double)(*((const unsigned char*)ptr));
+            break;
+        case __TSBYTE:
+            *value = (double)(*((const char*)ptr));
+            break;
+        case __TSHORT:
+            *value = (double)(*((const short*)ptr));
+            break;
+        case __TUSHORT:
+            *value = (double)(*((const unsigned short*)ptr));
+            break;
+        case __TLONG:
+            *value = (double)(*((const long*)ptr));
+            break;
+        case __TULONG:
+            *value = (double)(*((const unsigned long*)ptr));
+            break;
+        case __TLONGLONG:
+            *value = (double)(*((const long long*)ptr));
+            break;
+        case __TFLOAT:
+            *value = (double)(*((const float*)ptr));
+            break;
+        case __TDOUBLE:
+            *value = *((const double*)ptr);
+            break;
+        default:
+            ptr = NULL;
+            break;
+        }
+    }
+
+    // Return
+    return (ptr != NULL);
+}
+
+
+/***********************************************************************//**
+ * @brief Read image plane from FITS file
+ *
+ * @param[in] iplane Plane index.
+ * @param[out] pixels Plane pixels.
+ ***************************************************************************/
+void GFitsImage::read_plane(const int& iplane, double* pixels) const
+{
+    // Set pixel range of plane
+    long* fpixel = new long[m_naxis];
+    long* lpixel = new long[m_naxis];
+    int   index  = iplane;
+    for (int i = 0; i < m_naxis; ++i) {
+        if (i < 2) {
+            fpixel[i] = 1;
+            lpixel[i] = m_naxes[i];
+        }
+        else {
+            fpixel[i] = index % m_naxes[i] + 1;
+            lpixel[i] = fpixel[i];
+            index    /= m_naxes[i];
+        }
+    }
+
+    // Read plane
+    try {
+        read_pixels(fpixel, lpixel, pixels);
+    }
+    catch (...) {
+        delete [] fpixel;
+        delete [] lpixel;
+        throw;
+    }
+
+    // Free pixel range
+    delete [] fpixel;
+    delete [] lpixel;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return pixel value from plane cache
+ *
+ * @param[in] offset Pixel offset.
+ * @return Pixel value.
+ *
+ * Returns the pixel value from the plane cache. If the plane that contains
+ * the pixel is not cached, it is read from the FITS file and put into the
+ * cache. The cache is accessed in a critical section, while the plane is
+ * read outside the critical section.
+ ***************************************************************************/
+double GFitsImage::cached_pixel(const int& offset) const
+{
+    // Get plane and pixel index
+    int size   = plane_size();
+    int iplane = offset / size;
+    int ipixel = offset % size;
+
+    // Get pixel value if plane is cached
+    double value  = 0.0;
+    bool   cached = false;
+    #pragma omp critical(GFitsImage_cache)
+    {
+        const std::vector<double>* plane = cache_find(iplane);
+        if (plane != NULL) {
+            value  = (*plane)[ipixel];
+            cached = true;
+        }
+    }
+
+    // ... otherwise read plane from FITS file and put it into the cache
+    if (!cached) {
+        std::vector<double> pixels(size);
+        read_plane(iplane, &(pixels[0]));
+        #pragma omp critical(GFitsImage_cache)
+        value = cache_insert(iplane, pixels)[ipixel];
+    }
+
+    // Return pixel value
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Return image plane from plane cache
+ *
+ * @param[in] iplane Plane index.
+ * @return Plane pixels.
+ *
+ * Returns a copy of the specified image plane from the plane cache. If the
+ * plane is not cached, it is read from the FITS file and put into the
+ * cache.
+ ***************************************************************************/
+std::vector<double> GFitsImage::cached_plane(const int& iplane) const
+{
+    // Get plane if it is cached
+    std::vector<double> pixels;
+    bool                cached = false;
+    #pragma omp critical(GFitsImage_cache)
+    {
+        const std::vector<double>* plane = cache_find(iplane);
+        if (plane != NULL) {
+            pixels = *plane;
+            cached = true;
+        }
+    }
+
+    // ... otherwise read plane from FITS file and put it into the cache
+    if (!cached) {
+        pixels.resize(plane_size());
+        read_plane(iplane, &(pixels[0]));
+        std::vector<double> copy = pixels;
+        #pragma omp critical(GFitsImage_cache)
+        cache_insert(iplane, copy);
+    }
+
+    // Return plane
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Find image plane in plane cache
+ *
+ * @param[in] iplane Plane index.
+ * @return Pointer to plane pixels (NULL if plane is not cached).
+ *
+ * Returns a pointer to the cached plane and makes it the most recently
+ * used plane. The method needs to be called in the GFitsImage_cache
+ * critical section.
+ ***************************************************************************/
+const std::vector<double>* GFitsImage::cache_find(const int& iplane) const
+{
+    // Initialise result
+    const std::vector<double>* pixels = NULL;
+
+    // If plane is cached then make it the most recently used plane
+    cache_type::iterator plane = m_cache.find(iplane);
+    if (plane != m_cache.end()) {
+        m_cache_order.splice(m_cache_order.begin(), m_cache_order,
+                             plane->second.order);
+        pixels = &(plane->second.pixels);
+    }
+
+    // Return pixels
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Put image plane into plane cache
+ *
+ * @param[in] iplane Plane index.
+ * @param[in,out] pixels Plane pixels (emptied on return).
+ * @return Cached plane pixels.
+ *
+ * Puts the plane into the cache as the most recently used plane, and drops
+ * the least recently used planes until the cache fits into the budget. If
+ * the plane was already put into the cache by another thread, the cached
+ * plane is kept. The method needs to be called in the GFitsImage_cache
+ * critical section.
+ ***************************************************************************/
+const std::vector<double>& GFitsImage::cache_insert(const int& iplane,
+                                                    std::vector<double>& pixels) const
+{
+    // Return plane if it is already cached
+    const std::vector<double>* cached = cache_find(iplane);
+    if (cached != NULL) {
+        return *cached;
+    }
+
+    // Put plane into cache as the most recently used plane
+    m_cache_order.push_front(iplane);
+    cache_entry& entry = m_cache[iplane];
+    entry.pixels.swap(pixels);
+    entry.order = m_cache_order.begin();
+
+    // Drop least recently used planes that exceed the budget
+    double bytes      = double(plane_size()) * double(sizeof(double));
+    int    max_planes = int(m_cache_budget * 1.0e6 / bytes);
+    if (max_planes < 1) {
+        max_planes = 1;
+    }
+    while ((int)m_cache.size() > max_planes) {
+        m_cache.erase(m_cache_order.back());
+        m_cache_order.pop_back();
+    }
+
+    // Return plane
+    return entry.pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Empty plane cache
+ ***************************************************************************/
+void GFitsImage::clear_cache(void) const
+{
+    // Empty cache
+    #pragma omp critical(GFitsImage_cache)
+    {
+        m_cache.clear();
+        m_cache_order.clear();
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Fetch image pixels
  *
@@ -782,6 +1636,9 @@ void GFitsImage::fetch_data(void)
             load_image(type(), ptr_data(), ptr_nulval(), &m_anynul);
         }
 
+        // Empty plane cache since all pixels are now in memory
+        clear_cache();
+
     } // endif: there were pixels available
 
     // Return
@@ -944,11 +1801,15 @@ int GFitsImage::offset(const int& ix, const int& iy, const int& iz,
 void GFitsImage::init_members(void)
 {
     // Initialise members
-    m_bitpix     = 8;
-    m_naxis      = 0;
-    m_naxes      = NULL;
-    m_num_pixels = 0;
-    m_anynul     = 0;
+    m_bitpix       = 8;
+    m_naxis        = 0;
+    m_naxes        = NULL;
+    m_num_pixels   = 0;
+    m_anynul       = 0;
+    m_compression  = 0;
+    m_cache_budget = 0.0;
+    m_mmap.clear();
+    clear_cache();
 
     // Return
     return;
@@ -963,10 +1824,13 @@ void GFitsImage::init_members(void)
 void GFitsImage::copy_members(const GFitsImage& image)
 {
     // Copy attributes
-    m_bitpix     = image.m_bitpix;
-    m_naxis      = image.m_naxis;
-    m_num_pixels = image.m_num_pixels;
-    m_anynul     = image.m_anynul;
+    m_bitpix       = image.m_bitpix;
+    m_naxis        = image.m_naxis;
+    m_num_pixels   = image.m_num_pixels;
+    m_anynul       = image.m_anynul;
+    m_compression  = image.m_compression;
+    m_cache_budget = image.m_cache_budget;
+    m_mmap         = image.m_mmap;
 
     // Copy axes
     m_naxes = NULL;
@@ -990,6 +1854,9 @@ void GFitsImage::free_members(void)
     // Free memory
     if (m_naxes != NULL) delete [] m_naxes;
 
+    // Unmap image data
+    m_mmap.clear();
+
     // Mark memory as free
     m_naxes = NULL;
 
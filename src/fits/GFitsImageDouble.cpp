@@ -639,6 +639,18 @@ const double& GFitsImageDouble::at(const int& ix, const int& iy,
  ***************************************************************************/
 double GFitsImageDouble::pixel(const int& ix) const
 {
+    // If pixels are not in memory but the image is memory mapped then
+    // return the pixel value from the mapped file
+    if (m_pixels == NULL && ismapped()) {
+        return mapped_pixel(offset(ix));
+    }
+
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix));
+    }
+
     // Return pixel value
     return (double(this->at(ix)));
 }
@@ -655,6 +667,18 @@ double GFitsImageDouble::pixel(const int& ix) const
  ***************************************************************************/
 double GFitsImageDouble::pixel(const int& ix, const int& iy) const
 {
+    // If pixels are not in memory but the image is memory mapped then
+    // return the pixel value from the mapped file
+    if (m_pixels == NULL && ismapped()) {
+        return mapped_pixel(offset(ix,iy));
+    }
+
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy)));
 }
@@ -672,6 +696,18 @@ double GFitsImageDouble::pixel(const int& ix, const int& iy) const
  ***************************************************************************/
 double GFitsImageDouble::pixel(const int& ix, const int& iy, const int& iz) const
 {
+    // If pixels are not in memory but the image is memory mapped then
+    // return the pixel value from the mapped file
+    if (m_pixels == NULL && ismapped()) {
+        return mapped_pixel(offset(ix,iy,iz));
+    }
+
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy,iz));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy,iz)));
 }
@@ -691,6 +727,18 @@ double GFitsImageDouble::pixel(const int& ix, const int& iy, const int& iz) cons
 double GFitsImageDouble::pixel(const int& ix, const int& iy, const int& iz,
                                const int& it) const
 {
+    // If pixels are not in memory but the image is memory mapped then
+    // return the pixel value from the mapped file
+    if (m_pixels == NULL && ismapped()) {
+        return mapped_pixel(offset(ix,iy,iz,it));
+    }
+
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy,iz,it));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy,iz,it)));
 }
@@ -638,6 +638,12 @@ const char& GFitsImageSByte::at(const int& ix, const int& iy,
  ***************************************************************************/
 double GFitsImageSByte::pixel(const int& ix) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix));
+    }
+
     // Return pixel value
     return (double(this->at(ix)));
 }
@@ -654,6 +660,12 @@ double GFitsImageSByte::pixel(const int& ix) const
  ***************************************************************************/
 double GFitsImageSByte::pixel(const int& ix, const int& iy) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy)));
 }
@@ -671,6 +683,12 @@ double GFitsImageSByte::pixel(const int& ix, const int& iy) const
  ***************************************************************************/
 double GFitsImageSByte::pixel(const int& ix, const int& iy, const int& iz) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy,iz));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy,iz)));
 }
@@ -690,6 +708,12 @@ double GFitsImageSByte::pixel(const int& ix, const int& iy, const int& iz) const
 double GFitsImageSByte::pixel(const int& ix, const int& iy, const int& iz,
                               const int& it) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy,iz,it));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy,iz,it)));
 }
@@ -639,6 +639,12 @@ const short& GFitsImageShort::at(const int& ix, const int& iy,
  ***************************************************************************/
 double GFitsImageShort::pixel(const int& ix) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix));
+    }
+
     // Return pixel value
     return (double(this->at(ix)));
 }
@@ -655,6 +661,12 @@ double GFitsImageShort::pixel(const int& ix) const
  ***************************************************************************/
 double GFitsImageShort::pixel(const int& ix, const int& iy) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy)));
 }
@@ -672,6 +684,12 @@ double GFitsImageShort::pixel(const int& ix, const int& iy) const
  ***************************************************************************/
 double GFitsImageShort::pixel(const int& ix, const int& iy, const int& iz) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy,iz));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy,iz)));
 }
@@ -691,6 +709,12 @@ double GFitsImageShort::pixel(const int& ix, const int& iy, const int& iz) const
 double GFitsImageShort::pixel(const int& ix, const int& iy, const int& iz,
                               const int& it) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy,iz,it));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy,iz,it)));
 }
@@ -640,6 +640,12 @@ const unsigned short& GFitsImageUShort::at(const int& ix, const int& iy,
  ***************************************************************************/
 double GFitsImageUShort::pixel(const int& ix) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix));
+    }
+
     // Return pixel value
     return (double(this->at(ix)));
 }
@@ -656,6 +662,12 @@ double GFitsImageUShort::pixel(const int& ix) const
  ***************************************************************************/
 double GFitsImageUShort::pixel(const int& ix, const int& iy) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy)));
 }
@@ -673,6 +685,12 @@ double GFitsImageUShort::pixel(const int& ix, const int& iy) const
  ***************************************************************************/
 double GFitsImageUShort::pixel(const int& ix, const int& iy, const int& iz) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy,iz));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy,iz)));
 }
@@ -692,6 +710,12 @@ double GFitsImageUShort::pixel(const int& ix, const int& iy, const int& iz) cons
 double GFitsImageUShort::pixel(const int& ix, const int& iy, const int& iz,
                               const int& it) const
 {
+    // If pixels are loaded on demand then return the pixel value from
+    // the plane cache
+    if (m_pixels == NULL && islazy()) {
+        return cached_pixel(offset(ix,iy,iz,it));
+    }
+
     // Return pixel value
     return (double(this->at(ix,iy,iz,it)));
 }
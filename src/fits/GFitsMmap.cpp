@@ -0,0 +1,463 @@
+/***************************************************************************
+ *              GFitsMmap.cpp - Memory mapped FITS data region             *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsMmap.cpp
+ * @brief Memory mapped FITS data region class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#if defined(HAVE_UNISTD_H)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <cstring>
+#include "GException.hpp"
+#include "GFitsCfitsio.hpp"
+#include "GFitsMmap.hpp"
+#include "GTools.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_REAL                             "GFitsMmap::real(int&, long long&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                         Constructors/destructors                        =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GFitsMmap::GFitsMmap(void)
+{
+    // Initialise class members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Region constructor
+ *
+ * @param[in] filename FITS file name.
+ * @param[in] offset Byte offset of region in file.
+ * @param[in] size Size of region in bytes.
+ *
+ * Maps the specified region of a FITS file into memory (see open()).
+ ***************************************************************************/
+GFitsMmap::GFitsMmap(const std::string& filename,
+                     const long long&   offset,
+                     const long long&   size)
+{
+    // Initialise class members
+    init_members();
+
+    // Map region
+    open(filename, offset, size);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] map Memory mapped region.
+ ***************************************************************************/
+GFitsMmap::GFitsMmap(const GFitsMmap& map)
+{
+    // Initialise class members
+    init_members();
+
+    // Copy members
+    copy_members(map);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GFitsMmap::~GFitsMmap(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                                Operators                                =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] map Memory mapped region.
+ * @return Memory mapped region.
+ ***************************************************************************/
+GFitsMmap& GFitsMmap::operator= (const GFitsMmap& map)
+{
+    // Execute only if object is not identical
+    if (this != &map) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members
+        init_members();
+
+        // Copy members
+        copy_members(map);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear memory mapped region
+ ***************************************************************************/
+void GFitsMmap::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone memory mapped region
+ *
+ * @return Pointer to deep copy of memory mapped region.
+ ***************************************************************************/
+GFitsMmap* GFitsMmap::clone(void) const
+{
+    return new GFitsMmap(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Map region of FITS file into memory
+ *
+ * @param[in] filename FITS file name.
+ * @param[in] offset Byte offset of region in file.
+ * @param[in] size Size of region in bytes.
+ *
+ * Maps the region [offset,offset+size) of the specified FITS file
+ * read-only into memory. Any previously mapped region is unmapped.
+ *
+ * The file is only mapped if it starts with the SIMPLE keyword, which
+ * excludes compressed files, and if the region is fully contained in the
+ * file. Otherwise the region is left unmapped.
+ ***************************************************************************/
+void GFitsMmap::open(const std::string& filename,
+                     const long long&   offset,
+                     const long long&   size)
+{
+    // Unmap any previous region
+    clear();
+
+    // Continue only if region is valid
+    #if defined(HAVE_UNISTD_H) && defined(MAP_FAILED)
+    if (offset >= 0 && size > 0) {
+
+        // Open file
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd >= 0) {
+
+            // Check that the file is an uncompressed FITS file that
+            // contains the region
+            char        card[6];
+            struct stat info;
+            bool        valid = (::read(fd, card, 6) == 6 &&
+                                 std::strncmp(card, "SIMPLE", 6) == 0 &&
+                                 ::fstat(fd, &info) == 0 &&
+                                 (long long)info.st_size >= offset+size);
+
+            // Map the region. The mapping needs to start at a page boundary,
+            // hence we map from the page that contains the region start.
+            if (valid) {
+                long long page  = (long long)sysconf(_SC_PAGESIZE);
+                long long start = (offset / page) * page;
+                long long len   = offset + size - start;
+                void*     base  = ::mmap(NULL, (size_t)len, PROT_READ,
+                                         MAP_SHARED, fd, (off_t)start);
+                if (base != MAP_FAILED) {
+                    m_filename = filename;
+                    m_offset   = offset;
+                    m_size     = size;
+                    m_base     = base;
+                    m_length   = len;
+                    m_data     = (const char*)base + (offset - start);
+                }
+            }
+
+            // Close file. The mapping stays valid after closing.
+            ::close(fd);
+
+        } // endif: file was opened
+
+    } // endif: region was valid
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Unmap region
+ ***************************************************************************/
+void GFitsMmap::close(void)
+{
+    // Unmap region
+    clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return value from mapped region
+ *
+ * @param[in] type FITS data type.
+ * @param[in] pos Byte position of value in region.
+ * @return Value.
+ *
+ * @exception GException::out_of_range
+ *            Position outside mapped region.
+ * @exception GException::fits_invalid_type
+ *            Data type not supported.
+ *
+ * Decodes the big-endian FITS representation of a value of the specified
+ * type at byte position @p pos of the region. Unsigned 16 and 32 bit
+ * types are assumed to be stored as signed integers with the standard
+ * FITS offset (TZERO or BZERO) of 32768 and 2147483648, respectively.
+ ***************************************************************************/
+double GFitsMmap::real(const int& type, const long long& pos) const
+{
+    // Check position
+    #if defined(G_RANGE_CHECK)
+    if (pos < 0 || pos >= m_size) {
+        throw GException::out_of_range(G_REAL, (int)pos, 0, (int)m_size-1);
+    }
+    #endif
+
+    // Get pointer to value
+    const unsigned char* p = (const unsigned char*)(m_data + pos);
+
+    // Decode value
+    double value = 0.0;
+    switch (type) {
+    case __TBYTE:
+        value = double(p[0]);
+        break;
+    case __TSBYTE:
+        value = double((signed char)p[0]);
+        break;
+    case __TSHORT:
+    case __TUSHORT:
+        {
+            short v = (short)((p[0] << 8) | p[1]);
+            value   = (type == __TUSHORT) ? double(v) + 32768.0 : double(v);
+        }
+        break;
+    case __TINT:
+    case __TUINT:
+    case __TLONG:
+    case __TULONG:
+    case __TFLOAT:
+        {
+            unsigned int u = ((unsigned int)p[0] << 24) |
+                             ((unsigned int)p[1] << 16) |
+                             ((unsigned int)p[2] <<  8) |
+                              (unsigned int)p[3];
+            if (type == __TFLOAT) {
+                float v;
+                std::memcpy(&v, &u, 4);
+                value = double(v);
+            }
+            else {
+                int v;
+                std::memcpy(&v, &u, 4);
+                value = (type == __TUINT || type == __TULONG)
+                        ? double(v) + 2147483648.0 : double(v);
+            }
+        }
+        break;
+    case __TLONGLONG:
+    case __TDOUBLE:
+        {
+            unsigned long long u = 0;
+            for (int i = 0; i < 8; ++i) {
+                u = (u << 8) | (unsigned long long)p[i];
+            }
+            if (type == __TDOUBLE) {
+                double v;
+                std::memcpy(&v, &u, 8);
+                value = v;
+            }
+            else {
+                long long v;
+                std::memcpy(&v, &u, 8);
+                value = double(v);
+            }
+        }
+        break;
+    default:
+        throw GException::fits_invalid_type(G_REAL,
+              "Data type "+str(type)+" not supported for mapped access.");
+        break;
+    }
+
+    // Return value
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Print memory mapped region information
+ *
+ * @return String containing memory mapped region information.
+ ***************************************************************************/
+std::string GFitsMmap::print(void) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Append header
+    result.append("=== GFitsMmap ===");
+
+    // Append information
+    if (is_open()) {
+        result.append("\n"+parformat("File name")+m_filename);
+        result.append("\n"+parformat("Region offset")+str((int)m_offset));
+        result.append("\n"+parformat("Region size")+str((int)m_size));
+    }
+    else {
+        result.append("\n"+parformat("Region")+"not mapped");
+    }
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GFitsMmap::init_members(void)
+{
+    // Initialise members
+    m_filename.clear();
+    m_offset = 0;
+    m_size   = 0;
+    m_base   = NULL;
+    m_length = 0;
+    m_data   = NULL;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] map Memory mapped region.
+ *
+ * The region is mapped again, so that the copy owns its mapping. The
+ * physical pages are shared with the original mapping.
+ ***************************************************************************/
+void GFitsMmap::copy_members(const GFitsMmap& map)
+{
+    // Map the same region
+    if (map.is_open()) {
+        open(map.m_filename, map.m_offset, map.m_size);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GFitsMmap::free_members(void)
+{
+    // Unmap region
+    #if defined(HAVE_UNISTD_H) && defined(MAP_FAILED)
+    if (m_base != NULL) {
+        ::munmap(m_base, (size_t)m_length);
+    }
+    #endif
+
+    // Mark region as unmapped
+    m_base = NULL;
+    m_data = NULL;
+
+    // Return
+    return;
+}
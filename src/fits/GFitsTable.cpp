@@ -34,6 +34,7 @@
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GFitsCfitsio.hpp"
+#include "GFitsFileLock.hpp"
 #include "GFits.hpp"
 #include "GFitsTable.hpp"
 #include "GFitsTableBitCol.hpp"
@@ -59,6 +60,7 @@
 #define G_REMOVE_ROWS                   "GFitsTable::remove_rows(int&, int&)"
 #define G_DATA_OPEN                            "GFitsTable::data_open(void*)"
 #define G_DATA_SAVE                                 "GFitsTable::data_save()"
+#define G_DATA_MAP                                   "GFitsTable::data_map()"
 #define G_GET_TFORM                             "GFitsTable::get_tform(int&)"
 
 /* __ Macros _____________________________________________________________ */
@@ -632,6 +634,9 @@ std::string GFitsTable::print(void) const
  ***************************************************************************/
 void GFitsTable::data_open(void* vptr)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(vptr);
+
     // Move to HDU
     int status = 0;
     status     = __ffmahd(FPTR(vptr), (FPTR(vptr)->HDUposition)+1, NULL, &status);
@@ -826,6 +831,9 @@ void GFitsTable::data_open(void* vptr)
  ***************************************************************************/
 void GFitsTable::data_save(void)
 {
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
     // Debug definition: Dump method entry
     #if defined(G_DEBUG_SAVE)
     std::cout << "GFitsTable::save: entry" << std::endl;
@@ -1178,6 +1186,84 @@ void GFitsTable::data_connect(void* vptr)
 }
 
 
+/***********************************************************************//**
+ * @brief Map table data into memory
+ *
+ * @exception GException::fits_hdu_not_found
+ *            HDU not found in FITS file.
+ *
+ * Maps the data of all numerical columns of a binary table read-only into
+ * memory. Columns with a scale factor (TSCALn) different from 1 or with an
+ * undefined value (TNULLn) are not mapped, as well as bit, logical, string
+ * and complex columns. Column values that are not yet loaded into memory
+ * are then decoded directly from the mapped file.
+ ***************************************************************************/
+void GFitsTable::data_map(void)
+{
+    // Lock FITS file for this thread
+    GFitsFileLock lock(m_fitsfile);
+
+    #if defined(HAVE_LIBCFITSIO)
+    // Continue only for binary tables that are attached to a FITS file
+    if (FPTR(m_fitsfile)->Fptr != NULL && m_type == 2 && m_columns != NULL) {
+
+        // Move to HDU
+        int status = 0;
+        status     = __ffmahd(FPTR(m_fitsfile),
+                              (FPTR(m_fitsfile)->HDUposition)+1, NULL, &status);
+        if (status != 0) {
+            throw GException::fits_hdu_not_found(G_DATA_MAP,
+                              (FPTR(m_fitsfile)->HDUposition)+1, status);
+        }
+
+        // Get table layout
+        FITSfile*   file      = FPTR(m_fitsfile)->Fptr;
+        std::string filename  = file->filename;
+        long long   start     = file->datastart;
+        long long   rowlength = file->rowlength;
+
+        // Map all numerical columns
+        for (int i = 0; i < m_cols; ++i) {
+
+            // Get column and skip non-numerical columns
+            GFitsTableCol* column = m_columns[i];
+            if (column == NULL || column->m_colnum < 1) {
+                continue;
+            }
+            int type = column->m_type;
+            if (type < 0 ||
+                type == __TBIT     || type == __TLOGICAL ||
+                type == __TSTRING  || type == __TCOMPLEX ||
+                type == __TDBLCOMPLEX) {
+                continue;
+            }
+
+            // Skip scaled columns
+            std::string keyname = "TSCAL"+str(column->m_colnum);
+            if (hascard(keyname) && real(keyname) != 1.0) {
+                continue;
+            }
+
+            // Skip columns with undefined values, as the mapped values are
+            // decoded without null value substitution
+            if (hascard("TNULL"+str(column->m_colnum))) {
+                continue;
+            }
+
+            // Map column
+            column->map(filename, start, rowlength,
+                        file->tableptr[column->m_colnum-1].tbcol);
+
+        } // endfor: looped over columns
+
+    } // endif: binary table was attached to FITS file
+    #endif
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns pointer to column type
  *
@@ -32,6 +32,7 @@
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GFitsCfitsio.hpp"
+#include "GFitsFileLock.hpp"
 #include "GFitsTableBitCol.hpp"
 
 /* __ Method name definitions ____________________________________________ */
@@ -770,6 +771,9 @@ void GFitsTableBitCol::load_column(void)
         // file
         if (FPTR(m_fitsfile)->Fptr != NULL) {
 
+            // Lock FITS file for this thread
+            GFitsFileLock lock(m_fitsfile);
+
             // Move to the HDU
             int status = 0;
             status     = __ffmahd(FPTR(m_fitsfile),
@@ -812,6 +816,9 @@ void GFitsTableBitCol::save_column(void)
     // Continue only if a FITS file is connected and data have been loaded
     if (FPTR(m_fitsfile)->Fptr != NULL && m_colnum > 0 && m_data != NULL) {
 
+        // Lock FITS file for this thread
+        GFitsFileLock lock(m_fitsfile);
+
         // Set any pending Bit
         set_pending();
 
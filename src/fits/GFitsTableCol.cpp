@@ -28,8 +28,14 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#if defined(HAVE_LIBCFITSIO)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <cstring>
 #include "GException.hpp"
 #include "GFitsCfitsio.hpp"
+#include "GFitsFileLock.hpp"
 #include "GFitsTableCol.hpp"
 #include "GTools.hpp"
 
@@ -37,6 +43,7 @@
 #define G_LOAD_COLUMN                          "GFitsTableCol::load_column()"
 #define G_SAVE_COLUMN                          "GFitsTableCol::save_column()"
 #define G_OFFSET                           "GFitsTableCol::offset(int&,int&)"
+#define G_COPY_VALUES "GFitsTableCol::copy_values(int&, int&, int&, int&, void*)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -44,6 +51,169 @@
 
 /* __ Debug definitions __________________________________________________ */
 
+/* __ Local functions ____________________________________________________ */
+
+/***********************************************************************//**
+ * @brief Convert column values into a typed buffer
+ *
+ * @param[in] src Pointer to first column value.
+ * @param[in] num Number of values.
+ * @param[in] stride Distance between consecutive values in @p src.
+ * @param[out] dst Buffer.
+ *
+ * The contiguous case is a plain conversion loop that the compiler can
+ * vectorise.
+ ***************************************************************************/
+template <typename S, typename D>
+static void convert_values(const S* src, const int& num, const int& stride,
+                           D* dst)
+{
+    // Convert values
+    if (stride == 1) {
+        for (int i = 0; i < num; ++i) {
+            dst[i] = (D)src[i];
+        }
+    }
+    else {
+        for (int i = 0, k = 0; i < num; ++i, k += stride) {
+            dst[i] = (D)src[k];
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Decode big-endian column values into a typed buffer
+ *
+ * @param[in] data Pointer to first value of first row.
+ * @param[in] type FITS data type of column.
+ * @param[in] rowlength Distance between consecutive rows in bytes.
+ * @param[in] width Distance between consecutive values of a row in bytes.
+ * @param[in] nrows Number of rows.
+ * @param[in] nvalues Number of values per row.
+ * @param[out] dst Buffer (nrows*nvalues elements).
+ *
+ * Decodes the values of a memory mapped FITS table directly into the
+ * buffer type, without an intermediate double precision value, hence 64-bit
+ * integers are preserved exactly in a long long buffer.
+ ***************************************************************************/
+template <typename D>
+static void decode_values(const char* data, const int& type,
+                          const long long& rowlength, const int& width,
+                          const int& nrows, const int& nvalues, D* dst)
+{
+    // Loop over rows
+    for (int i = 0, k = 0; i < nrows; ++i) {
+
+        // Get pointer to first value of row
+        const unsigned char* row = (const unsigned char*)data + i * rowlength;
+
+        // Decode values of row
+        for (int j = 0; j < nvalues; ++j, ++k) {
+            const unsigned char* p = row + j * width;
+            switch (type) {
+            case __TBYTE:
+                dst[k] = (D)p[0];
+                break;
+            case __TSBYTE:
+                dst[k] = (D)((signed char)p[0]);
+                break;
+            case __TSHORT:
+                dst[k] = (D)((short)((p[0] << 8) | p[1]));
+                break;
+            case __TUSHORT:
+                dst[k] = (D)((int)((short)((p[0] << 8) | p[1])) + 32768);
+                break;
+            case __TINT:
+            case __TLONG:
+            case __TUINT:
+            case __TULONG:
+            case __TFLOAT:
+                {
+                    unsigned int u = ((unsigned int)p[0] << 24) |
+                                     ((unsigned int)p[1] << 16) |
+                                     ((unsigned int)p[2] <<  8) |
+                                      (unsigned int)p[3];
+                    if (type == __TFLOAT) {
+                        float v;
+                        std::memcpy(&v, &u, 4);
+                        dst[k] = (D)v;
+                    }
+                    else {
+                        int v;
+                        std::memcpy(&v, &u, 4);
+                        dst[k] = (type == __TUINT || type == __TULONG)
+                                 ? (D)((long long)v + 2147483648LL) : (D)v;
+                    }
+                }
+                break;
+            case __TLONGLONG:
+            case __TDOUBLE:
+                {
+                    unsigned long long u = 0;
+                    for (int b = 0; b < 8; ++b) {
+                        u = (u << 8) | (unsigned long long)p[b];
+                    }
+                    if (type == __TDOUBLE) {
+                        double v;
+                        std::memcpy(&v, &u, 8);
+                        dst[k] = (D)v;
+                    }
+                    else {
+                        long long v;
+                        std::memcpy(&v, &u, 8);
+                        dst[k] = (D)v;
+                    }
+                }
+                break;
+            default:
+                dst[k] = (D)0;
+                break;
+            }
+        } // endfor: looped over values of row
+
+    } // endfor: looped over rows
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convert column values into a buffer of given FITS data type
+ *
+ * @param[in] src Pointer to first column value.
+ * @param[in] num Number of values.
+ * @param[in] stride Distance between consecutive values in @p src.
+ * @param[in] type Buffer data type (__TDOUBLE, __TFLOAT or __TLONGLONG).
+ * @param[out] buffer Buffer.
+ ***************************************************************************/
+template <typename S>
+static void convert_values(const S* src, const int& num, const int& stride,
+                           const int& type, void* buffer)
+{
+    // Convert values
+    switch (type) {
+    case __TDOUBLE:
+        convert_values(src, num, stride, (double*)buffer);
+        break;
+    case __TFLOAT:
+        convert_values(src, num, stride, (float*)buffer);
+        break;
+    case __TLONGLONG:
+        convert_values(src, num, stride, (long long*)buffer);
+        break;
+    default:
+        break;
+    }
+
+    // Return
+    return;
+}
+
 
 /*==========================================================================
  =                                                                         =
@@ -333,6 +503,146 @@ int GFitsTableCol::anynul(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Release column data
+ *
+ * Frees the memory that holds the column data if the column is attached
+ * to a FITS file. The data are loaded again from the FITS file on the next
+ * access, hence this method allows to process large tables column by
+ * column without keeping all columns in memory. Any modifications of the
+ * column data that have not been saved are lost.
+ *
+ * Columns that are not attached to a FITS file are not changed.
+ ***************************************************************************/
+void GFitsTableCol::release(void)
+{
+    // Release data only if the column is attached to a FITS file
+    if (FPTR(m_fitsfile)->Fptr != NULL && m_colnum > 0) {
+        release_data();
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Load a range of table rows as double precision values
+ *
+ * @param[in] row First row to load (starting from 0).
+ * @param[in] nrows Number of rows to load.
+ * @param[out] values Column values (nrows*number() elements).
+ *
+ * @exception GException::out_of_range
+ *            Row range outside valid range.
+ * @exception GException::fits_hdu_not_found
+ *            Specified HDU not found in FITS file.
+ * @exception GException::fits_error
+ *            An error occured while loading column data from FITS file.
+ *
+ * Loads the values of the rows [row,row+nrows) into the @p values array.
+ * For vector columns the values of a row are stored contiguously, i.e.
+ * element @p inx of row @p row+i is found at values[i*number()+inx].
+ *
+ * If the column data have not yet been loaded into memory and if the
+ * column is memory mapped or attached to a FITS file, the values are read
+ * directly from the file without loading the full column into memory. This allows
+ * to traverse columns that do not fit into memory in chunks of rows.
+ ***************************************************************************/
+void GFitsTableCol::load_rows(const int& row, const int& nrows,
+                              double* values) const
+{
+    // Load rows
+    copy_values(row, nrows, -1, __TDOUBLE, values);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy a range of table rows into a double precision buffer
+ *
+ * @param[in] row First row to copy (starting from 0).
+ * @param[in] nrows Number of rows to copy.
+ * @param[out] buffer Buffer.
+ * @param[in] inx Vector index to copy (-1 = all vector elements).
+ *
+ * @exception GException::out_of_range
+ *            Row range or vector index outside valid range.
+ *
+ * Copies the values of the rows [row,row+nrows) into @p buffer. If @p inx
+ * is -1, the buffer needs to hold nrows*number() values, and element
+ * @p k of row @p row+i is stored at buffer[i*number()+k]. Otherwise, the
+ * buffer needs to hold nrows values, and the vector element @p inx of
+ * row @p row+i is stored at buffer[i].
+ *
+ * For numerical columns that are in memory, the values are converted in
+ * a single loop without any virtual method call per element. Columns that
+ * are not yet in memory are read directly from the memory mapped or
+ * attached FITS file, as for load_rows(). Non-numerical columns are
+ * converted using the real() method.
+ ***************************************************************************/
+void GFitsTableCol::values(const int& row, const int& nrows, double* buffer,
+                           const int& inx) const
+{
+    // Copy values
+    copy_values(row, nrows, inx, __TDOUBLE, buffer);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy a range of table rows into a single precision buffer
+ *
+ * @param[in] row First row to copy (starting from 0).
+ * @param[in] nrows Number of rows to copy.
+ * @param[out] buffer Buffer.
+ * @param[in] inx Vector index to copy (-1 = all vector elements).
+ *
+ * @exception GException::out_of_range
+ *            Row range or vector index outside valid range.
+ *
+ * See the double precision version of this method for details.
+ ***************************************************************************/
+void GFitsTableCol::values(const int& row, const int& nrows, float* buffer,
+                           const int& inx) const
+{
+    // Copy values
+    copy_values(row, nrows, inx, __TFLOAT, buffer);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy a range of table rows into a 64 bit integer buffer
+ *
+ * @param[in] row First row to copy (starting from 0).
+ * @param[in] nrows Number of rows to copy.
+ * @param[out] buffer Buffer.
+ * @param[in] inx Vector index to copy (-1 = all vector elements).
+ *
+ * @exception GException::out_of_range
+ *            Row range or vector index outside valid range.
+ *
+ * See the double precision version of this method for details. Floating
+ * point values are truncated towards zero, as for the integer() method.
+ ***************************************************************************/
+void GFitsTableCol::values(const int& row, const int& nrows,
+                           long long* buffer, const int& inx) const
+{
+    // Copy values
+    copy_values(row, nrows, inx, __TLONGLONG, buffer);
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Print column information
  *
@@ -461,6 +771,10 @@ void GFitsTableCol::fetch_data(void) const
  * GFitsTableCol::ptr_nulval.
  * These methods are implemented by the derived column classes which 
  * implement a specific storage class (i.e. float, double, short, ...).
+ *
+ * The FITS file is locked while the column is read (see GFitsFileLock),
+ * hence different columns of the same file can be loaded from parallel
+ * threads.
  ***************************************************************************/
 void GFitsTableCol::load_column(void)
 {
@@ -480,6 +794,9 @@ void GFitsTableCol::load_column(void)
         // the initalised column ... 
         if (FPTR(m_fitsfile)->Fptr != NULL) {
 
+            // Lock FITS file for this thread
+            GFitsFileLock lock(m_fitsfile);
+
             // Move to the HDU
             int status = 0;
             status     = __ffmahd(FPTR(m_fitsfile),
@@ -542,6 +859,9 @@ void GFitsTableCol::save_column(void)
     // Continue only if a FITS file is connected and data have been loaded
     if (FPTR(m_fitsfile)->Fptr != NULL && m_colnum > 0 && ptr_data() != NULL) {
 
+        // Lock FITS file for this thread
+        GFitsFileLock lock(m_fitsfile);
+
         // Move to the HDU
         int status = 0;
         status     = __ffmahd(FPTR(m_fitsfile),
@@ -567,6 +887,315 @@ void GFitsTableCol::save_column(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Announce upcoming access to a range of table rows
+ *
+ * @param[in] row First row (starting from 0).
+ * @param[in] nrows Number of rows.
+ *
+ * Advises the operating system that the part of the FITS file holding the
+ * rows [row,row+nrows) will be accessed soon, so that the data can be read
+ * ahead in the background while the client processes the current rows.
+ * The advice is only given if the HDU of the column is the current HDU of
+ * the FITS file, and if the platform supports posix_fadvise(). Otherwise
+ * the method does nothing. The file is opened on the first call and is
+ * kept open until the column is connected to another file or destroyed.
+ ***************************************************************************/
+void GFitsTableCol::prefetch_rows(const int& row, const int& nrows) const
+{
+    #if defined(HAVE_LIBCFITSIO) && defined(POSIX_FADV_WILLNEED)
+    // Continue only if a FITS file is connected
+    if (FPTR(m_fitsfile)->Fptr != NULL && m_colnum > 0 && nrows > 0) {
+
+        // Lock FITS file for this thread and get FITS file
+        GFitsFileLock lock(m_fitsfile);
+        FITSfile*     file = FPTR(m_fitsfile)->Fptr;
+
+        // Give advice only if the column HDU is the current HDU
+        if (file->curhdu == FPTR(m_fitsfile)->HDUposition &&
+            file->filename != NULL) {
+            off_t start = off_t(file->datastart + LONGLONG(row) * file->rowlength);
+            off_t size  = off_t(LONGLONG(nrows) * file->rowlength);
+            if (m_fd < 0) {
+                m_fd = open(file->filename, O_RDONLY);
+            }
+            if (m_fd >= 0) {
+                posix_fadvise(m_fd, start, size, POSIX_FADV_WILLNEED);
+            }
+        }
+
+    } // endif: FITS file was connected
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Map column data into memory
+ *
+ * @param[in] filename FITS file name.
+ * @param[in] start Byte offset of table data in file.
+ * @param[in] rowlength Length of table row in bytes.
+ * @param[in] colstart Byte offset of column in table row.
+ *
+ * Maps the table data that hold the column read-only into memory. As long
+ * as the column data are not loaded into memory, column values are then
+ * decoded directly from the mapped file (see mapped_real()). If the file
+ * can not be mapped, the column is left unmapped and the data are read
+ * through cfitsio.
+ ***************************************************************************/
+void GFitsTableCol::map(const std::string& filename,
+                        const long long&   start,
+                        const long long&   rowlength,
+                        const long long&   colstart)
+{
+    // Map table data
+    m_mmap.open(filename, start, rowlength * m_length);
+
+    // Store column location
+    m_mmap_col = colstart;
+    m_mmap_row = rowlength;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return column value from memory mapped file
+ *
+ * @param[in] row Table row.
+ * @param[in] inx Table column vector index.
+ * @return Column value.
+ *
+ * @exception GException::out_of_range
+ *            Table row or vector index are out of valid range.
+ ***************************************************************************/
+double GFitsTableCol::mapped_real(const int& row, const int& inx) const
+{
+    // Check row and vector index
+    #if defined(G_RANGE_CHECK)
+    if (row < 0 || row >= m_length) {
+        throw GException::out_of_range(G_OFFSET, row, 0, m_length-1);
+    }
+    if (inx < 0 || inx >= m_number) {
+        throw GException::out_of_range(G_OFFSET, inx, 0, m_number-1);
+    }
+    #endif
+
+    // Return value
+    return (m_mmap.real(m_type, m_mmap_row*row + m_mmap_col +
+                                (long long)(inx) * m_width));
+}
+
+
+/***********************************************************************//**
+ * @brief Copy a range of table rows into a typed buffer
+ *
+ * @param[in] row First row to copy (starting from 0).
+ * @param[in] nrows Number of rows to copy.
+ * @param[in] inx Vector index to copy (-1 = all vector elements).
+ * @param[in] type Buffer data type (__TDOUBLE, __TFLOAT or __TLONGLONG).
+ * @param[out] buffer Buffer.
+ *
+ * @exception GException::out_of_range
+ *            Row range or vector index outside valid range.
+ * @exception GException::fits_hdu_not_found
+ *            Specified HDU not found in FITS file.
+ * @exception GException::fits_error
+ *            An error occured while loading column data from FITS file.
+ *
+ * Implements the values() and load_rows() methods. The values are taken
+ *
+ * - from the memory mapped file if the column is mapped but not in memory,
+ *   decoded directly into the buffer type,
+ * - directly from the FITS file, converted by cfitsio into the buffer type,
+ *   if the column is numerical, not in memory and attached to a FITS file
+ *   (a single vector element per row is read row by row),
+ * - from memory otherwise, using a single conversion loop for numerical
+ *   columns and the real() method for all other columns.
+ ***************************************************************************/
+void GFitsTableCol::copy_values(const int& row, const int& nrows,
+                                const int& inx, const int& type,
+                                void* buffer) const
+{
+    // Check row range and vector index
+    if (row < 0 || row > m_length) {
+        throw GException::out_of_range(G_COPY_VALUES, row, 0, m_length-1);
+    }
+    if (nrows < 0 || row+nrows > m_length) {
+        throw GException::out_of_range(G_COPY_VALUES, row+nrows-1, 0, m_length-1);
+    }
+    if (inx < -1 || inx >= m_number) {
+        throw GException::out_of_range(G_COPY_VALUES, inx, 0, m_number-1);
+    }
+
+    // Determine number of values per row and in total
+    int nvalues = (inx < 0) ? m_number : 1;
+    int num     = nrows * nvalues;
+
+    // Continue only if there is something to copy
+    if (num > 0) {
+
+        // Signal numerical column
+        bool numeric = (m_type != __TBIT     && m_type != __TLOGICAL &&
+                        m_type != __TSTRING  && m_type != __TCOMPLEX &&
+                        m_type != __TDBLCOMPLEX);
+
+        // If the column is memory mapped then decode the rows from the
+        // mapped file directly into the buffer type
+        bool mapped = (m_size == 0 && ismapped());
+        if (mapped) {
+            const char* data = m_mmap.data() + m_mmap_row * row + m_mmap_col +
+                               (long long)((inx < 0) ? 0 : inx) * m_width;
+            switch (type) {
+            case __TDOUBLE:
+                decode_values(data, m_type, m_mmap_row, m_width, nrows,
+                              nvalues, (double*)buffer);
+                break;
+            case __TFLOAT:
+                decode_values(data, m_type, m_mmap_row, m_width, nrows,
+                              nvalues, (float*)buffer);
+                break;
+            case __TLONGLONG:
+                decode_values(data, m_type, m_mmap_row, m_width, nrows,
+                              nvalues, (long long*)buffer);
+                break;
+            default:
+                break;
+            }
+        }
+
+        // Determine whether the rows can be read directly from the FITS
+        // file. This is only done for numerical columns that have not been
+        // loaded into memory.
+        bool direct = (!mapped && numeric && m_size == 0 &&
+                       FPTR(m_fitsfile)->Fptr != NULL && m_colnum > 0);
+
+        // Read rows from the FITS file
+        if (direct) {
+
+            // Lock FITS file for this thread
+            GFitsFileLock lock(m_fitsfile);
+
+            // Move to the HDU
+            int status = 0;
+            status     = __ffmahd(FPTR(m_fitsfile),
+                                  (FPTR(m_fitsfile)->HDUposition)+1,
+                                  NULL, &status);
+
+            // If no data have yet been written to the file (see
+            // load_column()) then fall back to the column in memory
+            if (status == 252 || status == 107) {
+                direct = false;
+            }
+            else if (status != 0) {
+                throw GException::fits_hdu_not_found(G_COPY_VALUES,
+                              (FPTR(m_fitsfile)->HDUposition)+1,
+                              status);
+            }
+
+            // Load rows. A single vector element per row is read row by
+            // row. The values are converted by cfitsio into the buffer type.
+            // The nul value is a zero bit pattern that is large enough for
+            // all buffer types.
+            if (direct) {
+                double nulval = 0.0;
+                int    anynul = 0;
+                if (nvalues == m_number) {
+                    status = __ffgcv(FPTR(m_fitsfile), type, m_colnum,
+                                     row+1, 1, num, &nulval, buffer,
+                                     &anynul, &status);
+                }
+                else {
+                    int   size = (type == __TFLOAT) ? sizeof(float)
+                                                    : sizeof(double);
+                    char* ptr  = (char*)buffer;
+                    for (int i = 0; i < nrows && status == 0; ++i) {
+                        status = __ffgcv(FPTR(m_fitsfile), type, m_colnum,
+                                         row+i+1, inx+1, 1, &nulval,
+                                         ptr + i * size, &anynul, &status);
+                    }
+                }
+                if (status != 0) {
+                    throw GException::fits_error(G_COPY_VALUES, status,
+                                      "for column \""+m_name+"\".");
+                }
+            }
+
+        } // endif: rows were read from FITS file
+
+        // ... otherwise get rows from memory
+        if (!mapped && !direct) {
+
+            // Make sure that column data are in memory
+            if (m_size == 0) {
+                fetch_data();
+            }
+
+            // Get pointer to first value and distance between values
+            const void* data   = const_cast<GFitsTableCol*>(this)->ptr_data();
+            int         start  = row * m_number + ((inx < 0) ? 0 : inx);
+            int         stride = (inx < 0) ? 1 : m_number;
+
+            // Convert values
+            switch (m_type) {
+            case __TBYTE:
+                convert_values((const unsigned char*)data + start, num,
+                               stride, type, buffer);
+                break;
+            case __TSHORT:
+                convert_values((const short*)data + start, num, stride,
+                               type, buffer);
+                break;
+            case __TUSHORT:
+                convert_values((const unsigned short*)data + start, num,
+                               stride, type, buffer);
+                break;
+            case __TLONG:
+                convert_values((const long*)data + start, num, stride,
+                               type, buffer);
+                break;
+            case __TULONG:
+                convert_values((const unsigned long*)data + start, num,
+                               stride, type, buffer);
+                break;
+            case __TLONGLONG:
+                convert_values((const long long*)data + start, num, stride,
+                               type, buffer);
+                break;
+            case __TFLOAT:
+                convert_values((const float*)data + start, num, stride,
+                               type, buffer);
+                break;
+            case __TDOUBLE:
+                convert_values((const double*)data + start, num, stride,
+                               type, buffer);
+                break;
+            default:
+                {
+                    std::vector<double> values(num);
+                    for (int i = 0, k = 0; i < nrows; ++i) {
+                        for (int j = 0; j < nvalues; ++j, ++k) {
+                            values[k] = real(row+i, (inx < 0) ? j : inx);
+                        }
+                    }
+                    convert_values(&(values[0]), num, 1, type, buffer);
+                }
+                break;
+            }
+
+        } // endif: rows were taken from memory
+
+    } // endif: there were rows to copy
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Convert row and vector index into column offset
  *
@@ -631,6 +1260,10 @@ void GFitsTableCol::init_members(void)
     m_length = 0;
     m_size   = 0;
     m_anynul = 0;
+    m_mmap.clear();
+    m_mmap_col = 0;
+    m_mmap_row = 0;
+    m_fd       = -1;
 
     // Return
     return;
@@ -656,6 +1289,9 @@ void GFitsTableCol::copy_members(const GFitsTableCol& column)
     m_length   = column.m_length;
     m_size     = column.m_size;
     m_anynul   = column.m_anynul;
+    m_mmap     = column.m_mmap;
+    m_mmap_col = column.m_mmap_col;
+    m_mmap_row = column.m_mmap_row;
     FPTR_COPY(m_fitsfile, column.m_fitsfile);
 
     // Return
@@ -671,6 +1307,12 @@ void GFitsTableCol::free_members(void)
     // Free memory
     if (m_fitsfile != NULL) delete FPTR(m_fitsfile);
 
+    // Unmap table data
+    m_mmap.clear();
+
+    // Close read-ahead file
+    close_fd();
+
     // Mark memory as free
     m_fitsfile = NULL;
 
@@ -686,9 +1328,32 @@ void GFitsTableCol::free_members(void)
  ***************************************************************************/
 void GFitsTableCol::connect(void* vptr)
 {
+    // Close read-ahead file of previous connection
+    close_fd();
+
     // Connect table column by copying the column file pointer
     FPTR_COPY(m_fitsfile, vptr);
 
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Close read-ahead file
+ *
+ * Closes the file descriptor that was opened by prefetch_rows().
+ ***************************************************************************/
+void GFitsTableCol::close_fd(void) const
+{
+    // Close file descriptor
+    #if defined(HAVE_LIBCFITSIO)
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+    #endif
+    m_fd = -1;
+
+    // Return
+    return;
+}
@@ -0,0 +1,424 @@
+/***************************************************************************
+ *        GFitsTableColReader.cpp - FITS table column chunk reader         *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsTableColReader.cpp
+ * @brief FITS table column chunk reader class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "GException.hpp"
+#include "GFitsTableColReader.hpp"
+#include "GTools.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_CONSTRUCT  "GFitsTableColReader::GFitsTableColReader(GFitsTableCol*,"\
+                                                                       " int&)"
+#define G_OPERATOR                 "GFitsTableColReader::operator()(int&,int&)"
+#define G_CHUNK                          "GFitsTableColReader::chunk(int&)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                         Constructors/destructors                        =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GFitsTableColReader::GFitsTableColReader(void)
+{
+    // Initialise class members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Column constructor
+ *
+ * @param[in] column Pointer to FITS table column.
+ * @param[in] chunk Maximum number of rows per chunk.
+ *
+ * @exception GException::invalid_argument
+ *            Invalid column pointer or chunk size specified.
+ *
+ * Constructs a reader for the specified @p column. The column is not
+ * copied, hence it needs to stay alive as long as the reader is used.
+ ***************************************************************************/
+GFitsTableColReader::GFitsTableColReader(const GFitsTableCol* column,
+                                         const int&           chunk)
+{
+    // Throw an exception if no column is specified
+    if (column == NULL) {
+        throw GException::invalid_argument(G_CONSTRUCT,
+              "No FITS table column specified.");
+    }
+
+    // Initialise class members
+    init_members();
+
+    // Set members
+    m_column = column;
+    this->chunk(chunk);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] reader Column reader.
+ ***************************************************************************/
+GFitsTableColReader::GFitsTableColReader(const GFitsTableColReader& reader)
+{
+    // Initialise class members
+    init_members();
+
+    // Copy members
+    copy_members(reader);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GFitsTableColReader::~GFitsTableColReader(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                                Operators                                =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] reader Column reader.
+ * @return Column reader.
+ ***************************************************************************/
+GFitsTableColReader& GFitsTableColReader::operator= (const GFitsTableColReader& reader)
+{
+    // Execute only if object is not identical
+    if (this != &reader) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members
+        init_members();
+
+        // Copy members
+        copy_members(reader);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/***********************************************************************//**
+ * @brief Return column value in current chunk
+ *
+ * @param[in] row Row index relative to start of chunk.
+ * @param[in] inx Vector index in column row.
+ * @return Column value.
+ *
+ * @exception GException::out_of_range
+ *            Row or vector index out of valid range.
+ ***************************************************************************/
+double GFitsTableColReader::operator()(const int& row, const int& inx) const
+{
+    // Get number of elements per row
+    int number = (m_column != NULL) ? m_column->number() : 0;
+
+    // Check indices
+    #if defined(G_RANGE_CHECK)
+    if (row < 0 || row >= m_rows) {
+        throw GException::out_of_range(G_OPERATOR, row, 0, m_rows-1);
+    }
+    if (inx < 0 || inx >= number) {
+        throw GException::out_of_range(G_OPERATOR, inx, 0, number-1);
+    }
+    #endif
+
+    // Return value
+    return m_data[row*number+inx];
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear column reader
+ ***************************************************************************/
+void GFitsTableColReader::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone column reader
+ *
+ * @return Pointer to deep copy of column reader.
+ ***************************************************************************/
+GFitsTableColReader* GFitsTableColReader::clone(void) const
+{
+    return new GFitsTableColReader(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Set maximum number of rows per chunk
+ *
+ * @param[in] chunk Maximum number of rows per chunk.
+ *
+ * @exception GException::invalid_argument
+ *            Non-positive chunk size specified.
+ *
+ * Sets the maximum number of rows per chunk. The new chunk size takes
+ * effect with the next call of next().
+ ***************************************************************************/
+void GFitsTableColReader::chunk(const int& chunk)
+{
+    // Throw an exception if chunk size is not positive
+    if (chunk < 1) {
+        throw GException::invalid_argument(G_CHUNK,
+              "Chunk size "+str(chunk)+" must be positive.");
+    }
+
+    // Set chunk size
+    m_chunk = chunk;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Load next chunk of rows
+ *
+ * @return True if a chunk has been loaded, false if the end of the column
+ *         has been reached.
+ *
+ * Loads the next chunk of rows from the column. On the first call the
+ * chunk starting at the first column row is loaded.
+ ***************************************************************************/
+bool GFitsTableColReader::next(void)
+{
+    // Determine first row and number of rows of next chunk
+    int length = (m_column != NULL) ? m_column->length() : 0;
+    int row    = m_row + m_rows;
+    int rows   = length - row;
+    if (rows > m_chunk) {
+        rows = m_chunk;
+    }
+
+    // Load chunk if there are remaining rows
+    bool loaded = (rows > 0);
+    if (loaded) {
+
+        // Load rows
+        m_data.resize(rows * m_column->number());
+        m_column->load_rows(row, rows, &(m_data[0]));
+
+        // Announce the subsequent chunk
+        if (m_prefetch && row+rows < length) {
+            int nrows = length - (row+rows);
+            m_column->prefetch_rows(row+rows, (nrows > m_chunk) ? m_chunk : nrows);
+        }
+
+        // Set chunk
+        m_row  = row;
+        m_rows = rows;
+
+    }
+    else {
+        m_row  = length;
+        m_rows = 0;
+        m_data.clear();
+    }
+
+    // Return flag
+    return loaded;
+}
+
+
+/***********************************************************************//**
+ * @brief Rewind reader to start of column
+ *
+ * After rewinding, the next call of next() loads the first chunk of the
+ * column.
+ ***************************************************************************/
+void GFitsTableColReader::rewind(void)
+{
+    // Reset chunk
+    m_row  = 0;
+    m_rows = 0;
+    m_data.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Return pointer to column values of current chunk
+ *
+ * @return Pointer to column values (NULL if no chunk is loaded).
+ *
+ * The values of row @p i and vector index @p inx in the current chunk are
+ * found at data()[i*number+inx], where number is the number of elements
+ * per column row.
+ ***************************************************************************/
+const double* GFitsTableColReader::data(void) const
+{
+    // Return pointer
+    return (m_data.empty()) ? NULL : &(m_data[0]);
+}
+
+
+/***********************************************************************//**
+ * @brief Print column reader information
+ *
+ * @return String containing column reader information.
+ ***************************************************************************/
+std::string GFitsTableColReader::print(void) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Append header
+    result.append("=== GFitsTableColReader ===");
+
+    // Append information
+    if (m_column != NULL) {
+        result.append("\n"+parformat("Column")+m_column->name());
+        result.append("\n"+parformat("Column length")+str(m_column->length()));
+    }
+    else {
+        result.append("\n"+parformat("Column")+"None");
+    }
+    result.append("\n"+parformat("Chunk size")+str(m_chunk));
+    result.append("\n"+parformat("Prefetch")+((m_prefetch) ? "yes" : "no"));
+    result.append("\n"+parformat("Current rows"));
+    if (m_rows > 0) {
+        result.append(str(m_row)+" - "+str(m_row+m_rows-1));
+    }
+    else {
+        result.append("none");
+    }
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GFitsTableColReader::init_members(void)
+{
+    // Initialise members
+    m_column   = NULL;
+    m_chunk    = 100000;
+    m_prefetch = true;
+    m_row      = 0;
+    m_rows     = 0;
+    m_data.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] reader Column reader.
+ ***************************************************************************/
+void GFitsTableColReader::copy_members(const GFitsTableColReader& reader)
+{
+    // Copy members
+    m_column   = reader.m_column;
+    m_chunk    = reader.m_chunk;
+    m_prefetch = reader.m_prefetch;
+    m_row      = reader.m_row;
+    m_rows     = reader.m_rows;
+    m_data     = reader.m_data;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GFitsTableColReader::free_members(void)
+{
+    // Return
+    return;
+}
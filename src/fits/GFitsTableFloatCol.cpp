@@ -256,6 +256,12 @@ std::string GFitsTableFloatCol::string(const int& row, const int& inx) const
  ***************************************************************************/
 double GFitsTableFloatCol::real(const int& row, const int& inx) const
 {
+    // If data are not in memory but the column is memory mapped then
+    // return the value from the mapped file
+    if (m_data == NULL && ismapped()) {
+        return mapped_real(row, inx);
+    }
+
     // If data are not available then load them now
     if (m_data == NULL) fetch_data();
 
@@ -277,6 +283,12 @@ double GFitsTableFloatCol::real(const int& row, const int& inx) const
  ***************************************************************************/
 int GFitsTableFloatCol::integer(const int& row, const int& inx) const
 {
+    // If data are not in memory but the column is memory mapped then
+    // return the value from the mapped file
+    if (m_data == NULL && ismapped()) {
+        return (int)mapped_real(row, inx);
+    }
+
     // If data are not available then load them now
     if (m_data == NULL) fetch_data();
 
@@ -256,6 +256,12 @@ std::string GFitsTableLongCol::string(const int& row, const int& inx) const
  ***************************************************************************/
 double GFitsTableLongCol::real(const int& row, const int& inx) const
 {
+    // If data are not in memory but the column is memory mapped then
+    // return the value from the mapped file
+    if (m_data == NULL && ismapped()) {
+        return mapped_real(row, inx);
+    }
+
     // If data are not available then load them now
     if (m_data == NULL) fetch_data();
 
@@ -277,6 +283,12 @@ double GFitsTableLongCol::real(const int& row, const int& inx) const
  ***************************************************************************/
 int GFitsTableLongCol::integer(const int& row, const int& inx) const
 {
+    // If data are not in memory but the column is memory mapped then
+    // return the value from the mapped file
+    if (m_data == NULL && ismapped()) {
+        return (int)mapped_real(row, inx);
+    }
+
     // If data are not available then load them now
     if (m_data == NULL) fetch_data();
 
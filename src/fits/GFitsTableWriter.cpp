@@ -0,0 +1,770 @@
+/***************************************************************************
+ *           GFitsTableWriter.cpp - Streaming FITS table writer            *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2013 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GFitsTableWriter.cpp
+ * @brief Streaming FITS table writer class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <cstdio>
+#include <cstring>
+#include "GException.hpp"
+#include "GFitsCfitsio.hpp"
+#include "GFitsFileLock.hpp"
+#include "GFitsTableWriter.hpp"
+#include "GTools.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_OPEN             "GFitsTableWriter::open(std::string&, std::string&)"
+#define G_WRITE                        "GFitsTableWriter::write(GFitsTable&)"
+#define G_FLUSH                                 "GFitsTableWriter::flush()"
+#define G_CLOSE                                 "GFitsTableWriter::close()"
+#define G_CHECK_BLOCK            "GFitsTableWriter::check_block(GFitsTable&)"
+#define G_ENCODE_COLUMN   "GFitsTableWriter::encode_column(GFitsTableCol&,"\
+                                             " int&, int&, unsigned char*)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+/* __ Local functions ____________________________________________________ */
+static void put_bytes(unsigned char* dst, unsigned long long value,
+                      const int& size)
+{
+    // Store value in big-endian byte order
+    for (int i = size-1; i >= 0; --i) {
+        dst[i]  = (unsigned char)(value & 0xff);
+        value >>= 8;
+    }
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                         Constructors/destructors                        =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GFitsTableWriter::GFitsTableWriter(void)
+{
+    // Initialise class members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Table extension constructor
+ *
+ * @param[in] filename FITS file name.
+ * @param[in] extname Name of binary table extension.
+ *
+ * Constructs a writer that appends rows to the specified binary table
+ * extension (see open()).
+ ***************************************************************************/
+GFitsTableWriter::GFitsTableWriter(const std::string& filename,
+                                   const std::string& extname)
+{
+    // Initialise class members
+    init_members();
+
+    // Open table extension
+    open(filename, extname);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] writer Table writer.
+ ***************************************************************************/
+GFitsTableWriter::GFitsTableWriter(const GFitsTableWriter& writer)
+{
+    // Initialise class members
+    init_members();
+
+    // Copy members
+    copy_members(writer);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ *
+ * Writes any pending block to disk and closes the file. Errors that occur
+ * during writing are ignored; use close() to catch them.
+ ***************************************************************************/
+GFitsTableWriter::~GFitsTableWriter(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                                Operators                                =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] writer Table writer.
+ * @return Table writer.
+ ***************************************************************************/
+GFitsTableWriter& GFitsTableWriter::operator= (const GFitsTableWriter& writer)
+{
+    // Execute only if object is not identical
+    if (this != &writer) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members
+        init_members();
+
+        // Copy members
+        copy_members(writer);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear table writer
+ ***************************************************************************/
+void GFitsTableWriter::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone table writer
+ *
+ * @return Pointer to copy of table writer.
+ ***************************************************************************/
+GFitsTableWriter* GFitsTableWriter::clone(void) const
+{
+    return new GFitsTableWriter(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Open binary table extension for appending rows
+ *
+ * @param[in] filename FITS file name.
+ * @param[in] extname Name of binary table extension.
+ *
+ * @exception GException::fits_open_error
+ *            Unable to open FITS file.
+ * @exception GException::fits_error
+ *            Unable to access binary table extension.
+ *
+ * Opens the FITS file and moves to the binary table extension with the
+ * specified name. Rows written with write() are appended after the rows
+ * that already exist in the extension. Any previously opened extension is
+ * flushed and closed before.
+ ***************************************************************************/
+void GFitsTableWriter::open(const std::string& filename,
+                            const std::string& extname)
+{
+    // Close any previously opened extension
+    close();
+
+    // Open FITS file for writing
+    int status = 0;
+    #pragma omp critical(GFits_open)
+    status     = __ffopen(FHANDLE(m_fitsfile), filename.c_str(), 1, &status);
+    if (status != 0) {
+        m_fitsfile = NULL;
+        throw GException::fits_open_error(G_OPEN, filename, status);
+    }
+
+    // Continue only if file has been opened
+    if (m_fitsfile != NULL) {
+
+        // Lock FITS file for this thread
+        GFitsFileLock lock(m_fitsfile);
+
+        // Move to binary table extension
+        status = __ffmnhd(FPTR(m_fitsfile), __BINARY_TBL,
+                          (char*)extname.c_str(), 0, &status);
+        if (status != 0) {
+            #pragma omp critical(GFits_open)
+            __ffclos(FPTR(m_fitsfile), &status);
+            m_fitsfile = NULL;
+            throw GException::fits_error(G_OPEN, status,
+                  "Binary table extension \""+extname+"\" not found.");
+        }
+
+        // Get number of rows and columns
+        long nrows = 0;
+        int  ncols = 0;
+        status = __ffgnrw(FPTR(m_fitsfile), &nrows, &status);
+        status = __ffgncl(FPTR(m_fitsfile), &ncols, &status);
+
+        // Get column definitions
+        m_type.resize(ncols);
+        m_repeat.resize(ncols);
+        m_width.resize(ncols);
+        m_start.resize(ncols);
+        for (int i = 0; i < ncols && status == 0; ++i) {
+
+            // Get column type
+            int  typecode = 0;
+            long repeat   = 0;
+            long width    = 0;
+            status = __ffgtcl(FPTR(m_fitsfile), i+1, &typecode, &repeat,
+                              &width, &status);
+
+            // Check for unsigned columns
+            unsigned long offset = 0;
+            char          keyname[10];
+            int           keystat = 0;
+            sprintf(keyname, "TZERO%d", i+1);
+            __ffgky(FPTR(m_fitsfile), __TULONG, keyname, &offset, NULL, &keystat);
+            if (keystat == 0) {
+                if (typecode == __TSHORT && offset == 32768u) {
+                    typecode = __TUSHORT;
+                }
+                else if (typecode == __TLONG && offset == 2147483648u) {
+                    typecode = __TULONG;
+                }
+            }
+
+            // Store column definition
+            m_type[i]   = typecode;
+            m_repeat[i] = int(repeat);
+            m_width[i]  = int(width);
+
+        } // endfor: looped over columns
+
+        // Get row layout
+        #if defined(HAVE_LIBCFITSIO)
+        FITSfile* file = FPTR(m_fitsfile)->Fptr;
+        m_rowlength    = file->rowlength;
+        for (int i = 0; i < ncols; ++i) {
+            m_start[i] = file->tableptr[i].tbcol;
+        }
+        #endif
+
+        // Throw an exception if the table could not be accessed
+        if (status != 0) {
+            int clostat = 0;
+            #pragma omp critical(GFits_open)
+            __ffclos(FPTR(m_fitsfile), &clostat);
+            m_fitsfile = NULL;
+            throw GException::fits_error(G_OPEN, status);
+        }
+
+        // Set members
+        m_filename = filename;
+        m_extname  = extname;
+        m_rows     = int(nrows);
+
+    } // endif: file was opened
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Append block of rows to table extension
+ *
+ * @param[in] block Table holding the rows to be appended.
+ *
+ * @exception GException::fits_file_not_open
+ *            No table extension has been opened.
+ * @exception GException::invalid_argument
+ *            Block columns do not match the table extension columns.
+ * @exception GException::fits_invalid_type
+ *            Column type not supported.
+ * @exception GException::fits_error
+ *            Unable to write previous block to disk.
+ *
+ * Encodes the rows of the block into the FITS row format and queues them
+ * for writing. The columns are encoded in parallel, and while they are
+ * encoded, the previously queued block is written to disk. The block can
+ * therefore be modified or destroyed once the method has returned.
+ ***************************************************************************/
+void GFitsTableWriter::write(const GFitsTable& block)
+{
+    // Throw an exception if no table extension has been opened
+    if (!is_open()) {
+        throw GException::fits_file_not_open(G_WRITE, m_filename);
+    }
+
+    // Check that the block columns match the table columns
+    check_block(block);
+
+    // Continue only if there are rows
+    int nrows = block.nrows();
+    if (nrows > 0) {
+
+        // Allocate encoding buffer
+        m_buffer.assign(size_t(nrows) * size_t(m_rowlength), 0);
+
+        // Determine number of threads
+        #ifdef _OPENMP
+        int nthreads = (m_threads > 0) ? m_threads : omp_get_max_threads();
+        #else
+        int nthreads = 1;
+        #endif
+
+        // Write previous block on one thread, while the other threads
+        // encode the columns of the current block
+        int         ncols  = int(m_type.size());
+        int         status = 0;
+        std::string error;
+        #pragma omp parallel num_threads(nthreads)
+        {
+            #pragma omp single nowait
+            {
+                status = write_pending();
+            }
+            #pragma omp for schedule(dynamic)
+            for (int icol = 0; icol < ncols; ++icol) {
+                try {
+                    encode_column(block[icol], icol, nrows, &(m_buffer[0]));
+                }
+                catch (std::exception& e) {
+                    #pragma omp critical(GFitsTableWriter_write)
+                    error = e.what();
+                }
+            }
+        }
+
+        // Throw an exception if an error occured
+        if (status != 0) {
+            throw GException::fits_error(G_WRITE, status);
+        }
+        if (!error.empty()) {
+            throw GException::fits_invalid_type(G_WRITE, error);
+        }
+
+        // Queue encoded block for writing
+        m_data.swap(m_buffer);
+        m_pending = nrows;
+
+    } // endif: there were rows
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Write pending block to disk
+ *
+ * @exception GException::fits_error
+ *            Unable to write block to disk.
+ ***************************************************************************/
+void GFitsTableWriter::flush(void)
+{
+    // Write pending block
+    int status = write_pending();
+    if (status != 0) {
+        throw GException::fits_error(G_FLUSH, status);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Write pending block to disk and close file
+ *
+ * @exception GException::fits_error
+ *            Unable to write block to disk or to close file.
+ *
+ * Updates the number of rows in the header of the table extension and
+ * closes the file.
+ ***************************************************************************/
+void GFitsTableWriter::close(void)
+{
+    // Continue only if file is open
+    if (is_open()) {
+
+        // Lock FITS file for this thread
+        GFitsFileLock lock(m_fitsfile);
+
+        // Write pending block and close file
+        int status = write_pending();
+        #pragma omp critical(GFits_open)
+        status     = __ffclos(FPTR(m_fitsfile), &status);
+        m_fitsfile = NULL;
+
+        // Reset members, keeping the settings
+        int threads = m_threads;
+        clear();
+        m_threads = threads;
+
+        // Throw an exception if an error occured
+        if (status != 0) {
+            throw GException::fits_error(G_CLOSE, status);
+        }
+
+    } // endif: file was open
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Print table writer information
+ *
+ * @return String containing table writer information.
+ ***************************************************************************/
+std::string GFitsTableWriter::print(void) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Append header
+    result.append("=== GFitsTableWriter ===");
+
+    // Append information
+    if (is_open()) {
+        result.append("\n"+parformat("File name")+m_filename);
+        result.append("\n"+parformat("Extension name")+m_extname);
+        result.append("\n"+parformat("Number of columns")+str((int)m_type.size()));
+        result.append("\n"+parformat("Number of rows")+str(rows()));
+        result.append("\n"+parformat("Pending rows")+str(m_pending));
+    }
+    else {
+        result.append("\n"+parformat("Table extension")+"not opened");
+    }
+    result.append("\n"+parformat("Threads"));
+    result.append((m_threads > 0) ? str(m_threads) : "all");
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GFitsTableWriter::init_members(void)
+{
+    // Initialise members
+    m_filename.clear();
+    m_extname.clear();
+    m_threads   = 0;
+    m_fitsfile  = NULL;
+    m_rows      = 0;
+    m_rowlength = 0;
+    m_type.clear();
+    m_repeat.clear();
+    m_width.clear();
+    m_start.clear();
+    m_buffer.clear();
+    m_data.clear();
+    m_pending   = 0;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] writer Table writer.
+ *
+ * Only the settings are copied. The copy is not attached to any file.
+ ***************************************************************************/
+void GFitsTableWriter::copy_members(const GFitsTableWriter& writer)
+{
+    // Copy members
+    m_threads = writer.m_threads;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ *
+ * Writes any pending block and closes the file. Errors are ignored.
+ ***************************************************************************/
+void GFitsTableWriter::free_members(void)
+{
+    // Write pending block and close file
+    if (m_fitsfile != NULL) {
+        GFitsFileLock lock(m_fitsfile);
+        int status = write_pending();
+        status     = 0;
+        #pragma omp critical(GFits_open)
+        __ffclos(FPTR(m_fitsfile), &status);
+        m_fitsfile = NULL;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Check that block columns match table extension columns
+ *
+ * @param[in] block Table holding rows to be appended.
+ *
+ * @exception GException::invalid_argument
+ *            Block columns do not match the table extension columns.
+ ***************************************************************************/
+void GFitsTableWriter::check_block(const GFitsTable& block) const
+{
+    // Check number of columns
+    int ncols = int(m_type.size());
+    if (block.ncols() != ncols) {
+        throw GException::invalid_argument(G_CHECK_BLOCK,
+              "Block has "+str(block.ncols())+" columns but table extension"
+              " \""+m_extname+"\" has "+str(ncols)+" columns.");
+    }
+
+    // Check number of elements per row of each column
+    for (int i = 0; i < ncols; ++i) {
+        int number = (m_type[i] == __TSTRING && m_width[i] > 0)
+                     ? m_repeat[i] / m_width[i] : m_repeat[i];
+        if (block[i].number() != number) {
+            throw GException::invalid_argument(G_CHECK_BLOCK,
+                  "Block column \""+block[i].name()+"\" has "+
+                  str(block[i].number())+" elements per row but table"
+                  " column has "+str(number)+" elements per row.");
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Encode column of block into FITS row format
+ *
+ * @param[in] column Block column.
+ * @param[in] icol Column index in table extension.
+ * @param[in] nrows Number of rows in block.
+ * @param[in] buffer Encoding buffer (nrows*m_rowlength bytes).
+ *
+ * @exception GException::fits_invalid_type
+ *            Column type not supported.
+ *
+ * Stores the column values in big-endian byte order at the column
+ * position of each row in the buffer. Unsigned 16 and 32 bit integers are
+ * stored with the standard FITS offset (TZERO) of 32768 and 2147483648,
+ * respectively.
+ ***************************************************************************/
+void GFitsTableWriter::encode_column(const GFitsTableCol& column,
+                                     const int&           icol,
+                                     const int&           nrows,
+                                     unsigned char*       buffer) const
+{
+    // Get column layout
+    int       type    = m_type[icol];
+    int       repeat  = m_repeat[icol];
+    long long start   = m_start[icol];
+    int       number  = column.number();
+    int       nvalues = nrows * number;
+
+    // Encode column
+    switch (type) {
+    case __TDOUBLE:
+        {
+            std::vector<double> values(nvalues);
+            column.values(0, nrows, &(values[0]));
+            for (int row = 0, k = 0; row < nrows; ++row) {
+                unsigned char* dst = buffer + row*m_rowlength + start;
+                for (int j = 0; j < number; ++j, ++k, dst += 8) {
+                    unsigned long long u;
+                    std::memcpy(&u, &(values[k]), 8);
+                    put_bytes(dst, u, 8);
+                }
+            }
+        }
+        break;
+    case __TFLOAT:
+        {
+            std::vector<float> values(nvalues);
+            column.values(0, nrows, &(values[0]));
+            for (int row = 0, k = 0; row < nrows; ++row) {
+                unsigned char* dst = buffer + row*m_rowlength + start;
+                for (int j = 0; j < number; ++j, ++k, dst += 4) {
+                    unsigned int u;
+                    std::memcpy(&u, &(values[k]), 4);
+                    put_bytes(dst, u, 4);
+                }
+            }
+        }
+        break;
+    case __TLONGLONG:
+    case __TLONG:
+    case __TULONG:
+    case __TSHORT:
+    case __TUSHORT:
+    case __TBYTE:
+        {
+            int       size   = (type == __TLONGLONG) ? 8 :
+                               (type == __TBYTE)     ? 1 :
+                               (type == __TSHORT || type == __TUSHORT) ? 2 : 4;
+            long long offset = (type == __TULONG)  ? 2147483648LL :
+                               (type == __TUSHORT) ? 32768LL      : 0;
+            std::vector<long long> values(nvalues);
+            column.values(0, nrows, &(values[0]));
+            for (int row = 0, k = 0; row < nrows; ++row) {
+                unsigned char* dst = buffer + row*m_rowlength + start;
+                for (int j = 0; j < number; ++j, ++k, dst += size) {
+                    put_bytes(dst, (unsigned long long)(values[k] - offset), size);
+                }
+            }
+        }
+        break;
+    case __TLOGICAL:
+        {
+            std::vector<double> values(nvalues);
+            column.values(0, nrows, &(values[0]));
+            for (int row = 0, k = 0; row < nrows; ++row) {
+                unsigned char* dst = buffer + row*m_rowlength + start;
+                for (int j = 0; j < number; ++j, ++k) {
+                    dst[j] = (values[k] != 0.0) ? 'T' : 'F';
+                }
+            }
+        }
+        break;
+    case __TSTRING:
+        {
+            int width = m_width[icol];
+            for (int row = 0; row < nrows; ++row) {
+                unsigned char* dst = buffer + row*m_rowlength + start;
+                std::memset(dst, ' ', repeat);
+                for (int j = 0; j < number; ++j, dst += width) {
+                    std::string value = column.string(row, j);
+                    int         n     = (int(value.length()) < width)
+                                        ? int(value.length()) : width;
+                    std::memcpy(dst, value.c_str(), n);
+                }
+            }
+        }
+        break;
+    case __TBIT:
+        for (int row = 0; row < nrows; ++row) {
+            unsigned char* dst = buffer + row*m_rowlength + start;
+            for (int j = 0; j < number; ++j) {
+                if (column.integer(row, j) != 0) {
+                    dst[j/8] |= (unsigned char)(0x80 >> (j % 8));
+                }
+            }
+        }
+        break;
+    default:
+        throw GException::fits_invalid_type(G_ENCODE_COLUMN,
+              "Data type "+str(type)+" of column \""+column.name()+"\" not"
+              " supported for streaming.");
+        break;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Write pending block to disk
+ *
+ * @return cfitsio status (0 on success).
+ *
+ * Writes the pending block after the last row of the table extension.
+ * cfitsio extends the table as needed. The method does not throw, so that
+ * it can be used within a parallel region and from the destructor.
+ ***************************************************************************/
+int GFitsTableWriter::write_pending(void)
+{
+    // Initialise status
+    int status = 0;
+
+    // Write pending rows
+    if (m_pending > 0 && m_fitsfile != NULL) {
+        GFitsFileLock lock(m_fitsfile);
+        long long nbytes = (long long)m_pending * m_rowlength;
+        status = __ffptbb(FPTR(m_fitsfile), (long long)m_rows+1, 1, nbytes,
+                          &(m_data[0]), &status);
+        if (status == 0) {
+            m_rows   += m_pending;
+            m_pending = 0;
+        }
+    }
+
+    // Return status
+    return status;
+}
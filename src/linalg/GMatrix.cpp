@@ -45,6 +45,7 @@
 #define G_OP_MAT_MUL                          "GMatrix::operator*=(GMatrix&)"
 #define G_INVERT                                          "GMatrix::invert()"
 #define G_ADD_COL                           "GMatrix::add_col(GVector&,int&)"
+#define G_ADD_COL2                "GMatrix::add_col(double*,int*,int,int&)"
 #define G_EXTRACT_ROW                            "GMatrix::extract_row(int&)"
 #define G_EXTRACT_COL                            "GMatrix::extract_col(int&)"
 #define G_EXTRACT_LOWER               "GMatrix::extract_lower_triangle(void)"
@@ -575,6 +576,51 @@ void GMatrix::add_col(const GVector& vector, const int& col)
 }
 
 
+/***********************************************************************//**
+ * @brief Add compressed array into matrix column
+ *
+ * @param[in] values Compressed array.
+ * @param[in] rows Row indices of array.
+ * @param[in] number Number of elements in array.
+ * @param[in] col Column index (starting from 0).
+ *
+ * @exception GException::out_of_range
+ *            Invalid column index specified.
+ *
+ * Adds the content of a compressed array into a matrix column. This method
+ * has the same signature as GSparseMatrix::add_col so that dense and sparse
+ * matrices can be filled by the same code. As the matrix is stored densely,
+ * the addition does not involve any memory management and is considerably
+ * faster than the sparse matrix equivalent.
+ ***************************************************************************/
+void GMatrix::add_col(const double* values, const int* rows,
+                      int number, const int& col)
+{
+    // Raise an exception if the column index is invalid
+    #if defined(G_RANGE_CHECK)
+    if (col < 0 || col >= m_cols) {
+        throw GException::out_of_range(G_ADD_COL2, col, 0, m_cols-1);
+    }
+    #endif
+
+    // Continue only if we have elements
+    if (m_elements > 0 && number > 0) {
+
+        // Get pointer to start of column
+        double* data = m_data + m_colstart[col];
+
+        // Add array into column
+        for (int i = 0; i < number; ++i) {
+            data[rows[i]] += values[i];
+        }
+
+    } // endif: matrix had elements
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Insert vector column into matrix
  *
@@ -47,6 +47,7 @@
 #define G_OP_MAT_MUL                   "GSymMatrix::operator*= (GSymMatrix&)"
 #define G_INVERT                                   "GSymMatrix::invert(void)"
 #define G_ADD_COL                        "GSymMatrix::add_col(GVector&, int)"
+#define G_ADD_COL2             "GSymMatrix::add_col(double*,int*,int,int&)"
 #define G_INSERT_COL                  "GSymMatrix::insert_col(GVector&,int&)"
 #define G_CHOL_DECOMP                  "GSymMatrix::cholesky_decompose(int&)"
 #define G_CHOL_SOLVE            "GSymMatrix::cholesky_solver(GVector&, int&)"
@@ -475,6 +476,39 @@ void GSymMatrix::add_col(const GVector& vector, const int& col)
 }
 
 
+/***********************************************************************//**
+ * @brief Add compressed array into matrix column
+ *
+ * @param[in] values Compressed array.
+ * @param[in] rows Row indices of array.
+ * @param[in] number Number of elements in array.
+ * @param[in] col Column index (starting from 0).
+ *
+ * @exception GException::out_of_range
+ *            Invalid column index specified.
+ *
+ * Adds the content of a compressed array into a matrix column.
+ ***************************************************************************/
+void GSymMatrix::add_col(const double* values, const int* rows,
+                         int number, const int& col)
+{
+    // Raise an exception if the column index is invalid
+    #if defined(G_RANGE_CHECK)
+    if (col < 0 || col >= m_cols) {
+        throw GException::out_of_range(G_ADD_COL2, col, 0, m_cols-1);
+    }
+    #endif
+
+    // Add array into column
+    for (int i = 0; i < number; ++i) {
+        (*this)(rows[i],col) += values[i];
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Insert vector column into matrix
  *
@@ -31,11 +31,15 @@
 #include "GTools.hpp"
 #include "GException.hpp"
 #include "GModel.hpp"
+#include "GObservation.hpp"
+#include "GEvents.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_ACCESS1                                  "GModel::operator[](int&)"
 #define G_ACCESS2                          "GModel::operator[](std::string&)"
 #define G_WRITE_SCALES                   "GModel::write_scales(GXmlElement&)"
+#define G_EVAL_GRADIENTS        "GModel::eval_gradients(GObservation&, int&,"\
+                                                 " int&, double*, double*)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -264,6 +268,75 @@ const GModelPar& GModel::operator[](const std::string& name) const
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Evaluate model and parameter gradients for a range of events
+ *
+ * @param[in] obs Observation.
+ * @param[in] ibegin Index of first event.
+ * @param[in] iend Index after last event.
+ * @param[out] values Model values (iend-ibegin elements).
+ * @param[out] gradients Parameter gradients ((iend-ibegin)*size() elements).
+ *
+ * @exception GException::out_of_range
+ *            Event range is not contained in the observation.
+ *
+ * Evaluates the model and its parameter gradients for the events
+ * [ibegin,iend[ of the observation. The model value for event ibegin+k is
+ * stored in values[k], the gradient of parameter ipar for that event is
+ * stored in gradients[k*size()+ipar]. The gradients are those that
+ * eval_gradients(event,obs) sets in the model parameters; parameters
+ * without analytical gradient should therefore be handled by the caller.
+ *
+ * Upon return, the parameter gradients of the model correspond to the last
+ * event of the range, as if the single event method had been called for
+ * all events in sequence.
+ *
+ * This default implementation loops over the single event method.
+ * Derived classes may overload the method to amortise dispatch costs and
+ * to implement vectorised kernels.
+ ***************************************************************************/
+void GModel::eval_gradients(const GObservation& obs,
+                            const int&          ibegin,
+                            const int&          iend,
+                            double*             values,
+                            double*             gradients) const
+{
+    // Get event container
+    const GEvents* events = obs.events();
+
+    // Raise an exception if the event range is invalid
+    #if defined(G_RANGE_CHECK)
+    if (ibegin < 0 || ibegin > iend) {
+        throw GException::out_of_range(G_EVAL_GRADIENTS, ibegin, 0, iend);
+    }
+    if (iend > events->size()) {
+        throw GException::out_of_range(G_EVAL_GRADIENTS, iend, 0,
+                                       events->size());
+    }
+    #endif
+
+    // Get number of parameters
+    int npars = size();
+
+    // Loop over events
+    for (int i = ibegin, k = 0; i < iend; ++i, ++k) {
+
+        // Evaluate model and gradients
+        values[k] = eval_gradients(*((*events)[i]), obs);
+
+        // Store gradients
+        double* grad = gradients + k * npars;
+        for (int ipar = 0; ipar < npars; ++ipar) {
+            grad[ipar] = m_pars[ipar]->factor_gradient();
+        }
+
+    } // endfor: looped over events
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns instruments to which model applies
  *
@@ -40,6 +40,8 @@
 #include "GModelTemporalConst.hpp"
 #include "GSource.hpp"
 #include "GResponse.hpp"
+#include "GResponseCache.hpp"
+#include "GEvents.hpp"
 
 /* __ Globals ____________________________________________________________ */
 const GModelSky         g_pointsource_seed("PointSource");
@@ -59,6 +61,8 @@ const GModelRegistry    g_diffusesource_registry(&g_diffusesource_seed);
 #define G_SPECTRAL                     "GModelSky::spectral(GEvent&, GTime&," \
                                                       " GObservation&, bool)"
 #define G_TEMPORAL        "GModelSky::temporal(GEvent&, GObservation&, bool)"
+#define G_EVAL_GRADIENTS     "GModelSky::eval_gradients(GObservation&, int&,"\
+                                                 " int&, double*, double*)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -472,6 +476,221 @@ double GModelSky::eval_gradients(const GEvent& event,
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate model and parameter gradients for a range of events
+ *
+ * @param[in] obs Observation.
+ * @param[in] ibegin Index of first event.
+ * @param[in] iend Index after last event.
+ * @param[out] values Model values (iend-ibegin elements).
+ * @param[out] gradients Parameter gradients ((iend-ibegin)*size() elements).
+ *
+ * @exception GException::no_response
+ *            Observation has no valid instrument response
+ *
+ * Evaluates the source model and model gradients for the events
+ * [ibegin,iend[ of an observation (see GModel::eval_gradients for the
+ * storage convention). The response, the instrument scale factor and the
+ * source are set up only once for the entire range, and the spectral
+ * component is evaluated for all event energies in a single call so that
+ * spectral models can make use of vectorised kernels.
+ *
+ * If the observation has a response cache, the response values of sources
+ * with a fixed extended or diffuse spatial shape are taken from the cache,
+ * which avoids recomputing the convolution of the spatial model with the
+ * instrument response for every optimizer iteration. The cached values are
+ * recomputed once a spatial model parameter has changed.
+ *
+ * If the response has energy or time dispersion the method falls back to
+ * the single event method.
+ ***************************************************************************/
+void GModelSky::eval_gradients(const GObservation& obs,
+                               const int&          ibegin,
+                               const int&          iend,
+                               double*             values,
+                               double*             gradients) const
+{
+    // Get response function
+    GResponse* rsp = obs.response();
+    if (rsp == NULL) {
+        throw GException::no_response(G_EVAL_GRADIENTS);
+    }
+
+    // Fall back to single event method if the model has no spatial
+    // component or if the response has energy or time dispersion
+    if (m_spatial == NULL || rsp->hasedisp() || rsp->hastdisp()) {
+        GModel::eval_gradients(obs, ibegin, iend, values, gradients);
+        return;
+    }
+
+    // Get number of events. Continue only if there are events
+    int num = iend - ibegin;
+    if (num < 1) {
+        return;
+    }
+
+    // Determine the number of parameters per component
+    int npars      = size();
+    int n_spatial  = m_spatial->size();
+    int n_spectral = (m_spectral != NULL) ? m_spectral->size() : 0;
+    int n_temporal = (m_temporal != NULL) ? m_temporal->size() : 0;
+    int i_spectral = n_spatial;
+    int i_temporal = n_spatial + n_spectral;
+
+    // Get instrument specific model scaling
+    double scale = (m_scales.empty()) ? 1.0 : this->scale(obs.instrument()).value();
+
+    // Set source
+    GSource source(this->name(), *m_spatial, GEnergy(), GTime());
+
+    // Signal if the spatial model is radial. The response of radial models
+    // sets analytical gradients of the spatial parameters.
+    bool radial = (dynamic_cast<const GModelSpatialRadial*>(m_spatial) != NULL);
+
+    // Use the response cache only for extended or diffuse sources with
+    // a fixed spatial shape
+    GResponseCache* cache = obs.irf_cache();
+    if (cache != NULL) {
+        if (dynamic_cast<const GModelSpatialPointSource*>(m_spatial) != NULL) {
+            cache = NULL;
+        }
+        else {
+            for (int i = 0; i < n_spatial; ++i) {
+                if ((*m_spatial)[i].isfree()) {
+                    cache = NULL;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Allocate working arrays
+    std::vector<GEnergy> energies(num);
+    std::vector<double>  irfs(num);
+    std::vector<double>  temps(num, 1.0);
+    std::vector<double>  specs(num, 1.0);
+    std::vector<double>  spec_grads(num * n_spectral);
+
+    // Get event container
+    const GEvents* events = obs.events();
+
+    // Get IRF values from cache
+    bool cached = (cache != NULL) &&
+                  cache->get(this->name(), ibegin, iend, *m_spatial, &(irfs[0]));
+
+    // Compute IRF and temporal component for all events
+    for (int k = 0; k < num; ++k) {
+
+        // Get event
+        const GEvent* event = (*events)[ibegin+k];
+
+        // Store energy
+        energies[k] = event->energy();
+
+        // Get pointer to gradients of event
+        double* grad = gradients + k * npars;
+
+        // Get IRF value if not cached. This sets the spatial gradients.
+        // Cached IRF values only exist for fixed spatial parameters, hence
+        // their gradients are zero.
+        if (!cached) {
+            source.energy(event->energy());
+            source.time(event->time());
+            irfs[k] = rsp->irf(*event, source, obs);
+            for (int i = 0; i < n_spatial; ++i) {
+                grad[i] = (*source.model())[i].factor_gradient();
+            }
+        }
+        else {
+            for (int i = 0; i < n_spatial; ++i) {
+                grad[i] = 0.0;
+            }
+        }
+
+        // Evaluate temporal component and store temporal gradients
+        if (m_temporal != NULL) {
+            temps[k] = m_temporal->eval_gradients(event->time());
+            for (int i = 0; i < n_temporal; ++i) {
+                grad[i_temporal+i] = (*m_temporal)[i].factor_gradient();
+            }
+        }
+
+    } // endfor: looped over events
+
+    // Store IRF values in cache
+    if (cache != NULL && !cached) {
+        cache->set(this->name(), ibegin, iend, *m_spatial, &(irfs[0]));
+    }
+
+    // Apply instrument specific model scaling
+    for (int k = 0; k < num; ++k) {
+        irfs[k] *= scale;
+    }
+
+    // Evaluate spectral component for all energies
+    double* spec_grad = (n_spectral > 0) ? &(spec_grads[0]) : NULL;
+    if (m_spectral != NULL) {
+        m_spectral->eval_gradients(num, &(energies[0]), &(specs[0]),
+                                   spec_grad);
+    }
+
+    // Combine components
+    for (int k = 0; k < num; ++k) {
+
+        // Get pointer to gradients of event
+        double* grad = gradients + k * npars;
+
+        // Set value
+        values[k] = specs[k] * temps[k] * irfs[k];
+
+        // Compile option: Check for NaN/Inf
+        #if defined(G_NAN_CHECK)
+        if (isnotanumber(values[k]) || isinfinite(values[k])) {
+            std::cout << "*** ERROR: GModelSky::eval_gradients:";
+            std::cout << " NaN/Inf encountered";
+            std::cout << " (value=" << values[k];
+            std::cout << ", spec=" << specs[k];
+            std::cout << ", temp=" << temps[k];
+            std::cout << ", irf=" << irfs[k];
+            std::cout << ")" << std::endl;
+        }
+        #endif
+
+        // Set analytical spatial gradients of radial models
+        double fact = specs[k] * temps[k] * scale;
+        if (radial) {
+            for (int i = 0; i < n_spatial; ++i) {
+                if ((*m_spatial)[i].hasgrad()) {
+                    grad[i] *= fact;
+                }
+            }
+        }
+
+        // Set spectral gradients
+        fact = temps[k] * irfs[k];
+        for (int i = 0; i < n_spectral; ++i) {
+            grad[i_spectral+i] = spec_grad[k*n_spectral+i] * fact;
+        }
+
+        // Set temporal gradients
+        fact = specs[k] * irfs[k];
+        for (int i = 0; i < n_temporal; ++i) {
+            grad[i_temporal+i] *= fact;
+        }
+
+    } // endfor: looped over events
+
+    // Set parameter gradients of the last event
+    const double* grad = gradients + (num-1) * npars;
+    for (int i = n_spatial; i < npars; ++i) {
+        m_pars[i]->factor_gradient(grad[i]);
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return spatially integrated sky model
  *
@@ -1084,8 +1303,10 @@ double GModelSky::spatial(const GEvent& event,
         double irf = rsp->irf(event, source, obs);
 
         // If required, apply instrument specific model scaling
+        double scl = 1.0;
         if (!m_scales.empty()) {
-            irf *= scale(obs.instrument()).value();
+            scl  = scale(obs.instrument()).value();
+            irf *= scl;
         }
 
         // Case A: evaluate gradients
@@ -1111,6 +1332,18 @@ double GModelSky::spatial(const GEvent& event,
             }
             #endif
 
+            // Set analytical spatial gradients of radial models from the
+            // gradients that the response has set in the source model (see
+            // GResponse::irf_radial) and multiply factors
+            if (dynamic_cast<const GModelSpatialRadial*>(m_spatial) != NULL) {
+                double fact = spec * temp * scl;
+                for (int i = 0; i < spatial()->size(); ++i) {
+                    if ((*spatial())[i].hasgrad()) {
+                        (*spatial())[i].factor_gradient((*source.model())[i].factor_gradient() * fact);
+                    }
+                }
+            }
+
             // Multiply factors to spectral gradients
             if (spectral() != NULL) {
                 double fact = temp * irf;
@@ -198,6 +198,26 @@ double GModelSpatialRadial::eval_gradients(const GSkyDir& srcDir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return gradient of maximum model radius
+ *
+ * @param[in] ipar Parameter index [0,...,size()-1].
+ * @return Gradient of theta_max() with respect to the parameter factor
+ *         value (radians).
+ *
+ * Returns the derivative of the maximum model radius with respect to the
+ * factor value of parameter @p ipar. The derivative is needed for the
+ * boundary term of analytical gradients of IRF integrals that extend to
+ * theta_max(). By default the maximum model radius is assumed to not
+ * depend on parameters with analytical gradients and 0 is returned.
+ ***************************************************************************/
+double GModelSpatialRadial::theta_max_gradient(const int& ipar) const
+{
+    // Return gradient
+    return 0.0;
+}
+
+
 /***********************************************************************//**
  * @brief Read model from XML element
  *
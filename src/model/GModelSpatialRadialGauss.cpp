@@ -267,14 +267,30 @@ double GModelSpatialRadialGauss::eval(const double& theta) const
  *
  * @param[in] theta Angular distance from Gaussian centre (radians).
  *
- * This method simply calls GModelRadialShell::eval() as no analytical
- * gradients will be computed. See GModelRadialShell::eval() for details
- * about the implemented method.
+ * Evaluates the spatial part for a Gaussian source model and the gradient
+ * with respect to the Gaussian width. The gradient is given by
+ * \f[\frac{\partial f(\theta)}{\partial \sigma} = f(\theta)
+ *    \left(\frac{\theta^2}{\sigma^3} - \frac{2}{\sigma} \right)\f]
+ * and is stored as factor gradient in the Sigma parameter. Gradients with
+ * respect to the source position are not computed.
  ***************************************************************************/
 double GModelSpatialRadialGauss::eval_gradients(const double& theta) const
 {
+    // Compute value
+    double sigma_rad = sigma() * deg2rad;
+    double sigma2    = sigma_rad * sigma_rad;
+    double theta2    = theta   * theta;
+    double value     = std::exp(-0.5 * theta2 / sigma2) / (twopi * sigma2);
+
+    // Compute partial derivative with respect to sigma (radians)
+    double g_sigma = value * (theta2 / sigma2 - 2.0) / sigma_rad;
+
+    // Set factor gradient (circumvent const correctness)
+    const_cast<GModelSpatialRadialGauss*>(this)->m_sigma.factor_gradient(
+                                      g_sigma * m_sigma.scale() * deg2rad);
+
     // Return value
-    return (eval(theta));
+    return value;
 }
 
 
@@ -316,6 +332,24 @@ double GModelSpatialRadialGauss::theta_max(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Return gradient of maximum model radius
+ *
+ * @param[in] ipar Parameter index [0,...,size()-1].
+ * @return Gradient of theta_max() with respect to the parameter factor
+ *         value (radians).
+ *
+ * The maximum model radius \f$5 \sigma\f$ depends only on the Gaussian
+ * width, hence a non-zero gradient is only returned for the Sigma
+ * parameter.
+ ***************************************************************************/
+double GModelSpatialRadialGauss::theta_max_gradient(const int& ipar) const
+{
+    // Return gradient
+    return ((m_pars[ipar] == &m_sigma) ? m_sigma.scale()*deg2rad*5.0 : 0.0);
+}
+
+
 /***********************************************************************//**
  * @brief Read model from XML element
  *
@@ -491,7 +525,7 @@ void GModelSpatialRadialGauss::init_members(void)
     m_sigma.free();
     m_sigma.scale(1.0);
     m_sigma.gradient(0.0);
-    m_sigma.hasgrad(false);  // Radial components never have gradients
+    m_sigma.hasgrad(true);
 
     // Set parameter pointer(s)
     m_pars.push_back(&m_sigma);
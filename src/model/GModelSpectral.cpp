@@ -257,6 +257,49 @@ void GModelSpectral::autoscale(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate function and gradients for an array of energies
+ *
+ * @param[in] num Number of energies.
+ * @param[in] srcEng Array of true photon energies (num elements).
+ * @param[out] values Function values (num elements).
+ * @param[out] gradients Parameter gradients (num*size() elements).
+ *
+ * Evaluates the spectral model and its parameter gradients for an array of
+ * energies. The function value for energy k is stored in values[k], the
+ * gradient of parameter ipar is stored in gradients[k*size()+ipar]. Upon
+ * return, the parameter gradients of the model correspond to the last
+ * energy in the array.
+ *
+ * This default implementation loops over the single energy method.
+ ***************************************************************************/
+void GModelSpectral::eval_gradients(const int&     num,
+                                    const GEnergy* srcEng,
+                                    double*        values,
+                                    double*        gradients) const
+{
+    // Get number of parameters
+    int npars = size();
+
+    // Loop over energies
+    for (int k = 0; k < num; ++k) {
+
+        // Evaluate function and gradients
+        values[k] = eval_gradients(srcEng[k]);
+
+        // Store gradients
+        double* grad = gradients + k * npars;
+        for (int ipar = 0; ipar < npars; ++ipar) {
+            grad[ipar] = m_pars[ipar]->factor_gradient();
+        }
+
+    } // endfor: looped over energies
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
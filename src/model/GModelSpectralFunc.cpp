@@ -349,12 +349,14 @@ double GModelSpectralFunc::flux(const GEnergy& emin, const GEnergy& emax) const
     if (e_max > e_min) {
     
         // Determine left node index for minimum energy
-        m_lin_nodes.set_value(e_min);
-        int inx_emin = m_lin_nodes.inx_left();
+        int    inx[2];
+        double wgt[2];
+        m_lin_nodes.interpolate(e_min, inx, wgt);
+        int inx_emin = inx[0];
 
         // Determine left node index for maximum energy
-        m_lin_nodes.set_value(e_max);
-        int inx_emax = m_lin_nodes.inx_left();
+        m_lin_nodes.interpolate(e_max, inx, wgt);
+        int inx_emax = inx[0];
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -444,12 +446,14 @@ double GModelSpectralFunc::eflux(const GEnergy& emin, const GEnergy& emax) const
     if (e_max > e_min) {
     
         // Determine left node index for minimum energy
-        m_lin_nodes.set_value(e_min);
-        int inx_emin = m_lin_nodes.inx_left();
+        int    inx[2];
+        double wgt[2];
+        m_lin_nodes.interpolate(e_min, inx, wgt);
+        int inx_emin = inx[0];
 
         // Determine left node index for maximum energy
-        m_lin_nodes.set_value(e_max);
-        int inx_emax = m_lin_nodes.inx_left();
+        m_lin_nodes.interpolate(e_max, inx, wgt);
+        int inx_emax = inx[0];
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -982,12 +986,14 @@ void GModelSpectralFunc::mc_update(const GEnergy& emin, const GEnergy& emax) con
             double flux;
     
             // Determine left node index for minimum energy
-            m_lin_nodes.set_value(e_min);
-            int inx_emin = m_lin_nodes.inx_left();
+            int    inx[2];
+            double wgt[2];
+            m_lin_nodes.interpolate(e_min, inx, wgt);
+            int inx_emin = inx[0];
 
             // Determine left node index for maximum energy
-            m_lin_nodes.set_value(e_max);
-            int inx_emax = m_lin_nodes.inx_left();
+            m_lin_nodes.interpolate(e_max, inx, wgt);
+            int inx_emax = inx[0];
     
             // If both energies are within the same node then just
             // add this one node on the stack
@@ -280,14 +280,14 @@ double GModelSpectralNodes::eval_gradients(const GEnergy& srcEng) const
     // Update evaluation cache
     update_eval_cache();
 
-    // Set interpolation value
-    m_log_energies.set_value(srcEng.log10MeV());
-
     // Get indices and weights for interpolation
-    int    inx_left  = m_log_energies.inx_left();
-    int    inx_right = m_log_energies.inx_right();
-    double wgt_left  = m_log_energies.wgt_left();
-    double wgt_right = m_log_energies.wgt_right();
+    int    inx[2];
+    double wgt[2];
+    m_log_energies.interpolate(srcEng.log10MeV(), inx, wgt);
+    int    inx_left  = inx[0];
+    int    inx_right = inx[1];
+    double wgt_left  = wgt[0];
+    double wgt_right = wgt[1];
 
     // Interpolate function
     double exponent = m_log_values[inx_left]  * wgt_left +
@@ -370,12 +370,14 @@ double GModelSpectralNodes::flux(const GEnergy& emin, const GEnergy& emax) const
     if (e_max > e_min) {
     
         // Determine left node index for minimum energy
-        m_lin_energies.set_value(e_min);
-        int inx_emin = m_lin_energies.inx_left();
+        int    inx[2];
+        double wgt[2];
+        m_lin_energies.interpolate(e_min, inx, wgt);
+        int inx_emin = inx[0];
 
         // Determine left node index for maximum energy
-        m_lin_energies.set_value(e_max);
-        int inx_emax = m_lin_energies.inx_left();
+        m_lin_energies.interpolate(e_max, inx, wgt);
+        int inx_emax = inx[0];
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -465,12 +467,14 @@ double GModelSpectralNodes::eflux(const GEnergy& emin, const GEnergy& emax) cons
     if (e_max > e_min) {
     
         // Determine left node index for minimum energy
-        m_lin_energies.set_value(e_min);
-        int inx_emin = m_lin_energies.inx_left();
+        int    inx[2];
+        double wgt[2];
+        m_lin_energies.interpolate(e_min, inx, wgt);
+        int inx_emin = inx[0];
 
         // Determine left node index for maximum energy
-        m_lin_energies.set_value(e_max);
-        int inx_emax = m_lin_energies.inx_left();
+        m_lin_energies.interpolate(e_max, inx, wgt);
+        int inx_emax = inx[0];
     
         // If both energies are within the same nodes then simply
         // integrate over the energy interval using the appropriate power
@@ -1203,12 +1207,14 @@ void GModelSpectralNodes::mc_update(const GEnergy& emin, const GEnergy& emax) co
             double flux;
     
             // Determine left node index for minimum energy
-            m_lin_energies.set_value(e_min);
-            int inx_emin = m_lin_energies.inx_left();
+            int    inx[2];
+            double wgt[2];
+            m_lin_energies.interpolate(e_min, inx, wgt);
+            int inx_emin = inx[0];
 
             // Determine left node index for maximum energy
-            m_lin_energies.set_value(e_max);
-            int inx_emax = m_lin_energies.inx_left();
+            m_lin_energies.interpolate(e_max, inx, wgt);
+            int inx_emax = inx[0];
     
             // If both energies are within the same node then just
             // add this one node on the stack
@@ -336,6 +336,68 @@ double GModelSpectralPlaw::eval_gradients(const GEnergy& srcEng) const
 }
 
 
+/***********************************************************************//**
+ * @brief Evaluate function and gradients for an array of energies
+ *
+ * @param[in] num Number of energies.
+ * @param[in] srcEng Array of true photon energies (num elements).
+ * @param[out] values Function values (num elements).
+ * @param[out] gradients Parameter gradients (num*3 elements).
+ *
+ * Evaluates the power law and its parameter gradients for an array of
+ * energies (see GModelSpectral::eval_gradients for the storage
+ * convention). The parameter values, scales and free flags are fetched only
+ * once, and the power law is computed from the logarithm of the reduced
+ * energy that is also needed for the index gradient. The inner loop only
+ * operates on plain arrays so that it can be vectorised by the compiler.
+ ***************************************************************************/
+void GModelSpectralPlaw::eval_gradients(const int&     num,
+                                        const GEnergy* srcEng,
+                                        double*        values,
+                                        double*        gradients) const
+{
+    // Continue only if there are energies
+    if (num > 0) {
+
+        // Fetch parameters
+        double norm        = this->norm();
+        double index       = this->index();
+        double inv_pivot   = 1.0 / pivot();
+        double scale_norm  = (m_norm.isfree())  ? m_norm.scale()  : 0.0;
+        double scale_index = (m_index.isfree()) ? m_index.scale() : 0.0;
+        double scale_pivot = (m_pivot.isfree()) ? -index / m_pivot.factor_value()
+                                                : 0.0;
+
+        // Gather logarithms of reduced energies
+        for (int k = 0; k < num; ++k) {
+            values[k] = std::log(srcEng[k].MeV() * inv_pivot);
+        }
+
+        // Compute function values and gradients
+        for (int k = 0; k < num; ++k) {
+            double  ln_energy = values[k];
+            double  power     = std::exp(index * ln_energy);
+            double  value     = norm * power;
+            double* grad      = gradients + 3*k;
+            grad[0]   = scale_norm  * power;
+            grad[1]   = scale_index * value * ln_energy;
+            grad[2]   = scale_pivot * value;
+            values[k] = value;
+        }
+
+        // Set gradients of last energy (circumvent const correctness)
+        const double* grad = gradients + 3*(num-1);
+        const_cast<GModelSpectralPlaw*>(this)->m_norm.factor_gradient(grad[0]);
+        const_cast<GModelSpectralPlaw*>(this)->m_index.factor_gradient(grad[1]);
+        const_cast<GModelSpectralPlaw*>(this)->m_pivot.factor_gradient(grad[2]);
+
+    } // endif: there were energies
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns model photon flux between [emin, emax] (units: ph/cm2/s)
  *
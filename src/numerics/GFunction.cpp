@@ -124,6 +124,31 @@ GFunction& GFunction::operator= (const GFunction& func)
  =                                                                         =
  ==========================================================================*/
 
+/***********************************************************************//**
+ * @brief Evaluate function for a batch of arguments
+ *
+ * @param[in] num Number of arguments.
+ * @param[in] x Arguments (num elements).
+ * @param[out] values Function values (num elements).
+ *
+ * Evaluates the function for num arguments in a single call. This method
+ * is used by integration methods that evaluate the function at several
+ * nodes at once (see GIntegral::gkq). The default implementation calls
+ * eval() for each argument. Derived classes may overload the method to
+ * share computations between the arguments.
+ ***************************************************************************/
+void GFunction::eval(const int& num, const double* x, double* values)
+{
+    // Evaluate function for all arguments
+    for (int i = 0; i < num; ++i) {
+        values[i] = eval(x[i]);
+    }
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
@@ -0,0 +1,484 @@
+/***************************************************************************
+ *          GIntegrals.cpp  -  Integration class for set of functions      *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2012 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GIntegrals.cpp
+ * @brief Integration class for set of functions implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#include <cmath>            // For std::abs()
+#include <vector>
+#include "GIntegrals.hpp"
+#include "GTools.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                        Constructors/destructors                         =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GIntegrals::GIntegrals(void)
+{
+    // Initialise members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Function kernel constructor
+ *
+ * @param[in] kernel Pointer to function kernel.
+ *
+ * The function kernel constructor assigns the function kernel pointer in
+ * constructing the object.
+ ***************************************************************************/
+GIntegrals::GIntegrals(GFunctions* kernel)
+{
+    // Initialise members
+    init_members();
+
+    // Set function kernel
+    m_kernel = kernel;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] integral Integral.
+ ***************************************************************************/
+GIntegrals::GIntegrals(const GIntegrals& integral)
+{ 
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(integral);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GIntegrals::~GIntegrals(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                               Operators                                 =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] integral Integral.
+ ***************************************************************************/
+GIntegrals& GIntegrals::operator= (const GIntegrals& integral)
+{
+    // Execute only if object is not identical
+    if (this != &integral) {
+
+        // Free members
+        free_members();
+
+        // Initialise integral
+        init_members();
+
+        // Copy members
+        copy_members(integral);
+
+    } // endif: object was not identical
+
+    // Return
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear instance
+ ***************************************************************************/
+void GIntegrals::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone instance
+ *
+ * @return Pointer to deep copy of integral.
+ ***************************************************************************/
+GIntegrals* GIntegrals::clone(void) const
+{
+    return new GIntegrals(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Perform Romberg integration
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[in] k Integration order (default: k=5)
+ * @return Vector of integrals (one element per function).
+ *
+ * Returns the integrals of all functions of the kernel from a to b.
+ * Integration is performed by Romberg's method of order 2K, where e.g. K=2
+ * in Simpson's rule, using the same nodes for all functions.
+ *
+ * The number of iterations is limited by m_max_iter. m_eps specifies the
+ * requested fractional accuracy, which applies to the norm of the vector
+ * of integrals. By default it is set to 1e-6. Using the norm avoids that
+ * functions with a vanishing integral, which is frequently the case for
+ * gradients, require an excessive number of iterations.
+ ***************************************************************************/
+GVector GIntegrals::romb(double a, double b, int k)
+{
+    // Get number of functions
+    int nfun = m_kernel->size();
+
+    // Initialise result
+    GVector result(nfun);
+
+    // Continue only if integration range is valid
+    if (b > a) {
+
+        // Initialise variables
+        bool    converged = false;
+        GVector ss(nfun);
+        GVector dss(nfun);
+
+        // Allocate temporal storage
+        std::vector<GVector> s(m_max_iter+2, GVector(nfun));
+        std::vector<double>  h(m_max_iter+2);
+        std::vector<double>  s_fun(m_max_iter+2);
+
+        // Initialise step size
+        h[1] = 1.0;
+
+        // Iterative loop
+        for (m_iter = 1; m_iter <= m_max_iter; ++m_iter) {
+
+            // Integration using Trapezoid rule
+            s[m_iter] = trapzd(a, b, m_iter, s[m_iter-1]);
+
+            // Starting from iteration k on, use polynomial interpolation
+            // for all functions
+            if (m_iter >= k) {
+                for (int i = 0; i < nfun; ++i) {
+                    for (int j = m_iter-k; j <= m_iter; ++j) {
+                        s_fun[j] = s[j][i];
+                    }
+                    double dy = 0.0;
+                    ss[i]     = polint(&h[m_iter-k], &s_fun[m_iter-k], k, 0.0, &dy);
+                    dss[i]    = dy;
+                }
+                if (norm(dss) <= m_eps * norm(ss)) {
+                    converged = true;
+                    result    = ss;
+                    break;
+                }
+            }
+
+            // Reduce step size
+            h[m_iter+1]= 0.25 * h[m_iter];
+
+        } // endfor: iterative loop
+
+        // Dump warning
+        if (!m_silent) {
+            if (!converged) {
+                std::cout << "*** WARNING: GIntegrals::romb: ";
+                std::cout << "Integration did not converge ";
+                std::cout << "(iter=" << m_iter;
+                std::cout << ", result=" << norm(ss);
+                std::cout << ", d=" << norm(dss);
+                std::cout << " > " << m_eps * norm(ss) << ")";
+                std::cout << std::endl;
+            }
+        }
+    
+    } // endif: integration range was valid
+
+    // Return result
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform Trapezoidal integration
+ *
+ * @param[in] a Left integration boundary.
+ * @param[in] b Right integration boundary.
+ * @param[in] n Number of steps.
+ * @param[in] result Result from a previous trapezoidal integration step.
+ * @return Vector of integrals (one element per function).
+ *
+ * Performs the n-th refinement of the trapezoidal rule for all functions
+ * of the kernel (see GIntegral::trapzd). Result initialisation is done if
+ * n=1.
+ ***************************************************************************/
+GVector GIntegrals::trapzd(double a, double b, int n, const GVector& result)
+{
+    // Initialise result
+    GVector value(m_kernel->size());
+    
+    // Continue only if boundaries differ
+    if (a != b) {
+    
+        // Case A: Only a single step is requested
+        if (n == 1) {
+        
+            // Evaluate integrand at boundaries
+            GVector y_a = m_kernel->eval(a);
+            GVector y_b = m_kernel->eval(b);
+            
+            // Compute result
+            value = 0.5*(b-a)*(y_a + y_b);
+            
+        } // endif: only a single step was requested
+
+        // Case B: More than a single step is requested
+        else {
+
+            // Compute step level 2^(n-1)
+            int it = 1;
+            for (int j = 1; j < n-1; ++j) {
+                it <<= 1;
+            }
+
+            // Set step size
+            double tnm = double(it);
+            double del = (b-a)/tnm;
+
+            // Sum up values
+            double  x = a + 0.5*del;
+            GVector sum(m_kernel->size());
+            for (int j = 0; j < it; ++j, x+=del) {
+                sum += m_kernel->eval(x);
+            }
+
+            // Set result
+            value = 0.5*(result + (b-a)*sum/tnm);
+        }
+        
+    } // endif: boundaries differed
+
+    // Return result
+    return value;
+}
+
+
+/***********************************************************************//**
+ * @brief Print integral information
+ ***************************************************************************/
+std::string GIntegrals::print(void) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Append header
+    result.append("=== GIntegrals ===");
+
+    // Append information
+    result.append("\n"+parformat("Relative precision")+str(eps()));
+    result.append("\n"+parformat("Max. number of iterations")+str(max_iter()));
+    if (silent()) {
+        result.append("\n"+parformat("Warnings")+"suppressed");
+    }
+    else {
+        result.append("\n"+parformat("Warnings")+"in standard output");
+    }
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                            Protected methods                            =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GIntegrals::init_members(void)
+{
+    // Initialise members
+    m_kernel    = NULL;
+    m_eps       = 1.0e-6;
+    m_max_iter  = 20;
+    m_iter      = 0;
+    m_silent    = false;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] integral Integral.
+ ***************************************************************************/
+void GIntegrals::copy_members(const GIntegrals& integral)
+{
+    // Copy attributes
+    m_kernel   = integral.m_kernel;
+    m_eps      = integral.m_eps;
+    m_max_iter = integral.m_max_iter;
+    m_iter     = integral.m_iter;
+    m_silent   = integral.m_silent;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GIntegrals::free_members(void)
+{
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Perform Polynomial interpolation
+ *
+ * @param[in] xa Pointer to array of X values.
+ * @param[in] ya Pointer to array of Y values.
+ * @param[in] n Number of elements in arrays.
+ * @param[in] x X value at which interpolations should be performed.
+ * @param[out] dy Error estimate for interpolated values.
+ *
+ * Given arrays xa[1,..,n] and ya[1,..,n], and given a value x, this
+ * method returns a value y, and an error estimate dy. If P(x) is the
+ * polynomial of degree n-1, then the returned value y=P(x).
+ *
+ * @todo Implement exceptions instead of screen dump.
+ * @todo Use std::vector for xa and ya and start at 0
+ ***************************************************************************/
+double GIntegrals::polint(double* xa, double* ya, int n, double x, double *dy)
+{
+    // Initialise result
+    double y = 0.0;
+
+    // Allocate temporary memory
+    std::vector<double> c(n, 0.0);
+    std::vector<double> d(n, 0.0);
+
+    // Compute initial distance to first node
+    double dif = std::abs(x-xa[1]);
+
+    // Find index ns of the closest table entry
+    int ns = 0;
+    for (int i = 0; i < n; ++i) {
+        double dift = std::abs(x-xa[i+1]);
+        if (dift < dif) {
+            ns  = i;
+            dif = dift;
+        }
+        c[i] = ya[i+1];
+        d[i] = ya[i+1];
+    }
+
+    // Get initial approximation to y
+    y = ya[ns+1];
+    ns--;
+
+    // Loop over each column of the tableau
+    for (int m = 1; m < n; ++m) {
+
+        // Update current c's and d's
+        for (int i = 0; i < n-m; ++i) {
+            double ho  = xa[i+1]   - x;
+            double hp  = xa[i+m+1] - x;
+            double w   = c[i+1] - d[i];
+            double den = ho - hp;
+            if (den == 0.0) {
+                std::cout << "*** ERROR: GIntegrals::polint: ";
+                std::cout << "This error can only occur if two input xa's are identical.";
+                std::cout << std::endl;
+            }
+            den  = w/den;
+            d[i] = hp*den;
+            c[i] = ho*den;
+        }
+
+        // Compute y correction
+        *dy = (2*(ns+1) < (n-m)) ? c[ns+1] : d[ns--];
+
+        // Update y
+        y += *dy;
+
+    } // endfor: looped over columns of tableau
+
+    // Return
+    return y;
+}
@@ -400,6 +400,28 @@ void GEnergy::MeV(const double& eng)
 }
 
 
+/***********************************************************************//**
+ * @brief Set energy in MeV with known log10 of energy
+ *
+ * @param[in] eng Energy in MeV.
+ * @param[in] log10eng log10 of energy in MeV.
+ *
+ * Sets the energy together with its log10, which avoids the computation
+ * of the log10 by log10MeV(). The caller is responsible for the
+ * consistency of the arguments.
+ ***************************************************************************/
+void GEnergy::MeV(const double& eng, const double& log10eng)
+{
+    // Set energy and log10 of energy
+    m_energy    = eng;
+    m_elog10    = log10eng;
+    m_has_log10 = true;
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set energy in GeV
  *
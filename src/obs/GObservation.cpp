@@ -35,10 +35,13 @@
 #include "GIntegral.hpp"
 #include "GDerivative.hpp"
 #include "GTools.hpp"
+#include "GEvents.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_MODEL                   "GObservation::model(GModels&, GPointing&,"\
                                     " GInstDir&, GEnergy&, GTime&, GVector*)"
+#define G_MODEL_BLOCK     "GObservation::model(GModels&, int&, int&, double*,"\
+                                                                 " double*)"
 #define G_EVENTS                                     "GObservation::events()"
 #define G_NPRED_TEMP                 "GObservation::npred_temp(GModel&, int)"
 #define G_NPRED_SPEC              "GObservation::npred_spec(GModel&, GTime&)"
@@ -102,6 +105,35 @@ GObservation::GObservation(const GObservation& obs)
 }
 
 
+/***********************************************************************//**
+ * @brief Working copy constructor
+ *
+ * @param[in] obs Observation.
+ * @param[in] share_events Reference the event container of @p obs?
+ *
+ * Instantiate a working copy of an existing observation. The working copy
+ * references the response cache of @p obs. If @p share_events is true,
+ * the event container of @p obs is also referenced instead of being
+ * copied. This constructor is used by derived classes for implementing
+ * shallow_clone().
+ ***************************************************************************/
+GObservation::GObservation(const GObservation& obs, const bool& share_events)
+{
+    // Initialise members
+    init_members();
+
+    // Copy members
+    copy_members(obs, share_events);
+
+    // Reference response cache
+    m_irf_cache    = obs.m_irf_cache;
+    m_shared_cache = (m_irf_cache != NULL);
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Destructor
  ***************************************************************************/
@@ -212,10 +244,20 @@ double GObservation::model(const GModels& models, const GEvent& event,
                 // Compute value and add to model
                 model += mptr->eval_gradients(event, *this);
 
-                // Optionally determine model gradients
+                // Optionally determine model gradients. Analytical gradients
+                // are collected first as the numerical computation of the
+                // other gradients re-evaluates the model, which may alter
+                // analytical gradients that are set by the response.
                 if (gradient != NULL) {
                     for (int k = 0; k < mptr->size(); ++k) {
-                        (*gradient)[igrad+k] = model_grad(*mptr, event, k);
+                        if ((*mptr)[k].hasgrad()) {
+                            (*gradient)[igrad+k] = model_grad(*mptr, event, k);
+                        }
+                    }
+                    for (int k = 0; k < mptr->size(); ++k) {
+                        if (!(*mptr)[k].hasgrad()) {
+                            (*gradient)[igrad+k] = model_grad(*mptr, event, k);
+                        }
                     }
                 }
 
@@ -233,6 +275,153 @@ double GObservation::model(const GModels& models, const GEvent& event,
 }
 
 
+/***********************************************************************//**
+ * @brief Return model values (and optionally gradients) for a range of
+ *        events
+ *
+ * @param[in] models Models.
+ * @param[in] ibegin Index of first event.
+ * @param[in] iend Index after last event.
+ * @param[out] values Model values (iend-ibegin elements).
+ * @param[out] gradients Model parameter gradients (optional).
+ *
+ * @exception GException::out_of_range
+ *            Event range is not contained in the observation.
+ *
+ * Evaluates the sum of all models for the events [ibegin,iend[ of the
+ * observation. The model value of event ibegin+k is stored in values[k].
+ * If a gradients array is provided (with (iend-ibegin)*models.npars()
+ * elements), the gradient of parameter ipar for event ibegin+k is stored in
+ * gradients[k*models.npars()+ipar]. If NULL is passed for the gradients
+ * array, no gradients are computed.
+ *
+ * The models are evaluated for the full range of events using the block
+ * version of GModel::eval_gradients(), which allows models to amortise
+ * their per-event overhead. Gradients of parameters that have no
+ * analytical gradient are computed numerically using model_grad().
+ *
+ * The method will only operate on models for which the list of instruments
+ * and observation identifiers matches those of the observation. Models that
+ * do not match will be skipped.
+ ***************************************************************************/
+void GObservation::model(const GModels& models, const int& ibegin,
+                         const int& iend, double* values,
+                         double* gradients) const
+{
+    // Get event container
+    const GEvents* events = this->events();
+
+    // Raise an exception if the event range is invalid
+    #if defined(G_RANGE_CHECK)
+    if (ibegin < 0 || ibegin > iend) {
+        throw GException::out_of_range(G_MODEL_BLOCK, ibegin, 0, iend);
+    }
+    if (iend > events->size()) {
+        throw GException::out_of_range(G_MODEL_BLOCK, iend, 0,
+                                       events->size());
+    }
+    #endif
+
+    // Get number of events and parameters. Continue only if there are
+    // events
+    int num   = iend - ibegin;
+    int npars = models.npars();
+    if (num < 1) {
+        return;
+    }
+
+    // Initialise values and gradients
+    for (int k = 0; k < num; ++k) {
+        values[k] = 0.0;
+    }
+    if (gradients != NULL) {
+        for (int k = 0; k < num*npars; ++k) {
+            gradients[k] = 0.0;
+        }
+    }
+
+    // Allocate working arrays
+    std::vector<double> wrk_values(num);
+    std::vector<double> wrk_gradients;
+
+    // Initialise gradient counter
+    int igrad = 0;
+
+    // Loop over models
+    for (int i = 0; i < models.size(); ++i) {
+
+        // Get model pointer. Continue only if pointer is valid
+        const GModel* mptr = models[i];
+        if (mptr != NULL) {
+
+            // Continue only if model applies to specific instrument and
+            // observation identifier
+            if (mptr->isvalid(instrument(), id())) {
+
+                // Case A: no gradients are requested
+                if (gradients == NULL) {
+                    for (int k = 0; k < num; ++k) {
+                        values[k] += mptr->eval(*((*events)[ibegin+k]), *this);
+                    }
+                }
+
+                // Case B: gradients are requested
+                else {
+
+                    // Evaluate model and gradients for all events
+                    int n = mptr->size();
+                    wrk_gradients.resize(num * n);
+                    double* wrk_grad = (n > 0) ? &(wrk_gradients[0]) : NULL;
+                    mptr->eval_gradients(*this, ibegin, iend,
+                                         &(wrk_values[0]), wrk_grad);
+
+                    // Add model values
+                    for (int k = 0; k < num; ++k) {
+                        values[k] += wrk_values[k];
+                    }
+
+                    // Set gradients of free parameters
+                    for (int ipar = 0; ipar < n; ++ipar) {
+
+                        // Skip fixed parameters
+                        if (!(*mptr)[ipar].isfree()) {
+                            continue;
+                        }
+
+                        // Use analytical gradient if available ...
+                        double* grad = gradients + igrad + ipar;
+                        if ((*mptr)[ipar].hasgrad()) {
+                            for (int k = 0; k < num; ++k) {
+                                grad[k*npars] = wrk_grad[k*n+ipar];
+                            }
+                        }
+
+                        // ... otherwise compute it numerically
+                        else {
+                            for (int k = 0; k < num; ++k) {
+                                grad[k*npars] =
+                                    model_grad(*mptr, *((*events)[ibegin+k]), ipar);
+                            }
+                        }
+
+                    } // endfor: looped over model parameters
+
+                } // endelse: gradients were requested
+
+            } // endif: model component was valid for instrument
+
+            // Increment parameter counter for gradients
+            igrad += mptr->size();
+
+        } // endif: model was valid
+
+    } // endfor: Looped over models
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Return total number (and optionally gradient) of predicted counts
  *        for all models
@@ -354,16 +543,22 @@ void GObservation::id(const std::string& id)
 void GObservation::events(const GEvents* events)
 {
     // Remove an existing event container
-    if (m_events != NULL) delete m_events;
+    if (m_events != NULL && !m_shared_events) delete m_events;
 
     // Signal event container as free
-    m_events = NULL;
+    m_events        = NULL;
+    m_shared_events = false;
 
     // Set event container if the input pointer is valid
     if (events != NULL) {
         m_events = events->clone();
     }
 
+    // Invalidate cached response values
+    if (m_irf_cache != NULL && !m_shared_cache) {
+        m_irf_cache->clear();
+    }
+
     // Return
     return;
 }
@@ -406,6 +601,77 @@ const GEvents* GObservation::events(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Clone working copy of observation
+ *
+ * @param[in] share_events Reference the event container?
+ * @return Pointer to observation clone.
+ *
+ * Returns a working copy of the observation that references the response
+ * cache of this observation. If @p share_events is true, the working copy
+ * also references the event container of this observation instead of
+ * holding a copy of it. The working copy does not take ownership of the
+ * referenced members, and this observation must therefore outlive the
+ * working copy and must not change its events or response cache meanwhile.
+ *
+ * The method is intended for building working copies of observations,
+ * for example for evaluating the events of a single observation in several
+ * threads. The observation is not modified, hence the method may be called
+ * from several threads at the same time.
+ *
+ * Derived classes implement the method using the protected copy
+ * constructor GObservation(const GObservation&, const bool&). This default
+ * implementation copies the observation, including the event container,
+ * and attaches the response cache.
+ ***************************************************************************/
+GObservation* GObservation::shallow_clone(const bool& share_events) const
+{
+    // Copy observation
+    GObservation* obs = clone();
+
+    // Reference response cache
+    obs->m_irf_cache    = m_irf_cache;
+    obs->m_shared_cache = (m_irf_cache != NULL);
+
+    // Return working copy
+    return obs;
+}
+
+
+/***********************************************************************//**
+ * @brief Enable or disable response cache
+ *
+ * @param[in] use Use response cache?
+ *
+ * Enables or disables the caching of response values for event ranges.
+ * If enabled, models with a fixed spatial shape may store the response
+ * values of all events in the cache, so that they need not be recomputed
+ * for each evaluation. Copies of the observation start without a cache,
+ * while working copies obtained from shallow_clone() reference the cache
+ * of this observation. Disabling the cache deletes all cached values.
+ ***************************************************************************/
+void GObservation::use_irf_cache(const bool& use)
+{
+    // Allocate response cache if required
+    if (use) {
+        if (m_irf_cache == NULL) {
+            m_irf_cache    = new GResponseCache;
+            m_shared_cache = false;
+        }
+    }
+
+    // ... otherwise remove response cache
+    else {
+        if (m_irf_cache != NULL && !m_shared_cache) delete m_irf_cache;
+        m_irf_cache    = NULL;
+        m_shared_cache = false;
+    }
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                             Private methods                             =
@@ -420,8 +686,11 @@ void GObservation::init_members(void)
     // Initialise members
     m_name.clear();
     m_id.clear();
-    m_statistics = "Poisson";
-    m_events     = NULL;
+    m_statistics    = "Poisson";
+    m_events        = NULL;
+    m_shared_events = false;
+    m_irf_cache     = NULL;
+    m_shared_cache  = false;
 
     // Return
     return;
@@ -432,18 +701,28 @@ void GObservation::init_members(void)
  * @brief Copy class members
  *
  * @param[in] obs Observation.
+ * @param[in] share_events Reference the event container of @p obs?
  *
- * Copy members from an observation.
+ * Copy members from an observation. The response cache is neither copied
+ * nor referenced, hence copies start without a response cache.
  ***************************************************************************/
-void GObservation::copy_members(const GObservation& obs)
+void GObservation::copy_members(const GObservation& obs,
+                                const bool&         share_events)
 {
     // Copy members
     m_name       = obs.m_name;
     m_id         = obs.m_id;
     m_statistics = obs.m_statistics;
 
-    // Clone members
-    m_events = (obs.m_events != NULL) ? obs.m_events->clone() : NULL;
+    // Reference or clone event container
+    if (share_events) {
+        m_events        = obs.m_events;
+        m_shared_events = (m_events != NULL);
+    }
+    else {
+        m_events        = (obs.m_events != NULL) ? obs.m_events->clone() : NULL;
+        m_shared_events = false;
+    }
 
     // Return
     return;
@@ -456,10 +735,14 @@ void GObservation::copy_members(const GObservation& obs)
 void GObservation::free_members(void)
 {
     // Free members
-    if (m_events != NULL) delete m_events;
+    if (m_events != NULL && !m_shared_events) delete m_events;
+    if (m_irf_cache != NULL && !m_shared_cache) delete m_irf_cache;
 
     // Signal free pointers
-    m_events = NULL;
+    m_events        = NULL;
+    m_shared_events = false;
+    m_irf_cache     = NULL;
+    m_shared_cache  = false;
 
     // Return
     return;
@@ -28,6 +28,11 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <ctime>
+#include <fstream>
 #include "GTools.hpp"
 #include "GException.hpp"
 #include "GObservations.hpp"
@@ -39,6 +44,8 @@
 #define G_INSERT                 "GObservations::insert(int&, GObservation&)"
 #define G_REMOVE                                "GObservations::remove(int&)"
 #define G_READ                                   "GObservations::read(GXml&)"
+#define G_LOAD_THREADS                   "GObservations::load_threads(int&)"
+#define G_LOAD_BUDGET                  "GObservations::load_budget(double&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -469,6 +476,23 @@ void GObservations::save(const std::string& filename) const
  * The structure within the @p observation tag is defined by the instrument
  * specific GObservation class.
  *
+ * If more than one thread was requested using load_threads(), the
+ * observations are read in parallel. If a size budget was set using
+ * load_budget(), the observations are read in consecutive batches so
+ * that the total size of the files referenced by the observations of a
+ * batch does not exceed the budget. Each batch holds at least one
+ * observation. The order of the observations in the container does not
+ * depend on the number of threads. Observations whose reading failed in
+ * parallel are read again sequentially, so that any exception is thrown
+ * as in sequential reading.
+ *
+ * Parallel reading requires that the instrument specific read() methods
+ * are thread safe, which for FITS files requires a cfitsio library that
+ * has been built with the --enable-reentrant option.
+ *
+ * The time needed to read each observation is stored and can be retrieved
+ * using the load_times() method.
+ *
  * @todo Observation names and IDs are not verified so far for uniqueness.
  *       This would be required to achieve an unambiguous update of parameters
  *       in an already existing XML file when using the write method.
@@ -478,44 +502,112 @@ void GObservations::read(const GXml& xml)
     // Get pointer on observation library
     const GXmlElement* lib = xml.element("observation_list", 0);
 
-    // Loop over all observations
-    int n = lib->elements("observation");
+    // Allocate all observations. This is done before reading to catch any
+    // invalid instrument before any file is read.
+    int                             n = lib->elements("observation");
+    std::vector<const GXmlElement*> elements(n, NULL);
+    std::vector<GObservation*>      ptrs(n, NULL);
     for (int i = 0; i < n; ++i) {
 
         // Get pointer on observation
-        const GXmlElement* obs = lib->element("observation", i);
-
-        // Get attributes
-        std::string name       = obs->attribute("name");
-        std::string id         = obs->attribute("id");
-        std::string instrument = obs->attribute("instrument");
+        elements[i] = lib->element("observation", i);
 
         // Allocate instrument specific observation
+        std::string          instrument = elements[i]->attribute("instrument");
         GObservationRegistry registry;
-        GObservation*        ptr = registry.alloc(instrument);
+        ptrs[i] = registry.alloc(instrument);
 
-        // If observation is valid then read its definition from XML file
-        if (ptr != NULL) {
+        // Throw an exception if observation is invalid
+        if (ptrs[i] == NULL) {
+            for (int k = 0; k < i; ++k) {
+                delete ptrs[k];
+            }
+            throw GException::invalid_instrument(G_READ, instrument);
+        }
 
-            // Read definition
-            ptr->read(*obs);
+    } // endfor: looped over all observations
 
-            // Set attributes
-            ptr->name(name);
-            ptr->id(id);
+    // Initialise reading times
+    m_load_times.assign(n, 0.0);
+
+    // Read observations in batches
+    for (int ibegin = 0, iend = 0; ibegin < n; ibegin = iend) {
+
+        // Determine end of batch
+        iend = n;
+        if (m_load_budget > 0.0) {
+            double budget = m_load_budget * 1.0e6;
+            double size   = load_size(*elements[ibegin]);
+            for (iend = ibegin+1; iend < n; ++iend) {
+                size += load_size(*elements[iend]);
+                if (size > budget) {
+                    break;
+                }
+            }
+        }
 
-        } // endif: observation was valid
+        // Read definitions of all observations in the batch. Any failure
+        // is recorded since exceptions can not leave the parallel region.
+        std::vector<int> failed(iend-ibegin, 0);
+        #pragma omp parallel for schedule(dynamic) num_threads(m_load_threads)
+        for (int i = ibegin; i < iend; ++i) {
 
-        // ... otherwise throw an exception
-        else {
-            throw GException::invalid_instrument(G_READ, instrument);
+            // Start timing
+            #ifdef _OPENMP
+            double t_start = omp_get_wtime();
+            #else
+            clock_t t_start = clock();
+            #endif
+
+            // Read definition
+            try {
+                ptrs[i]->read(*elements[i]);
+            }
+            catch (...) {
+                failed[i-ibegin] = 1;
+            }
+
+            // Store reading time
+            #ifdef _OPENMP
+            m_load_times[i] = omp_get_wtime() - t_start;
+            #else
+            m_load_times[i] = (double)(clock() - t_start) / (double)CLOCKS_PER_SEC;
+            #endif
+
+        } // endfor: looped over observations in batch
+
+        // Read failed observations again sequentially into a fresh
+        // observation. Any exception thrown now is passed to the client.
+        for (int i = ibegin; i < iend; ++i) {
+            if (failed[i-ibegin]) {
+                GObservationRegistry registry;
+                GObservation* ptr = registry.alloc(elements[i]->attribute("instrument"));
+                delete ptrs[i];
+                ptrs[i] = ptr;
+                try {
+                    ptr->read(*elements[i]);
+                }
+                catch (...) {
+                    for (int k = 0; k < n; ++k) {
+                        delete ptrs[k];
+                    }
+                    throw;
+                }
+            }
         }
 
-        // Append observation to container
-        append(*ptr);
+    } // endfor: looped over batches
 
-        // Free observation (the append method made a deep copy)
-        delete ptr;
+    // Append observations to container
+    for (int i = 0; i < n; ++i) {
+
+        // Set attributes
+        ptrs[i]->name(elements[i]->attribute("name"));
+        ptrs[i]->id(elements[i]->attribute("id"));
+
+        // Append observation to container. The container takes over the
+        // observation, which avoids a deep copy of the observation data.
+        m_obs.push_back(ptrs[i]);
 
     } // endfor: looped over all observations
 
@@ -524,6 +616,64 @@ void GObservations::read(const GXml& xml)
 }
 
 
+/***********************************************************************//**
+ * @brief Set number of threads for reading observations
+ *
+ * @param[in] threads Number of threads.
+ *
+ * @exception GException::invalid_argument
+ *            Non-positive number of threads specified.
+ *
+ * Sets the number of threads that are used for reading observations in
+ * the read() and load() methods. By default, observations are read
+ * sequentially.
+ ***************************************************************************/
+void GObservations::load_threads(const int& threads)
+{
+    // Throw an exception if the number of threads is not positive
+    if (threads < 1) {
+        throw GException::invalid_argument(G_LOAD_THREADS,
+              "Number of threads "+str(threads)+" must be positive.");
+    }
+
+    // Set number of threads
+    m_load_threads = threads;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set size budget for reading observations
+ *
+ * @param[in] budget Size budget (MB).
+ *
+ * @exception GException::invalid_argument
+ *            Negative size budget specified.
+ *
+ * Sets the maximum total size of the files that are read at the same time
+ * in the read() and load() methods. The size of an observation is
+ * estimated from the sizes of all files that are referenced in the
+ * observation definition. A budget of 0 (the default) means that the size
+ * is not limited.
+ ***************************************************************************/
+void GObservations::load_budget(const double& budget)
+{
+    // Throw an exception if the budget is negative
+    if (budget < 0.0) {
+        throw GException::invalid_argument(G_LOAD_BUDGET,
+              "Size budget "+str(budget)+" MB must not be negative.");
+    }
+
+    // Set budget
+    m_load_budget = budget;
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Write observations into XML document
  *
@@ -607,11 +757,35 @@ void GObservations::models(const std::string& filename)
  *
  * Optimizes the free parameters of the models by using the optimizer
  * that has been provided by the @p opt argument.
+ *
+ * Response caching is enabled for all observations during the
+ * optimization, so that the response values for sources with a fixed
+ * spatial shape are only computed once. The caches are deleted after
+ * the optimization.
  ***************************************************************************/
 void GObservations::optimize(GOptimizer& opt)
 {
-    // Optimize model parameters
-    opt.optimize(m_fct, m_models);
+    // Enable response caching
+    for (int i = 0; i < size(); ++i) {
+        m_obs[i]->use_irf_cache(true);
+    }
+
+    // Optimize model parameters. Make sure that response caching is
+    // disabled if the optimization fails.
+    try {
+        opt.optimize(m_fct, m_models);
+    }
+    catch (...) {
+        for (int i = 0; i < size(); ++i) {
+            m_obs[i]->use_irf_cache(false);
+        }
+        throw;
+    }
+
+    // Disable response caching
+    for (int i = 0; i < size(); ++i) {
+        m_obs[i]->use_irf_cache(false);
+    }
 
     // Return
     return;
@@ -664,6 +838,9 @@ void GObservations::init_members(void)
     m_obs.clear();
     m_models.clear();
     m_fct.set(this);  //!< Makes sure that optimizer points to this instance
+    m_load_threads = 1;
+    m_load_budget  = 0.0;
+    m_load_times.clear();
 
     // Return
     return;
@@ -683,7 +860,10 @@ void GObservations::copy_members(const GObservations& obs)
     // Copy attributes. WARNING: The member m_fct SHALL not be copied to not
     // corrupt its m_this pointer which should always point to the proper
     // observation. See note in init_members().
-    m_models = obs.m_models;
+    m_models       = obs.m_models;
+    m_load_threads = obs.m_load_threads;
+    m_load_budget  = obs.m_load_budget;
+    m_load_times   = obs.m_load_times;
 
     // Copy observations
     m_obs.clear();
@@ -715,3 +895,45 @@ void GObservations::free_members(void)
     // Return
     return;
 }
+
+
+/***********************************************************************//**
+ * @brief Return size of files referenced by an observation definition
+ *
+ * @param[in] obs Observation definition XML element.
+ * @return Total size of referenced files (bytes).
+ *
+ * Sums the sizes of all files that are referenced by the @p file
+ * attributes of the parameters of the observation definition. Any
+ * extension or filter specification in square brackets is ignored, and
+ * files that can not be opened are not counted.
+ ***************************************************************************/
+double GObservations::load_size(const GXmlElement& obs) const
+{
+    // Initialise size
+    double size = 0.0;
+
+    // Loop over all parameters
+    int npars = obs.elements("parameter");
+    for (int i = 0; i < npars; ++i) {
+
+        // Get filename without extension or filter specification
+        std::string filename = expand_env(obs.element("parameter", i)->attribute("file"));
+        size_t      pos      = filename.find("[");
+        if (pos != std::string::npos) {
+            filename = filename.substr(0, pos);
+        }
+
+        // Add file size
+        if (!filename.empty()) {
+            std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+            if (file.good()) {
+                size += double(file.tellg());
+            }
+        }
+
+    } // endfor: looped over parameters
+
+    // Return size
+    return size;
+}
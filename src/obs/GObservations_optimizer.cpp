@@ -34,6 +34,7 @@
 #include "GEventList.hpp"
 #include "GEventCube.hpp"
 #include "GEventBin.hpp"
+#include <algorithm>
 
 /* __ OpenMP section _____________________________________________________ */
 #ifdef _OPENMP
@@ -46,6 +47,10 @@
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_MIN_CHUNK_SIZE 1000 //!< Minimum number of events per chunk
+#define G_MAX_CHUNKS      256 //!< Maximum number of chunks per observation
+#define G_BLOCK_SIZE      256 //!< Number of events per model evaluation
+#define G_MAX_DENSE  16777216 //!< Maximum number of dense curvature elements
 
 /* __ Debug definitions __________________________________________________ */
 #define G_EVAL_TIMING   0 //!< Perform optimizer timing (0=no, 1=yes)
@@ -184,6 +189,25 @@ GObservations::optimizer& GObservations::optimizer::operator= (const optimizer&
  * Poisson and Gaussian statistics. 
  * Note that different statistics and different analysis methods
  * (binned/unbinned) may be combined.
+ *
+ * The events (or bins) of each observation are split into work units of
+ * at least G_MIN_CHUNK_SIZE events, an observation being split into at
+ * most G_MAX_CHUNKS units. The units are evaluated in parallel using
+ * OpenMP, so that a list mixing a few observations with many events and
+ * many observations with few events keeps all threads busy.
+ *
+ * The function value, Npred, gradient and curvature are accumulated into
+ * one reduction slot per work unit, hence all threads get work as long as
+ * there are at least as many units as threads. The curvature of a slot is
+ * accumulated in a dense matrix, avoiding the costly sparse matrix fill,
+ * unless the dense matrices of all slots would exceed G_MAX_DENSE
+ * elements, in which case sparse matrices are used. The units are
+ * evaluated in order of decreasing number of events. Each slot is
+ * evaluated by a single thread, and once all slots have been evaluated
+ * they are combined using a pairwise (tree) reduction. As neither the
+ * units, the slot assignment nor the summation order depend on the number
+ * of threads, the result is bit-for-bit identical irrespective of the
+ * number of threads that were used.
  ***************************************************************************/
 void GObservations::optimizer::eval(const GOptimizerPars& pars) 
 {
@@ -216,182 +240,204 @@ void GObservations::optimizer::eval(const GOptimizerPars& pars)
         m_value    = 0.0;
         m_npred    = 0.0;
         m_gradient = new GVector(npars);
-        m_covar    = new GSparseMatrix(npars,npars);
+        m_covar    = NULL;
         m_wrk_grad = new GVector(npars);
-        m_covar->stack_init(npars,10000);
-        
-        // Allocate vectors to save working variables of each thread
-        std::vector<GVector*>       vect_cpy_grad;
-        std::vector<GSparseMatrix*> vect_cpy_covar;
-        std::vector<double*>        vect_cpy_value;
-        std::vector<double*>        vect_cpy_npred;
-        
-        // Here OpenMP will paralellize the execution. The following code will
-        // be executed by the differents threads. In order to avoid protecting
-        // attributes ( m_value,m_npred, m_gradient and m_covar), each thread
-        // works with its own working variables (cpy_*). When a thread starts,
-        // we add working variables in a vector (vect_cpy_*). When computation
-        // is finished we just add all elements contain in the vector to the
-        // attributes value.
-        #pragma omp parallel
-        {
-            // Allocate and initialize variable copies for multi-threading
-            GModels        cpy_model((GModels&)pars);
-            GVector        cpy_wrk_grad(npars);
-            GVector*       cpy_gradient = new GVector(npars);
-            GSparseMatrix* cpy_covar    = new GSparseMatrix(npars,npars);
-            double*        cpy_npred    = new double(0.0);
-            double*        cpy_value    = new double(0.0);
-            cpy_covar->stack_init(npars,10000);
-            
-            // Push variable copies into vector. This is a critical zone to
-            // avoid multiple thread pushing simultaneously.
-            #pragma omp critical
-            {
-                vect_cpy_grad.push_back(cpy_gradient);
-                vect_cpy_covar.push_back(cpy_covar); 
-                vect_cpy_value.push_back(cpy_value);
-                vect_cpy_npred.push_back(cpy_npred);
-            }
 
-            // The omp for directive will deal the iterations on the differents
-            // threads.
-            #pragma omp for
-            // Loop over all observations
-            for (int i = 0; i < m_this->size(); ++i) {
-    
-                // Extract statistics for this observation
-                std::string statistics = m_this->m_obs[i]->statistics();
-    
-                // Unbinned analysis
-                if (dynamic_cast<const GEventList*>(m_this->m_obs[i]->events()) != NULL) {
-    
-                    // Poisson statistics
-                    if (toupper(statistics) == "POISSON") {
-    
-                        // Determine Npred value and gradient for this observation
-                        double npred = m_this->m_obs[i]->npred(cpy_model, &cpy_wrk_grad);
-    
-                        // Update the Npred value, gradient.
-                        *cpy_npred    += npred;
-                        *cpy_gradient += cpy_wrk_grad;
-
-                        // Optionally show debug information
-                        #if G_EVAL_DEBUG
-                        #pragma omp critial single
-                        {
-                            std::cout << "Unbinned Poisson (" << i << "):";
-                            std::cout << " Npred=" << npred;
-                            std::cout << " Grad="<< cpy_wrk_grad << std::endl;
-                            std::cout << "Sum:";
-                            std::cout << " Npred=" << *cpy_npred;
-                            std::cout << " Grad=" << *cpy_gradient << std::endl;
-                        }
-                        #endif
-    
-                        // Update the log-likelihood
-                        poisson_unbinned(*(m_this->m_obs[i]), 
-                                          cpy_model,
-                                         *cpy_covar,
-                                         *cpy_gradient,
-                                         *cpy_value,
-                                          cpy_wrk_grad);
-    
-                        // Add the Npred value to the log-likelihood
-                        *cpy_value += npred;
-    
-                    } // endif: Poisson statistics
-    
-                    // ... otherwise throw an exception
-                    else {
-                        throw GException::invalid_statistics(G_EVAL, statistics,
-                            "Unbinned optimization requires Poisson statistics.");
-                    }
-    
-                } // endif: unbinned analysis
-    
-                // ... or binned analysis
+        // Get number of observations
+        int nobs = m_this->size();
+
+        // If there are no observations then set an empty curvature matrix
+        // and fall through
+        if (nobs < 1) {
+            m_covar = new GSparseMatrix(npars,npars);
+            continue;
+        }
+
+        // Check statistics of all observations before entering the parallel
+        // region, as exceptions may not be thrown out of OpenMP threads
+        std::vector<Kernel> type(nobs);
+        for (int i = 0; i < nobs; ++i) {
+            std::string statistics = toupper(m_this->m_obs[i]->statistics());
+            if (dynamic_cast<const GEventList*>(m_this->m_obs[i]->events()) != NULL) {
+                if (statistics == "POISSON") {
+                    type[i] = POISSON_UNBINNED;
+                }
                 else {
-    
-                    // Poisson statistics
-                    if (toupper(statistics) == "POISSON") {
-                        #if G_EVAL_DEBUG
-                        std::cout << "Binned Poisson" << std::endl;
-                        #endif
-                        poisson_binned(*(m_this->m_obs[i]), 
-                                        cpy_model,
-                                       *cpy_covar,
-                                       *cpy_gradient,
-                                       *cpy_value,
-                                       *cpy_npred,
-                                        cpy_wrk_grad);
-                    }
-    
-                    // ... or Gaussian statistics
-                    else if (toupper(statistics) == "GAUSSIAN") {
-                        #if G_EVAL_DEBUG
-                        std::cout << "Binned Gaussian" << std::endl;
-                        #endif
-                        gaussian_binned(*(m_this->m_obs[i]), 
-                                         cpy_model,
-                                        *cpy_covar,
-                                        *cpy_gradient,
-                                        *cpy_value,
-                                        *cpy_npred,
-                                         cpy_wrk_grad);
-                    }
-    
-                    // ... or unsupported
-                    else {
-                        throw GException::invalid_statistics(G_EVAL, statistics,
-                            "Binned optimization requires Poisson or Gaussian statistics.");
-                    }
-    
-                } // endelse: binned analysis
-    
-            } // endfor: looped over observations
-            
-        } // end pragma omp parallel
-        
-        // Now the computation is finished, update attributes.
-        // For each omp section, a thread will be created.
-        #pragma omp sections
-        {
-            #pragma omp section
-            {
-                for (int i = 0; i < vect_cpy_covar.size() ; ++i) {
-                    *m_covar += *(vect_cpy_covar.at(i));
-                    delete vect_cpy_covar.at(i);
+                    throw GException::invalid_statistics(G_EVAL, statistics,
+                        "Unbinned optimization requires Poisson statistics.");
                 }
             }
-
-            #pragma omp section
-            {
-                for (int i = 0; i < vect_cpy_grad.size(); ++i){
-                    *m_gradient += *(vect_cpy_grad.at(i));
-                    delete vect_cpy_grad.at(i);
+            else {
+                if (statistics == "POISSON") {
+                    type[i] = POISSON_BINNED;
                 }
+                else if (statistics == "GAUSSIAN") {
+                    type[i] = GAUSSIAN_BINNED;
+                }
+                else {
+                    throw GException::invalid_statistics(G_EVAL, statistics,
+                        "Binned optimization requires Poisson or Gaussian statistics.");
+                }
+            }
+        }
+
+        // Split the events (or bins) of each observation into work units.
+        // The unit size depends only on the number of events of the
+        // observation, so that observations with many events are split into
+        // several units while small observations form a single unit.
+        std::vector<int> unit_obs;
+        std::vector<int> unit_begin;
+        std::vector<int> unit_end;
+        std::vector<int> obs_units(nobs, 0);
+        for (int i = 0; i < nobs; ++i) {
+            int nevents = m_this->m_obs[i]->events()->size();
+            int size    = (nevents + G_MAX_CHUNKS - 1) / G_MAX_CHUNKS;
+            if (size < G_MIN_CHUNK_SIZE) {
+                size = G_MIN_CHUNK_SIZE;
             }
+            int ibegin = 0;
+            do {
+                int iend = (ibegin + size < nevents) ? ibegin + size : nevents;
+                unit_obs.push_back(i);
+                unit_begin.push_back(ibegin);
+                unit_end.push_back(iend);
+                obs_units[i]++;
+                ibegin = iend;
+            } while (ibegin < nevents);
+        }
+        int nunits = unit_obs.size();
+
+        // Set the processing order so that the largest units are processed
+        // first (longest processing time first scheduling)
+        std::vector<std::pair<int,int> > order;
+        order.reserve(nunits);
+        for (int k = 0; k < nunits; ++k) {
+            order.push_back(std::make_pair(unit_begin[k]-unit_end[k], k));
+        }
+        std::sort(order.begin(), order.end());
+
+        // Assign one reduction slot to each unit, the slots being ordered
+        // by decreasing number of events. The assignment only depends on the
+        // number of events, hence the summation order does not depend on the
+        // number of threads.
+        int nslots = nunits;
+
+        // Allocate accumulators for all reduction slots. The curvature is
+        // accumulated in dense matrices unless these would take too much
+        // memory.
+        bool                       dense = ((double)nslots * npars * npars <= G_MAX_DENSE);
+        std::vector<double>        value(nslots, 0.0);
+        std::vector<double>        npred(nslots, 0.0);
+        std::vector<GVector>       gradient(nslots, GVector(npars));
+        std::vector<GMatrix>       dense_covar;
+        std::vector<GSparseMatrix> sparse_covar;
+        if (dense) {
+            dense_covar.assign(nslots, GMatrix(npars,npars));
+        }
+        else {
+            sparse_covar.assign(nslots, GSparseMatrix(npars,npars));
+        }
 
-            #pragma omp section
-            {
-                for(int i = 0; i < vect_cpy_npred.size(); ++i){
-                    m_npred += *(vect_cpy_npred.at(i));
-                    delete vect_cpy_npred.at(i);
+        // Evaluate reduction slots. Each thread works on its own copy of the
+        // models and of the working gradient. As every slot is evaluated by
+        // a single thread, no synchronisation between the threads is
+        // needed.
+        #pragma omp parallel
+        {
+            // Allocate variable copies for multi-threading
+            GModels cpy_model((GModels&)pars);
+            GVector cpy_wrk_grad(npars);
+
+            // Allocate working copies of observations that were split into
+            // several units, as these may be evaluated by several threads at
+            // the same time. The working copies share the response cache of
+            // the observation (see GObservation::shallow_clone()) and the
+            // event container, avoiding the duplication of large event lists
+            // and cubes. Events are only read through const access, which
+            // does not modify the event container. The copies are only
+            // created when needed.
+            std::vector<GObservation*> cpy_obs(nobs, (GObservation*)NULL);
+
+            // Loop over all reduction slots
+            #pragma omp for schedule(dynamic,1)
+            for (int s = 0; s < nslots; ++s) {
+
+                // Get curvature accumulator of slot
+                GMatrixBase& covar = (dense) ? (GMatrixBase&)dense_covar[s]
+                                             : (GMatrixBase&)sparse_covar[s];
+
+                // Get unit and observation index
+                int iunit = order[s].second;
+                int i     = unit_obs[iunit];
+
+                // Get observation
+                const GObservation* obs = m_this->m_obs[i];
+                if (obs_units[i] > 1) {
+                    if (cpy_obs[i] == NULL) {
+                        cpy_obs[i] = obs->shallow_clone(true);
+                    }
+                    obs = cpy_obs[i];
+                }
+
+                // For unbinned Poisson analysis, add Npred value and
+                // gradient once for each observation
+                if (type[i] == POISSON_UNBINNED && unit_begin[iunit] == 0) {
+                    double obs_npred = obs->npred(cpy_model, &cpy_wrk_grad);
+                    npred[s]    += obs_npred;
+                    value[s]    += obs_npred;
+                    gradient[s] += cpy_wrk_grad;
+                }
+
+                // Evaluate likelihood kernel for events of unit
+                eval_range(type[i], *obs, cpy_model,
+                           unit_begin[iunit], unit_end[iunit],
+                           covar, gradient[s], value[s], npred[s],
+                           cpy_wrk_grad);
+
+                // Optionally show debug information
+                #if G_EVAL_DEBUG
+                #pragma omp critical
+                {
+                    std::cout << "Slot (" << s << "):";
+                    std::cout << " Value=" << value[s];
+                    std::cout << " Npred=" << npred[s];
+                    std::cout << " Grad=" << gradient[s] << std::endl;
                 }
+                #endif
+
+            } // endfor: looped over reduction slots
+
+            // Free working copies of observations
+            for (int i = 0; i < nobs; ++i) {
+                if (cpy_obs[i] != NULL) delete cpy_obs[i];
             }
 
-            #pragma omp section
-            {
-                for (int i = 0; i < vect_cpy_value.size(); ++i){
-                    m_value += *(vect_cpy_value.at(i));
-                    delete vect_cpy_value.at(i);
+        } // end pragma omp parallel
+
+        // Combine the reduction slots using a pairwise reduction. The
+        // pairing only depends on the slot index, hence the summation order
+        // is fixed.
+        for (int step = 1; step < nslots; step *= 2) {
+            #pragma omp parallel for schedule(dynamic,1)
+            for (int i = 0; i < nslots-step; i += 2*step) {
+                value[i]    += value[i+step];
+                npred[i]    += npred[i+step];
+                gradient[i] += gradient[i+step];
+                if (dense) {
+                    dense_covar[i] += dense_covar[i+step];
+                }
+                else {
+                    sparse_covar[i] += sparse_covar[i+step];
                 }
             }
-        } // end of pragma omp sections
+        }
 
-        // Release stack
-        m_covar->stack_destroy();
+        // Store result
+        m_value     = value[0];
+        m_npred     = npred[0];
+        *m_gradient = gradient[0];
+        m_covar     = (dense) ? new GSparseMatrix(dense_covar[0])
+                              : new GSparseMatrix(sparse_covar[0]);
 
     } while(0); // endwhile: main loop
     
@@ -448,11 +494,365 @@ void GObservations::optimizer::eval(const GOptimizerPars& pars)
  * and the curvature matrix
  * \f$\delta^2 L/dp_1 dp_2\f$.
  ***************************************************************************/
-void GObservations::optimizer::poisson_unbinned(const GObservation& obs,
-                                                const GOptimizerPars& pars)
+void GObservations::optimizer::poisson_unbinned(const GObservation& obs,
+                                                const GOptimizerPars& pars)
+{
+    // Perform computations using the global members
+    poisson_unbinned(obs, pars, *m_covar, *m_gradient, m_value, *m_wrk_grad);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function for Poisson statistics and
+ *        unbinned analysis (version with working arrays)
+ *
+ * @param[in] obs Observation.
+ * @param[in] pars Optimizer parameters.
+ * @param[in,out] covar Covariance matrix.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] value Likelihood value.
+ * @param[in,out] wrk_grad Gradient working array.
+ *
+ * The events are evaluated sequentially. Parallel evaluation of the
+ * events is done by eval().
+ ***************************************************************************/
+void GObservations::optimizer::poisson_unbinned(const GObservation&   obs,
+                                                const GOptimizerPars& pars,
+                                                GMatrixBase&          covar,
+                                                GVector&              gradient,
+                                                double&               value,
+                                                GVector&              wrk_grad)
+{
+    // Timing measurement
+    #if G_EVAL_TIMING
+    #ifdef _OPENMP
+    double t_start = omp_get_wtime();
+    #else
+    clock_t t_start = clock();
+    #endif
+    #endif
+
+    // Evaluate events (Npred is not used for unbinned analysis)
+    double npred = 0.0;
+    eval_range(POISSON_UNBINNED, obs, pars, 0, obs.events()->size(), covar,
+               gradient, value, npred, wrk_grad);
+
+    // Optionally dump gradient and covariance matrix
+    #if G_EVAL_DEBUG
+    std::cout << gradient << std::endl;
+    std::cout << covar << std::endl;
+    #endif
+
+    // Timing measurement
+    #if G_EVAL_TIMING
+    #ifdef _OPENMP
+    double t_elapse = omp_get_wtime()-t_start;
+    #else
+    double t_elapse = (double)(clock() - t_start) / (double)CLOCKS_PER_SEC;
+    #endif
+    std::cout << "GObservations::optimizer::poisson_unbinned: CPU usage = "
+              << t_elapse << " sec" << std::endl;
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function for Poisson statistics and
+ *        binned analysis
+ *
+ * @param[in] obs Observation.
+ * @param[in] pars Optimizer parameters.
+ *
+ * This method evaluates the -(log-likelihood) function for parameter
+ * optimisation using binned analysis and Poisson statistics.
+ * The -(log-likelihood) function is given by
+ * \f$L=-\sum_i n_i \log e_i - e_i\f$
+ * where the sum is taken over all data space bins, \f$n_i\f$ is the
+ * observed number of counts and \f$e_i\f$ is the model.
+ * This method also computes the parameter gradients
+ * \f$\delta L/dp\f$
+ * and the curvature matrix
+ * \f$\delta^2 L/dp_1 dp_2\f$
+ * and also updates the total number of predicted events m_npred.
+ ***************************************************************************/
+void GObservations::optimizer::poisson_binned(const GObservation& obs,
+                                              const GOptimizerPars& pars) 
+{
+    // Perform computations using the global members
+    poisson_binned(obs, pars, *m_covar, *m_gradient, m_value, m_npred, *m_wrk_grad);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function for Poisson statistics and
+ *        binned analysis (version with working arrays)
+ *
+ * @param[in] obs Observation.
+ * @param[in] pars Optimizer parameters.
+ * @param[in,out] covar Covariance matrix.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] value Likelihood value.
+ * @param[in,out] npred Number of predicted events.
+ * @param[in,out] wrk_grad Gradient working array.
+ *
+ * The bins are evaluated sequentially. Parallel evaluation of the bins
+ * is done by eval().
+ ***************************************************************************/
+void GObservations::optimizer::poisson_binned(const GObservation&   obs,
+                                              const GOptimizerPars& pars,
+                                              GMatrixBase&          covar,
+                                              GVector&              gradient,
+                                              double&               value,
+                                              double&               npred,
+                                              GVector&              wrk_grad)
+{
+    // Timing measurement
+    #if G_EVAL_TIMING
+    #ifdef _OPENMP
+    double t_start = omp_get_wtime();
+    #else
+    clock_t t_start = clock();
+    #endif
+    #endif
+
+    // Evaluate bins
+    eval_range(POISSON_BINNED, obs, pars, 0, obs.events()->size(), covar,
+               gradient, value, npred, wrk_grad);
+
+    // Optionally dump gradient and covariance matrix
+    #if G_EVAL_DEBUG
+    std::cout << gradient << std::endl;
+    std::cout << covar << std::endl;
+    #endif
+
+    // Timing measurement
+    #if G_EVAL_TIMING
+    #ifdef _OPENMP
+    double t_elapse = omp_get_wtime()-t_start;
+    #else
+    double t_elapse = (double)(clock() - t_start) / (double)CLOCKS_PER_SEC;
+    #endif
+    std::cout << "GObservations::optimizer::poisson_binned: CPU usage = "
+              << t_elapse << " sec" << std::endl;
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function for Gaussian statistics and
+ *        binned analysis
+ *
+ * @param[in] obs Observation.
+ * @param[in] pars Optimizer parameters.
+ *
+ * This method evaluates the -(log-likelihood) function for parameter
+ * optimisation using binned analysis and Poisson statistics.
+ * The -(log-likelihood) function is given by
+ * \f$L = 1/2 \sum_i (n_i - e_i)^2 \sigma_i^{-2}\f$
+ * where the sum is taken over all data space bins, \f$n_i\f$ is the
+ * observed number of counts, \f$e_i\f$ is the model and \f$\sigma_i\f$
+ * is the statistical uncertainty.
+ * This method also computes the parameter gradients
+ * \f$\delta L/dp\f$
+ * and the curvature matrix
+ * \f$\delta^2 L/dp_1 dp_2\f$
+ * and also updates the total number of predicted events m_npred.
+ ***************************************************************************/
+void GObservations::optimizer::gaussian_binned(const GObservation& obs,
+                                               const GOptimizerPars& pars) 
+{
+    // Perform computations using the global members
+    gaussian_binned(obs, pars, *m_covar, *m_gradient, m_value, m_npred, *m_wrk_grad);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood function for Gaussian statistics and
+ *        binned analysis (version with working arrays)
+ *
+ * @param[in] obs Observation.
+ * @param[in] pars Optimizer parameters.
+ * @param[in,out] covar Covariance matrix.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] value Likelihood value.
+ * @param[in,out] npred Number of predicted events.
+ * @param[in,out] wrk_grad Gradient working array.
+ *
+ * The bins are evaluated sequentially. Parallel evaluation of the bins
+ * is done by eval().
+ ***************************************************************************/
+void GObservations::optimizer::gaussian_binned(const GObservation&   obs,
+                                               const GOptimizerPars& pars,
+                                               GMatrixBase&          covar,
+                                               GVector&              gradient,
+                                               double&               value,
+                                               double&               npred,
+                                               GVector&              wrk_grad)
+{
+    // Timing measurement
+    #if G_EVAL_TIMING
+    #ifdef _OPENMP
+    double t_start = omp_get_wtime();
+    #else
+    clock_t t_start = clock();
+    #endif
+    #endif
+
+    // Evaluate bins
+    eval_range(GAUSSIAN_BINNED, obs, pars, 0, obs.events()->size(), covar,
+               gradient, value, npred, wrk_grad);
+
+    // Optionally dump gradient and covariance matrix
+    #if G_EVAL_DEBUG
+    std::cout << gradient << std::endl;
+    std::cout << covar << std::endl;
+    #endif
+
+    // Timing measurement
+    #if G_EVAL_TIMING
+    #ifdef _OPENMP
+    double t_elapse = omp_get_wtime()-t_start;
+    #else
+    double t_elapse = (double)(clock() - t_start) / (double)CLOCKS_PER_SEC;
+    #endif
+    std::cout << "GObservations::optimizer::gaussian_binned: CPU usage = "
+              << t_elapse << " sec" << std::endl;
+    #endif
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                            Private methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GObservations::optimizer::init_members(void)
+{
+    // Initialise members
+    m_value     = 0.0;
+    m_npred     = 0.0;
+    m_minmod    = 1.0e-100;
+    m_minerr    = 1.0e-100;
+    m_this      = NULL;
+    m_gradient  = NULL;
+    m_covar     = NULL;
+    m_wrk_grad  = NULL;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] fct Optimizer.
+ ***************************************************************************/
+void GObservations::optimizer::copy_members(const optimizer& fct)
+{
+    // Copy attributes
+    m_value  = fct.m_value;
+    m_npred  = fct.m_npred;
+    m_minmod = fct.m_minmod;
+    m_minerr = fct.m_minerr;
+    m_this   = fct.m_this;
+
+    // Clone gradient if it exists
+    if (fct.m_gradient != NULL) m_gradient = new GVector(*fct.m_gradient);
+
+    // Clone covariance matrix if it exists
+    if (fct.m_covar != NULL) m_covar = new GSparseMatrix(*fct.m_covar);
+
+    // Clone working gradient if it exists
+    if (fct.m_wrk_grad != NULL) m_wrk_grad = new GVector(*fct.m_wrk_grad);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GObservations::optimizer::free_members(void)
+{
+    // Free members
+    if (m_gradient != NULL) delete m_gradient;
+    if (m_covar    != NULL) delete m_covar;
+    if (m_wrk_grad != NULL) delete m_wrk_grad;
+
+    // Signal free pointers
+    m_gradient = NULL;
+    m_covar    = NULL;
+    m_wrk_grad = NULL;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Evaluate log-likelihood kernel for a range of events
+ *
+ * @param[in] kernel Likelihood kernel.
+ * @param[in] obs Observation.
+ * @param[in] pars Optimizer parameters.
+ * @param[in] ibegin Index of first event.
+ * @param[in] iend Index after last event.
+ * @param[in,out] covar Covariance matrix.
+ * @param[in,out] gradient Gradient.
+ * @param[in,out] value Likelihood value.
+ * @param[in,out] npred Number of predicted events.
+ * @param[in,out] wrk_grad Gradient working array.
+ ***************************************************************************/
+void GObservations::optimizer::eval_range(const Kernel&         kernel,
+                                          const GObservation&   obs,
+                                          const GOptimizerPars& pars,
+                                          const int&            ibegin,
+                                          const int&            iend,
+                                          GMatrixBase&          covar,
+                                          GVector&              gradient,
+                                          double&               value,
+                                          double&               npred,
+                                          GVector&              wrk_grad)
 {
-    // Perform computations using the global members
-    poisson_unbinned(obs, pars, *m_covar, *m_gradient, m_value, *m_wrk_grad);
+    // Dispatch to kernel
+    switch (kernel) {
+    case POISSON_UNBINNED:
+        poisson_unbinned_range(obs, pars, ibegin, iend, covar, gradient,
+                               value, wrk_grad);
+        break;
+    case POISSON_BINNED:
+        poisson_binned_range(obs, pars, ibegin, iend, covar, gradient,
+                             value, npred, wrk_grad);
+        break;
+    case GAUSSIAN_BINNED:
+        gaussian_binned_range(obs, pars, ibegin, iend, covar, gradient,
+                              value, npred, wrk_grad);
+        break;
+    }
 
     // Return
     return;
@@ -461,31 +861,30 @@ void GObservations::optimizer::poisson_unbinned(const GObservation& obs,
 
 /***********************************************************************//**
  * @brief Evaluate log-likelihood function for Poisson statistics and
- *        unbinned analysis (version with working arrays)
+ *        unbinned analysis for a range of events
  *
  * @param[in] obs Observation.
  * @param[in] pars Optimizer parameters.
+ * @param[in] ibegin Index of first event.
+ * @param[in] iend Index after last event.
  * @param[in,out] covar Covariance matrix.
  * @param[in,out] gradient Gradient.
  * @param[in,out] value Likelihood value.
  * @param[in,out] wrk_grad Gradient working array.
+ *
+ * This method evaluates the -(log-likelihood) function for parameter
+ * optimisation using unbinned analysis and Poisson statistics for the
+ * events [ibegin,iend[ of the observation.
  ***************************************************************************/
-void GObservations::optimizer::poisson_unbinned(const GObservation&   obs,
-                                                const GOptimizerPars& pars,
-                                                GSparseMatrix&        covar,
-                                                GVector&              gradient,
-                                                double&               value,
-                                                GVector&              wrk_grad)
+void GObservations::optimizer::poisson_unbinned_range(const GObservation&   obs,
+                                                      const GOptimizerPars& pars,
+                                                      const int&            ibegin,
+                                                      const int&            iend,
+                                                      GMatrixBase&          covar,
+                                                      GVector&              gradient,
+                                                      double&               value,
+                                                      GVector&              wrk_grad)
 {
-    // Timing measurement
-    #if G_EVAL_TIMING
-    #ifdef _OPENMP
-    double t_start = omp_get_wtime();
-    #else
-    clock_t t_start = clock();
-    #endif
-    #endif
-
     // Get number of parameters
     int npars = pars.npars();
 
@@ -493,15 +892,30 @@ void GObservations::optimizer::poisson_unbinned(const GObservation&   obs,
     int*    inx    = new int[npars];
     double* values = new double[npars];
 
-    
-    // Iterate over all events
-    for (int i = 0; i < obs.events()->size(); ++i) {
-
-        // Get event pointer
-        const GEvent* event = (*obs.events())[i];
+    // Allocate model block working arrays
+    std::vector<double> block_values(G_BLOCK_SIZE);
+    std::vector<double> block_grads(G_BLOCK_SIZE * npars);
+    double*             block_grad  = (npars > 0) ? &(block_grads[0]) : NULL;
+    int                 block_begin = ibegin;
+    int                 block_end   = ibegin;
+
+    // Iterate over events in range
+    for (int i = ibegin; i < iend; ++i) {
+
+        // Evaluate models for the next block of events if needed
+        if (i >= block_end) {
+            block_begin = i;
+            block_end   = (i + G_BLOCK_SIZE < iend) ? i + G_BLOCK_SIZE : iend;
+            obs.model((GModels&)pars, block_begin, block_end,
+                      &(block_values[0]), block_grad);
+        }
 
         // Get model and derivative
-        double model = obs.model((GModels&)pars, *event, &wrk_grad);
+        double        model = block_values[i-block_begin];
+        const double* grad  = block_grad + (i-block_begin) * npars;
+        for (int k = 0; k < npars; ++k) {
+            wrk_grad[k] = grad[k];
+        }
 
         // Skip bin if model is too small (avoids -Inf or NaN gradients)
         if (model <= m_minmod) {
@@ -559,53 +973,6 @@ void GObservations::optimizer::poisson_unbinned(const GObservation&   obs,
     if (values != NULL) delete [] values;
     if (inx    != NULL) delete [] inx;
 
-    // Optionally dump gradient and covariance matrix
-    #if G_EVAL_DEBUG
-    std::cout << gradient << std::endl;
-    std::cout << covar << std::endl;
-    #endif
-
-    // Timing measurement
-    #if G_EVAL_TIMING
-    #ifdef _OPENMP
-    double t_elapse = omp_get_wtime()-t_start;
-    #else
-    double t_elapse = (double)(clock() - t_start) / (double)CLOCKS_PER_SEC;
-    #endif
-    std::cout << "GObservations::optimizer::poisson_unbinned: CPU usage = "
-              << t_elapse << " sec" << std::endl;
-    #endif
-
-    // Return
-    return;
-}
-
-
-/***********************************************************************//**
- * @brief Evaluate log-likelihood function for Poisson statistics and
- *        binned analysis
- *
- * @param[in] obs Observation.
- * @param[in] pars Optimizer parameters.
- *
- * This method evaluates the -(log-likelihood) function for parameter
- * optimisation using binned analysis and Poisson statistics.
- * The -(log-likelihood) function is given by
- * \f$L=-\sum_i n_i \log e_i - e_i\f$
- * where the sum is taken over all data space bins, \f$n_i\f$ is the
- * observed number of counts and \f$e_i\f$ is the model.
- * This method also computes the parameter gradients
- * \f$\delta L/dp\f$
- * and the curvature matrix
- * \f$\delta^2 L/dp_1 dp_2\f$
- * and also updates the total number of predicted events m_npred.
- ***************************************************************************/
-void GObservations::optimizer::poisson_binned(const GObservation& obs,
-                                              const GOptimizerPars& pars) 
-{
-    // Perform computations using the global members
-    poisson_binned(obs, pars, *m_covar, *m_gradient, m_value, m_npred, *m_wrk_grad); 
-
     // Return
     return;
 }
@@ -613,33 +980,32 @@ void GObservations::optimizer::poisson_binned(const GObservation& obs,
 
 /***********************************************************************//**
  * @brief Evaluate log-likelihood function for Poisson statistics and
- *        binned analysis (version with working arrays)
+ *        binned analysis for a range of bins
  *
  * @param[in] obs Observation.
  * @param[in] pars Optimizer parameters.
+ * @param[in] ibegin Index of first bin.
+ * @param[in] iend Index after last bin.
  * @param[in,out] covar Covariance matrix.
  * @param[in,out] gradient Gradient.
  * @param[in,out] value Likelihood value.
  * @param[in,out] npred Number of predicted events.
  * @param[in,out] wrk_grad Gradient working array.
+ *
+ * This method evaluates the -(log-likelihood) function for parameter
+ * optimisation using binned analysis and Poisson statistics for the
+ * bins [ibegin,iend[ of the observation.
  ***************************************************************************/
-void GObservations::optimizer::poisson_binned(const GObservation&   obs,
-                                              const GOptimizerPars& pars,
-                                              GSparseMatrix&        covar,
-                                              GVector&              gradient,
-                                              double&               value,
-                                              double&               npred,
-                                              GVector&              wrk_grad)
+void GObservations::optimizer::poisson_binned_range(const GObservation&   obs,
+                                                    const GOptimizerPars& pars,
+                                                    const int&            ibegin,
+                                                    const int&            iend,
+                                                    GMatrixBase&          covar,
+                                                    GVector&              gradient,
+                                                    double&               value,
+                                                    double&               npred,
+                                                    GVector&              wrk_grad)
 {
-    // Timing measurement
-    #if G_EVAL_TIMING
-    #ifdef _OPENMP
-    double t_start = omp_get_wtime();
-    #else
-    clock_t t_start = clock();
-    #endif
-    #endif
-
     // Initialise statistics
     #if G_OPT_DEBUG
     int    n_bins        = 0;
@@ -658,8 +1024,23 @@ void GObservations::optimizer::poisson_binned(const GObservation&   obs,
     int*    inx    = new int[npars];
     double* values = new double[npars];
 
-    // Iterate over all bins
-    for (int i = 0; i < obs.events()->size(); ++i) {
+    // Allocate model block working arrays
+    std::vector<double> block_values(G_BLOCK_SIZE);
+    std::vector<double> block_grads(G_BLOCK_SIZE * npars);
+    double*             block_grad  = (npars > 0) ? &(block_grads[0]) : NULL;
+    int                 block_begin = ibegin;
+    int                 block_end   = ibegin;
+
+    // Iterate over bins in range
+    for (int i = ibegin; i < iend; ++i) {
+
+        // Evaluate models for the next block of events if needed
+        if (i >= block_end) {
+            block_begin = i;
+            block_end   = (i + G_BLOCK_SIZE < iend) ? i + G_BLOCK_SIZE : iend;
+            obs.model((GModels&)pars, block_begin, block_end,
+                      &(block_values[0]), block_grad);
+        }
 
         // Update number of bins
         #if G_OPT_DEBUG
@@ -668,13 +1049,17 @@ void GObservations::optimizer::poisson_binned(const GObservation&   obs,
 
         // Get event pointer
         const GEventBin* bin =
-            (*(static_cast<GEventCube*>(const_cast<GEvents*>(obs.events()))))[i];
+            (*(static_cast<const GEventCube*>(obs.events())))[i];
 
         // Get number of counts in bin
         double data = bin->counts();
 
         // Get model and derivative
-        double model = obs.model((GModels&)pars, *bin, &wrk_grad);
+        double        model = block_values[i-block_begin];
+        const double* grad  = block_grad + (i-block_begin) * npars;
+        for (int k = 0; k < npars; ++k) {
+            wrk_grad[k] = grad[k];
+        }
 
         // Multiply model by bin size
         model *= bin->size();
@@ -796,57 +1181,9 @@ void GObservations::optimizer::poisson_binned(const GObservation&   obs,
     std::cout << "Sum of data: " << sum_data << std::endl;
     std::cout << "Sum of model: " << sum_model << std::endl;
     std::cout << "Initial statistics: " << init_value << std::endl;
-    std::cout << "Statistics: " << m_value-init_value << std::endl;
+    std::cout << "Statistics: " << value-init_value << std::endl;
     #endif
 
-    // Optionally dump gradient and covariance matrix
-    #if G_EVAL_DEBUG
-    std::cout << gradient << std::endl;
-    std::cout << covar << std::endl;
-    #endif
-
-    // Timing measurement
-    #if G_EVAL_TIMING
-    #ifdef _OPENMP
-    double t_elapse = omp_get_wtime()-t_start;
-    #else
-    double t_elapse = (double)(clock() - t_start) / (double)CLOCKS_PER_SEC;
-    #endif
-    std::cout << "GObservations::optimizer::poisson_binned: CPU usage = "
-              << t_elapse << " sec" << std::endl;
-    #endif
-
-    // Return
-    return;
-}
-
-
-/***********************************************************************//**
- * @brief Evaluate log-likelihood function for Gaussian statistics and
- *        binned analysis
- *
- * @param[in] obs Observation.
- * @param[in] pars Optimizer parameters.
- *
- * This method evaluates the -(log-likelihood) function for parameter
- * optimisation using binned analysis and Poisson statistics.
- * The -(log-likelihood) function is given by
- * \f$L = 1/2 \sum_i (n_i - e_i)^2 \sigma_i^{-2}\f$
- * where the sum is taken over all data space bins, \f$n_i\f$ is the
- * observed number of counts, \f$e_i\f$ is the model and \f$\sigma_i\f$
- * is the statistical uncertainty.
- * This method also computes the parameter gradients
- * \f$\delta L/dp\f$
- * and the curvature matrix
- * \f$\delta^2 L/dp_1 dp_2\f$
- * and also updates the total number of predicted events m_npred.
- ***************************************************************************/
-void GObservations::optimizer::gaussian_binned(const GObservation& obs,
-                                               const GOptimizerPars& pars) 
-{
-    // Perform computations using the global members
-    gaussian_binned(obs, pars, *m_covar, *m_gradient, m_value, m_npred, *m_wrk_grad); 
-
     // Return
     return;
 }
@@ -854,33 +1191,32 @@ void GObservations::optimizer::gaussian_binned(const GObservation& obs,
 
 /***********************************************************************//**
  * @brief Evaluate log-likelihood function for Gaussian statistics and
- *        binned analysis (version with working arrays)
+ *        binned analysis for a range of bins
  *
  * @param[in] obs Observation.
  * @param[in] pars Optimizer parameters.
+ * @param[in] ibegin Index of first bin.
+ * @param[in] iend Index after last bin.
  * @param[in,out] covar Covariance matrix.
  * @param[in,out] gradient Gradient.
- * @param[in,out] npred Number of predicted events.
  * @param[in,out] value Likelihood value.
+ * @param[in,out] npred Number of predicted events.
  * @param[in,out] wrk_grad Gradient working array.
+ *
+ * This method evaluates the -(log-likelihood) function for parameter
+ * optimisation using binned analysis and Gaussian statistics for the
+ * bins [ibegin,iend[ of the observation.
  ***************************************************************************/
-void GObservations::optimizer::gaussian_binned(const GObservation&   obs,
-                                               const GOptimizerPars& pars,
-                                               GSparseMatrix&        covar,
-                                               GVector&              gradient,
-                                               double&               value,
-                                               double&               npred,
-                                               GVector&              wrk_grad)
+void GObservations::optimizer::gaussian_binned_range(const GObservation&   obs,
+                                                     const GOptimizerPars& pars,
+                                                     const int&            ibegin,
+                                                     const int&            iend,
+                                                     GMatrixBase&          covar,
+                                                     GVector&              gradient,
+                                                     double&               value,
+                                                     double&               npred,
+                                                     GVector&              wrk_grad)
 {
-    // Timing measurement
-    #if G_EVAL_TIMING
-    #ifdef _OPENMP
-    double t_start = omp_get_wtime();
-    #else
-    clock_t t_start = clock();
-    #endif
-    #endif
-
     // Get number of parameters
     int npars = pars.npars();
 
@@ -888,12 +1224,27 @@ void GObservations::optimizer::gaussian_binned(const GObservation&   obs,
     int*    inx    = new int[npars];
     double* values = new double[npars];
 
-    // Iterate over all bins
-    for (int i = 0; i < obs.events()->size(); ++i) {
+    // Allocate model block working arrays
+    std::vector<double> block_values(G_BLOCK_SIZE);
+    std::vector<double> block_grads(G_BLOCK_SIZE * npars);
+    double*             block_grad  = (npars > 0) ? &(block_grads[0]) : NULL;
+    int                 block_begin = ibegin;
+    int                 block_end   = ibegin;
+
+    // Iterate over bins in range
+    for (int i = ibegin; i < iend; ++i) {
+
+        // Evaluate models for the next block of events if needed
+        if (i >= block_end) {
+            block_begin = i;
+            block_end   = (i + G_BLOCK_SIZE < iend) ? i + G_BLOCK_SIZE : iend;
+            obs.model((GModels&)pars, block_begin, block_end,
+                      &(block_values[0]), block_grad);
+        }
 
         // Get event pointer
         const GEventBin* bin =
-            (*(static_cast<GEventCube*>(const_cast<GEvents*>(obs.events()))))[i];
+            (*(static_cast<const GEventCube*>(obs.events())))[i];
 
         // Get number of counts in bin
         double data = bin->counts();
@@ -907,7 +1258,11 @@ void GObservations::optimizer::gaussian_binned(const GObservation&   obs,
         }
 
         // Get model and derivative
-        double model = obs.model((GModels&)pars, *bin, &wrk_grad);
+        double        model = block_values[i-block_begin];
+        const double* grad  = block_grad + (i-block_begin) * npars;
+        for (int k = 0; k < npars; ++k) {
+            wrk_grad[k] = grad[k];
+        }
 
         // Multiply model by bin size
         model *= bin->size();
@@ -973,97 +1328,6 @@ void GObservations::optimizer::gaussian_binned(const GObservation&   obs,
     if (values != NULL) delete [] values;
     if (inx    != NULL) delete [] inx;
 
-    // Optionally dump gradient and covariance matrix
-    #if G_EVAL_DEBUG
-    std::cout << gradient << std::endl;
-    std::cout << covar << std::endl;
-    #endif
-
-    // Timing measurement
-    #if G_EVAL_TIMING
-    #ifdef _OPENMP
-    double t_elapse = omp_get_wtime()-t_start;
-    #else
-    double t_elapse = (double)(clock() - t_start) / (double)CLOCKS_PER_SEC;
-    #endif
-    std::cout << "GObservations::optimizer::gaussian_binned: CPU usage = "
-              << t_elapse << " sec" << std::endl;
-    #endif
-
-    // Return
-    return;
-}
-
-
-/*==========================================================================
- =                                                                         =
- =                            Private methods                              =
- =                                                                         =
- ==========================================================================*/
-
-/***********************************************************************//**
- * @brief Initialise class members
- ***************************************************************************/
-void GObservations::optimizer::init_members(void)
-{
-    // Initialise members
-    m_value     = 0.0;
-    m_npred     = 0.0;
-    m_minmod    = 1.0e-100;
-    m_minerr    = 1.0e-100;
-    m_this      = NULL;
-    m_gradient  = NULL;
-    m_covar     = NULL;
-    m_wrk_grad  = NULL;
-
-    // Return
-    return;
-}
-
-
-/***********************************************************************//**
- * @brief Copy class members
- *
- * @param[in] fct Optimizer.
- ***************************************************************************/
-void GObservations::optimizer::copy_members(const optimizer& fct)
-{
-    // Copy attributes
-    m_value  = fct.m_value;
-    m_npred  = fct.m_npred;
-    m_minmod = fct.m_minmod;
-    m_minerr = fct.m_minerr;
-    m_this   = fct.m_this;
-
-    // Clone gradient if it exists
-    if (fct.m_gradient != NULL) m_gradient = new GVector(*fct.m_gradient);
-
-    // Clone covariance matrix if it exists
-    if (fct.m_covar != NULL) m_covar = new GSparseMatrix(*fct.m_covar);
-
-    // Clone working gradient if it exists
-    if (fct.m_wrk_grad != NULL) m_wrk_grad = new GVector(*fct.m_wrk_grad);
-
-    // Return
-    return;
-}
-
-
-/***********************************************************************//**
- * @brief Delete class members
- ***************************************************************************/
-void GObservations::optimizer::free_members(void)
-{
-    // Free members
-    if (m_gradient != NULL) delete m_gradient;
-    if (m_covar    != NULL) delete m_covar;
-    if (m_wrk_grad != NULL) delete m_wrk_grad;
-
-    // Signal free pointers
-    m_gradient = NULL;
-    m_covar    = NULL;
-    m_wrk_grad = NULL;
-
     // Return
     return;
 }
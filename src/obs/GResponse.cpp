@@ -163,22 +163,27 @@ GResponse& GResponse::operator= (const GResponse& rsp)
  *
  * The method applies the deadtime correction, so that the response function
  * can be directly multiplied by the exposure time (also known as ontime).
+ * The deadtime correction is also applied to the analytical gradients of
+ * the spatial model parameters.
  ***************************************************************************/
 double GResponse::irf(const GEvent&       event,
                       const GSource&      source,
                       const GObservation& obs) const
 {
-    // Initialise IRF value
-    double irf = 0.0;
+    // Initialise IRF value and analytical gradients flag
+    double irf  = 0.0;
+    bool   grad = false;
 
     // Is spatial model a point source?
     if (dynamic_cast<const GModelSpatialPointSource*>(source.model()) != NULL) {
         irf = irf_ptsrc(event, source, obs);
     }
 
-    // Is spatial model a radial source?
+    // Is spatial model a radial source? Analytical gradients of radial
+    // model parameters are set by the irf_radial() method.
     else if (dynamic_cast<const GModelSpatialRadial*>(source.model()) != NULL) {
-        irf = irf_radial(event, source, obs);
+        irf  = irf_radial(event, source, obs);
+        grad = true;
     }
 
     // Is spatial model an elliptical source?
@@ -192,7 +197,19 @@ double GResponse::irf(const GEvent&       event,
     }
 
     // Apply deadtime correction
-    irf *= obs.deadc(source.time());
+    double deadc = obs.deadc(source.time());
+    irf *= deadc;
+
+    // Apply deadtime correction to analytical spatial gradients (circumvent
+    // const correctness)
+    if (grad && deadc != 1.0) {
+        GModelSpatial* model = const_cast<GModelSpatial*>(source.model());
+        for (int i = 0; i < model->size(); ++i) {
+            if ((*model)[i].hasgrad()) {
+                (*model)[i].factor_gradient((*model)[i].factor_gradient() * deadc);
+            }
+        }
+    }
 
     // Return IRF value
     return irf;
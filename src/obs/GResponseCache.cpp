@@ -0,0 +1,359 @@
+/***************************************************************************
+ *            GResponseCache.cpp - Instrument response cache class         *
+ * ----------------------------------------------------------------------- *
+ *  copyright (C) 2012 by Juergen Knoedlseder                              *
+ * ----------------------------------------------------------------------- *
+ *                                                                         *
+ *  This program is free software: you can redistribute it and/or modify   *
+ *  it under the terms of the GNU General Public License as published by   *
+ *  the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                    *
+ *                                                                         *
+ *  This program is distributed in the hope that it will be useful,        *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *  GNU General Public License for more details.                           *
+ *                                                                         *
+ *  You should have received a copy of the GNU General Public License      *
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.  *
+ *                                                                         *
+ ***************************************************************************/
+/**
+ * @file GResponseCache.cpp
+ * @brief Instrument response cache class implementation
+ * @author Juergen Knoedlseder
+ */
+
+/* __ Includes ___________________________________________________________ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include "GResponseCache.hpp"
+#include "GException.hpp"
+#include "GTools.hpp"
+
+/* __ Method name definitions ____________________________________________ */
+#define G_SET             "GResponseCache::set(std::string&, int&, int&,"\
+                                               " GModelSpatial&, double*)"
+
+/* __ Macros _____________________________________________________________ */
+
+/* __ Coding definitions _________________________________________________ */
+
+/* __ Debug definitions __________________________________________________ */
+
+
+/*==========================================================================
+ =                                                                         =
+ =                         Constructors/destructors                        =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Void constructor
+ ***************************************************************************/
+GResponseCache::GResponseCache(void)
+{
+    // Initialise class members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy constructor
+ *
+ * @param[in] cache Response cache.
+ ***************************************************************************/
+GResponseCache::GResponseCache(const GResponseCache& cache)
+{
+    // Initialise class members
+    init_members();
+
+    // Copy members
+    copy_members(cache);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Destructor
+ ***************************************************************************/
+GResponseCache::~GResponseCache(void)
+{
+    // Free members
+    free_members();
+
+    // Return
+    return;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                                Operators                                =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Assignment operator
+ *
+ * @param[in] cache Response cache.
+ * @return Response cache.
+ ***************************************************************************/
+GResponseCache& GResponseCache::operator= (const GResponseCache& cache)
+{
+    // Execute only if object is not identical
+    if (this != &cache) {
+
+        // Free members
+        free_members();
+
+        // Initialise private members
+        init_members();
+
+        // Copy members
+        copy_members(cache);
+
+    } // endif: object was not identical
+
+    // Return this object
+    return *this;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Public methods                              =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Clear response cache
+ ***************************************************************************/
+void GResponseCache::clear(void)
+{
+    // Free members
+    free_members();
+
+    // Initialise private members
+    init_members();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Clone response cache
+ *
+ * @return Pointer to deep copy of response cache.
+ ***************************************************************************/
+GResponseCache* GResponseCache::clone(void) const
+{
+    return new GResponseCache(*this);
+}
+
+
+/***********************************************************************//**
+ * @brief Return number of cached event ranges
+ *
+ * @return Number of cached event ranges.
+ ***************************************************************************/
+int GResponseCache::size(void) const
+{
+    // Get size
+    int size = 0;
+    #pragma omp critical(GResponseCache)
+    size = m_irfs.size();
+
+    // Return size
+    return size;
+}
+
+
+/***********************************************************************//**
+ * @brief Get cached response values
+ *
+ * @param[in] name Source name.
+ * @param[in] ibegin Index of first event.
+ * @param[in] iend Index after last event.
+ * @param[in] spatial Spatial model of source.
+ * @param[out] irfs Response values (iend-ibegin elements).
+ * @return True if response values were found in cache.
+ *
+ * Returns the cached response values for the events [ibegin,iend) of
+ * source @p name. Cached values are only returned if they have been
+ * computed for the same event range and for the actual parameters of the
+ * spatial model.
+ ***************************************************************************/
+bool GResponseCache::get(const std::string&   name,
+                         const int&           ibegin,
+                         const int&           iend,
+                         const GModelSpatial& spatial,
+                         double*              irfs) const
+{
+    // Initialise flag
+    bool found = false;
+
+    // Set key
+    key_type key(name, ibegin);
+
+    // Search cache
+    #pragma omp critical(GResponseCache)
+    {
+        cache_type::const_iterator irf = m_irfs.find(key);
+        if (irf != m_irfs.end() && irf->second.size() == iend-ibegin) {
+
+            // Check spatial model parameters
+            const std::vector<double>& pars = m_pars.find(key)->second;
+            found = (pars.size() == spatial.size());
+            for (int i = 0; i < pars.size() && found; ++i) {
+                found = (pars[i] == spatial[i].value());
+            }
+
+            // Copy response values
+            if (found) {
+                for (int i = 0; i < irf->second.size(); ++i) {
+                    irfs[i] = irf->second[i];
+                }
+            }
+
+        } // endif: event range found
+    } // end omp critical
+
+    // Return flag
+    return found;
+}
+
+
+/***********************************************************************//**
+ * @brief Set cached response values
+ *
+ * @param[in] name Source name.
+ * @param[in] ibegin Index of first event.
+ * @param[in] iend Index after last event.
+ * @param[in] spatial Spatial model of source.
+ * @param[in] irfs Response values (iend-ibegin elements).
+ *
+ * @exception GException::invalid_argument
+ *            Invalid event range specified.
+ *
+ * Stores the response values for the events [ibegin,iend) of source
+ * @p name, together with the actual parameters of the spatial model.
+ * Any values that were cached before for the same source and event range
+ * are replaced.
+ ***************************************************************************/
+void GResponseCache::set(const std::string&   name,
+                         const int&           ibegin,
+                         const int&           iend,
+                         const GModelSpatial& spatial,
+                         const double*        irfs)
+{
+    // Throw an exception if the event range is invalid
+    if (iend < ibegin) {
+        throw GException::invalid_argument(G_SET,
+              "Invalid event range ["+str(ibegin)+","+str(iend)+").");
+    }
+
+    // Set key
+    key_type key(name, ibegin);
+
+    // Gather spatial model parameters
+    std::vector<double> pars(spatial.size());
+    for (int i = 0; i < pars.size(); ++i) {
+        pars[i] = spatial[i].value();
+    }
+
+    // Store values
+    #pragma omp critical(GResponseCache)
+    {
+        m_pars[key] = pars;
+        m_irfs[key].assign(irfs, irfs+(iend-ibegin));
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Print response cache
+ *
+ * @return String containing response cache information.
+ ***************************************************************************/
+std::string GResponseCache::print(void) const
+{
+    // Initialise result string
+    std::string result;
+
+    // Count number of cached values
+    int nranges = 0;
+    int nvalues = 0;
+    #pragma omp critical(GResponseCache)
+    {
+        nranges = m_irfs.size();
+        for (cache_type::const_iterator irf = m_irfs.begin();
+             irf != m_irfs.end(); ++irf) {
+            nvalues += irf->second.size();
+        }
+    }
+
+    // Append information
+    result.append("=== GResponseCache ===");
+    result.append("\n"+parformat("Number of event ranges")+str(nranges));
+    result.append("\n"+parformat("Number of cached values")+str(nvalues));
+
+    // Return result
+    return result;
+}
+
+
+/*==========================================================================
+ =                                                                         =
+ =                             Private methods                             =
+ =                                                                         =
+ ==========================================================================*/
+
+/***********************************************************************//**
+ * @brief Initialise class members
+ ***************************************************************************/
+void GResponseCache::init_members(void)
+{
+    // Initialise members
+    m_pars.clear();
+    m_irfs.clear();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Copy class members
+ *
+ * @param[in] cache Response cache.
+ ***************************************************************************/
+void GResponseCache::copy_members(const GResponseCache& cache)
+{
+    // Copy members
+    m_pars = cache.m_pars;
+    m_irfs = cache.m_irfs;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Delete class members
+ ***************************************************************************/
+void GResponseCache::free_members(void)
+{
+    // Return
+    return;
+}
@@ -45,6 +45,15 @@
 
 /* __ Prototypes _________________________________________________________ */
 
+/* __ Constants __________________________________________________________ */
+// Rotation matrix from Galactic to celestial unit vectors. The matrix
+// corresponds to the transformation done by GSkyDir::euler(1,...), made
+// orthonormal to machine precision so that angular distances between
+// Galactic directions are preserved.
+const double g_gal2equ[3][3] = {{-0.054875560399387659,  0.49410942788993029, -0.86766614901189898},
+                                {-0.87343709023825022,  -0.44482962994560965, -0.19807637344870435},
+                                {-0.48383501554454666,   0.74698224449630513,  0.45598377618098479}};
+
 /*==========================================================================
  =                                                                         =
  =                          Constructors/destructors                       =
@@ -175,6 +184,44 @@ void GSkyDir::radec(const double& ra, const double& dec)
     m_ra  = ra;
     m_dec = dec;
 
+    // Set unit vector
+    set_vector();
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set equatorial sky direction with known celestial unit vector
+ *
+ * @param[in] ra Right Ascension in radians.
+ * @param[in] dec Declination in radians.
+ * @param[in] x Celestial unit vector x component.
+ * @param[in] y Celestial unit vector y component.
+ * @param[in] z Celestial unit vector z component.
+ *
+ * Sets the sky direction from equatorial coordinates and the corresponding
+ * celestial unit vector, which avoids the trigonometric computation of the
+ * unit vector. The caller is responsible for the consistency of the
+ * arguments.
+ ***************************************************************************/
+void GSkyDir::radec(const double& ra, const double& dec,
+                    const double& x, const double& y, const double& z)
+{
+    // Set attributes
+    m_has_lb    = false;
+    m_has_radec = true;
+
+    // Set direction
+    m_ra  = ra;
+    m_dec = dec;
+
+    // Set unit vector
+    m_x = x;
+    m_y = y;
+    m_z = z;
+
     // Return
     return;
 }
@@ -196,6 +243,9 @@ void GSkyDir::radec_deg(const double& ra, const double& dec)
     m_ra  = ra  * deg2rad;
     m_dec = dec * deg2rad;
 
+    // Set unit vector
+    set_vector();
+
     // Return
     return;
 }
@@ -217,6 +267,9 @@ void GSkyDir::lb(const double& l, const double& b)
     m_l = l;
     m_b = b;
 
+    // Set unit vector
+    set_vector();
+
     // Return
     return;
 }
@@ -238,6 +291,9 @@ void GSkyDir::lb_deg(const double& l, const double& b)
     m_l = l * deg2rad;
     m_b = b * deg2rad;
 
+    // Set unit vector
+    set_vector();
+
     // Return
     return;
 }
@@ -258,6 +314,9 @@ void GSkyDir::celvector(const GVector& vector)
     m_dec = std::asin(vector[2]);
     m_ra  = std::atan2(vector[1], vector[0]);
 
+    // Set unit vector
+    set_vector();
+
     // Return
     return;
 }
@@ -428,16 +487,8 @@ double GSkyDir::dec_deg(void) const
  ***************************************************************************/
 GVector GSkyDir::celvector(void) const
 {
-    // If we have no equatorial coordinates then get them now
-    if (!m_has_radec && m_has_lb)
-        gal2equ();
-
-    // Compute 3D vector
-    double  cosra  = std::cos(m_ra);
-    double  sinra  = std::sin(m_ra);
-    double  cosdec = std::cos(m_dec);
-    double  sindec = std::sin(m_dec);
-    GVector vector(cosdec*cosra, cosdec*sinra, sindec);
+    // Set 3D vector from unit vector
+    GVector vector(m_x, m_y, m_z);
 
     // Return vector
     return vector;
@@ -445,46 +496,76 @@ GVector GSkyDir::celvector(void) const
 
 
 /***********************************************************************//**
- * @brief Compute angular distance between sky directions in radians
+ * @brief Compute cosine of angular distance between sky directions
  *
  * @param[in] dir Sky direction to which distance is to be computed.
+ * @return Cosine of angular distance.
+ *
+ * Computes the cosine of the angular distance as the dot product of the
+ * celestial unit vectors of both sky directions. Note that rounding may
+ * lead to values that are slightly outside the interval [-1,1].
  ***************************************************************************/
-double GSkyDir::dist(const GSkyDir& dir) const
+double GSkyDir::cos_dist(const GSkyDir& dir) const
 {
-    // Initialise cosine of distance
-    double cosdis;
+    // Return dot product of unit vectors
+    return (m_x*dir.m_x + m_y*dir.m_y + m_z*dir.m_z);
+}
 
-    // Compute dependent on coordinate system availability. This speeds
-    // up things by avoiding unnecessary coordinate transformations.
-    if (m_has_lb && dir.m_has_lb) {
-        cosdis = std::sin(m_b)*std::sin(dir.m_b) +
-                 std::cos(m_b)*std::cos(dir.m_b) * std::cos(dir.m_l - m_l);
-    }
-    else if (m_has_radec && dir.m_has_radec) {
-        cosdis = std::sin(m_dec)*std::sin(dir.m_dec) +
-                 std::cos(m_dec)*std::cos(dir.m_dec) * std::cos(dir.m_ra - m_ra);
-    }
-    else if (m_has_lb) {
-        cosdis = std::sin(m_b)*std::sin(dir.b()) +
-                 std::cos(m_b)*std::cos(dir.b()) * std::cos(dir.l() - m_l);
-    }
-    else if (m_has_radec) {
-        cosdis = sin(m_dec)*sin(dir.dec()) +
-                 cos(m_dec)*cos(dir.dec()) * std::cos(dir.ra() - m_ra);
-    }
-    else {
-        cosdis = std::sin(dec())*std::sin(dir.dec()) +
-                 std::cos(dec())*std::cos(dir.dec()) * std::cos(dir.ra() - ra());
-    }
 
+/***********************************************************************//**
+ * @brief Compute angular distance between sky directions in radians
+ *
+ * @param[in] dir Sky direction to which distance is to be computed.
+ * @return Angular distance (radians).
+ ***************************************************************************/
+double GSkyDir::dist(const GSkyDir& dir) const
+{
     // Compute distance (use argument save GTools function)
-    double dist = arccos(cosdis);
+    double dist = arccos(cos_dist(dir));
 
     // Return distance
     return dist;
 }
 
 
+/***********************************************************************//**
+ * @brief Compute cosines of angular distances to sky directions
+ *
+ * @param[in] num Number of sky directions.
+ * @param[in] dirs Sky directions [num].
+ * @param[out] cosdist Cosines of angular distances [num].
+ ***************************************************************************/
+void GSkyDir::cos_dist(const int& num, const GSkyDir* dirs, double* cosdist) const
+{
+    // Compute dot products of unit vectors
+    for (int i = 0; i < num; ++i) {
+        cosdist[i] = m_x*dirs[i].m_x + m_y*dirs[i].m_y + m_z*dirs[i].m_z;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute angular distances to sky directions in radians
+ *
+ * @param[in] num Number of sky directions.
+ * @param[in] dirs Sky directions [num].
+ * @param[out] dist Angular distances (radians) [num].
+ ***************************************************************************/
+void GSkyDir::dist(const int& num, const GSkyDir* dirs, double* dist) const
+{
+    // Compute distances
+    for (int i = 0; i < num; ++i) {
+        dist[i] = arccos(m_x*dirs[i].m_x + m_y*dirs[i].m_y + m_z*dirs[i].m_z);
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Compute angular distance between sky directions in degrees
  *
@@ -605,6 +686,9 @@ void GSkyDir::init_members(void)
     m_b         = 0.0;
     m_ra        = 0.0;
     m_dec       = 0.0;
+    m_x         = 1.0;
+    m_y         = 0.0;
+    m_z         = 0.0;
 
     // Return
     return;
@@ -625,6 +709,9 @@ void GSkyDir::copy_members(const GSkyDir& dir)
     m_b         = dir.m_b;
     m_ra        = dir.m_ra;
     m_dec       = dir.m_dec;
+    m_x         = dir.m_x;
+    m_y         = dir.m_y;
+    m_z         = dir.m_z;
 
     // Return
     return;
@@ -641,6 +728,40 @@ void GSkyDir::free_members(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Set celestial unit vector
+ *
+ * Computes the celestial unit vector from the equatorial coordinates, or
+ * from the Galactic coordinates if only those are available. Galactic unit
+ * vectors are rotated into the celestial system, which avoids computing
+ * the equatorial coordinates.
+ ***************************************************************************/
+void GSkyDir::set_vector(void)
+{
+    // Compute unit vector from equatorial coordinates
+    if (m_has_radec) {
+        double cosdec = std::cos(m_dec);
+        m_x = cosdec * std::cos(m_ra);
+        m_y = cosdec * std::sin(m_ra);
+        m_z = std::sin(m_dec);
+    }
+
+    // ... otherwise compute unit vector from Galactic coordinates
+    else if (m_has_lb) {
+        double cosb = std::cos(m_b);
+        double x    = cosb * std::cos(m_l);
+        double y    = cosb * std::sin(m_l);
+        double z    = std::sin(m_b);
+        m_x = g_gal2equ[0][0]*x + g_gal2equ[0][1]*y + g_gal2equ[0][2]*z;
+        m_y = g_gal2equ[1][0]*x + g_gal2equ[1][1]*y + g_gal2equ[1][2]*z;
+        m_z = g_gal2equ[2][0]*x + g_gal2equ[2][1]*y + g_gal2equ[2][2]*z;
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Convert equatorial to galactic coordinates
  ***************************************************************************/
@@ -28,6 +28,8 @@
 #ifdef HAVE_CONFIG_H
 #include <config.h>
 #endif
+#include <vector>
+#include <cmath>
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GSkymap.hpp"
@@ -36,7 +38,12 @@
 #include "GWcsHPX.hpp"
 #include "GFits.hpp"
 #include "GFitsTableDoubleCol.hpp"
+#include "GFitsTableFloatCol.hpp"
+#include "GFitsTableLongCol.hpp"
+#include "GFitsTableWriter.hpp"
 #include "GFitsImageDouble.hpp"
+#include "GFitsImageFloat.hpp"
+#include "GFitsImageLong.hpp"
 
 /* __ Method name definitions ____________________________________________ */
 #define G_CONSTRUCT_HPX     "GSkymap::GSkymap(std::string,std::string,int," \
@@ -51,17 +58,28 @@
 #define G_DIR2PIX                                 "GSkymap::dir2pix(GSkyDir)"
 #define G_XY2DIR                                 "GSkymap::xy2dir(GSkyPixel)"
 #define G_DIR2XY                                   "GSkymap::dir2xy(GSkyDir)"
+#define G_PIX2DIR_ARRAY       "GSkymap::pix2dir(int&, int*, double*, double*)"
+#define G_DIR2PIX_ARRAY       "GSkymap::dir2pix(int&, double*, double*, int*)"
+#define G_XY2DIR_ARRAY "GSkymap::xy2dir(int&, double*, double*, double*, "\
+                                                                   "double*)"
+#define G_DIR2XY_ARRAY "GSkymap::dir2xy(int&, double*, double*, double*, "\
+                                                                   "double*)"
 #define G_OMEGA1                                        "GSkymap::omega(int)"
 #define G_OMEGA2                                  "GSkymap::omega(GSkyPixel)"
 #define G_SET_WCS "GSkymap::set_wcs(std::string,std::string,double,double," \
                                "double,double,double,double,GMatrix,GVector)"
 #define G_READ_HEALPIX                   "GSkymap::read_healpix(GFitsTable*)"
+#define G_READ_HEALPIX_EXPLICIT "GSkymap::read_healpix_explicit(GFitsTable*)"
 #define G_READ_WCS                           "GSkymap::read_wcs(GFitsImage*)"
+#define G_BITPIX                                      "GSkymap::bitpix(int)"
 #define G_ALLOC_WCS                         "GSkymap::alloc_wcs(GFitsImage*)"
 
 /* __ Macros _____________________________________________________________ */
 
 /* __ Coding definitions _________________________________________________ */
+#define G_SAVE_BLOCK 100000       //!< HEALPix pixels per block for streaming
+#define G_TRANSFORM_CHUNK 4096    //!< Coordinates per thread for transforms
+#define G_SPARSE_TILE 1024        //!< Pixels per tile for sparse storage
 
 /* __ Debug definitions __________________________________________________ */
 //#define G_READ_HEALPIX_DEBUG                          // Debug read_healpix
@@ -69,6 +87,23 @@
 
 /* __ Prototype __________________________________________________________ */
 
+/* __ Constants __________________________________________________________ */
+const double g_sparse_zero = 0.0;  //!< Value of unallocated sparse pixels
+
+/* __ Local functions ____________________________________________________ */
+static long integer(const double& value)
+{
+    // Round to nearest integer and clip to 32-bit integer range
+    double rounded = std::floor(value + 0.5);
+    if (rounded > 2147483647.0) {
+        rounded = 2147483647.0;
+    }
+    else if (rounded < -2147483648.0) {
+        rounded = -2147483648.0;
+    }
+    return long(rounded);
+}
+
 
 /*==========================================================================
  =                                                                         =
@@ -115,6 +150,7 @@ GSkymap::GSkymap(const std::string& filename)
  * @param[in] nside Nside parameter.
  * @param[in] order Pixel ordering (RING or NEST).
  * @param[in] nmaps Number of maps in set (default=1).
+ * @param[in] sparse Use sparse pixel storage (default=false).
  *
  * @exception GException::wcs_invalid
  *            Invalid wcs parameter.
@@ -123,7 +159,7 @@ GSkymap::GSkymap(const std::string& filename)
  ***************************************************************************/
 GSkymap::GSkymap(const std::string& wcs, const std::string& coords,
                  const int& nside, const std::string& order,
-                 const int nmaps)
+                 const int nmaps, const bool sparse)
 {
     // Initialise class members for clean destruction
     init_members();
@@ -146,6 +182,7 @@ GSkymap::GSkymap(const std::string& wcs, const std::string& coords,
     // Set number of pixels and number of maps
     m_num_pixels = static_cast<GWcsHPX*>(m_wcs)->npix();
     m_num_maps   = nmaps;
+    m_sparse     = sparse;
 
     // Allocate pixels
     alloc_pixels();
@@ -167,6 +204,7 @@ GSkymap::GSkymap(const std::string& wcs, const std::string& coords,
  * @param[in] nx Number of pixels in x direction.
  * @param[in] ny Number of pixels in y direction.
  * @param[in] nmaps Number of maps in set (default=1).
+ * @param[in] sparse Use sparse pixel storage (default=false).
  *
  * @exception GException::skymap_bad_par
  *            Invalid sky map parameter.
@@ -174,7 +212,8 @@ GSkymap::GSkymap(const std::string& wcs, const std::string& coords,
 GSkymap::GSkymap(const std::string& wcs, const std::string& coords,
                  double const& x, double const& y,
                  double const& dx, double const& dy,
-                 const int& nx, const int& ny, const int nmaps)
+                 const int& nx, const int& ny, const int nmaps,
+                 const bool sparse)
 {
     // Initialise class members for clean destruction
     init_members();
@@ -210,6 +249,7 @@ GSkymap::GSkymap(const std::string& wcs, const std::string& coords,
     m_num_y      = ny;
     m_num_pixels = m_num_x * m_num_y;
     m_num_maps   = nmaps;
+    m_sparse     = sparse;
 
     // Allocate pixels
     alloc_pixels();
@@ -266,7 +306,8 @@ GSkymap::~GSkymap(void)
  *            Pixel index and/or map index are outside valid range.
  *
  * Access sky map pixel by its index, where the most quickly varying axis is
- * the x axis of the map.
+ * the x axis of the map. For sparse maps, the tile holding the pixel is
+ * allocated if it does not yet exist.
  *
  * @todo Implement proper skymap exception (actual is for matrix elements)
  ***************************************************************************/
@@ -283,6 +324,9 @@ double& GSkymap::operator() (const int& pixel, const int& map)
     #endif
 
     // Return reference to pixel value
+    if (m_sparse) {
+        return *sparse_pixel(pixel, map);
+    }
     return m_pixels[pixel+m_num_pixels*map];
 }
 
@@ -297,7 +341,8 @@ double& GSkymap::operator() (const int& pixel, const int& map)
  *            Pixel index and/or map index are outside valid range.
  *
  * Access sky map pixel by its index, where the most quickly varying axis is
- * the x axis of the map.
+ * the x axis of the map. For sparse maps, pixels in unallocated tiles have
+ * a value of 0.
  *
  * @todo Implement proper skymap exception (actual is for matrix elements)
  ***************************************************************************/
@@ -314,6 +359,9 @@ const double& GSkymap::operator() (const int& pixel, const int& map) const
     #endif
 
     // Return reference to pixel value
+    if (m_sparse) {
+        return *sparse_pixel(pixel, map);
+    }
     return m_pixels[pixel+m_num_pixels*map];
 }
 
@@ -350,6 +398,9 @@ double& GSkymap::operator() (const GSkyPixel& pixel, const int& map)
     int index = xy2pix(pixel);
 
     // Return reference to pixel value
+    if (m_sparse) {
+        return *sparse_pixel(index, map);
+    }
     return m_pixels[index+m_num_pixels*map];
 }
 
@@ -386,6 +437,9 @@ const double& GSkymap::operator() (const GSkyPixel& pixel, const int& map) const
     int index = xy2pix(pixel);
 
     // Return reference to pixel value
+    if (m_sparse) {
+        return *sparse_pixel(index, map);
+    }
     return m_pixels[index+m_num_pixels*map];
 }
 
@@ -457,14 +511,20 @@ double GSkymap::operator() (const GSkyDir& dir, const int& map) const
         double wgt3 = wgt_x_right * wgt_y_left;
         double wgt4 = wgt_x_right * wgt_y_right;
 
-        // Compute map offset
-        int offset = m_num_pixels * map;
-
         // Compute interpolated skymap value
-        intensity = wgt1 * m_pixels[inx1 + offset] +
-                    wgt2 * m_pixels[inx2 + offset] +
-                    wgt3 * m_pixels[inx3 + offset] +
-                    wgt4 * m_pixels[inx4 + offset];
+        if (m_sparse) {
+            intensity = wgt1 * *sparse_pixel(inx1, map) +
+                        wgt2 * *sparse_pixel(inx2, map) +
+                        wgt3 * *sparse_pixel(inx3, map) +
+                        wgt4 * *sparse_pixel(inx4, map);
+        }
+        else {
+            int offset = m_num_pixels * map;
+            intensity  = wgt1 * m_pixels[inx1 + offset] +
+                         wgt2 * m_pixels[inx2 + offset] +
+                         wgt3 * m_pixels[inx3 + offset] +
+                         wgt4 * m_pixels[inx4 + offset];
+        }
 
     } // endif: pixel was within map
 
@@ -594,7 +654,7 @@ void GSkymap::load(const std::string& filename)
             }
 
             // Load WCS map
-            read_wcs(static_cast<const GFitsImageDouble*>(hdu));
+            read_wcs(static_cast<const GFitsImage*>(hdu));
             loaded = true;
             break;
 
@@ -616,18 +676,37 @@ void GSkymap::load(const std::string& filename)
  * @param[in] clobber Overwrite existing file? (true=yes)
  *
  * The method does nothing if the skymap holds no valid WCS.
+ *
+ * HEALPix maps with more than G_SAVE_BLOCK pixels are not copied into a
+ * FITS table in memory. The file is created with a table that has no
+ * rows, and the pixels are then streamed into that table in blocks using
+ * a GFitsTableWriter. Sparse HEALPix maps are written as partial-sky maps
+ * that hold only the allocated pixels.
  ***************************************************************************/
 void GSkymap::save(const std::string& filename, bool clobber) const
 {
     // Continue only if we have data to save
     if (m_wcs != NULL) {
 
+        // Signal if pixels are streamed
+        bool stream = (m_wcs->code() == "HPX" && !m_sparse &&
+                       m_num_pixels > G_SAVE_BLOCK);
+
         // Initialise HDU pointer
         GFitsHDU* hdu = NULL;
 
         // Case A: Skymap is Healpix
         if (m_wcs->code() == "HPX") {
-            hdu = create_healpix_hdu();
+
+            // Large maps are streamed, hence create a table without rows
+            // that holds the header and the column definition
+            if (stream) {
+                hdu = create_healpix_hdu(0, 0);
+            }
+            else {
+                hdu = create_healpix_hdu();
+            }
+
         }
 
         // Case B: Skymap is not Healpix
@@ -645,6 +724,19 @@ void GSkymap::save(const std::string& filename, bool clobber) const
         // Delete HDU
         if (hdu != NULL) delete hdu;
 
+        // Stream pixels of large Healpix maps into the table
+        if (stream) {
+            GFitsTableWriter writer(filename, "HEALPIX");
+            for (int first = 0; first < m_num_pixels; first += G_SAVE_BLOCK) {
+                int nrows = (m_num_pixels-first < G_SAVE_BLOCK)
+                            ? m_num_pixels-first : G_SAVE_BLOCK;
+                GFitsBinTable* block = create_healpix_hdu(first, nrows);
+                writer.write(*block);
+                delete block;
+            }
+            writer.close();
+        }
+
     } // endif: we had data to save
 
     // Return
@@ -686,7 +778,7 @@ void GSkymap::read(const GFitsHDU* hdu)
 
             // Load only if HDU contains an image
             if (hdu->exttype() == 0) {
-                read_wcs(static_cast<const GFitsImageDouble*>(hdu));
+                read_wcs(static_cast<const GFitsImage*>(hdu));
                 loaded = true;
             }
 
@@ -859,6 +951,259 @@ GSkyPixel GSkymap::dir2xy(const GSkyDir& dir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Returns sky coordinates of pixels
+ *
+ * @param[in] num Number of pixels.
+ * @param[in] pix Pixel indices [num].
+ * @param[out] lon Longitudes in the map coordinate system (deg) [num].
+ * @param[out] lat Latitudes in the map coordinate system (deg) [num].
+ *
+ * @exception GException::wcs
+ *            No valid WCS found.
+ *
+ * Converts an array of pixel indices into sky coordinates. The coordinates
+ * are Right Ascension and Declination for equatorial maps, and Galactic
+ * longitude and latitude otherwise (see GWcs::coordsys()).
+ *
+ * The coordinates are transformed in chunks of G_TRANSFORM_CHUNK, where
+ * each chunk is passed as a whole to the WCS. Chunks are transformed in
+ * parallel if OpenMP is available.
+ ***************************************************************************/
+void GSkymap::pix2dir(const int& num, const int* pix,
+                      double* lon, double* lat) const
+{
+    // Throw error if WCS is not valid
+    if (m_wcs == NULL) {
+        throw GException::wcs(G_PIX2DIR_ARRAY, "No valid WCS found.");
+    }
+
+    // Continue only if there are pixels
+    if (num > 0) {
+
+        // Transform first pixel so that any lazy initialisation of the WCS
+        // is done before threads are started
+        if (m_num_x == 0) {
+            m_wcs->pix2dir(1, pix, lon, lat);
+        }
+        else {
+            double x = double(pix[0] % m_num_x);
+            double y = double(pix[0] / m_num_x);
+            m_wcs->xy2dir(1, &x, &y, lon, lat);
+        }
+
+        // Transform pixels in chunks
+        int nchunks = (num + G_TRANSFORM_CHUNK - 1) / G_TRANSFORM_CHUNK;
+        #pragma omp parallel for schedule(dynamic) if(nchunks > 1)
+        for (int k = 0; k < nchunks; ++k) {
+            int first = k * G_TRANSFORM_CHUNK;
+            int n     = (num-first < G_TRANSFORM_CHUNK) ? num-first : G_TRANSFORM_CHUNK;
+            if (m_num_x == 0) {
+                m_wcs->pix2dir(n, pix+first, lon+first, lat+first);
+            }
+            else {
+                std::vector<double> x(n);
+                std::vector<double> y(n);
+                for (int i = 0; i < n; ++i) {
+                    x[i] = double(pix[first+i] % m_num_x);
+                    y[i] = double(pix[first+i] / m_num_x);
+                }
+                m_wcs->xy2dir(n, &x[0], &y[0], lon+first, lat+first);
+            }
+        }
+
+    } // endif: there were pixels
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixel indices of sky coordinates
+ *
+ * @param[in] num Number of coordinates.
+ * @param[in] lon Longitudes in the map coordinate system (deg) [num].
+ * @param[in] lat Latitudes in the map coordinate system (deg) [num].
+ * @param[out] pix Pixel indices [num].
+ *
+ * @exception GException::wcs
+ *            No valid WCS found.
+ *
+ * Converts arrays of sky coordinates into pixel indices. For 2D maps the
+ * pixel values are rounded to the nearest integers (see xy2pix()).
+ ***************************************************************************/
+void GSkymap::dir2pix(const int& num, const double* lon, const double* lat,
+                      int* pix) const
+{
+    // Throw error if WCS is not valid
+    if (m_wcs == NULL) {
+        throw GException::wcs(G_DIR2PIX_ARRAY, "No valid WCS found.");
+    }
+
+    // Continue only if there are coordinates
+    if (num > 0) {
+
+        // Transform first coordinate so that any lazy initialisation of the
+        // WCS is done before threads are started
+        if (m_num_x == 0) {
+            m_wcs->dir2pix(1, lon, lat, pix);
+        }
+        else {
+            double x;
+            double y;
+            m_wcs->dir2xy(1, lon, lat, &x, &y);
+        }
+
+        // Transform coordinates in chunks
+        int nchunks = (num + G_TRANSFORM_CHUNK - 1) / G_TRANSFORM_CHUNK;
+        #pragma omp parallel for schedule(dynamic) if(nchunks > 1)
+        for (int k = 0; k < nchunks; ++k) {
+            int first = k * G_TRANSFORM_CHUNK;
+            int n     = (num-first < G_TRANSFORM_CHUNK) ? num-first : G_TRANSFORM_CHUNK;
+            if (m_num_x == 0) {
+                m_wcs->dir2pix(n, lon+first, lat+first, pix+first);
+            }
+            else {
+                std::vector<double> x(n);
+                std::vector<double> y(n);
+                m_wcs->dir2xy(n, lon+first, lat+first, &x[0], &y[0]);
+                for (int i = 0; i < n; ++i) {
+                    pix[first+i] = int(x[i]+0.5) + int(y[i]+0.5) * m_num_x;
+                }
+            }
+        }
+
+    } // endif: there were coordinates
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns sky coordinates of 2D pixels
+ *
+ * @param[in] num Number of pixels.
+ * @param[in] x Pixel x values [num].
+ * @param[in] y Pixel y values [num].
+ * @param[out] lon Longitudes in the map coordinate system (deg) [num].
+ * @param[out] lat Latitudes in the map coordinate system (deg) [num].
+ *
+ * @exception GException::wcs
+ *            No valid WCS found.
+ *
+ * Converts arrays of 2D pixel values into sky coordinates. For 1D maps the
+ * pixel values are rounded to the nearest pixel indices (see xy2pix()).
+ ***************************************************************************/
+void GSkymap::xy2dir(const int& num, const double* x, const double* y,
+                     double* lon, double* lat) const
+{
+    // Throw error if WCS is not valid
+    if (m_wcs == NULL) {
+        throw GException::wcs(G_XY2DIR_ARRAY, "No valid WCS found.");
+    }
+
+    // Continue only if there are pixels
+    if (num > 0) {
+
+        // Transform first pixel so that any lazy initialisation of the WCS
+        // is done before threads are started
+        if (m_num_x == 0) {
+            int pix = int(x[0]+0.5);
+            m_wcs->pix2dir(1, &pix, lon, lat);
+        }
+        else {
+            m_wcs->xy2dir(1, x, y, lon, lat);
+        }
+
+        // Transform pixels in chunks
+        int nchunks = (num + G_TRANSFORM_CHUNK - 1) / G_TRANSFORM_CHUNK;
+        #pragma omp parallel for schedule(dynamic) if(nchunks > 1)
+        for (int k = 0; k < nchunks; ++k) {
+            int first = k * G_TRANSFORM_CHUNK;
+            int n     = (num-first < G_TRANSFORM_CHUNK) ? num-first : G_TRANSFORM_CHUNK;
+            if (m_num_x == 0) {
+                std::vector<int> pix(n);
+                for (int i = 0; i < n; ++i) {
+                    pix[i] = int(x[first+i]+0.5);
+                }
+                m_wcs->pix2dir(n, &pix[0], lon+first, lat+first);
+            }
+            else {
+                m_wcs->xy2dir(n, x+first, y+first, lon+first, lat+first);
+            }
+        }
+
+    } // endif: there were pixels
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns 2D pixels of sky coordinates
+ *
+ * @param[in] num Number of coordinates.
+ * @param[in] lon Longitudes in the map coordinate system (deg) [num].
+ * @param[in] lat Latitudes in the map coordinate system (deg) [num].
+ * @param[out] x Pixel x values [num].
+ * @param[out] y Pixel y values [num].
+ *
+ * @exception GException::wcs
+ *            No valid WCS found.
+ *
+ * Converts arrays of sky coordinates into 2D pixel values. This method is
+ * the basis for reprojecting one map onto another.
+ ***************************************************************************/
+void GSkymap::dir2xy(const int& num, const double* lon, const double* lat,
+                     double* x, double* y) const
+{
+    // Throw error if WCS is not valid
+    if (m_wcs == NULL) {
+        throw GException::wcs(G_DIR2XY_ARRAY, "No valid WCS found.");
+    }
+
+    // Continue only if there are coordinates
+    if (num > 0) {
+
+        // Transform first coordinate so that any lazy initialisation of the
+        // WCS is done before threads are started
+        if (m_num_x == 0) {
+            int pix;
+            m_wcs->dir2pix(1, lon, lat, &pix);
+        }
+        else {
+            m_wcs->dir2xy(1, lon, lat, x, y);
+        }
+
+        // Transform coordinates in chunks
+        int nchunks = (num + G_TRANSFORM_CHUNK - 1) / G_TRANSFORM_CHUNK;
+        #pragma omp parallel for schedule(dynamic) if(nchunks > 1)
+        for (int k = 0; k < nchunks; ++k) {
+            int first = k * G_TRANSFORM_CHUNK;
+            int n     = (num-first < G_TRANSFORM_CHUNK) ? num-first : G_TRANSFORM_CHUNK;
+            if (m_num_x == 0) {
+                std::vector<int> pix(n);
+                m_wcs->dir2pix(n, lon+first, lat+first, &pix[0]);
+                for (int i = 0; i < n; ++i) {
+                    x[first+i] = double(pix[i]);
+                    y[first+i] = 0.0;
+                }
+            }
+            else {
+                m_wcs->dir2xy(n, lon+first, lat+first, x+first, y+first);
+            }
+        }
+
+    } // endif: there were coordinates
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns solid angle of pixel
  *
@@ -1020,6 +1365,161 @@ void GSkymap::wcs(const GWcs& wcs)
 }
 
 
+/***********************************************************************//**
+ * @brief Convert skymap to sparse pixel storage
+ *
+ * Converts the pixels into sparse storage. Tiles that hold only pixels
+ * with a value of 0 are not allocated. The method does nothing if the
+ * skymap already uses sparse storage.
+ ***************************************************************************/
+void GSkymap::sparse(void)
+{
+    // Continue only if pixels are not yet sparse
+    if (!m_sparse) {
+
+        // Setup unallocated tiles
+        int ntile = ntiles();
+        m_tiles.assign(ntile * m_num_maps, (double*)NULL);
+        m_sparse = true;
+
+        // Copy all tiles that hold non-zero pixels
+        if (m_pixels != NULL) {
+            for (int map = 0; map < m_num_maps; ++map) {
+                for (int tile = 0; tile < ntile; ++tile) {
+                    int first = tile * G_SPARSE_TILE;
+                    int last  = first + G_SPARSE_TILE;
+                    if (last > m_num_pixels) {
+                        last = m_num_pixels;
+                    }
+                    const double* src = m_pixels + map*m_num_pixels;
+                    for (int i = first; i < last; ++i) {
+                        if (src[i] != 0.0) {
+                            double* dst = sparse_pixel(first, map);
+                            for (int k = first; k < last; ++k) {
+                                *dst++ = src[k];
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+            delete [] m_pixels;
+            m_pixels = NULL;
+        }
+
+    } // endif: pixels were not sparse
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convert skymap to dense pixel storage
+ *
+ * Converts the pixels into a contiguous array. The method does nothing if
+ * the skymap already uses dense storage.
+ ***************************************************************************/
+void GSkymap::dense(void)
+{
+    // Continue only if pixels are sparse
+    if (m_sparse) {
+
+        // Allocate dense pixels
+        m_sparse = false;
+        alloc_pixels();
+
+        // Copy all allocated tiles and free them
+        int ntile = ntiles();
+        for (int map = 0; map < m_num_maps; ++map) {
+            for (int tile = 0; tile < ntile; ++tile) {
+                const double* src = m_tiles[map*ntile + tile];
+                if (src != NULL) {
+                    int first = tile * G_SPARSE_TILE;
+                    int last  = first + G_SPARSE_TILE;
+                    if (last > m_num_pixels) {
+                        last = m_num_pixels;
+                    }
+                    double* dst = m_pixels + map*m_num_pixels;
+                    for (int i = first; i < last; ++i) {
+                        dst[i] = *src++;
+                    }
+                    delete [] m_tiles[map*ntile + tile];
+                }
+            }
+        }
+        m_tiles.clear();
+
+    } // endif: pixels were sparse
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns number of pixel values held in memory
+ *
+ * Returns the number of pixel values that are allocated for all maps. For
+ * dense storage this is npix()*nmaps(), for sparse storage the number of
+ * pixels in allocated tiles.
+ ***************************************************************************/
+int GSkymap::nstored(void) const
+{
+    // Initialise number of stored pixels
+    int num = 0;
+
+    // Count pixels in allocated tiles for sparse storage
+    if (m_sparse) {
+        for (int i = 0; i < m_tiles.size(); ++i) {
+            if (m_tiles[i] != NULL) {
+                num += G_SPARSE_TILE;
+            }
+        }
+    }
+
+    // ... otherwise return size of pixel array
+    else if (m_pixels != NULL) {
+        num = m_num_pixels * m_num_maps;
+    }
+
+    // Return number of stored pixels
+    return num;
+}
+
+
+/***********************************************************************//**
+ * @brief Set pixel data type for FITS output
+ *
+ * @param[in] bitpix Pixel data type (-64: double, -32: float, 32: integer).
+ *
+ * @exception GException::invalid_argument
+ *            Unsupported pixel data type specified.
+ *
+ * Sets the data type that is used when the map is written into a FITS
+ * file. Single precision or integer pixels halve the size of the FITS
+ * image or table with respect to double precision. Pixel values are
+ * rounded to the nearest integer when written as integers, and values
+ * outside the 32-bit integer range are clipped. The pixels held in memory
+ * are not affected.
+ ***************************************************************************/
+void GSkymap::bitpix(const int& bitpix)
+{
+    // Throw exception if data type is not supported
+    if (bitpix != -64 && bitpix != -32 && bitpix != 32) {
+        throw GException::invalid_argument(G_BITPIX, str(bitpix),
+              "Pixel data type must be -64 (double), -32 (float) or"
+              " 32 (integer).");
+    }
+
+    // Set data type
+    m_bitpix = bitpix;
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Verifies if sky direction falls in map
  *
@@ -1075,6 +1575,14 @@ std::string GSkymap::print(void) const
     result.append("=== GSkymap ===\n");
     result.append(parformat("Number of pixels")+str(m_num_pixels)+"\n");
     result.append(parformat("Number of maps")+str(m_num_maps));
+    if (m_bitpix != -64) {
+        result.append("\n"+parformat("FITS pixel type"));
+        result.append((m_bitpix == -32) ? "float" : "integer");
+    }
+    if (m_sparse) {
+        result.append("\n"+parformat("Sparse storage")+str(nstored()) +
+                      " pixels allocated");
+    }
     if (m_wcs != NULL && m_wcs->code() != "HPX") {
         result.append("\n"+parformat("X axis dimension")+str(m_num_x));
         result.append("\n"+parformat("Y axis dimension")+str(m_num_y));
@@ -1111,6 +1619,9 @@ void GSkymap::init_members(void)
     m_num_y      = 0;
     m_wcs        = NULL;
     m_pixels     = NULL;
+    m_bitpix     = -64;
+    m_sparse     = false;
+    m_tiles.clear();
 
     // Return
     return;
@@ -1119,14 +1630,21 @@ void GSkymap::init_members(void)
 
 /***********************************************************************//**
  * @brief Allocate skymap pixels
+ *
+ * For sparse storage, no tile is allocated.
  ***************************************************************************/
 void GSkymap::alloc_pixels(void)
 {
     // Compute data size
     int size = m_num_pixels * m_num_maps;
 
-    // Continue only if there are pixels
-    if (size > 0) {
+    // Setup unallocated tiles for sparse storage
+    if (m_sparse) {
+        m_tiles.assign(ntiles() * m_num_maps, (double*)NULL);
+    }
+
+    // ... otherwise continue only if there are pixels
+    else if (size > 0) {
 
         // Allocate pixels and initialize them to 0
         m_pixels = new double[size];
@@ -1153,6 +1671,8 @@ void GSkymap::copy_members(const GSkymap& map)
     m_num_maps   = map.m_num_maps;
     m_num_x      = map.m_num_x;
     m_num_y      = map.m_num_y;
+    m_bitpix     = map.m_bitpix;
+    m_sparse     = map.m_sparse;
 
     // Clone WCS if it is valid
     if (map.m_wcs != NULL) m_wcs = map.m_wcs->clone();
@@ -1160,8 +1680,21 @@ void GSkymap::copy_members(const GSkymap& map)
     // Compute data size
     int size = m_num_pixels * m_num_maps;
 
-    // Copy pixels
-    if (size > 0 && map.m_pixels != NULL) {
+    // Copy sparse pixels
+    if (m_sparse) {
+        m_tiles.assign(map.m_tiles.size(), (double*)NULL);
+        for (int i = 0; i < m_tiles.size(); ++i) {
+            if (map.m_tiles[i] != NULL) {
+                m_tiles[i] = new double[G_SPARSE_TILE];
+                for (int k = 0; k < G_SPARSE_TILE; ++k) {
+                    m_tiles[i][k] = map.m_tiles[i][k];
+                }
+            }
+        }
+    }
+
+    // ... otherwise copy dense pixels
+    else if (size > 0 && map.m_pixels != NULL) {
         alloc_pixels();
         for (int i = 0; i <  size; ++i) {
             m_pixels[i] = map.m_pixels[i];
@@ -1181,10 +1714,15 @@ void GSkymap::free_members(void)
     // Free memory
     if (m_wcs    != NULL) delete m_wcs;
     if (m_pixels != NULL) delete [] m_pixels;
+    for (int i = 0; i < m_tiles.size(); ++i) {
+        if (m_tiles[i] != NULL) delete [] m_tiles[i];
+    }
 
     // Signal free pointers
     m_wcs        = NULL;
     m_pixels     = NULL;
+    m_sparse     = false;
+    m_tiles.clear();
 
     // Reset number of pixels
     m_num_pixels = 0;
@@ -1197,6 +1735,93 @@ void GSkymap::free_members(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Returns number of tiles per map for sparse storage
+ ***************************************************************************/
+int GSkymap::ntiles(void) const
+{
+    // Return number of tiles
+    return (m_num_pixels + G_SPARSE_TILE - 1) / G_SPARSE_TILE;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pointer to sparse pixel
+ *
+ * @param[in] pixel Pixel index (0,1,...,m_num_pixels).
+ * @param[in] map Map index (0,1,...,m_num_maps).
+ *
+ * Returns a pointer to the pixel in sparse storage. If the tile that holds
+ * the pixel does not yet exist, it is allocated and initialised to 0.
+ *
+ * Tiles are allocated in a critical section, hence distinct pixels may be
+ * written from several threads at the same time. The tile pointer is read
+ * and written atomically, and memory is flushed so that a thread that sees
+ * the tile also sees its initialised pixels.
+ ***************************************************************************/
+double* GSkymap::sparse_pixel(const int& pixel, const int& map)
+{
+    // Get tile
+    int     itile = pixel / G_SPARSE_TILE;
+    int     index = map*ntiles() + itile;
+    double* tile;
+    #pragma omp atomic read
+    tile = m_tiles[index];
+    #pragma omp flush
+
+    // Allocate tile if it does not exist
+    if (tile == NULL) {
+        #pragma omp critical(GSkymap_tile)
+        {
+        if (m_tiles[index] == NULL) {
+
+            // Allocate and initialise tile
+            double* alloc = new double[G_SPARSE_TILE];
+            for (int i = 0; i < G_SPARSE_TILE; ++i) {
+                alloc[i] = 0.0;
+            }
+
+            // Make tile visible after it was initialised
+            #pragma omp flush
+            #pragma omp atomic write
+            m_tiles[index] = alloc;
+
+        } // endif: tile did not exist
+        tile = m_tiles[index];
+        } // end critical section
+    }
+
+    // Return pointer to pixel
+    return tile + (pixel - itile*G_SPARSE_TILE);
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pointer to sparse pixel (const variant)
+ *
+ * @param[in] pixel Pixel index (0,1,...,m_num_pixels).
+ * @param[in] map Map index (0,1,...,m_num_maps).
+ *
+ * Returns a pointer to the pixel in sparse storage, or a pointer to a
+ * constant of value 0 if the tile that holds the pixel does not exist.
+ * The tile pointer is read atomically, as tiles may be allocated by other
+ * threads (see sparse_pixel(const int&, const int&)).
+ ***************************************************************************/
+const double* GSkymap::sparse_pixel(const int& pixel, const int& map) const
+{
+    // Get tile
+    int     itile = pixel / G_SPARSE_TILE;
+    double* tile;
+    #pragma omp atomic read
+    tile = m_tiles[map*ntiles() + itile];
+    #pragma omp flush
+
+    // Return pointer to pixel
+    return (tile != NULL) ? tile + (pixel - itile*G_SPARSE_TILE)
+                          : &g_sparse_zero;
+}
+
+
 /***********************************************************************//**
  * @brief Set WCS
  *
@@ -1273,9 +1898,19 @@ void GSkymap::set_wcs(const std::string& wcs, const std::string& coords,
  * a multiple of 1024. On the other hand, vectors may also be used to store
  * several HEALPix maps into a single column. Alternatively, multiple maps
  * may be stored in multiple columns.
+ *
+ * Partial-sky maps (INDXSCHM=EXPLICIT) are read into sparse storage using
+ * read_healpix_explicit().
  ***************************************************************************/
 void GSkymap::read_healpix(const GFitsTable* hdu)
 {
+    // Read partial-sky map
+    if (hdu != NULL && hdu->hascard("INDXSCHM") &&
+        toupper(hdu->string("INDXSCHM")) == "EXPLICIT") {
+        read_healpix_explicit(hdu);
+        return;
+    }
+
     // Continue only if HDU is valid
     if (hdu != NULL) {
 
@@ -1388,6 +2023,82 @@ void GSkymap::read_healpix(const GFitsTable* hdu)
 }
 
 
+/***********************************************************************//**
+ * @brief Read partial-sky Healpix map from FITS HDU
+ *
+ * @param[in] hdu FITS HDU containing the partial-sky Healpix map.
+ *
+ * @exception GException::skymap
+ *            No PIXEL column found in table.
+ * @exception GException::out_of_range
+ *            Pixel index outside valid range.
+ *
+ * Reads a Healpix map that uses explicit pixel indexing (INDXSCHM=EXPLICIT).
+ * The pixel indices are taken from the PIXEL column, and each element of
+ * all other columns is read as one map. The map is stored in sparse
+ * storage, hence only tiles that contain pixels of the table are
+ * allocated.
+ ***************************************************************************/
+void GSkymap::read_healpix_explicit(const GFitsTable* hdu)
+{
+    // Allocate Healpix WCS and read WCS information from FITS header
+    m_wcs = new GWcsHPX;
+    m_wcs->read(hdu);
+
+    // Set number of pixels based on NSIDE parameter
+    m_num_pixels = static_cast<GWcsHPX*>(m_wcs)->npix();
+
+    // Determine pixel column and number of maps
+    int ncols  = hdu->ncols();
+    int ipixel = -1;
+    m_num_maps = 0;
+    for (int icol = 0; icol < ncols; ++icol) {
+        const GFitsTableCol* col = &(*hdu)[icol];
+        if (toupper(col->name()) == "PIXEL") {
+            ipixel = icol;
+        }
+        else {
+            m_num_maps += col->number();
+        }
+    }
+    if (ipixel < 0) {
+        throw GException::skymap(G_READ_HEALPIX_EXPLICIT,
+              "No PIXEL column found in partial-sky Healpix table.");
+    }
+
+    // Allocate sparse pixels
+    m_sparse = true;
+    alloc_pixels();
+
+    // Loop over all rows
+    const GFitsTableCol* pixels = &(*hdu)[ipixel];
+    for (int row = 0; row < hdu->nrows(); ++row) {
+
+        // Get pixel index
+        int pixel = pixels->integer(row);
+        if (pixel < 0 || pixel >= m_num_pixels) {
+            throw GException::out_of_range(G_READ_HEALPIX_EXPLICIT, pixel,
+                                           0, m_num_pixels-1);
+        }
+
+        // Set pixel values of all maps
+        int imap = 0;
+        for (int icol = 0; icol < ncols; ++icol) {
+            if (icol != ipixel) {
+                const GFitsTableCol* col = &(*hdu)[icol];
+                for (int inx = 0; inx < col->number(); ++inx, ++imap) {
+                    *sparse_pixel(pixel, imap) = col->real(row, inx);
+                }
+            }
+        }
+
+    } // endfor: looped over rows
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Read WCS image from FITS HDU
  *
@@ -1436,23 +2147,14 @@ void GSkymap::read_wcs(const GFitsImage* hdu)
         // Allocate pixels to hold the map
         alloc_pixels();
 
-        // Read image
-        if (hdu->naxis() == 2) {
-            double* ptr = m_pixels;
-            for (int iy = 0; iy < m_num_y; ++iy) {
-                for (int ix = 0; ix < m_num_x; ++ix) {
-                    *ptr++ = hdu->pixel(ix,iy);
-                }
-            }
-        }
-        else {
-            double* ptr = m_pixels;
-            for (int imap = 0; imap < m_num_maps; ++imap) {
-                for (int iy = 0; iy < m_num_y; ++iy) {
-                    for (int ix = 0; ix < m_num_x; ++ix) {
-                        *ptr++ = hdu->pixel(ix,iy,imap);
-                    }
-                }
+        // Read image plane by plane. If the image pixels have not yet been
+        // loaded from the FITS file, only the planes are read, which avoids
+        // holding a second full copy of the image in memory.
+        double* ptr = m_pixels;
+        for (int imap = 0; imap < m_num_maps; ++imap) {
+            std::vector<double> plane = hdu->plane(imap);
+            for (int i = 0; i < m_num_pixels; ++i) {
+                *ptr++ = plane[i];
             }
         }
 
@@ -1518,9 +2220,34 @@ void GSkymap::alloc_wcs(const GFitsImage* hdu)
  * @brief Create FITS HDU containing Healpix data
  *
  * This method allocates a binary table HDU that contains the Healpix data.
- * Deallocation of the table has to be done by the client.
+ * Sparse maps are written as partial-sky maps. Deallocation of the table
+ * has to be done by the client.
  ***************************************************************************/
 GFitsBinTable* GSkymap::create_healpix_hdu(void) const
+{
+    // Return partial-sky HDU for sparse maps
+    if (m_sparse) {
+        return (create_healpix_explicit_hdu());
+    }
+
+    // Return HDU with all pixels
+    return (create_healpix_hdu(0, m_num_pixels));
+}
+
+
+/***********************************************************************//**
+ * @brief Create FITS HDU containing range of Healpix pixels
+ *
+ * @param[in] first Index of first pixel.
+ * @param[in] nrows Number of pixels.
+ *
+ * This method allocates a binary table HDU that contains the Healpix
+ * pixels [first,first+nrows) of all maps. For @p nrows=0 the table holds
+ * the column definition but no rows. Deallocation of the table has to be
+ * done by the client.
+ ***************************************************************************/
+GFitsBinTable* GSkymap::create_healpix_hdu(const int& first,
+                                           const int& nrows) const
 {
     // Initialise result to NULL pointer
     GFitsBinTable* hdu = NULL;
@@ -1532,23 +2259,24 @@ GFitsBinTable* GSkymap::create_healpix_hdu(void) const
     if (size > 0) {
 
         // Set number of rows and columns
-        int rows   = m_num_pixels;
+        int rows   = nrows;
         int number = m_num_maps;
 
         // Create column to hold Healpix data
-        GFitsTableDoubleCol column = GFitsTableDoubleCol("DATA", rows, number);
+        GFitsTableCol* column = alloc_column("DATA", rows, number);
 
         // Fill data into column
-        double* ptr = m_pixels;
         for (int inx = 0; inx < number; ++inx) {
+            const double* ptr = m_pixels + inx*m_num_pixels + first;
             for (int row = 0; row < rows; ++row) {
-                column(row,inx) = *ptr++;
+                set_value(column, row, inx, *ptr++);
             }
         }
 
         // Create HDU that contains Healpix map in a binary table
         hdu = new GFitsBinTable(rows);
-        hdu->append_column(column);
+        hdu->append_column(*column);
+        delete column;
 
     } // endif: there were pixels
 
@@ -1564,6 +2292,7 @@ GFitsBinTable* GSkymap::create_healpix_hdu(void) const
     if (m_wcs != NULL) m_wcs->write(hdu);
 
     // Set additional keywords
+    hdu->card("INDXSCHM", "IMPLICIT", "Indexing: IMPLICIT or EXPLICIT");
     hdu->card("NBRBINS", m_num_maps, "Number of HEALPix maps");
 
     // Return HDU
@@ -1571,57 +2300,127 @@ GFitsBinTable* GSkymap::create_healpix_hdu(void) const
 }
 
 
+/***********************************************************************//**
+ * @brief Create FITS HDU containing partial-sky Healpix data
+ *
+ * This method allocates a binary table HDU that contains all pixels of
+ * the allocated tiles of a sparse map, using the explicit indexing scheme
+ * of partial-sky Healpix maps. The table has a PIXEL column holding the
+ * pixel indices and a DATA column holding the pixel values of all maps.
+ * Deallocation of the table has to be done by the client.
+ ***************************************************************************/
+GFitsBinTable* GSkymap::create_healpix_explicit_hdu(void) const
+{
+    // Collect tiles that are allocated in any map
+    int              ntile = ntiles();
+    std::vector<int> tiles;
+    for (int tile = 0; tile < ntile; ++tile) {
+        for (int map = 0; map < m_num_maps; ++map) {
+            if (m_tiles[map*ntile + tile] != NULL) {
+                tiles.push_back(tile);
+                break;
+            }
+        }
+    }
+
+    // Determine number of rows
+    int rows = 0;
+    for (int i = 0; i < tiles.size(); ++i) {
+        int first = tiles[i] * G_SPARSE_TILE;
+        int last  = (first + G_SPARSE_TILE < m_num_pixels)
+                    ? first + G_SPARSE_TILE : m_num_pixels;
+        rows += last - first;
+    }
+
+    // Create columns
+    GFitsTableLongCol pixel("PIXEL", rows);
+    GFitsTableCol*    data = alloc_column("DATA", rows, m_num_maps);
+
+    // Fill columns
+    int row = 0;
+    for (int i = 0; i < tiles.size(); ++i) {
+        int first = tiles[i] * G_SPARSE_TILE;
+        int last  = (first + G_SPARSE_TILE < m_num_pixels)
+                    ? first + G_SPARSE_TILE : m_num_pixels;
+        for (int pix = first; pix < last; ++pix, ++row) {
+            pixel(row) = pix;
+            for (int map = 0; map < m_num_maps; ++map) {
+                set_value(data, row, map, *sparse_pixel(pix, map));
+            }
+        }
+    }
+
+    // Create HDU that contains partial-sky map in a binary table
+    GFitsBinTable* hdu = new GFitsBinTable(rows);
+    hdu->append_column(pixel);
+    hdu->append_column(*data);
+    delete data;
+
+    // Set extension name
+    hdu->extname("HEALPIX");
+
+    // If we have WCS information then write into FITS header
+    if (m_wcs != NULL) m_wcs->write(hdu);
+
+    // Set additional keywords
+    hdu->card("INDXSCHM", "EXPLICIT", "Indexing: IMPLICIT or EXPLICIT");
+    hdu->card("OBJECT",   "PARTIAL",  "Sky coverage: FULLSKY or PARTIAL");
+    hdu->card("OBS_NPIX", rows,       "Number of pixels in table");
+    hdu->card("NBRBINS",  m_num_maps, "Number of HEALPix maps");
+
+    // Return HDU
+    return hdu;
+}
+
+
 /***********************************************************************//**
  * @brief Create FITS HDU containing WCS image
  *
  * This method allocates an image HDU that contains the WCS image data.
- * Deallocation of the image has to be done by the client.
+ * The image data type is set by the bitpix() member. Deallocation of the
+ * image has to be done by the client.
  *
  * @todo Set additional keywords.
  ***************************************************************************/
-GFitsImageDouble* GSkymap::create_wcs_hdu(void) const
+GFitsImage* GSkymap::create_wcs_hdu(void) const
 {
     // Initialise result to NULL pointer
-    GFitsImageDouble* hdu = NULL;
+    GFitsImage* hdu = NULL;
 
     // Compute size of Healpix data
     int size = m_num_pixels * m_num_maps;
 
-    // Continue only if we have pixels
-    if (size > 0) {
-
-        // Set axis parameters for image construction
-        int naxis   = (m_num_maps == 1) ? 2 : 3;
-        int naxes[] = {m_num_x, m_num_y, m_num_maps};
-
-        // Allocate image
-        hdu = new GFitsImageDouble(naxis, naxes);
+    // Set axis parameters for image construction
+    int naxis   = (m_num_maps == 1) ? 2 : 3;
+    int naxes[] = {m_num_x, m_num_y, m_num_maps};
+
+    // Allocate image of requested data type. An empty image is allocated
+    // if there are no pixels.
+    switch (m_bitpix) {
+    case -32:
+        hdu = (size > 0) ? new GFitsImageFloat(naxis, naxes)
+                         : new GFitsImageFloat;
+        break;
+    case 32:
+        hdu = (size > 0) ? new GFitsImageLong(naxis, naxes)
+                         : new GFitsImageLong;
+        break;
+    default:
+        hdu = (size > 0) ? new GFitsImageDouble(naxis, naxes)
+                         : new GFitsImageDouble;
+        break;
+    }
 
-        // Store data in image
-        if (naxis == 2) {
-            double* ptr = m_pixels;
-            for (int iy = 0; iy < m_num_y; ++iy) {
-                for (int ix = 0; ix < m_num_x; ++ix) {
-                    (*hdu)(ix,iy) = *ptr++;
-                }
-            }
-        }
-        else {
-            double* ptr = m_pixels;
-            for (int imap = 0; imap < m_num_maps; ++imap) {
-                for (int iy = 0; iy < m_num_y; ++iy) {
-                    for (int ix = 0; ix < m_num_x; ++ix) {
-                        (*hdu)(ix,iy,imap) = *ptr++;
-                    }
-                }
+    // Store pixels in image. The image pixels are ordered (x,y,map) like
+    // the skymap pixels.
+    if (size > 0) {
+        for (int imap = 0, pix = 0; imap < m_num_maps; ++imap) {
+            for (int i = 0; i < m_num_pixels; ++i, ++pix) {
+                double value = (m_sparse) ? *sparse_pixel(i, imap)
+                                          : m_pixels[pix];
+                set_value(hdu, pix, value);
             }
         }
-
-    } // endif: there were pixels
-
-    // ... otherwise create an empty header
-    else {
-        hdu = new GFitsImageDouble;
     }
 
     // Set extension name
@@ -1636,3 +2435,94 @@ GFitsImageDouble* GSkymap::create_wcs_hdu(void) const
     // Return HDU
     return hdu;
 }
+
+
+/***********************************************************************//**
+ * @brief Allocate FITS table column for pixel data
+ *
+ * @param[in] name Column name.
+ * @param[in] rows Number of rows.
+ * @param[in] number Vector size of column.
+ *
+ * Allocates a table column with the data type that is set by the bitpix()
+ * member. Deallocation of the column has to be done by the client.
+ ***************************************************************************/
+GFitsTableCol* GSkymap::alloc_column(const std::string& name,
+                                     const int&         rows,
+                                     const int&         number) const
+{
+    // Allocate column
+    GFitsTableCol* column = NULL;
+    switch (m_bitpix) {
+    case -32:
+        column = new GFitsTableFloatCol(name, rows, number);
+        break;
+    case 32:
+        column = new GFitsTableLongCol(name, rows, number);
+        break;
+    default:
+        column = new GFitsTableDoubleCol(name, rows, number);
+        break;
+    }
+
+    // Return column
+    return column;
+}
+
+
+/***********************************************************************//**
+ * @brief Set pixel value in FITS table column
+ *
+ * @param[in] column Table column allocated by alloc_column().
+ * @param[in] row Table row.
+ * @param[in] inx Vector index in row.
+ * @param[in] value Pixel value.
+ ***************************************************************************/
+void GSkymap::set_value(GFitsTableCol* column, const int& row,
+                        const int& inx, const double& value) const
+{
+    // Set value according to column data type
+    switch (m_bitpix) {
+    case -32:
+        (*static_cast<GFitsTableFloatCol*>(column))(row, inx) = float(value);
+        break;
+    case 32:
+        (*static_cast<GFitsTableLongCol*>(column))(row, inx) =
+                                                           integer(value);
+        break;
+    default:
+        (*static_cast<GFitsTableDoubleCol*>(column))(row, inx) = value;
+        break;
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Set pixel value in FITS image
+ *
+ * @param[in] image Image allocated by create_wcs_hdu().
+ * @param[in] pix Linear pixel index in image.
+ * @param[in] value Pixel value.
+ ***************************************************************************/
+void GSkymap::set_value(GFitsImage* image, const int& pix,
+                        const double& value) const
+{
+    // Set value according to image data type
+    switch (m_bitpix) {
+    case -32:
+        (*static_cast<GFitsImageFloat*>(image))(pix) = float(value);
+        break;
+    case 32:
+        (*static_cast<GFitsImageLong*>(image))(pix) = integer(value);
+        break;
+    default:
+        (*static_cast<GFitsImageDouble*>(image))(pix) = value;
+        break;
+    }
+
+    // Return
+    return;
+}
@@ -214,6 +214,129 @@ void GWcs::coordsys(const std::string& coordsys)
 }
 
 
+/***********************************************************************//**
+ * @brief Returns sky coordinates of pixels
+ *
+ * @param[in] num Number of pixels.
+ * @param[in] pix Pixel indices [num].
+ * @param[out] lon Longitudes in the WCS coordinate system (deg) [num].
+ * @param[out] lat Latitudes in the WCS coordinate system (deg) [num].
+ *
+ * Converts an array of 1D pixel indices into longitudes and latitudes. The
+ * coordinates are Right Ascension and Declination for equatorial systems,
+ * and Galactic longitude and latitude otherwise.
+ *
+ * This default implementation calls pix2dir(const int&) for each pixel.
+ * Derived classes should overload the method if they can transform many
+ * coordinates more efficiently.
+ ***************************************************************************/
+void GWcs::pix2dir(const int& num, const int* pix,
+                   double* lon, double* lat) const
+{
+    // Transform pixels
+    for (int i = 0; i < num; ++i) {
+        GSkyDir dir = pix2dir(pix[i]);
+        lon[i] = (m_coordsys == 0) ? dir.ra_deg()  : dir.l_deg();
+        lat[i] = (m_coordsys == 0) ? dir.dec_deg() : dir.b_deg();
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixel indices of sky coordinates
+ *
+ * @param[in] num Number of coordinates.
+ * @param[in] lon Longitudes in the WCS coordinate system (deg) [num].
+ * @param[in] lat Latitudes in the WCS coordinate system (deg) [num].
+ * @param[out] pix Pixel indices [num].
+ *
+ * Converts arrays of longitudes and latitudes into 1D pixel indices. This
+ * default implementation calls dir2pix(const GSkyDir&) for each coordinate.
+ ***************************************************************************/
+void GWcs::dir2pix(const int& num, const double* lon, const double* lat,
+                   int* pix) const
+{
+    // Transform coordinates
+    GSkyDir dir;
+    for (int i = 0; i < num; ++i) {
+        if (m_coordsys == 0) {
+            dir.radec_deg(lon[i], lat[i]);
+        }
+        else {
+            dir.lb_deg(lon[i], lat[i]);
+        }
+        pix[i] = dir2pix(dir);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns sky coordinates of 2D pixels
+ *
+ * @param[in] num Number of pixels.
+ * @param[in] x Pixel x values [num].
+ * @param[in] y Pixel y values [num].
+ * @param[out] lon Longitudes in the WCS coordinate system (deg) [num].
+ * @param[out] lat Latitudes in the WCS coordinate system (deg) [num].
+ *
+ * Converts arrays of 2D pixel values into longitudes and latitudes. This
+ * default implementation calls xy2dir(const GSkyPixel&) for each pixel.
+ ***************************************************************************/
+void GWcs::xy2dir(const int& num, const double* x, const double* y,
+                  double* lon, double* lat) const
+{
+    // Transform pixels
+    for (int i = 0; i < num; ++i) {
+        GSkyDir dir = xy2dir(GSkyPixel(x[i], y[i]));
+        lon[i] = (m_coordsys == 0) ? dir.ra_deg()  : dir.l_deg();
+        lat[i] = (m_coordsys == 0) ? dir.dec_deg() : dir.b_deg();
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns 2D pixels of sky coordinates
+ *
+ * @param[in] num Number of coordinates.
+ * @param[in] lon Longitudes in the WCS coordinate system (deg) [num].
+ * @param[in] lat Latitudes in the WCS coordinate system (deg) [num].
+ * @param[out] x Pixel x values [num].
+ * @param[out] y Pixel y values [num].
+ *
+ * Converts arrays of longitudes and latitudes into 2D pixel values. This
+ * default implementation calls dir2xy(const GSkyDir&) for each coordinate.
+ ***************************************************************************/
+void GWcs::dir2xy(const int& num, const double* lon, const double* lat,
+                  double* x, double* y) const
+{
+    // Transform coordinates
+    GSkyDir dir;
+    for (int i = 0; i < num; ++i) {
+        if (m_coordsys == 0) {
+            dir.radec_deg(lon[i], lat[i]);
+        }
+        else {
+            dir.lb_deg(lon[i], lat[i]);
+        }
+        GSkyPixel pixel = dir2xy(dir);
+        x[i] = pixel.x();
+        y[i] = pixel.y();
+    }
+
+    // Return
+    return;
+}
+
+
 /*==========================================================================
  =                                                                         =
  =                            Protected methods                            =
@@ -29,6 +29,7 @@
 #include <config.h>
 #endif
 #include <cmath>
+#include <algorithm>
 #include "GException.hpp"
 #include "GTools.hpp"
 #include "GWcsHPX.hpp"
@@ -42,6 +43,12 @@
 #define G_PIX2ANG_RING           "GWcsHPX::pix2ang_ring(int,double*,double*)"
 #define G_PIX2ANG_NEST           "GWcsHPX::pix2ang_nest(int,double*,double*)"
 #define G_ORDERING_SET                       "GWcsHPX::coordsys(std::string)"
+#define G_QUERY_POLYGON        "GWcsHPX::query_polygon(std::vector<GSkyDir>&)"
+#define G_NEIGHBOURS                             "GWcsHPX::neighbours(int&)"
+#define G_RING2NEST                               "GWcsHPX::ring2nest(int&)"
+#define G_NEST2RING                               "GWcsHPX::nest2ring(int&)"
+#define G_PARENT                                "GWcsHPX::parent(int&,int&)"
+#define G_CHILDREN                            "GWcsHPX::children(int&,int&)"
 
 /* __ Macros _____________________________________________________________ */
 
@@ -56,6 +63,29 @@ const int jrll[12]  = {2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4};
 const int jpll[12]  = {1, 3, 5, 7, 0, 2, 4, 6, 1, 3, 5, 7};
 const int order_max = 13;
 const int ns_max    = 1 << order_max;
+const int max_table = 12 * 512 * 512;  // Maximum size of ring/nest tables
+
+/* __ Neighbour lookup tables (adapted from HEALPix 2.1) _________________ */
+const int nb_xoffset[8]      = {-1,-1, 0, 1, 1, 1, 0,-1};
+const int nb_yoffset[8]      = { 0, 1, 1, 1, 0,-1,-1,-1};
+const int nb_facearray[9][12] = {{ 8, 9,10,11,-1,-1,-1,-1,10,11, 8, 9},  // S
+                                 { 5, 6, 7, 4, 8, 9,10,11, 9,10,11, 8},  // SE
+                                 {-1,-1,-1,-1, 5, 6, 7, 4,-1,-1,-1,-1},  // E
+                                 { 4, 5, 6, 7,11, 8, 9,10,11, 8, 9,10},  // SW
+                                 { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11},  // center
+                                 { 1, 2, 3, 0, 0, 1, 2, 3, 5, 6, 7, 4},  // NE
+                                 {-1,-1,-1,-1, 7, 4, 5, 6,-1,-1,-1,-1},  // W
+                                 { 3, 0, 1, 2, 3, 0, 1, 2, 4, 5, 6, 7},  // NW
+                                 { 2, 3, 0, 1,-1,-1,-1,-1, 0, 1, 2, 3}}; // N
+const int nb_swaparray[9][3]  = {{0,0,3},  // S
+                                 {0,0,6},  // SE
+                                 {0,0,0},  // E
+                                 {0,0,5},  // SW
+                                 {0,0,0},  // center
+                                 {5,0,0},  // NE
+                                 {0,0,0},  // W
+                                 {6,0,0},  // NW
+                                 {3,0,0}}; // N
 
 /* __ Static conversion arrays ___________________________________________ */
 static short ctab[0x100];
@@ -459,6 +489,77 @@ int GWcsHPX::dir2pix(const GSkyDir& dir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Returns sky coordinates of pixels
+ *
+ * @param[in] num Number of pixels.
+ * @param[in] pix Pixel indices [num].
+ * @param[out] lon Longitudes in the WCS coordinate system (deg) [num].
+ * @param[out] lat Latitudes in the WCS coordinate system (deg) [num].
+ ***************************************************************************/
+void GWcsHPX::pix2dir(const int& num, const int* pix,
+                      double* lon, double* lat) const
+{
+    // Transform pixels
+    for (int i = 0; i < num; ++i) {
+
+        // Perform ordering dependent conversion
+        double theta = 0.0;
+        double phi   = 0.0;
+        if (m_ordering == 0) {
+            pix2ang_ring(pix[i], &theta, &phi);
+        }
+        else if (m_ordering == 1) {
+            pix2ang_nest(pix[i], &theta, &phi);
+        }
+
+        // Store coordinates
+        lon[i] = phi * rad2deg;
+        lat[i] = (pihalf-theta) * rad2deg;
+
+    } // endfor: looped over pixels
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixel indices of sky coordinates
+ *
+ * @param[in] num Number of coordinates.
+ * @param[in] lon Longitudes in the WCS coordinate system (deg) [num].
+ * @param[in] lat Latitudes in the WCS coordinate system (deg) [num].
+ * @param[out] pix Pixel indices [num].
+ ***************************************************************************/
+void GWcsHPX::dir2pix(const int& num, const double* lon, const double* lat,
+                      int* pix) const
+{
+    // Transform coordinates
+    for (int i = 0; i < num; ++i) {
+
+        // Compute (z,phi)
+        double z   = cos(pihalf-lat[i]*deg2rad);
+        double phi = lon[i] * deg2rad;
+
+        // Perform ordering dependent conversion
+        if (m_ordering == 0) {
+            pix[i] = ang2pix_z_phi_ring(z, phi);
+        }
+        else if (m_ordering == 1) {
+            pix[i] = ang2pix_z_phi_nest(z, phi);
+        }
+        else {
+            pix[i] = 0;
+        }
+
+    } // endfor: looped over coordinates
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Returns sky direction of pixel
  *
@@ -585,6 +686,438 @@ void GWcsHPX::ordering(const std::string& ordering)
 }
 
 
+/***********************************************************************//**
+ * @brief Returns pixels with centres inside a disc
+ *
+ * @param[in] dir Centre of disc.
+ * @param[in] radius Radius of disc (radians).
+ * @param[in] inclusive Return all pixels that overlap with the disc.
+ * @return Sorted pixel indices.
+ *
+ * Returns the indices of all pixels whose centres lie within the specified
+ * disc. Only the rings that intersect with the disc are visited, and for
+ * each ring the range of pixels within the disc is computed analytically,
+ * hence the computing time scales with the number of returned pixels and
+ * not with npix().
+ *
+ * If @p inclusive is true, the radius is enlarged by the maximum pixel
+ * radius, so that all pixels that overlap with the disc are returned. The
+ * result may then also contain some pixels close to the disc that do not
+ * overlap with it.
+ ***************************************************************************/
+std::vector<int> GWcsHPX::query_disc(const GSkyDir& dir, const double& radius,
+                                     const bool& inclusive) const
+{
+    // Initialise result
+    std::vector<int> pixels;
+
+    // Continue only if we have pixels
+    if (m_num_pixels > 0) {
+
+        // Enlarge radius by maximum pixel radius for inclusive queries
+        double rad = radius;
+        if (inclusive) {
+            double t1   = 1.0 - 1.0/double(m_nside);
+            t1         *= t1;
+            double za   = 2.0/3.0;
+            double zb   = 1.0 - t1/3.0;
+            double phia = pi/(4.0*double(m_nside));
+            double cosd = za*zb + std::sqrt((1.0-za*za)*(1.0-zb*zb)) *
+                          std::cos(phia);
+            rad += arccos(cosd);
+        }
+
+        // Get disc centre in the coordinate system of the map
+        double vec[3];
+        dir2vec(dir, vec);
+        double theta = arccos(vec[2]);
+        double phi   = modulo(std::atan2(vec[1], vec[0]), twopi);
+
+        // Collect pixels in RING ordering
+        query_ring(theta, phi, rad, pixels);
+
+        // Convert to NESTED ordering if required
+        if (m_ordering == 1 && !pixels.empty()) {
+            ring2nest(pixels.size(), &pixels[0], &pixels[0]);
+            std::sort(pixels.begin(), pixels.end());
+        }
+
+    } // endif: there were pixels
+
+    // Return pixels
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixels with centres inside a convex polygon
+ *
+ * @param[in] vertices Vertices of convex polygon.
+ * @return Sorted pixel indices.
+ *
+ * @exception GException::invalid_argument
+ *            Less than three vertices specified.
+ *
+ * Returns the indices of all pixels whose centres lie within the convex
+ * spherical polygon with the specified vertices. The polygon edges are
+ * great circles. The vertices may be given in clockwise or anti-clockwise
+ * order. Only the pixels within the disc enclosing the polygon are tested.
+ ***************************************************************************/
+std::vector<int> GWcsHPX::query_polygon(const std::vector<GSkyDir>& vertices) const
+{
+    // Check number of vertices
+    int nv = vertices.size();
+    if (nv < 3) {
+        throw GException::invalid_argument(G_QUERY_POLYGON,
+              "At least three vertices are required, "+str(nv)+" given.");
+    }
+
+    // Get vertex unit vectors and their mean
+    std::vector<double> vec(3*nv);
+    double              centre[3] = {0.0, 0.0, 0.0};
+    for (int i = 0; i < nv; ++i) {
+        dir2vec(vertices[i], &vec[3*i]);
+        centre[0] += vec[3*i];
+        centre[1] += vec[3*i+1];
+        centre[2] += vec[3*i+2];
+    }
+    double norm = std::sqrt(centre[0]*centre[0] + centre[1]*centre[1] +
+                            centre[2]*centre[2]);
+    if (norm > 0.0) {
+        centre[0] /= norm;
+        centre[1] /= norm;
+        centre[2] /= norm;
+    }
+
+    // Compute edge normals and radius of enclosing disc
+    std::vector<double> normal(3*nv);
+    double              cosrad = 1.0;
+    for (int i = 0; i < nv; ++i) {
+        const double* a = &vec[3*i];
+        const double* b = &vec[3*((i+1) % nv)];
+        normal[3*i]   = a[1]*b[2] - a[2]*b[1];
+        normal[3*i+1] = a[2]*b[0] - a[0]*b[2];
+        normal[3*i+2] = a[0]*b[1] - a[1]*b[0];
+        double cosd   = a[0]*centre[0] + a[1]*centre[1] + a[2]*centre[2];
+        if (cosd < cosrad) {
+            cosrad = cosd;
+        }
+    }
+
+    // Orient edge normals towards the polygon interior
+    const double* c    = &vec[6];
+    double        sign = (normal[0]*c[0] + normal[1]*c[1] + normal[2]*c[2] < 0.0)
+                         ? -1.0 : 1.0;
+
+    // Collect pixels within enclosing disc
+    std::vector<int> candidates;
+    query_ring(arccos(centre[2]), modulo(std::atan2(centre[1], centre[0]), twopi),
+               arccos(cosrad), candidates);
+
+    // Keep pixels whose centres are on the inner side of all edges
+    std::vector<int> pixels;
+    pixels.reserve(candidates.size());
+    for (int k = 0; k < candidates.size(); ++k) {
+        double theta;
+        double phi;
+        pix2ang_ring(candidates[k], &theta, &phi);
+        double sintheta = std::sin(theta);
+        double p[3]     = {sintheta*std::cos(phi), sintheta*std::sin(phi),
+                           std::cos(theta)};
+        bool inside = true;
+        for (int i = 0; i < nv; ++i) {
+            const double* n = &normal[3*i];
+            if (sign * (n[0]*p[0] + n[1]*p[1] + n[2]*p[2]) < 0.0) {
+                inside = false;
+                break;
+            }
+        }
+        if (inside) {
+            pixels.push_back(candidates[k]);
+        }
+    }
+
+    // Convert to NESTED ordering if required
+    if (m_ordering == 1 && !pixels.empty()) {
+        ring2nest(pixels.size(), &pixels[0], &pixels[0]);
+        std::sort(pixels.begin(), pixels.end());
+    }
+
+    // Return pixels
+    return pixels;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns neighbours of a pixel
+ *
+ * @param[in] pix Pixel index.
+ * @return Indices of the 8 neighbours (SW, W, NW, N, NE, E, SE, S).
+ *
+ * @exception GException::out_of_range
+ *            Pixel index is out of range.
+ *
+ * Returns the indices of the 8 neighbouring pixels in the ordering of the
+ * map. Pixels at the corners of the base faces have only 7 neighbours; the
+ * missing neighbour is set to -1.
+ ***************************************************************************/
+std::vector<int> GWcsHPX::neighbours(const int& pix) const
+{
+    // Check if pixel is in range
+    if (pix < 0 || pix >= m_num_pixels) {
+        throw GException::out_of_range(G_NEIGHBOURS, pix, 0, m_num_pixels-1);
+    }
+
+    // Initialise result
+    std::vector<int> result(8, -1);
+
+    // Get face coordinates of pixel
+    int ix;
+    int iy;
+    int face;
+    if (m_ordering == 0) {
+        ring2xyf(pix, &ix, &iy, &face);
+    }
+    else {
+        nest2xyf(pix, &ix, &iy, &face);
+    }
+
+    // Determine neighbours
+    for (int i = 0; i < 8; ++i) {
+
+        // Get face coordinates of neighbour
+        int x  = ix + nb_xoffset[i];
+        int y  = iy + nb_yoffset[i];
+        int nb = 4;
+        if (x < 0) {
+            x  += m_nside;
+            nb -= 1;
+        }
+        else if (x >= m_nside) {
+            x  -= m_nside;
+            nb += 1;
+        }
+        if (y < 0) {
+            y  += m_nside;
+            nb -= 3;
+        }
+        else if (y >= m_nside) {
+            y  -= m_nside;
+            nb += 3;
+        }
+
+        // Set neighbour if it exists, swapping coordinates if it lies on
+        // another base face
+        int f = nb_facearray[nb][face];
+        if (f >= 0) {
+            int bits = nb_swaparray[nb][face>>2];
+            if (bits & 1) {
+                x = m_nside - x - 1;
+            }
+            if (bits & 2) {
+                y = m_nside - y - 1;
+            }
+            if (bits & 4) {
+                std::swap(x, y);
+            }
+            result[i] = (m_ordering == 0) ? xyf2ring(x, y, f)
+                                          : xyf2nest(x, y, f);
+        }
+
+    } // endfor: looped over neighbours
+
+    // Return neighbours
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Converts RING pixel index into NESTED pixel index
+ *
+ * @param[in] pix Pixel index in RING ordering.
+ * @return Pixel index in NESTED ordering.
+ *
+ * @exception GException::out_of_range
+ *            Pixel index is out of range.
+ ***************************************************************************/
+int GWcsHPX::ring2nest(const int& pix) const
+{
+    // Check if pixel is in range
+    if (pix < 0 || pix >= m_num_pixels) {
+        throw GException::out_of_range(G_RING2NEST, pix, 0, m_num_pixels-1);
+    }
+
+    // Return nested index
+    if (set_tables()) {
+        return m_ring2nest[pix];
+    }
+    int ix;
+    int iy;
+    int face;
+    ring2xyf(pix, &ix, &iy, &face);
+    return xyf2nest(ix, iy, face);
+}
+
+
+/***********************************************************************//**
+ * @brief Converts NESTED pixel index into RING pixel index
+ *
+ * @param[in] pix Pixel index in NESTED ordering.
+ * @return Pixel index in RING ordering.
+ *
+ * @exception GException::out_of_range
+ *            Pixel index is out of range.
+ ***************************************************************************/
+int GWcsHPX::nest2ring(const int& pix) const
+{
+    // Check if pixel is in range
+    if (pix < 0 || pix >= m_num_pixels) {
+        throw GException::out_of_range(G_NEST2RING, pix, 0, m_num_pixels-1);
+    }
+
+    // Return ring index
+    if (set_tables()) {
+        return m_nest2ring[pix];
+    }
+    int ix;
+    int iy;
+    int face;
+    nest2xyf(pix, &ix, &iy, &face);
+    return xyf2ring(ix, iy, face);
+}
+
+
+/***********************************************************************//**
+ * @brief Converts RING pixel indices into NESTED pixel indices
+ *
+ * @param[in] num Number of pixels.
+ * @param[in] ring Pixel indices in RING ordering [num].
+ * @param[out] nest Pixel indices in NESTED ordering [num].
+ *
+ * The input and output arrays may be identical.
+ ***************************************************************************/
+void GWcsHPX::ring2nest(const int& num, const int* ring, int* nest) const
+{
+    // Convert pixels
+    for (int i = 0; i < num; ++i) {
+        nest[i] = ring2nest(ring[i]);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Converts NESTED pixel indices into RING pixel indices
+ *
+ * @param[in] num Number of pixels.
+ * @param[in] nest Pixel indices in NESTED ordering [num].
+ * @param[out] ring Pixel indices in RING ordering [num].
+ *
+ * The input and output arrays may be identical.
+ ***************************************************************************/
+void GWcsHPX::nest2ring(const int& num, const int* nest, int* ring) const
+{
+    // Convert pixels
+    for (int i = 0; i < num; ++i) {
+        ring[i] = nest2ring(nest[i]);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixel of lower resolution that contains a pixel
+ *
+ * @param[in] pix Pixel index.
+ * @param[in] nside Resolution of parent pixel (<= nside()).
+ * @return Index of parent pixel.
+ *
+ * @exception GException::out_of_range
+ *            Pixel index is out of range.
+ * @exception GException::wcs_hpx_bad_nside
+ *            Invalid or too large nside parameter.
+ *
+ * Pixel and parent index are both in the ordering of the map. In NESTED
+ * ordering, the parent is obtained by discarding the low-order bits of the
+ * pixel index.
+ ***************************************************************************/
+int GWcsHPX::parent(const int& pix, const int& nside) const
+{
+    // Check arguments
+    if (pix < 0 || pix >= m_num_pixels) {
+        throw GException::out_of_range(G_PARENT, pix, 0, m_num_pixels-1);
+    }
+    int order = nside2order(nside);
+    if (order < 0 || order > m_order) {
+        throw GException::wcs_hpx_bad_nside(G_PARENT, nside);
+    }
+
+    // Get nested parent index
+    int nest   = (m_ordering == 0) ? ring2nest(pix) : pix;
+    int result = nest >> (2*(m_order-order));
+
+    // Convert to RING ordering if required
+    if (m_ordering == 0) {
+        GWcsHPX wcs(nside, "RING", coordsys());
+        result = wcs.nest2ring(result);
+    }
+
+    // Return parent
+    return result;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixels of higher resolution that are contained in a pixel
+ *
+ * @param[in] pix Pixel index.
+ * @param[in] nside Resolution of children (>= nside()).
+ * @return Indices of child pixels.
+ *
+ * @exception GException::out_of_range
+ *            Pixel index is out of range.
+ * @exception GException::wcs_hpx_bad_nside
+ *            Invalid or too small nside parameter.
+ *
+ * Pixel and child indices are both in the ordering of the map. In NESTED
+ * ordering, the children form a contiguous range of pixel indices.
+ ***************************************************************************/
+std::vector<int> GWcsHPX::children(const int& pix, const int& nside) const
+{
+    // Check arguments
+    if (pix < 0 || pix >= m_num_pixels) {
+        throw GException::out_of_range(G_CHILDREN, pix, 0, m_num_pixels-1);
+    }
+    int order = nside2order(nside);
+    if (order < m_order) {
+        throw GException::wcs_hpx_bad_nside(G_CHILDREN, nside);
+    }
+
+    // Set contiguous range of nested children
+    int              nest  = (m_ordering == 0) ? ring2nest(pix) : pix;
+    int              shift = 2*(order-m_order);
+    int              num   = 1 << shift;
+    std::vector<int> result(num);
+    for (int i = 0; i < num; ++i) {
+        result[i] = (nest << shift) + i;
+    }
+
+    // Convert to RING ordering if required
+    if (m_ordering == 0) {
+        GWcsHPX wcs(nside, "RING", coordsys());
+        wcs.nest2ring(num, &result[0], &result[0]);
+        std::sort(result.begin(), result.end());
+    }
+
+    // Return children
+    return result;
+}
+
+
 /***********************************************************************//**
  * @brief Print WCS information
  ***************************************************************************/
@@ -631,6 +1164,9 @@ void GWcsHPX::init_members(void)
     m_fact1       = 0.0;
     m_fact2       = 0.0;
     m_omega       = 0.0;
+    m_has_tables  = false;
+    m_ring2nest.clear();
+    m_nest2ring.clear();
 
     // Construct conversion arrays
     for (int m = 0; m < 0x100; ++m) {
@@ -665,6 +1201,9 @@ void GWcsHPX::copy_members(const GWcsHPX& wcs)
     m_fact2      = wcs.m_fact2;
     m_omega      = wcs.m_omega;
 
+    // Note that ring/nest conversion tables are not copied, they are
+    // recomputed on demand
+
     // Return
     return;
 }
@@ -714,7 +1253,7 @@ bool GWcsHPX::compare(const GWcs& wcs) const
  *
  * @param[in] nside Number of sides.
  ***************************************************************************/
-int GWcsHPX::nside2order(int nside)
+int GWcsHPX::nside2order(int nside) const
 {
     // Initialise order
     int order = -1;
@@ -1013,6 +1552,398 @@ unsigned int GWcsHPX::isqrt(unsigned int arg) const
 }
 
 
+/***********************************************************************//**
+ * @brief Returns ring that lies just north of a given z
+ *
+ * @param[in] z Cosine of zenith angle.
+ * @return Ring number (0 if z lies north of the first ring).
+ ***************************************************************************/
+int GWcsHPX::ring_above(const double& z) const
+{
+    // Equatorial region
+    double az = std::abs(z);
+    if (az <= twothird) {
+        return int(m_nside*(2.0-1.5*z));
+    }
+
+    // Polar caps
+    int iring = int(m_nside*std::sqrt(3.0*(1.0-az)));
+    return (z > 0.0) ? iring : 4*m_nside-iring-1;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns cosine of zenith angle of a ring
+ *
+ * @param[in] ring Ring number (1,...,4*nside-1).
+ ***************************************************************************/
+double GWcsHPX::ring2z(const int& ring) const
+{
+    // North polar cap
+    if (ring < m_nside) {
+        return 1.0 - ring*ring*m_fact2;
+    }
+
+    // Equatorial region
+    if (ring <= 3*m_nside) {
+        return (2*m_nside-ring)*m_fact1;
+    }
+
+    // South polar cap
+    int nr = 4*m_nside - ring;
+    return nr*nr*m_fact2 - 1.0;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns pixel information of a ring
+ *
+ * @param[in] ring Ring number (1,...,4*nside-1).
+ * @param[out] startpix First pixel of ring in RING ordering.
+ * @param[out] ringpix Number of pixels in ring.
+ * @param[out] shifted True if pixel centres are shifted by half a pixel.
+ ***************************************************************************/
+void GWcsHPX::ring_info(const int& ring, int* startpix, int* ringpix,
+                        bool* shifted) const
+{
+    // North polar cap
+    if (ring < m_nside) {
+        *shifted  = true;
+        *ringpix  = 4*ring;
+        *startpix = 2*ring*(ring-1);
+    }
+
+    // Equatorial region
+    else if (ring < 3*m_nside) {
+        *shifted  = ((ring-m_nside) & 1) == 0;
+        *ringpix  = 4*m_nside;
+        *startpix = m_ncap + (ring-m_nside)*(*ringpix);
+    }
+
+    // South polar cap
+    else {
+        int nr    = 4*m_nside - ring;
+        *shifted  = true;
+        *ringpix  = 4*nr;
+        *startpix = m_num_pixels - 2*nr*(nr+1);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convert RING pixel index to face coordinates
+ *
+ * @param[in] pix Pixel index in RING ordering.
+ * @param[out] ix x coordinate within face.
+ * @param[out] iy y coordinate within face.
+ * @param[out] face Face number (0,...,11).
+ ***************************************************************************/
+void GWcsHPX::ring2xyf(const int& pix, int* ix, int* iy, int* face) const
+{
+    // Declare ring coordinates
+    int iring;
+    int iphi;
+    int kshift;
+    int nr;
+    int nl2 = 2*m_nside;
+
+    // North polar cap
+    if (pix < m_ncap) {
+        iring  = (1+isqrt(1+2*pix)) >> 1;
+        iphi   = (pix+1) - 2*iring*(iring-1);
+        kshift = 0;
+        nr     = iring;
+        *face  = (iphi-1)/nr;
+    }
+
+    // Equatorial region
+    else if (pix < (m_num_pixels-m_ncap)) {
+        int ip  = pix - m_ncap;
+        int tmp = ip >> (m_order+2);
+        iring   = tmp + m_nside;
+        iphi    = ip - tmp*4*m_nside + 1;
+        kshift  = (iring+m_nside) & 1;
+        nr      = m_nside;
+        int ire = iring - m_nside + 1;
+        int irm = nl2 + 2 - ire;
+        int ifm = (iphi - ire/2 + m_nside - 1) >> m_order;
+        int ifp = (iphi - irm/2 + m_nside - 1) >> m_order;
+        *face   = (ifp == ifm) ? (ifp|4) : ((ifp < ifm) ? ifp : (ifm+8));
+    }
+
+    // South polar cap
+    else {
+        int ip = m_num_pixels - pix;
+        iring  = (1+isqrt(2*ip-1)) >> 1;
+        iphi   = 4*iring + 1 - (ip - 2*iring*(iring-1));
+        kshift = 0;
+        nr     = iring;
+        iring  = 2*nl2 - iring;
+        *face  = (iphi-1)/nr + 8;
+    }
+
+    // Compute face coordinates
+    int irt = iring - ((2+(*face>>2))*m_nside) + 1;
+    int ipt = 2*iphi - jpll[*face]*nr - kshift - 1;
+    if (ipt >= nl2) {
+        ipt -= 8*m_nside;
+    }
+    *ix = ( ipt-irt) >> 1;
+    *iy = (-ipt-irt) >> 1;
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convert face coordinates to RING pixel index
+ *
+ * @param[in] ix x coordinate within face.
+ * @param[in] iy y coordinate within face.
+ * @param[in] face Face number (0,...,11).
+ ***************************************************************************/
+int GWcsHPX::xyf2ring(const int& ix, const int& iy, const int& face) const
+{
+    // Get ring number and ring information
+    int  jr = (jrll[face]*m_nside) - ix - iy - 1;
+    int  startpix;
+    int  nr;
+    bool shifted;
+    ring_info(jr, &startpix, &nr, &shifted);
+    nr >>= 2;
+
+    // Get pixel index in ring
+    int kshift = 1 - int(shifted);
+    int jp     = (jpll[face]*nr + ix - iy + 1 + kshift) / 2;
+    if (jp < 1) {
+        jp += 4*m_nside;
+    }
+
+    // Return pixel index
+    return startpix + jp - 1;
+}
+
+
+/***********************************************************************//**
+ * @brief Convert NESTED pixel index to face coordinates
+ *
+ * @param[in] pix Pixel index in NESTED ordering.
+ * @param[out] ix x coordinate within face.
+ * @param[out] iy y coordinate within face.
+ * @param[out] face Face number (0,...,11).
+ ***************************************************************************/
+void GWcsHPX::nest2xyf(const int& pix, int* ix, int* iy, int* face) const
+{
+    // Get face and coordinates
+    *face = pix >> (2*m_order);
+    pix2xy(pix & (m_npface-1), ix, iy);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Convert face coordinates to NESTED pixel index
+ *
+ * @param[in] ix x coordinate within face.
+ * @param[in] iy y coordinate within face.
+ * @param[in] face Face number (0,...,11).
+ ***************************************************************************/
+int GWcsHPX::xyf2nest(const int& ix, const int& iy, const int& face) const
+{
+    // Return pixel index
+    return (face << (2*m_order)) + xy2pix(ix, iy);
+}
+
+
+/***********************************************************************//**
+ * @brief Returns unit vector of sky direction in map coordinate system
+ *
+ * @param[in] dir Sky direction.
+ * @param[out] vec Unit vector [3].
+ ***************************************************************************/
+void GWcsHPX::dir2vec(const GSkyDir& dir, double* vec) const
+{
+    // Get coordinate system dependent longitude and latitude
+    double lon = (m_coordsys == 1) ? dir.l() : dir.ra();
+    double lat = (m_coordsys == 1) ? dir.b() : dir.dec();
+
+    // Set vector
+    double coslat = std::cos(lat);
+    vec[0] = coslat * std::cos(lon);
+    vec[1] = coslat * std::sin(lon);
+    vec[2] = std::sin(lat);
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Appends RING pixels with centres inside a disc
+ *
+ * @param[in] theta Zenith angle of disc centre (radians).
+ * @param[in] phi Azimuth angle of disc centre [0,2pi[ (radians).
+ * @param[in] radius Radius of disc (radians).
+ * @param[out] pixels Sorted pixel indices in RING ordering.
+ *
+ * Implements the HEALPix disc query by computing for each ring that
+ * intersects with the disc the azimuth range that is covered by the disc.
+ ***************************************************************************/
+void GWcsHPX::query_ring(const double& theta, const double& phi,
+                         const double& radius, std::vector<int>& pixels) const
+{
+    // Clear pixels
+    pixels.clear();
+
+    // If the disc covers the full sphere then return all pixels
+    if (radius >= pi) {
+        pixels.resize(m_num_pixels);
+        for (int i = 0; i < m_num_pixels; ++i) {
+            pixels[i] = i;
+        }
+        return;
+    }
+
+    // Setup disc parameters
+    double z0     = std::cos(theta);
+    double xa     = 1.0 / std::sqrt((1.0-z0)*(1.0+z0));
+    double cosrad = std::cos(radius);
+
+    // Add all rings north of disc if disc covers the North pole
+    double rlat1 = theta - radius;
+    int    irmin = ring_above(std::cos(rlat1)) + 1;
+    if (rlat1 <= 0.0 && irmin > 1) {
+        int  startpix;
+        int  ringpix;
+        bool shifted;
+        ring_info(irmin-1, &startpix, &ringpix, &shifted);
+        for (int i = 0; i < startpix+ringpix; ++i) {
+            pixels.push_back(i);
+        }
+    }
+
+    // Loop over all rings that intersect with the disc
+    double rlat2 = theta + radius;
+    int    irmax = ring_above(std::cos(rlat2));
+    for (int iz = irmin; iz <= irmax; ++iz) {
+
+        // Compute azimuth range covered by disc
+        double z    = ring2z(iz);
+        double x    = (cosrad - z*z0) * xa;
+        double ysq  = 1.0 - z*z - x*x;
+        double dphi = (ysq <= 0.0) ? 0.0 : std::atan2(std::sqrt(ysq), x);
+
+        // Add pixels of the ring within the azimuth range
+        if (dphi > 0.0) {
+            int  ipix1;
+            int  nr;
+            bool shifted;
+            ring_info(iz, &ipix1, &nr, &shifted);
+            double shift = (shifted) ? 0.5 : 0.0;
+            int    ipix2 = ipix1 + nr - 1;
+            int    ip_lo = int(std::floor(nr*(phi-dphi)/twopi - shift)) + 1;
+            int    ip_hi = int(std::floor(nr*(phi+dphi)/twopi - shift));
+            if (ip_lo <= ip_hi) {
+                if (ip_hi >= nr) {
+                    ip_lo -= nr;
+                    ip_hi -= nr;
+                }
+                if (ip_lo < 0) {
+                    for (int i = ipix1; i <= ipix1+ip_hi; ++i) {
+                        pixels.push_back(i);
+                    }
+                    for (int i = ipix1+ip_lo+nr; i <= ipix2; ++i) {
+                        pixels.push_back(i);
+                    }
+                }
+                else {
+                    for (int i = ipix1+ip_lo; i <= ipix1+ip_hi; ++i) {
+                        pixels.push_back(i);
+                    }
+                }
+            }
+        }
+
+    } // endfor: looped over rings
+
+    // Add all rings south of disc if disc covers the South pole
+    if (rlat2 >= pi && irmax+1 < 4*m_nside) {
+        int  startpix;
+        int  ringpix;
+        bool shifted;
+        ring_info(irmax+1, &startpix, &ringpix, &shifted);
+        for (int i = startpix; i < m_num_pixels; ++i) {
+            pixels.push_back(i);
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute ring/nest conversion tables
+ *
+ * @return True if the conversion tables exist.
+ *
+ * Computes the ring/nest conversion tables if they do not yet exist and
+ * if the map has not more than 12*512*512 pixels. The tables are computed
+ * in a critical section so that concurrent conversions do not compute them
+ * simultaneously. The flag that signals the existence of the tables is
+ * read and written atomically, and memory is flushed so that a thread
+ * that sees the flag set also sees the complete tables.
+ ***************************************************************************/
+bool GWcsHPX::set_tables(void) const
+{
+    // Get flag that signals the existence of the tables
+    bool has_tables;
+    #pragma omp atomic read
+    has_tables = m_has_tables;
+    #pragma omp flush
+
+    // Compute tables if required
+    if (!has_tables && m_num_pixels > 0 && m_num_pixels <= max_table) {
+
+        #pragma omp critical(GWcsHPX_set_tables)
+        {
+        if (!m_has_tables) {
+
+            // Compute tables
+            m_ring2nest.assign(m_num_pixels, 0);
+            m_nest2ring.assign(m_num_pixels, 0);
+            for (int pix = 0; pix < m_num_pixels; ++pix) {
+                int ix;
+                int iy;
+                int face;
+                ring2xyf(pix, &ix, &iy, &face);
+                int nest          = xyf2nest(ix, iy, face);
+                m_ring2nest[pix]  = nest;
+                m_nest2ring[nest] = pix;
+            }
+
+            // Make tables visible before signalling that they exist
+            #pragma omp flush
+            #pragma omp atomic write
+            m_has_tables = true;
+
+        } // endif: tables did not exist
+        has_tables = m_has_tables;
+        } // end critical section
+
+    } // endif: tables were needed
+
+    // Return
+    return has_tables;
+}
+
+
 /***********************************************************************//**
  * @brief Setup of projection
  *
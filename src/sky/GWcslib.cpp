@@ -642,6 +642,107 @@ GSkyPixel GWcslib::dir2xy(const GSkyDir& dir) const
 }
 
 
+/***********************************************************************//**
+ * @brief Returns sky coordinates of 2D pixels
+ *
+ * @param[in] num Number of pixels.
+ * @param[in] x Pixel x values [num].
+ * @param[in] y Pixel y values [num].
+ * @param[out] lon Longitudes in the WCS coordinate system (deg) [num].
+ * @param[out] lat Latitudes in the WCS coordinate system (deg) [num].
+ *
+ * Transforms all pixels in a single call of the wcslib pixel-to-world
+ * transformation, which loops over the coordinates in each of the linear,
+ * projection and spherical transformation steps.
+ ***************************************************************************/
+void GWcslib::xy2dir(const int& num, const double* x, const double* y,
+                     double* lon, double* lat) const
+{
+    // Continue only if there are pixels
+    if (num > 0) {
+
+        // Allocate memory for transformation
+        std::vector<double> pixcrd(2*num);
+        std::vector<double> imgcrd(2*num);
+        std::vector<double> phi(num);
+        std::vector<double> theta(num);
+        std::vector<double> world(2*num);
+        std::vector<int>    stat(num);
+
+        // Set sky pixels. We have to add 1.0 here as the WCS pixel
+        // reference (CRPIX) starts from one while GSkyPixel starts from 0.
+        for (int i = 0; i < num; ++i) {
+            pixcrd[2*i]   = x[i] + 1.0;
+            pixcrd[2*i+1] = y[i] + 1.0;
+        }
+
+        // Transform pixel-to-world coordinates
+        wcs_p2s(num, 2, &pixcrd[0], &imgcrd[0], &phi[0], &theta[0],
+                &world[0], &stat[0]);
+
+        // Extract sky coordinates
+        for (int i = 0; i < num; ++i) {
+            lon[i] = world[2*i];
+            lat[i] = world[2*i+1];
+        }
+
+    } // endif: there were pixels
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Returns 2D pixels of sky coordinates
+ *
+ * @param[in] num Number of coordinates.
+ * @param[in] lon Longitudes in the WCS coordinate system (deg) [num].
+ * @param[in] lat Latitudes in the WCS coordinate system (deg) [num].
+ * @param[out] x Pixel x values [num].
+ * @param[out] y Pixel y values [num].
+ *
+ * Transforms all coordinates in a single call of the wcslib world-to-pixel
+ * transformation.
+ ***************************************************************************/
+void GWcslib::dir2xy(const int& num, const double* lon, const double* lat,
+                     double* x, double* y) const
+{
+    // Continue only if there are coordinates
+    if (num > 0) {
+
+        // Allocate memory for transformation
+        std::vector<double> pixcrd(2*num);
+        std::vector<double> imgcrd(2*num);
+        std::vector<double> phi(num);
+        std::vector<double> theta(num);
+        std::vector<double> world(2*num);
+        std::vector<int>    stat(num);
+
+        // Set world coordinates
+        for (int i = 0; i < num; ++i) {
+            world[2*i]   = lon[i];
+            world[2*i+1] = lat[i];
+        }
+
+        // Transform world-to-pixel coordinates
+        wcs_s2p(num, 2, &world[0], &phi[0], &theta[0], &imgcrd[0],
+                &pixcrd[0], &stat[0]);
+
+        // Set sky pixels. We have to subtract 1 here as GSkyPixel starts
+        // from zero while the WCS reference (CRPIX) starts from one.
+        for (int i = 0; i < num; ++i) {
+            x[i] = pixcrd[2*i]   - 1.0;
+            y[i] = pixcrd[2*i+1] - 1.0;
+        }
+
+    } // endif: there were coordinates
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set World Coordinate System parameters
  *
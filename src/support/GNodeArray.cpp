@@ -35,7 +35,11 @@
 
 /* __ Method name definitions ____________________________________________ */
 #define G_ACCESS                                "GNodeArray::operator[](int)"
-#define G_INTERPOLATE "GNodeArray::interpolate(double&,std::vector<double>&)"
+#define G_INTERPOLATE1 \
+                       "GNodeArray::interpolate(double&,std::vector<double>&)"
+#define G_INTERPOLATE2           "GNodeArray::interpolate(double&,int*,double*)"
+#define G_INTERPOLATE3  "GNodeArray::interpolate(int&,double*,int*,double*,"\
+                                                                      "bool&)"
 #define G_SET_VALUE                          "GNodeArray::set_value(double&)"
 #define G_SETUP                                         "GNodeArray::setup()"
 
@@ -211,7 +215,8 @@ double& GNodeArray::operator[](const int& index)
     #endif
 
     // Signal that setup needs to be called
-    m_need_setup = false;
+    #pragma omp atomic write
+    m_need_setup = true;
 
     // Return node
     return m_node[index];
@@ -236,9 +241,6 @@ const double& GNodeArray::operator[](const int& index) const
     }
     #endif
 
-    // Signal that setup needs to be called
-    m_need_setup = false;
-
     // Return node
     return m_node[index];
 }
@@ -390,34 +392,156 @@ void GNodeArray::append(const double& node)
  *            Size of node vector does not match the size of vector argument.
  *
  * This method performs a linear interpolation of values \f$y_i\f$. The
- * corresponding values \f$x_i\f$ are stored in the node array.
+ * corresponding values \f$x_i\f$ are stored in the node array. The method
+ * does not modify the node array and is thread safe.
  ***************************************************************************/
 double GNodeArray::interpolate(const double& value,
                                const std::vector<double>& vector) const
 {
     // Throw exception if there are not enough nodes
     if (m_node.size() < 2) {
-        throw GException::not_enough_nodes(G_INTERPOLATE, m_node.size());
+        throw GException::not_enough_nodes(G_INTERPOLATE1, m_node.size());
     }
 
     // Throw exception if vectors have not the same size
     if (m_node.size() != vector.size()) {
-        throw GException::vector_mismatch(G_INTERPOLATE, m_node.size(),
+        throw GException::vector_mismatch(G_INTERPOLATE1, m_node.size(),
                                           vector.size());
     }
-    
-    // Set interpolation value (circumvent const correctness)
-    set_value(value);
+
+    // Make sure that node distances are set up
+    check_setup();
+
+    // Get left node index and weight of right node
+    int    inx_left  = search(value);
+    double wgt_right = (value - m_node[inx_left]) / m_step[inx_left];
 
     // Interpolate
-    double y = vector[inx_left()]  * wgt_left() +
-               vector[inx_right()] * wgt_right();
+    double y = vector[inx_left]   * (1.0 - wgt_right) +
+               vector[inx_left+1] * wgt_right;
 
     // Return
     return y;
 }
 
 
+/***********************************************************************//**
+ * @brief Compute interpolation indices and weighting factors
+ *
+ * @param[in] value Value \f$x\f$ at which interpolation should be done.
+ * @param[out] inx Indices of left and right node (2 elements).
+ * @param[out] wgt Weighting factors of left and right node (2 elements).
+ *
+ * @exception GException::not_enough_nodes
+ *            Not enough nodes for interpolation in node array.
+ *
+ * Computes the indices of the two nodes that bound @p value and the
+ * corresponding weighting factors for linear interpolation. Values outside
+ * the node array are extrapolated from the first or last two nodes.
+ *
+ * Contrary to set_value(), the method does not modify the node array and
+ * is thread safe.
+ ***************************************************************************/
+void GNodeArray::interpolate(const double& value,
+                             int*          inx,
+                             double*       wgt) const
+{
+    // Throw exception if there are not enough nodes
+    if (m_node.size() < 2) {
+        throw GException::not_enough_nodes(G_INTERPOLATE2, m_node.size());
+    }
+
+    // Make sure that node distances are set up
+    check_setup();
+
+    // Set indices
+    inx[0] = search(value);
+    inx[1] = inx[0] + 1;
+
+    // Set weighting factors
+    wgt[1] = (value - m_node[inx[0]]) / m_step[inx[0]];
+    wgt[0] = 1.0 - wgt[1];
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Compute interpolation indices and weighting factors for values
+ *
+ * @param[in] num Number of values.
+ * @param[in] values Values \f$x\f$ at which interpolation should be done
+ *                   (num elements).
+ * @param[out] inx Indices of left and right nodes (2*num elements).
+ * @param[out] wgt Weighting factors of left and right nodes (2*num
+ *                 elements).
+ * @param[in] sorted Values are sorted in ascending order.
+ *
+ * @exception GException::not_enough_nodes
+ *            Not enough nodes for interpolation in node array.
+ *
+ * Computes the indices and weighting factors for linear interpolation for
+ * an array of values. The indices and weighting factors of value k are
+ * returned in inx[2*k], inx[2*k+1] and wgt[2*k], wgt[2*k+1].
+ *
+ * If @p sorted is true and the nodes are not equally spaced, the search
+ * for the left node of a value starts from the left node of the preceeding
+ * value, and proceeds in steps of increasing size (galloping search)
+ * before the final bisection. For dense sorted batches, the cost per value
+ * is thus of order one instead of the logarithm of the number of nodes.
+ * Values that are smaller than the preceeding value are searched by full
+ * bisection, hence the result does not depend on @p sorted.
+ *
+ * The method does not modify the node array and is thread safe.
+ ***************************************************************************/
+void GNodeArray::interpolate(const int&    num,
+                             const double* values,
+                             int*          inx,
+                             double*       wgt,
+                             const bool&   sorted) const
+{
+    // Throw exception if there are not enough nodes
+    if (m_node.size() < 2) {
+        throw GException::not_enough_nodes(G_INTERPOLATE3, m_node.size());
+    }
+
+    // Make sure that node distances are set up
+    check_setup();
+
+    // Use hinted search if values are sorted and nodes are not linear
+    bool hinted = sorted && !m_is_linear;
+
+    // Loop over all values
+    int inx_left = 0;
+    for (int k = 0; k < num; ++k) {
+
+        // Get value
+        const double& value = values[k];
+
+        // Get left node index
+        if (hinted && k > 0 && value >= values[k-1]) {
+            inx_left = search(value, inx_left);
+        }
+        else {
+            inx_left = search(value);
+        }
+
+        // Set indices and weighting factors
+        int    i         = 2 * k;
+        double wgt_right = (value - m_node[inx_left]) / m_step[inx_left];
+        inx[i]   = inx_left;
+        inx[i+1] = inx_left + 1;
+        wgt[i]   = 1.0 - wgt_right;
+        wgt[i+1] = wgt_right;
+
+    } // endfor: looped over values
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Set indices and weighting factors for interpolation
  *
@@ -431,6 +555,10 @@ double GNodeArray::interpolate(const double& value,
  * form (i.e. the nodes are equidistant), an analytic formula is used to
  * determine the boundary indices. If the nodes are not equidistant the
  * boundary indices are searched by bisection.
+ *
+ * The indices and weighting factors are stored in the node array, hence
+ * this method is not thread safe. Use the interpolate() methods for
+ * node arrays that are shared between threads.
  ***************************************************************************/
 void GNodeArray::set_value(const double& value) const
 {
@@ -460,53 +588,8 @@ void GNodeArray::set_value(const double& value) const
     // Continue only if computation is required
     if (compute) {
 
-        // If array is linear then get left index from analytic formula
-        if (m_is_linear) {
-
-            // Set left index
-            m_inx_left = int(m_linear_slope * value + m_linear_offset);
-        
-            // Keep index in valid range
-            if (m_inx_left < 0) {
-                m_inx_left = 0;
-            }
-            else if (m_inx_left >= nodes-1) {
-                m_inx_left = nodes - 2;
-            }
-
-        } // endif: array is linear
-
-        // ... otherwise search the relevant indices by bisection
-        else {
-    
-            // Set left index if value is before first node
-            if (value < m_node[0]) {
-                m_inx_left = 0;
-            }
-
-            // Set left index if value is after last node
-            else if (value >  m_node[nodes-1]) {
-                m_inx_left = nodes - 2;
-            }
-
-            // Set left index by bisection
-            else {
-                int low  = 0;
-                int high = nodes - 1;
-                while ((high - low) > 1) {
-                    int mid = (low+high) / 2;
-                    if (m_node[mid] > value) {
-                        high = mid;
-                    }
-                    else {
-                        low = mid;
-                    }
-                }
-                m_inx_left = low;
-            } // endelse: did bisection
-        }
-
-        // Set right index
+        // Set indices
+        m_inx_left  = search(value);
         m_inx_right = m_inx_left + 1;
 
         // Set weighting factors
@@ -670,10 +753,174 @@ void GNodeArray::setup(void) const
 
     } // endif: there were at least two nodes
 
-    // Signal that setup has been called
+    // Signal that setup has been called. Memory is flushed before, so that
+    // a thread that sees the flag cleared also sees the complete setup.
+    #pragma omp flush
+    #pragma omp atomic write
     m_need_setup = false;
 
     // Return
     return;
 }
 
+
+/***********************************************************************//**
+ * @brief Set up node distances if required
+ *
+ * Calls setup() if the nodes may have been modified through the non-const
+ * access operator. The setup is done in a critical section so that
+ * concurrent interpolations do not set up the node array simultaneously.
+ * The flag that signals the need for a setup is read and written
+ * atomically, and memory is flushed so that a thread that sees the flag
+ * cleared also sees the complete setup.
+ ***************************************************************************/
+void GNodeArray::check_setup(void) const
+{
+    // Get flag that signals the need for a setup
+    bool need_setup;
+    #pragma omp atomic read
+    need_setup = m_need_setup;
+    #pragma omp flush
+
+    // Setup node array if required
+    if (need_setup) {
+        #pragma omp critical(GNodeArray_check_setup)
+        {
+            if (m_need_setup) {
+                setup();
+            }
+        }
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Search left node index for value
+ *
+ * @param[in] value Value.
+ * @return Index of left node [0,...,size()-2].
+ *
+ * Returns the index of the node that precedes @p value. If the array has
+ * a linear form, the index is computed using an analytic formula,
+ * otherwise it is searched by bisection. Values before the first node
+ * return 0, values after the last node return size()-2.
+ *
+ * The method requires at least two nodes and an up-to-date setup.
+ ***************************************************************************/
+int GNodeArray::search(const double& value) const
+{
+    // Get number of nodes
+    int nodes = m_node.size();
+
+    // Initialise left index
+    int inx_left = 0;
+
+    // If array is linear then get left index from analytic formula
+    if (m_is_linear) {
+
+        // Set left index
+        inx_left = int(m_linear_slope * value + m_linear_offset);
+
+        // Keep index in valid range
+        if (inx_left < 0) {
+            inx_left = 0;
+        }
+        else if (inx_left >= nodes-1) {
+            inx_left = nodes - 2;
+        }
+
+    } // endif: array is linear
+
+    // ... otherwise search the relevant indices by bisection
+    else {
+
+        // Set left index if value is before first node
+        if (value < m_node[0]) {
+            inx_left = 0;
+        }
+
+        // Set left index if value is after last node
+        else if (value > m_node[nodes-1]) {
+            inx_left = nodes - 2;
+        }
+
+        // Set left index by bisection
+        else {
+            int low  = 0;
+            int high = nodes - 1;
+            while ((high - low) > 1) {
+                int mid = (low+high) / 2;
+                if (m_node[mid] > value) {
+                    high = mid;
+                }
+                else {
+                    low = mid;
+                }
+            }
+            inx_left = low;
+        } // endelse: did bisection
+    }
+
+    // Return left index
+    return inx_left;
+}
+
+
+/***********************************************************************//**
+ * @brief Search left node index for value starting from a hint
+ *
+ * @param[in] value Value.
+ * @param[in] hint Index of left node for a value not larger than @p value.
+ * @return Index of left node [0,...,size()-2].
+ *
+ * Returns the same index as search(const double&), but starts the search
+ * at node @p hint. The nodes following @p hint are probed in steps of
+ * 1, 2, 4, ... nodes until a node larger than @p value is found, and the
+ * left node is then searched by bisection within the last step. The cost
+ * is therefore proportional to the logarithm of the distance between
+ * @p hint and the result.
+ *
+ * If @p value precedes node @p hint, the search falls back to a full
+ * search.
+ ***************************************************************************/
+int GNodeArray::search(const double& value, const int& hint) const
+{
+    // Get number of nodes
+    int nodes = m_node.size();
+
+    // Fall back to full search if the hint is not usable
+    if (hint < 0 || hint > nodes-2 || value < m_node[hint]) {
+        return (search(value));
+    }
+
+    // Gallop forward until a node exceeds the value or the last node is
+    // reached
+    int low  = hint;
+    int step = 1;
+    int high = low + step;
+    while (high < nodes-1 && m_node[high] <= value) {
+        low   = high;
+        step *= 2;
+        high  = low + step;
+    }
+    if (high > nodes-1) {
+        high = nodes - 1;
+    }
+
+    // Set left index by bisection
+    while ((high - low) > 1) {
+        int mid = (low+high) / 2;
+        if (m_node[mid] > value) {
+            high = mid;
+        }
+        else {
+            low = mid;
+        }
+    }
+
+    // Return left index
+    return low;
+}
@@ -27,6 +27,7 @@
 /* __ Includes ___________________________________________________________ */
 #include <cmath>
 #include <cstdlib>        // for system
+#include <fstream>
 #include "GTools.hpp"
 #include "test_GFits.hpp"
 
@@ -298,6 +299,13 @@ void TestGFits::set(void)
     append(static_cast<pfunction>(&TestGFits::test_bintable_ulong), "Test bintable ulong");
     append(static_cast<pfunction>(&TestGFits::test_bintable_long), "Test bintable long");
     append(static_cast<pfunction>(&TestGFits::test_bintable_longlong), "Test bintable longlong");
+    append(static_cast<pfunction>(&TestGFits::test_column_reader), "Test column reader");
+    append(static_cast<pfunction>(&TestGFits::test_column_values), "Test bulk column access");
+    append(static_cast<pfunction>(&TestGFits::test_mmap), "Test memory mapping");
+    append(static_cast<pfunction>(&TestGFits::test_image_compression), "Test image compression");
+    append(static_cast<pfunction>(&TestGFits::test_image_lazy), "Test on demand image loading");
+    append(static_cast<pfunction>(&TestGFits::test_table_writer), "Test streaming table writer");
+    append(static_cast<pfunction>(&TestGFits::test_parallel_access), "Test parallel column loading");
 
     // Return
     return;
@@ -1384,6 +1392,265 @@ void TestGFits::test_bintable_bit(void)
 }
 
 
+/***************************************************************************
+ * @brief Test chunked reading of table columns
+ ***************************************************************************/
+void TestGFits::test_column_reader(void)
+{
+    // Set parameters
+    int nrows = 25;
+    int nvec  = 3;
+
+    // Set vector column
+    GFitsTableDoubleCol col("DOUBLE", nrows, nvec);
+    for (int i = 0; i < nrows; ++i) {
+        for (int j = 0; j < nvec; ++j) {
+            col(i,j) = 10.0 * i + j;
+        }
+    }
+
+    // Load row range
+    std::vector<double> values(4*nvec);
+    col.load_rows(20, 4, &(values[0]));
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < nvec; ++j) {
+            test_value(values[i*nvec+j], 10.0*(20+i)+j, 1.0e-10,
+                       "Check value of row "+str(20+i));
+        }
+    }
+
+    // Check that invalid row ranges are catched
+    test_try("Load invalid row range");
+    try {
+        col.load_rows(20, 6, &(values[0]));
+        test_try_failure("Expected GException::out_of_range");
+    }
+    catch (GException::out_of_range &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Read column in chunks
+    GFitsTableColReader reader(&col, 10);
+    int  nchunks = 0;
+    int  nread   = 0;
+    bool ok      = true;
+    while (reader.next()) {
+        test_assert(reader.row() == nread,
+                    "Check first row of chunk "+str(nchunks));
+        for (int i = 0; i < reader.rows(); ++i) {
+            for (int j = 0; j < nvec; ++j) {
+                if (reader(i,j) != 10.0 * (reader.row()+i) + j) {
+                    ok = false;
+                }
+            }
+        }
+        nread += reader.rows();
+        nchunks++;
+    }
+    test_assert(ok, "Check chunk values");
+    test_value(nchunks, 3, "Check number of chunks");
+    test_value(nread, nrows, "Check number of rows");
+
+    // Rewind and read again with a different chunk size
+    reader.rewind();
+    reader.chunk(100);
+    test_assert(reader.next(), "Check that first chunk is read");
+    test_value(reader.rows(), nrows, "Check size of single chunk");
+    test_assert(!reader.next(), "Check end of column");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test bulk access to column values
+ ***************************************************************************/
+void TestGFits::test_column_values(void)
+{
+    // Set columns
+    GFitsTableShortCol  col_short("SHORT", 10, 3);
+    GFitsTableFloatCol  col_float("FLOAT", 10);
+    GFitsTableBoolCol   col_bool("BOOL", 10);
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            col_short(i,j) = 10 * i - j;
+        }
+        col_float(i) = 0.5 * i - 1.25;
+        col_bool(i)  = (i % 2 == 0);
+    }
+
+    // Copy all vector elements into double precision buffer
+    std::vector<double> dvalues(6);
+    col_short.values(4, 2, &(dvalues[0]));
+    test_value(dvalues[0], 40.0, 1.0e-10, "Check first short value");
+    test_value(dvalues[5], 48.0, 1.0e-10, "Check last short value");
+
+    // Copy single vector element into single precision and integer buffers
+    std::vector<float>     fvalues(10);
+    std::vector<long long> ivalues(10);
+    col_short.values(0, 10, &(fvalues[0]), 2);
+    col_short.values(0, 10, &(ivalues[0]), 1);
+    test_value(fvalues[7], 68.0, 1.0e-10, "Check strided float value");
+    test_value((int)ivalues[9], 89, "Check strided integer value");
+
+    // Convert float and boolean columns
+    col_float.values(2, 3, &(dvalues[0]));
+    col_float.values(0, 10, &(ivalues[0]));
+    test_value(dvalues[2], 0.75, 1.0e-10, "Check float to double conversion");
+    test_value((int)ivalues[1], 0, "Check float to integer truncation");
+    test_value((int)ivalues[9], 3, "Check float to integer conversion");
+    col_bool.values(0, 2, &(dvalues[0]));
+    test_value(dvalues[0], 1.0, 1.0e-10, "Check boolean conversion");
+    test_value(dvalues[1], 0.0, 1.0e-10, "Check boolean conversion");
+
+    // Check that invalid vector indices are catched
+    test_try("Copy invalid vector index");
+    try {
+        col_short.values(0, 1, &(dvalues[0]), 3);
+        test_try_failure("Expected GException::out_of_range");
+    }
+    catch (GException::out_of_range &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check values read from a FITS file, directly and memory mapped. The
+    // 64-bit integers exceed the double precision mantissa. The vector
+    // column has an undefined value and is therefore not mapped.
+    test_try("Copy values from FITS file");
+    try {
+        const long long big = 9007199254740993LL; // 2^53+1
+        GFitsBinTable         table(4);
+        GFitsTableLongLongCol col_long("LONGLONG", 4);
+        GFitsTableShortCol    col_vec("VECTOR", 4, 3);
+        for (int i = 0; i < 4; ++i) {
+            col_long(i) = big + i;
+            for (int j = 0; j < 3; ++j) {
+                col_vec(i,j) = 10 * i - j;
+            }
+        }
+        table.append_column(col_long);
+        table.append_column(col_vec);
+        table.card("TNULL2", -32768, "Undefined value");
+        GFits fits;
+        fits.append(table);
+        fits.saveto("test_column_values.fits", true);
+        for (int mapped = 0; mapped < 2; ++mapped) {
+            GFits file("test_column_values.fits");
+            if (mapped) {
+                file.map();
+            }
+            const GFitsTable* hdu = file.table(1);
+            if (mapped && (!(*hdu)["LONGLONG"].ismapped() ||
+                           (*hdu)["VECTOR"].ismapped())) {
+                throw exception_failure("Column with undefined value"
+                                        " mapped.");
+            }
+            (*hdu)["LONGLONG"].values(0, 4, &(ivalues[0]));
+            (*hdu)["VECTOR"].values(1, 3, &(fvalues[0]), 2);
+            for (int i = 0; i < 4; ++i) {
+                if (ivalues[i] != big + i) {
+                    throw exception_failure("Value "+str(i)+" of 64-bit"
+                                            " column differs.");
+                }
+            }
+            for (int i = 0; i < 3; ++i) {
+                if (fvalues[i] != float(10 * (i+1) - 2)) {
+                    throw exception_failure("Element of vector column"
+                                            " differs in row "+str(i+1)+".");
+                }
+            }
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
+/***************************************************************************
+ * @brief Test memory mapped access to FITS data
+ *
+ * Writes a minimal FITS file with big-endian values of different types
+ * and checks that the values are correctly decoded from the memory mapped
+ * data region.
+ ***************************************************************************/
+void TestGFits::test_mmap(void)
+{
+    // Set cfitsio data type codes
+    const int t_short    = 21;
+    const int t_ushort   = 20;
+    const int t_long     = 41;
+    const int t_longlong = 81;
+    const int t_float    = 42;
+    const int t_double   = 82;
+
+    // Set big-endian data: short -3, ushort 40000 (stored with offset
+    // 32768), long 123456, longlong -5, float -2.25, double 1.5
+    const unsigned char data[] = {0xff, 0xfd,
+                                  0x1c, 0x40,
+                                  0x00, 0x01, 0xe2, 0x40,
+                                  0xff, 0xff, 0xff, 0xff,
+                                  0xff, 0xff, 0xff, 0xfb,
+                                  0xc0, 0x10, 0x00, 0x00,
+                                  0x3f, 0xf8, 0x00, 0x00,
+                                  0x00, 0x00, 0x00, 0x00};
+    const int size = sizeof(data);
+
+    // Write FITS file with a 2880 byte header followed by the data
+    std::string header = "SIMPLE  =                    T";
+    header.resize(2880, ' ');
+    std::ofstream file("test_mmap.fits", std::ios::binary);
+    file.write(header.c_str(), header.size());
+    file.write((const char*)data, size);
+    file.close();
+
+    // Map data region
+    GFitsMmap map("test_mmap.fits", 2880, size);
+    test_assert(map.is_open(), "Check that data region is mapped");
+
+    // Check values
+    if (map.is_open()) {
+        test_value(map.real(t_short, 0), -3.0, 1.0e-10, "Check short value");
+        test_value(map.real(t_ushort, 2), 40000.0, 1.0e-10, "Check ushort value");
+        test_value(map.real(t_long, 4), 123456.0, 1.0e-10, "Check long value");
+        test_value(map.real(t_longlong, 8), -5.0, 1.0e-10, "Check longlong value");
+        test_value(map.real(t_float, 16), -2.25, 1.0e-10, "Check float value");
+        test_value(map.real(t_double, 20), 1.5, 1.0e-10, "Check double value");
+
+        // Check that copies map the same region
+        GFitsMmap copy = map;
+        test_assert(copy.is_open(), "Check that copy is mapped");
+        test_assert(copy.data() != map.data(), "Check that copy has its own mapping");
+        test_value(copy.real(t_double, 20), 1.5, 1.0e-10, "Check double value of copy");
+    }
+
+    // Check that regions beyond the end of the file are not mapped
+    map.open("test_mmap.fits", 2880, size+1);
+    test_assert(!map.is_open(), "Check that invalid region is not mapped");
+
+    // Check that non FITS files are not mapped
+    std::ofstream text("test_mmap.txt");
+    text << "This is not a FITS file" << std::endl;
+    text.close();
+    map.open("test_mmap.txt", 0, 4);
+    test_assert(!map.is_open(), "Check that non FITS file is not mapped");
+
+    // Return
+    return;
+}
+
+
 /***************************************************************************
  * @brief Main entry point for test executable
  ***************************************************************************/
@@ -1410,3 +1677,417 @@ int main(void)
     // Return success status
     return (success ? 0 : 1);
 }
+
+
+/***********************************************************************//**
+ * @brief Test tile compressed images
+ ***************************************************************************/
+void TestGFits::test_image_compression(void)
+{
+    // Check compression setting
+    GFitsImageDouble image(100, 50, 4);
+    test_assert(image.compression() == "NONE", "Check default compression");
+    image.compression("GZIP");
+    test_assert(image.compression() == "GZIP", "Check GZIP compression");
+    GFitsImageDouble copy = image;
+    test_assert(copy.compression() == "GZIP", "Check compression of copy");
+
+    // Check that an invalid compression algorithm is rejected
+    test_try("Check invalid compression algorithm");
+    try {
+        image.compression("LZMA");
+        test_try_failure("Invalid compression algorithm not rejected.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check that lossy compression of floating point images is rejected
+    GFitsImageFloat fimage(10, 10);
+    test_try("Check RICE compression of floating point image");
+    try {
+        fimage.compression("RICE");
+        test_try_failure("RICE compression of floating point image not"
+                         " rejected.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+    test_assert(fimage.compression() == "NONE",
+                "Check compression of floating point image");
+
+    // Check RICE compression of integer image
+    GFitsImageLong limage(10, 10);
+    limage.compression("rice");
+    test_assert(limage.compression() == "RICE",
+                "Check RICE compression of integer image");
+
+    // Fill image
+    double sum = 0.0;
+    for (int ix = 0; ix < 100; ++ix) {
+        for (int iy = 0; iy < 50; ++iy) {
+            for (int iz = 0; iz < 4; ++iz) {
+                image(ix,iy,iz) = 0.5*ix - 0.25*iy + iz;
+                sum            += image(ix,iy,iz);
+            }
+        }
+    }
+
+    // Save compressed image
+    test_try("Save compressed image");
+    try {
+        system("rm -rf test_compressed.fits");
+        GFits fits("test_compressed.fits", true);
+        GFitsImageDouble primary;
+        fits.append(primary);
+        fits.append(image);
+        fits.save();
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Re-open compressed image
+    double total = 0.0;
+    test_try("Re-open compressed image");
+    try {
+        GFits fits("test_compressed.fits");
+        GFitsImage* loaded = static_cast<GFitsImage*>(fits.hdu(1));
+        test_assert(loaded->compression() == "GZIP",
+                    "Check compression of loaded image");
+        for (int i = 0; i < loaded->size(); ++i) {
+            total += loaded->pixel(i);
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+    test_value(total, sum, 1.0e-6, "Check lossless compression");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test on demand loading of image planes and regions
+ ***************************************************************************/
+void TestGFits::test_image_lazy(void)
+{
+    // Create image
+    GFitsImageFloat image(20, 10, 5);
+    for (int ix = 0; ix < 20; ++ix) {
+        for (int iy = 0; iy < 10; ++iy) {
+            for (int iz = 0; iz < 5; ++iz) {
+                image(ix,iy,iz) = ix + 100.0*iy + 10000.0*iz;
+            }
+        }
+    }
+
+    // Check planes and regions of image in memory
+    std::vector<int> first(3);
+    std::vector<int> last(3);
+    first[0] = 3;
+    first[1] = 2;
+    first[2] = 1;
+    last[0]  = 5;
+    last[1]  = 4;
+    last[2]  = 3;
+    std::vector<double> plane  = image.plane(2);
+    std::vector<double> region = image.region(first, last);
+    test_value(image.planes(), 5, "Check number of planes");
+    test_value((int)plane.size(), 200, "Check plane size");
+    test_value(plane[21], 20101.0, 1.0e-10, "Check plane pixel");
+    test_value((int)region.size(), 27, "Check region size");
+    test_value(region[0], 10203.0, 1.0e-10, "Check first region pixel");
+    test_value(region[26], 30405.0, 1.0e-10, "Check last region pixel");
+    test_assert(!image.islazy(), "Check that image in memory is not lazy");
+
+    // Check invalid arguments
+    test_try("Check invalid plane index");
+    try {
+        image.plane(5);
+        test_try_failure("Invalid plane index not rejected.");
+    }
+    catch (GException::out_of_range &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+    test_try("Check negative cache budget");
+    try {
+        image.cache_budget(-1.0);
+        test_try_failure("Negative cache budget not rejected.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Save image
+    test_try("Save image");
+    try {
+        system("rm -rf test_lazy.fits");
+        GFits fits("test_lazy.fits", true);
+        fits.append(image);
+        fits.save();
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Load image planes and region on demand
+    test_try("Load image on demand");
+    try {
+        GFits       fits("test_lazy.fits");
+        GFitsImage* loaded = static_cast<GFitsImage*>(fits.hdu(0));
+        loaded->cache_budget(0.002);
+        test_assert(loaded->islazy(), "Check that loaded image is lazy");
+        test_value(loaded->pixel(7,3,4), 40307.0, 1.0e-10, "Check pixel of plane 4");
+        test_value(loaded->pixel(1,1,0), 101.0, 1.0e-10, "Check pixel of plane 0");
+        test_value(loaded->pixel(7,3,4), 40307.0, 1.0e-10, "Check cached pixel");
+        std::vector<double> region = loaded->region(first, last);
+        test_value(region[26], 30405.0, 1.0e-10, "Check region pixel read from file");
+        test_assert(loaded->islazy(), "Check that image is still lazy");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test streaming FITS table writer
+ ***************************************************************************/
+void TestGFits::test_table_writer(void)
+{
+    // Check that writing without opened table extension is catched
+    test_try("Write to closed writer");
+    try {
+        GFitsTableWriter writer;
+        GFitsBinTable    block(1);
+        writer.write(block);
+        test_try_failure("Expected GException::fits_file_not_open");
+    }
+    catch (GException::fits_file_not_open &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Save table without rows
+    test_try("Save table without rows");
+    try {
+        system("rm -rf test_writer.fits");
+        GFitsBinTable       table;
+        GFitsTableULongCol  col_id("ID", 0);
+        GFitsTableDoubleCol col_value("VALUE", 0, 2);
+        GFitsTableStringCol col_name("NAME", 0, 8);
+        GFitsTableShortCol  col_flag("FLAG", 0);
+        table.extname("STREAM");
+        table.append_column(col_id);
+        table.append_column(col_value);
+        table.append_column(col_name);
+        table.append_column(col_flag);
+        GFits fits;
+        fits.append(table);
+        fits.saveto("test_writer.fits", true);
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Stream rows into table
+    test_try("Stream rows into table");
+    try {
+        GFitsTableWriter writer("test_writer.fits", "STREAM");
+        writer.threads(2);
+        for (int iblock = 0; iblock < 3; ++iblock) {
+            GFitsBinTable       block(7);
+            GFitsTableULongCol  col_id("ID", 7);
+            GFitsTableDoubleCol col_value("VALUE", 7, 2);
+            GFitsTableStringCol col_name("NAME", 7, 8);
+            GFitsTableShortCol  col_flag("FLAG", 7);
+            for (int i = 0; i < 7; ++i) {
+                int row          = 7 * iblock + i;
+                col_id(i)        = 3000000000u + row;
+                col_value(i,0)   = 0.5 * row;
+                col_value(i,1)   = -1.5 * row;
+                col_name(i)      = "row"+str(row);
+                col_flag(i)      = -row;
+            }
+            block.append_column(col_id);
+            block.append_column(col_value);
+            block.append_column(col_name);
+            block.append_column(col_flag);
+            writer.write(block);
+        }
+        test_value(writer.rows(), 21, "Check number of streamed rows");
+        writer.close();
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Check that blocks with wrong columns are catched
+    test_try("Write block with wrong columns");
+    try {
+        GFitsTableWriter writer("test_writer.fits", "STREAM");
+        GFitsBinTable    block(1);
+        writer.write(block);
+        test_try_failure("Expected GException::invalid_argument");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Read back streamed table
+    test_try("Read streamed table");
+    try {
+        GFits       fits("test_writer.fits");
+        GFitsTable* table = fits.table("STREAM");
+        test_value(table->nrows(), 21, "Check number of rows");
+        test_value((*table)["ID"].real(20), 3000000020.0, 1.0e-10, "Check ID");
+        test_value((*table)["VALUE"].real(9,1), -13.5, 1.0e-10, "Check VALUE");
+        test_assert((*table)["NAME"].string(15) == "row15", "Check NAME");
+        test_value((*table)["FLAG"].integer(11), -11, "Check FLAG");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test loading of columns of the same FITS file in parallel
+ *
+ * Also checks that the file can be opened and its header be read while
+ * columns of the same file are loaded.
+ ***************************************************************************/
+void TestGFits::test_parallel_access(void)
+{
+    // Set table dimensions
+    const int ncols = 8;
+    const int nrows = 5000;
+
+    // Save table
+    test_try("Save table");
+    try {
+        system("rm -rf test_parallel.fits");
+        GFitsBinTable table(nrows);
+        for (int icol = 0; icol < ncols; ++icol) {
+            GFitsTableDoubleCol column("COL"+str(icol), nrows);
+            for (int row = 0; row < nrows; ++row) {
+                column(row) = icol * 100000.0 + row;
+            }
+            table.append_column(column);
+        }
+        GFits fits;
+        fits.append(table);
+        fits.saveto("test_parallel.fits", true);
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Load columns in parallel and sum their values
+    test_try("Load columns in parallel");
+    try {
+        GFits       fits("test_parallel.fits");
+        GFitsTable* table = fits.table(1);
+        std::vector<double> sums(ncols, 0.0);
+        int                 errors = 0;
+        #pragma omp parallel for schedule(dynamic) reduction(+:errors)
+        for (int icol = 0; icol < ncols; ++icol) {
+            try {
+                const GFitsTableCol& column = (*table)[icol];
+                for (int row = 0; row < nrows; ++row) {
+                    sums[icol] += column.real(row);
+                }
+            }
+            catch (std::exception &e) {
+                errors++;
+            }
+        }
+        test_value(errors, 0, "Check that no errors occured");
+        for (int icol = 0; icol < ncols; ++icol) {
+            double expected = nrows * icol * 100000.0 +
+                              0.5 * double(nrows) * double(nrows-1);
+            test_value(sums[icol], expected, 1.0e-6, "Check sum of column "+str(icol));
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Open the file and read its header while columns are loaded
+    test_try("Mix header reads and column loads in parallel");
+    try {
+        GFits       fits("test_parallel.fits");
+        GFitsTable* table = fits.table(1);
+        std::vector<double> sums(ncols, 0.0);
+        int                 errors = 0;
+        #pragma omp parallel for schedule(dynamic) reduction(+:errors)
+        for (int i = 0; i < 2*ncols; ++i) {
+            try {
+                if (i % 2 == 0) {
+                    const GFitsTableCol& column = (*table)[i/2];
+                    for (int row = 0; row < nrows; ++row) {
+                        sums[i/2] += column.real(row);
+                    }
+                }
+                else {
+                    GFits other("test_parallel.fits");
+                    if (other.table(1)->integer("NAXIS2") != nrows ||
+                        other.table(1)->integer("TFIELDS") != ncols) {
+                        errors++;
+                    }
+                }
+            }
+            catch (std::exception &e) {
+                errors++;
+            }
+        }
+        test_value(errors, 0, "Check that no errors occured");
+        for (int icol = 0; icol < ncols; ++icol) {
+            double expected = nrows * icol * 100000.0 +
+                              0.5 * double(nrows) * double(nrows-1);
+            test_value(sums[icol], expected, 1.0e-6, "Check sum of column "+str(icol));
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Return
+    return;
+}
@@ -64,6 +64,13 @@ public:
     void         test_bintable_ulong(void);
     void         test_bintable_long(void);
     void         test_bintable_longlong(void);
+    void         test_column_reader(void);
+    void         test_column_values(void);
+    void         test_mmap(void);
+    void         test_image_compression(void);
+    void         test_image_lazy(void);
+    void         test_table_writer(void);
+    void         test_parallel_access(void);
 };
 
 #endif /* TEST_GFITS_HPP */
@@ -265,6 +265,30 @@ void TestGModel::test_spatial_model(void)
     test_xml_model("GModelRadialShell", m_xml_model_radial_shell);
     test_xml_model("GModelSpatialEllipticalDisk", m_xml_model_elliptical_disk);
 
+    // Test analytical gradient of radial Gaussian model against numerical
+    // gradient
+    GModelSpatialRadialGauss gauss(GSkyDir(), 0.2);
+    double theta = 0.1 * deg2rad;
+    double value = gauss.eval_gradients(theta);
+    double grad  = gauss[2].factor_gradient();
+    test_value(value, gauss.eval(theta), 1.0e-10 * value,
+               "Check GModelSpatialRadialGauss::eval_gradients value");
+    double theta_max  = gauss.theta_max();
+    double theta_grad = gauss.theta_max_gradient(2);
+    gauss.sigma(0.2 + 1.0e-6);
+    double value_p    = gauss.eval(theta);
+    double theta_p    = gauss.theta_max();
+    gauss.sigma(0.2 - 1.0e-6);
+    double value_m    = gauss.eval(theta);
+    double theta_m    = gauss.theta_max();
+    double numeric    = (value_p - value_m) / 2.0e-6;
+    test_value(grad, numeric, 1.0e-6 * std::abs(numeric),
+               "Check GModelSpatialRadialGauss sigma gradient");
+    test_value(theta_grad, (theta_p - theta_m) / 2.0e-6, 1.0e-6 * theta_max,
+               "Check GModelSpatialRadialGauss theta_max gradient");
+    test_value(gauss.theta_max_gradient(0), 0.0, 1.0e-10,
+               "Check GModelSpatialRadialGauss theta_max RA gradient");
+
     // Return
     return;
 }
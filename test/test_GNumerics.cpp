@@ -46,6 +46,8 @@ void TestGNumerics::set(void)
     //Unbinned
     add_test(static_cast<pfunction>(&TestGNumerics::test_integral),"Test GIntegral");
     add_test(static_cast<pfunction>(&TestGNumerics::test_romberg_integration),"Test Romberg integration");
+    add_test(static_cast<pfunction>(&TestGNumerics::test_romberg_integrals),"Test Romberg integration of set of functions");
+    add_test(static_cast<pfunction>(&TestGNumerics::test_gauss_kronrod_integration),"Test Gauss-Kronrod integration");
     return;
 }
 
@@ -81,6 +83,51 @@ void TestGNumerics::test_romberg_integration(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test Romberg integration of set of functions.
+ ***************************************************************************/
+void TestGNumerics::test_romberg_integrals(void)
+{
+    GaussGrad  integrands(m_sigma);
+    GIntegrals integral(&integrands);
+    GVector    result = integral.romb(-m_sigma, m_sigma);
+    test_value(result[0],0.68268948130801355,1.0e-6,"","Gaussian integral is not 0.682689 (difference="+str((result[0]-0.68268948130801355))+")");
+
+    // The derivative of the integral over [-1,1] with respect to sigma
+    // is -sqrt(2/pi)/sigma^2 exp(-1/(2 sigma^2))
+    result = integral.romb(-1.0, 1.0);
+    double expected = -std::sqrt(2.0/pi)/(m_sigma*m_sigma) *
+                      std::exp(-0.5/(m_sigma*m_sigma));
+    test_value(result[1],expected,1.0e-6,"","Gaussian gradient integral is not "+str(expected)+" (difference="+str((result[1]-expected))+")");
+}
+
+
+/***********************************************************************//**
+ * @brief Test adaptive Gauss-Kronrod integration.
+ ***************************************************************************/
+void TestGNumerics::test_gauss_kronrod_integration(void)
+{
+    Gauss     integrand(m_sigma);
+    GIntegral integral(&integrand);
+    double    result = integral.gkq(-10.0*m_sigma, 10.0*m_sigma);
+    test_value(result,1.0,1.0e-6,"","Gaussian integral is not 1.0 (integral="+str(result)+")");
+    test_assert(integral.error() <= 1.0e-6*std::abs(result),
+                "Check Gauss-Kronrod error estimate ("+str(integral.error())+")");
+    test_assert(integral.calls() > 0 && integral.calls() % 15 == 0,
+                "Check number of 15-point kernel calls ("+str(integral.calls())+")");
+
+    result = integral.gkq(-m_sigma, m_sigma, 21);
+    test_value(result,0.68268948130801355,1.0e-6,"","Gaussian integral is not 0.682689 (difference="+str((result-0.68268948130801355))+")");
+    test_assert(integral.calls() > 0 && integral.calls() % 21 == 0,
+                "Check number of 21-point kernel calls ("+str(integral.calls())+")");
+
+    // Romberg reports the last extrapolation change as its error
+    result = integral.romb(0.0, m_sigma);
+    test_value(result,0.3413447460687748,1.0e-6,"","Gaussian integral is not 0.341345 (difference="+str((result-0.3413447460687748))+")");
+    test_assert(integral.calls() > 0, "Check number of Romberg kernel calls");
+}
+
+
 /***********************************************************************//**
  * @brief Main test function.
  ***************************************************************************/
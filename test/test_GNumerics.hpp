@@ -51,6 +51,27 @@ protected:
     double m_sigma;
 };
 
+/***********************************************************************//**
+ * @class GaussGrad
+ *
+ * @brief Gaussian function and its derivative with respect to sigma.
+ ***************************************************************************/
+class GaussGrad : public GFunctions {
+public:
+    GaussGrad(const double& sigma) : m_sigma(sigma) { return; }
+    virtual ~GaussGrad(void) { return; }
+    int size(void) const { return 2; }
+    GVector eval(double x) {
+        double  arg = -0.5*x*x/m_sigma/m_sigma;
+        GVector val(2);
+        val[0] = 1.0/std::sqrt(twopi)/m_sigma * std::exp(arg);
+        val[1] = val[0] * (x*x/m_sigma/m_sigma - 1.0) / m_sigma;
+        return val;
+    }
+protected:
+    double m_sigma;
+};
+
 class TestGNumerics : public GTestSuite
 {
     public:
@@ -62,6 +83,8 @@ class TestGNumerics : public GTestSuite
         virtual void set(void);
         void test_integral(void);
         void test_romberg_integration(void);
+        void test_romberg_integrals(void);
+        void test_gauss_kronrod_integration(void);
 
     // Private attributes
     private:
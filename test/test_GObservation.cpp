@@ -61,6 +61,8 @@ void TestGObservation::set(void)
     append(static_cast<pfunction>(&TestGObservation::test_time), "Test GTime");
     append(static_cast<pfunction>(&TestGObservation::test_times), "Test GTimes");
     append(static_cast<pfunction>(&TestGObservation::test_photons), "Test GPhotons");
+    append(static_cast<pfunction>(&TestGObservation::test_response_cache), "Test GResponseCache");
+    append(static_cast<pfunction>(&TestGObservation::test_model_block), "Test block model evaluation");
 
     // Return
     return;
@@ -396,6 +398,147 @@ void TestGObservation::test_photons(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test GResponseCache
+ ***************************************************************************/
+void TestGObservation::test_response_cache(void)
+{
+    // Set spatial model and response values
+    GSkyDir dir;
+    dir.radec_deg(83.6331, 22.0145);
+    GModelSpatialPointSource model(dir);
+    double irfs[] = {1.0, 2.0, 3.0};
+    double values[3];
+
+    // Manipulate GResponseCache starting from an empty object
+    GResponseCache cache;
+    test_value(cache.size(), 0, "GResponseCache should have zero size.");
+    test_assert(!cache.get("Crab", 0, 3, model, values),
+                "GResponseCache should not contain values.");
+
+    // Store values
+    cache.set("Crab", 0, 3, model, irfs);
+    test_value(cache.size(), 1, "GResponseCache should have 1 range.");
+    test_assert(cache.get("Crab", 0, 3, model, values),
+                "GResponseCache should contain values.");
+    for (int i = 0; i < 3; ++i) {
+        test_value(values[i], irfs[i], 1.0e-10, "Check cached value "+str(i));
+    }
+
+    // Check that other ranges and sources are not found
+    test_assert(!cache.get("Crab", 1, 3, model, values),
+                "GResponseCache should not contain range [1,3).");
+    test_assert(!cache.get("Crab", 0, 2, model, values),
+                "GResponseCache should not contain range [0,2).");
+    test_assert(!cache.get("Vela", 0, 3, model, values),
+                "GResponseCache should not contain source Vela.");
+
+    // Check that values are invalidated by changes of the spatial model
+    model["RA"].value(83.0);
+    test_assert(!cache.get("Crab", 0, 3, model, values),
+                "GResponseCache should be invalid after model change.");
+    cache.set("Crab", 0, 3, model, irfs);
+    test_value(cache.size(), 1, "GResponseCache should have 1 range.");
+    test_assert(cache.get("Crab", 0, 3, model, values),
+                "GResponseCache should contain values.");
+
+    // Clear object
+    cache.clear();
+    test_value(cache.size(), 0, "GResponseCache should have zero size.");
+
+    // Check that copies of an observation do not reference the response
+    // cache while working copies do
+    GTestObservation obs;
+    obs.use_irf_cache(true);
+    GTestObservation copy(obs);
+    GObservation*    working = obs.shallow_clone();
+    test_assert(copy.irf_cache() == NULL,
+                "Copy of observation should have no response cache.");
+    test_assert(working->irf_cache() == obs.irf_cache(),
+                "Working copy should reference the response cache.");
+    delete working;
+
+    // Check that a copy remains valid once the cache of the original
+    // observation has been removed
+    copy.use_irf_cache(true);
+    obs.use_irf_cache(false);
+    test_assert(obs.irf_cache() == NULL,
+                "Observation should have no response cache.");
+    test_assert(copy.irf_cache() != NULL && copy.irf_cache()->size() == 0,
+                "Copy should have its own response cache.");
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test block model evaluation
+ *
+ * Checks that the model values and gradients that are computed for a range
+ * of events by GObservation::model(models, ibegin, iend, values, gradients)
+ * are identical to those computed event by event. The range spans several
+ * blocks of 256 events as used by the optimizer.
+ ***************************************************************************/
+void TestGObservation::test_model_block(void)
+{
+    // Set models
+    GSkyDir dir;
+    dir.radec_deg(83.6331, 22.0145);
+    GModelSky src1(GModelSpatialPointSource(dir),
+                   GModelSpectralPlaw(2.0, -2.5, 1.0));
+    GModelSky src2(GModelSpatialPointSource(dir),
+                   GModelSpectralPlaw(0.5, -1.5, 1.0));
+    src1.name("Source 1");
+    src2.name("Source 2");
+    src1["RA"].free();
+    src2["Index"].fix();
+    GModels models;
+    models.append(src1);
+    models.append(src2);
+
+    // Set event list with events of different energies and times
+    GTestEventList list;
+    for (int i = 0; i < 800; ++i) {
+        GTestEventAtom event;
+        event.energy(GEnergy(1.0 + 0.01 * i, "MeV"));
+        event.time(GTime(0.5 * i));
+        list.append(event);
+    }
+
+    // Set observation
+    GTestObservation obs;
+    obs.events(&list);
+
+    // Evaluate models for a range of events
+    int                 ibegin = 100;
+    int                 iend   = 700;
+    int                 num    = iend - ibegin;
+    int                 npars  = models.npars();
+    std::vector<double> values(num);
+    std::vector<double> gradients(num * npars);
+    obs.model(models, ibegin, iend, &(values[0]), &(gradients[0]));
+
+    // Compare to event by event evaluation
+    const GEvents* events = obs.events();
+    GVector        gradient(npars);
+    for (int k = 0; k < num; ++k) {
+        double value = obs.model(models, *((*events)[ibegin+k]), &gradient);
+        test_value(values[k], value, 1.0e-10 * std::abs(value),
+                   "Check model value for event "+str(ibegin+k));
+        for (int ipar = 0; ipar < npars; ++ipar) {
+            test_value(gradients[k*npars+ipar], gradient[ipar],
+                       1.0e-10 * (std::abs(gradient[ipar]) + 1.0e-10),
+                       "Check gradient "+str(ipar)+" for event "+
+                       str(ibegin+k));
+        }
+    }
+
+    // Return
+    return;
+}
+
+
 /***********************************************************************//**
  * @brief Test GTimeReference
  ***************************************************************************/
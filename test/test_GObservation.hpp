@@ -48,6 +48,8 @@ public:
     void         test_ebounds(void);
     void         test_gti(void);
     void         test_photons(void);
+    void         test_response_cache(void);
+    void         test_model_block(void);
     void         test_time_reference(void);
     void         test_time(void);
     void         test_times(void);
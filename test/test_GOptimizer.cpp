@@ -30,6 +30,9 @@
 #endif
 #include "test_GOptimizer.hpp"
 #include "testinst/GTestLib.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* __ Coding definitions _________________________________________________ */
 #define RATE      13.0        //!< Events per seconde. For events generation.
@@ -48,6 +51,8 @@ void TestGOptimizer::set(void){
     // Append tests
     append(static_cast<pfunction>(&TestGOptimizer::test_unbinned_optimizer), "Test unbinned optimization");
     append(static_cast<pfunction>(&TestGOptimizer::test_binned_optimizer), "Test binned optimization");
+    append(static_cast<pfunction>(&TestGOptimizer::test_reproducibility), "Test likelihood reproducibility");
+    append(static_cast<pfunction>(&TestGOptimizer::test_mixed_observations), "Test likelihood for mixed observations");
 
     // Return
     return;
@@ -162,6 +167,206 @@ void TestGOptimizer::test_binned_optimizer(void)
 }
 
 
+/***********************************************************************//**
+ * @brief Test that likelihood does not depend on number of threads
+ *
+ * Evaluates the likelihood function of a list of observations with very
+ * different numbers of events using 1 to 4 threads, and checks that the
+ * function value, the gradient and the curvature matrix are bit-for-bit
+ * identical.
+ ***************************************************************************/
+void TestGOptimizer::test_reproducibility(void)
+{
+    // Save number of threads
+    #ifdef _OPENMP
+    int max_threads = omp_get_max_threads();
+    #endif
+
+    // Loop over unbinned and binned mode
+    for (int mode = UN_BINNED; mode <= BINNED; ++mode) {
+
+        // Create model
+        GTestModelData model;
+        GModels        models;
+        models.append(model);
+
+        // Set time interval
+        GTime tmin(0.0);
+        GTime tmax(1800.0);
+
+        // Create observations, the first being much deeper than the others
+        GObservations obs;
+        for (int i = 0; i < 5; ++i) {
+            GRan ran;
+            ran.seed(i);
+            double   rate   = (i == 0) ? 10.0 * RATE : RATE;
+            GEvents* events = NULL;
+            if (mode == UN_BINNED) {
+                events = model.generateList(rate, tmin, tmax, ran);
+            }
+            else {
+                events = model.generateCube(rate, tmin, tmax, ran);
+            }
+            GTestObservation ob;
+            ob.events(events);
+            ob.ontime(tmax.secs()-tmin.secs());
+            obs.append(ob);
+        }
+        obs.models(models);
+
+        // Evaluate likelihood for different number of threads
+        std::vector<double>  values;
+        std::vector<GVector> gradients;
+        std::vector<GMatrix> covars;
+        for (int nthreads = 1; nthreads <= 4; ++nthreads) {
+            #ifdef _OPENMP
+            omp_set_num_threads(nthreads);
+            #endif
+            GObservations::optimizer fct(&obs);
+            fct.eval(obs.models());
+            int     npars = fct.gradient()->size();
+            GMatrix covar(npars, npars);
+            for (int row = 0; row < npars; ++row) {
+                for (int col = 0; col < npars; ++col) {
+                    covar(row,col) = (*fct.covar())(row,col);
+                }
+            }
+            values.push_back(fct.value());
+            gradients.push_back(*fct.gradient());
+            covars.push_back(covar);
+        }
+
+        // Check that results are identical
+        std::string prefix = (mode == UN_BINNED) ? "Unbinned: " : "Binned: ";
+        for (int k = 1; k < values.size(); ++k) {
+            std::string threads = str(k+1)+" threads";
+            test_assert(values[k] == values[0],
+                        prefix+"Check function value for "+threads,
+                        "Found "+str(values[k])+" instead of "+str(values[0]));
+            test_assert(gradients[k] == gradients[0],
+                        prefix+"Check gradient for "+threads);
+            test_assert(covars[k] == covars[0],
+                        prefix+"Check curvature matrix for "+threads);
+        }
+
+    } // endfor: looped over modes
+
+    // Restore number of threads
+    #ifdef _OPENMP
+    omp_set_num_threads(max_threads);
+    #endif
+
+    // Return
+    return;
+}
+
+
+/***********************************************************************//**
+ * @brief Test likelihood for a mixed list of observations
+ *
+ * Evaluates the likelihood function of a list that contains a deep
+ * unbinned observation, which is split into several work units, together
+ * with shallow unbinned and binned observations. The result is compared
+ * for 1 and 4 threads and to the sum of the serial evaluations of all
+ * observations.
+ ***************************************************************************/
+void TestGOptimizer::test_mixed_observations(void)
+{
+    // Save number of threads
+    #ifdef _OPENMP
+    int max_threads = omp_get_max_threads();
+    #endif
+
+    // Create model
+    GTestModelData model;
+    GModels        models;
+    models.append(model);
+
+    // Create observations. The first observation is deep, followed by
+    // shallow unbinned and binned observations.
+    GObservations obs;
+    for (int i = 0; i < 6; ++i) {
+        GRan ran;
+        ran.seed(i);
+        GTime    tmin(0.0);
+        GTime    tmax((i == 0) ? 1800.0 : 60.0);
+        GEvents* events = NULL;
+        if (i < 4) {
+            events = model.generateList(RATE, tmin, tmax, ran);
+        }
+        else {
+            events = model.generateCube(RATE, tmin, tmax, ran);
+        }
+        GTestObservation ob;
+        ob.events(events);
+        ob.ontime(tmax.secs()-tmin.secs());
+        obs.append(ob);
+    }
+    obs.models(models);
+
+    // Evaluate likelihood using 1 and 4 threads
+    std::vector<double>  values;
+    std::vector<double>  npreds;
+    std::vector<GVector> gradients;
+    for (int nthreads = 1; nthreads <= 4; nthreads += 3) {
+        #ifdef _OPENMP
+        omp_set_num_threads(nthreads);
+        #endif
+        GObservations::optimizer fct(&obs);
+        fct.eval(obs.models());
+        values.push_back(fct.value());
+        npreds.push_back(fct.npred());
+        gradients.push_back(*fct.gradient());
+    }
+    test_assert(values[1] == values[0], "Check function value for 4 threads",
+                "Found "+str(values[1])+" instead of "+str(values[0]));
+    test_assert(gradients[1] == gradients[0], "Check gradient for 4 threads");
+
+    // Evaluate likelihood sequentially for each observation
+    GObservations::optimizer fct(&obs);
+    GModels       pars = obs.models();
+    int           npars = pars.npars();
+    GSparseMatrix covar(npars, npars);
+    GVector       gradient(npars);
+    GVector       wrk_grad(npars);
+    double        value = 0.0;
+    double        npred = 0.0;
+    for (int i = 0; i < obs.size(); ++i) {
+        if (i < 4) {
+            double obs_npred = obs[i]->npred(pars, &wrk_grad);
+            npred    += obs_npred;
+            value    += obs_npred;
+            gradient += wrk_grad;
+            fct.poisson_unbinned(*obs[i], pars, covar, gradient, value,
+                                 wrk_grad);
+        }
+        else {
+            fct.poisson_binned(*obs[i], pars, covar, gradient, value, npred,
+                               wrk_grad);
+        }
+    }
+
+    // Check that parallel evaluation matches sequential evaluation
+    test_value(values[0], value, 1.0e-8 * std::abs(value),
+               "Check function value against sequential evaluation");
+    test_value(npreds[0], npred, 1.0e-8 * npred,
+               "Check Npred against sequential evaluation");
+    for (int k = 0; k < npars; ++k) {
+        test_value(gradients[0][k], gradient[k],
+                   1.0e-8 * (std::abs(gradient[k]) + 1.0),
+                   "Check gradient "+str(k)+" against sequential evaluation");
+    }
+
+    // Restore number of threads
+    #ifdef _OPENMP
+    omp_set_num_threads(max_threads);
+    #endif
+
+    // Return
+    return;
+}
+
+
 /***************************************************************************
  * @brief Main entry point for test executable
  ***************************************************************************/
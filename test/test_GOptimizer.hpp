@@ -48,6 +48,8 @@ public:
     void         test_unbinned_optimizer(void);
     void         test_binned_optimizer(void);
     void         test_optimizer(const int& mode);
+    void         test_reproducibility(void);
+    void         test_mixed_observations(void);
 };
 
 #endif /* TEST_GOPTIMIZER_HPP */
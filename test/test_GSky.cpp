@@ -31,6 +31,9 @@
 #include <iostream>                           // cout, cerr
 #include <stdexcept>                          // std::exception
 #include <stdlib.h>
+#include <cmath>
+#include <vector>
+#include <algorithm>
 #include "test_GSky.hpp"
 #include "GTools.hpp"
 
@@ -50,11 +53,16 @@ void TestGSky::set(void){
     name("GSky");
 
     //add tests
+    add_test(static_cast<pfunction>(&TestGSky::test_GSkyDir),"Test GSkyDir");
     add_test(static_cast<pfunction>(&TestGSky::test_GWcslib),"Test GWcslib");
+    add_test(static_cast<pfunction>(&TestGSky::test_GWcsHPX),"Test GWcsHPX");
     add_test(static_cast<pfunction>(&TestGSky::test_GSkymap_healpix_construct),"Test Healpix GSkymap constructors");
     add_test(static_cast<pfunction>(&TestGSky::test_GSkymap_healpix_io),"Test Healpix GSkymap I/O");
     add_test(static_cast<pfunction>(&TestGSky::test_GSkymap_wcs_construct),"Test WCS GSkymap constructors");
     add_test(static_cast<pfunction>(&TestGSky::test_GSkymap_wcs_io),"Test WCS GSkymap I/O");
+    add_test(static_cast<pfunction>(&TestGSky::test_GSkymap_array_transforms),"Test GSkymap array transformations");
+    add_test(static_cast<pfunction>(&TestGSky::test_GSkymap_sparse),"Test sparse GSkymap");
+    add_test(static_cast<pfunction>(&TestGSky::test_GSkymap_bitpix),"Test GSkymap pixel data types");
 
     return;
 }
@@ -350,6 +358,163 @@ void TestGSky::test_GWcslib(void)
 }
 
 
+/***************************************************************************
+ *  Test: GWcsHPX                                                          *
+ ***************************************************************************/
+void TestGSky::test_GWcsHPX(void)
+{
+    // Setup maps
+    GWcsHPX ring(8, "RING", "GAL");
+    GWcsHPX nest(8, "NESTED", "GAL");
+    int     npix = ring.npix();
+
+    // Test ring/nest conversion
+    test_try("Test ring/nest conversion");
+    try {
+        for (int pix = 0; pix < npix; ++pix) {
+            int inx = ring.ring2nest(pix);
+            if (nest.nest2ring(inx) != pix) {
+                throw exception_failure("Ring pixel "+str(pix)+" not recovered.");
+            }
+            if (ring.pix2dir(pix).dist_deg(nest.pix2dir(inx)) > 1.0e-5) {
+                throw exception_failure("Ring pixel "+str(pix)+" and nested pixel "+
+                                        str(inx)+" differ.");
+            }
+        }
+        GWcsHPX large(1024, "RING", "GAL");
+        for (int pix = 0; pix < large.npix(); pix += 99991) {
+            GWcsHPX large_nest(1024, "NESTED", "GAL");
+            int     inx = large.ring2nest(pix);
+            if (large.pix2dir(pix).dist_deg(large_nest.pix2dir(inx)) > 1.0e-5) {
+                throw exception_failure("Ring pixel "+str(pix)+" and nested pixel "+
+                                        str(inx)+" differ for nside=1024.");
+            }
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test disc and polygon queries against full scan
+    test_try("Test disc and polygon queries");
+    try {
+        double lon[] = {0.0, 45.0, 184.0, 300.0, 10.0};
+        double lat[] = {90.0, 20.0, -2.0, -75.0, 0.0};
+        double rad[] = {30.0, 12.0, 5.0, 40.0, 100.0};
+        for (int k = 0; k < 5; ++k) {
+            GSkyDir centre;
+            centre.lb_deg(lon[k], lat[k]);
+            for (int iwcs = 0; iwcs < 2; ++iwcs) {
+                GWcsHPX&         wcs    = (iwcs == 0) ? ring : nest;
+                std::vector<int> pixels = wcs.query_disc(centre, rad[k]*deg2rad);
+                std::vector<int> scan;
+                for (int pix = 0; pix < npix; ++pix) {
+                    if (centre.dist_deg(wcs.pix2dir(pix)) <= rad[k]) {
+                        scan.push_back(pix);
+                    }
+                }
+                if (pixels != scan) {
+                    throw exception_failure("Disc query differs from scan for "+
+                          wcs.ordering()+" ordering: "+str((int)pixels.size())+
+                          " instead of "+str((int)scan.size())+" pixels.");
+                }
+                std::vector<int> incl = wcs.query_disc(centre, rad[k]*deg2rad, true);
+                if (incl.size() < scan.size()) {
+                    throw exception_failure("Inclusive disc query misses pixels.");
+                }
+            }
+        }
+        std::vector<GSkyDir> vertices(3);
+        vertices[0].lb_deg(10.0, 10.0);
+        vertices[1].lb_deg(50.0, 15.0);
+        vertices[2].lb_deg(30.0, 50.0);
+        for (int iwcs = 0; iwcs < 2; ++iwcs) {
+            GWcsHPX&         wcs    = (iwcs == 0) ? ring : nest;
+            std::vector<int> pixels = wcs.query_polygon(vertices);
+            if (pixels.empty()) {
+                throw exception_failure("No pixel found in polygon.");
+            }
+            for (int i = 0; i < pixels.size(); ++i) {
+                if (vertices[0].dist_deg(wcs.pix2dir(pixels[i])) > 60.0) {
+                    throw exception_failure("Pixel "+str(pixels[i])+" outside polygon.");
+                }
+            }
+        }
+        if (ring.query_polygon(vertices).size() != nest.query_polygon(vertices).size()) {
+            throw exception_failure("Polygon queries differ for RING and NESTED ordering.");
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test neighbours
+    test_try("Test neighbours");
+    try {
+        double maxdist = 2.5 * std::sqrt(ring.omega(0)) * rad2deg;
+        for (int iwcs = 0; iwcs < 2; ++iwcs) {
+            GWcsHPX& wcs = (iwcs == 0) ? ring : nest;
+            for (int pix = 0; pix < npix; ++pix) {
+                std::vector<int> nb = wcs.neighbours(pix);
+                for (int i = 0; i < 8; ++i) {
+                    if (nb[i] < 0) {
+                        continue;
+                    }
+                    if (wcs.pix2dir(pix).dist_deg(wcs.pix2dir(nb[i])) > maxdist) {
+                        throw exception_failure("Neighbour "+str(nb[i])+" of pixel "+
+                                                str(pix)+" too distant.");
+                    }
+                    std::vector<int> back = wcs.neighbours(nb[i]);
+                    if (std::find(back.begin(), back.end(), pix) == back.end()) {
+                        throw exception_failure("Pixel "+str(pix)+" is no neighbour of "+
+                                                str(nb[i])+".");
+                    }
+                }
+            }
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test up- and down-grading
+    test_try("Test up- and down-grading");
+    try {
+        for (int iwcs = 0; iwcs < 2; ++iwcs) {
+            GWcsHPX& wcs = (iwcs == 0) ? ring : nest;
+            GWcsHPX  fine(32, wcs.ordering(), "GAL");
+            for (int pix = 0; pix < npix; pix += 7) {
+                std::vector<int> children = wcs.children(pix, 32);
+                if (children.size() != 16) {
+                    throw exception_failure("Pixel "+str(pix)+" has "+
+                          str((int)children.size())+" children.");
+                }
+                for (int i = 0; i < children.size(); ++i) {
+                    if (fine.parent(children[i], 8) != pix) {
+                        throw exception_failure("Parent of child "+str(children[i])+
+                                                " is not "+str(pix)+".");
+                    }
+                }
+                if (wcs.dir2pix(fine.pix2dir(children[0])) != pix) {
+                    throw exception_failure("Child "+str(children[0])+
+                                            " is not within pixel "+str(pix)+".");
+                }
+            }
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
 /***************************************************************************
  *  Test: GSkymap_healpix_construct                                        *
  ***************************************************************************/
@@ -623,6 +788,168 @@ void TestGSky::test_GSkymap_wcs_construct(void)
 }
 
 
+/***************************************************************************
+ *  Test: GSkyDir                                                          *
+ ***************************************************************************/
+void TestGSky::test_GSkyDir(void)
+{
+    // Set precision
+    double eps = 1.0e-10;
+
+    // Test angular distances
+    test_try("Test angular distances");
+    try {
+        // Setup reference directions in both coordinate systems
+        GSkyDir ref_equ;
+        GSkyDir ref_gal;
+        ref_equ.radec_deg(83.63, 22.01);
+        ref_gal.lb_deg(ref_equ.l_deg(), ref_equ.b_deg());
+
+        // Setup test directions, alternating between coordinate systems
+        const int            num = 200;
+        std::vector<GSkyDir> dirs(num);
+        for (int i = 0; i < num; ++i) {
+            double lon = 1.7 * double(i);
+            double lat = 89.0 - 0.89 * double(i);
+            if (i % 2 == 0) {
+                dirs[i].radec_deg(lon, lat);
+            }
+            else {
+                dirs[i].lb_deg(lon, lat);
+            }
+        }
+
+        // Compute batched distances
+        std::vector<double> dist(num);
+        std::vector<double> cosdist(num);
+        ref_gal.dist(num, &dirs[0], &dist[0]);
+        ref_gal.cos_dist(num, &dirs[0], &cosdist[0]);
+
+        // Compare to spherical trigonometry in equatorial coordinates
+        for (int i = 0; i < num; ++i) {
+            double cosref = std::sin(ref_equ.dec()) * std::sin(dirs[i].dec()) +
+                            std::cos(ref_equ.dec()) * std::cos(dirs[i].dec()) *
+                            std::cos(dirs[i].ra() - ref_equ.ra());
+            if (std::abs(ref_equ.cos_dist(dirs[i]) - cosref) > eps ||
+                std::abs(ref_gal.cos_dist(dirs[i]) - cosref) > eps ||
+                std::abs(cosdist[i] - cosref) > eps) {
+                throw exception_failure("Cosine of distance differs: dir="+dirs[i].print()+" cos_dist="+str(ref_gal.cos_dist(dirs[i]))+" expected="+str(cosref));
+            }
+            if (std::abs(dist[i] - ref_equ.dist(dirs[i])) > 1.0e-7) {
+                throw exception_failure("Distance differs: dir="+dirs[i].print()+" dist="+str(dist[i])+" expected="+str(ref_equ.dist(dirs[i])));
+            }
+        }
+
+        // Check distance of rotated direction
+        GSkyDir rotated = ref_equ;
+        rotated.rotate_deg(30.0, 2.5);
+        test_value(ref_gal.dist_deg(rotated), 2.5, 1.0e-7, "Check distance of rotated direction");
+
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
+/***************************************************************************
+ *  Test: GSkymap_array_transforms                                         *
+ ***************************************************************************/
+void TestGSky::test_GSkymap_array_transforms(void)
+{
+    // Set precision
+    double eps = 1.0e-10;
+
+    // Test WCS and Healpix maps. The WCS map has more pixels than are
+    // transformed in one chunk.
+    GSkymap maps[2] = {GSkymap("TAN", "CEL", 83.63, 22.01, 0.02, 0.02, 200, 150),
+                       GSkymap("HPX", "GAL", 32, "RING")};
+    for (int m = 0; m < 2; ++m) {
+        test_try("Test array transformations of "+maps[m].wcs()->code()+" map");
+        try {
+            // Setup pixel indices
+            int                 num = maps[m].npix();
+            std::vector<int>    pix(num);
+            std::vector<int>    pix_back(num);
+            std::vector<double> lon(num);
+            std::vector<double> lat(num);
+            for (int i = 0; i < num; ++i) {
+                pix[i] = i;
+            }
+
+            // Transform pixels to sky coordinates and back
+            maps[m].pix2dir(num, &pix[0], &lon[0], &lat[0]);
+            maps[m].dir2pix(num, &lon[0], &lat[0], &pix_back[0]);
+
+            // Compare to single pixel transformations
+            bool equ = (maps[m].wcs()->coordsys() == "EQU");
+            for (int i = 0; i < num; ++i) {
+                GSkyDir dir = maps[m].pix2dir(i);
+                double  dlon = (equ) ? dir.ra_deg()  - lon[i] : dir.l_deg() - lon[i];
+                double  dlat = (equ) ? dir.dec_deg() - lat[i] : dir.b_deg() - lat[i];
+                if (std::abs(dlon) > eps || std::abs(dlat) > eps) {
+                    throw exception_failure("Sky direction differs: pixel="+str(i)+" dir="+dir.print()+" lon="+str(lon[i])+" lat="+str(lat[i]));
+                }
+                if (pix_back[i] != i) {
+                    throw exception_failure("Pixel differs: pixel="+str(i)+" pixel_back="+str(pix_back[i]));
+                }
+            }
+
+            test_try_success();
+        }
+        catch (std::exception &e) {
+            test_try_failure(e);
+        }
+    }
+
+    // Test 2D transformations
+    test_try("Test 2D array transformations");
+    try {
+        // Setup pixels in between pixel centres
+        GSkymap             map("CAR", "GAL", 0.0, 0.0, 0.5, 0.5, 100, 80);
+        int                 num = 1000;
+        std::vector<double> x(num);
+        std::vector<double> y(num);
+        std::vector<double> x_back(num);
+        std::vector<double> y_back(num);
+        std::vector<double> lon(num);
+        std::vector<double> lat(num);
+        for (int i = 0; i < num; ++i) {
+            x[i] = 0.097 * double(i);
+            y[i] = 0.071 * double(i);
+        }
+
+        // Transform pixels to sky coordinates and back
+        map.xy2dir(num, &x[0], &y[0], &lon[0], &lat[0]);
+        map.dir2xy(num, &lon[0], &lat[0], &x_back[0], &y_back[0]);
+
+        // Compare to single pixel transformations
+        for (int i = 0; i < num; ++i) {
+            GSkyPixel pixel(x[i], y[i]);
+            GSkyDir   dir = map.xy2dir(pixel);
+            if (std::abs(dir.l_deg()-lon[i]) > eps || std::abs(dir.b_deg()-lat[i]) > eps) {
+                throw exception_failure("Sky direction differs: pixel="+pixel.print()+" dir="+dir.print());
+            }
+            if (std::abs(x_back[i]-x[i]) > 1.0e-6 || std::abs(y_back[i]-y[i]) > 1.0e-6) {
+                throw exception_failure("Pixel differs: pixel="+pixel.print());
+            }
+        }
+
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
 /***************************************************************************
  *  Test: GSkymap_wcs_io                                                   *
  ***************************************************************************/
@@ -697,6 +1024,202 @@ void TestGSky::test_GSkymap_wcs_io(void)
 }
 
 
+/***************************************************************************
+ *  Test: GSkymap_sparse                                                   *
+ ***************************************************************************/
+void TestGSky::test_GSkymap_sparse(void)
+{
+    // Set filename
+    const std::string file = "test_skymap_hpx_partial.fits";
+
+    // Setup sparse high resolution Healpix map with pixels in a disc
+    GSkymap map("HPX", "GAL", 1024, "NESTED", 2, true);
+    GSkyDir centre;
+    centre.lb_deg(120.0, 30.0);
+    std::vector<int> pixels = static_cast<GWcsHPX*>(map.wcs())->query_disc(centre, 1.0*deg2rad);
+
+    // Test pixel access
+    test_try("Test sparse Healpix pixel access");
+    try {
+        for (int i = 0; i < pixels.size(); ++i) {
+            map(pixels[i], 0) = i + 1.0;
+            map(pixels[i], 1) = -(i + 1.0);
+        }
+        if (!map.issparse() || map.pixels() != NULL) {
+            throw exception_failure("Map does not use sparse storage.");
+        }
+        if (map.nstored() > 100 * pixels.size()) {
+            throw exception_failure("Sparse map stores "+str(map.nstored())+
+                                    " pixels for "+str((int)pixels.size())+
+                                    " pixels set.");
+        }
+        const GSkymap& cmap = map;
+        test_value(cmap(0, 1), 0.0, 0.0, "Check unset pixel");
+        for (int i = 0; i < pixels.size(); ++i) {
+            if (cmap(pixels[i], 0) != i + 1.0 || cmap(pixels[i], 1) != -(i + 1.0)) {
+                throw exception_failure("Pixel "+str(pixels[i])+" differs.");
+            }
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test storage conversion
+    test_try("Test sparse storage conversion");
+    try {
+        GSkymap copy = map;
+        GSkymap small("HPX", "GAL", 16, "RING", 1);
+        small(100) = 3.0;
+        small.sparse();
+        test_value(small.nstored(), 1024, "Check number of stored pixels");
+        small.dense();
+        test_value(small(100), 3.0, 0.0, "Check pixel after conversion");
+        if (small.issparse() || small.nstored() != small.npix()) {
+            throw exception_failure("Map does not use dense storage.");
+        }
+        GSkymap wcs("CAR", "GAL", 0.0, 0.0, 0.5, 0.5, 40, 40);
+        for (int i = 0; i < wcs.npix(); ++i) {
+            wcs(i) = double(i % 7);
+        }
+        GSkymap wcs_sparse = wcs;
+        wcs_sparse.sparse();
+        GSkyDir dir;
+        dir.lb_deg(1.3, -2.1);
+        test_value(wcs_sparse(dir), wcs(dir), 1.0e-10, "Check interpolation");
+        test_value(copy(pixels[5], 0), 6.0, 0.0, "Check copied pixel");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test partial-sky FITS I/O
+    test_try("Test partial-sky Healpix I/O");
+    try {
+        map.save(file, true);
+        GSkymap loaded(file);
+        if (!loaded.issparse() || loaded.nmaps() != 2) {
+            throw exception_failure("Loaded map is not a sparse map with 2 maps.");
+        }
+        for (int i = 0; i < pixels.size(); ++i) {
+            if (loaded(pixels[i], 0) != map(pixels[i], 0) ||
+                loaded(pixels[i], 1) != map(pixels[i], 1)) {
+                throw exception_failure("Loaded pixel "+str(pixels[i])+" differs.");
+            }
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
+/***************************************************************************
+ *  Test: GSkymap_bitpix                                                   *
+ ***************************************************************************/
+void TestGSky::test_GSkymap_bitpix(void)
+{
+    // Setup WCS map with 2 maps
+    GSkymap map("CAR", "GAL", 0.0, 0.0, 1.0, 1.0, 10, 10, 2);
+    for (int i = 0; i < map.npix(); ++i) {
+        map(i, 0) = i + 0.25;
+        map(i, 1) = -(i + 0.75);
+    }
+
+    // Test data type selection
+    test_value(map.bitpix(), -64, "Check default pixel data type");
+    test_try("Test invalid pixel data type");
+    try {
+        map.bitpix(16);
+        test_try_failure("Pixel data type 16 should throw an exception.");
+    }
+    catch (GException::invalid_argument &e) {
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test single precision and integer images
+    test_try("Test single precision and integer images");
+    try {
+        const int bitpix[] = {-32, 32};
+        for (int k = 0; k < 2; ++k) {
+            map.bitpix(bitpix[k]);
+            GFits fits;
+            map.write(&fits);
+            const GFitsImage* image = fits.image(0);
+            test_value(image->bitpix(), bitpix[k], "Check image data type");
+            GSkymap loaded;
+            loaded.read(image);
+            test_value(loaded.bitpix(), -64, "Check map data type");
+            GSkymap copy = map;
+            test_value(copy.bitpix(), bitpix[k], "Check copied data type");
+            for (int i = 0; i < map.npix(); ++i) {
+                double v0 = (bitpix[k] == 32) ? std::floor(map(i,0)+0.5) : map(i,0);
+                double v1 = (bitpix[k] == 32) ? std::floor(map(i,1)+0.5) : map(i,1);
+                if (loaded(i,0) != v0 || loaded(i,1) != v1) {
+                    throw exception_failure("Pixel "+str(i)+" differs.");
+                }
+            }
+        }
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test single precision Healpix table
+    test_try("Test single precision Healpix table");
+    try {
+        GSkymap hpx("HPX", "GAL", 4, "RING", 3);
+        for (int i = 0; i < hpx.npix(); ++i) {
+            hpx(i, 2) = i + 0.5;
+        }
+        hpx.bitpix(-32);
+        GFits fits;
+        hpx.write(&fits);
+        GSkymap loaded;
+        loaded.read(fits.hdu(0));
+        test_value(loaded.bitpix(), -64, "Check map data type");
+        test_value(loaded.nmaps(), 3, "Check number of maps");
+        test_value(loaded(17, 2), 17.5, 0.0, "Check pixel value");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Test clipping of integer pixels
+    test_try("Test clipping of integer pixels");
+    try {
+        GSkymap clip("CAR", "GAL", 0.0, 0.0, 1.0, 1.0, 2, 1, 1);
+        clip(0) =  3.0e9;
+        clip(1) = -3.0e9;
+        clip.bitpix(32);
+        GFits fits;
+        clip.write(&fits);
+        GSkymap loaded;
+        loaded.read(fits.image(0));
+        test_value(loaded(0), 2147483647.0, 0.0, "Check clipped maximum");
+        test_value(loaded(1), -2147483648.0, 0.0, "Check clipped minimum");
+        test_try_success();
+    }
+    catch (std::exception &e) {
+        test_try_failure(e);
+    }
+
+    // Exit test
+    return;
+}
+
+
 /***************************************************************************
  *                            Main test function                           *
  ***************************************************************************/
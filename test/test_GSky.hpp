@@ -35,11 +35,16 @@ class TestGSky : public GTestSuite
 
         // Methods
         virtual void set(void);
+        void test_GSkyDir(void);
         void test_GWcslib(void);
+        void test_GWcsHPX(void);
         void test_GSkymap_healpix_construct(void);
         void test_GSkymap_healpix_io(void);
         void test_GSkymap_wcs_construct(void);
         void test_GSkymap_wcs_io(void);
+        void test_GSkymap_array_transforms(void);
+        void test_GSkymap_sparse(void);
+        void test_GSkymap_bitpix(void);
 
     // Private methods
     private:
@@ -254,6 +254,11 @@ void TestGSupport::test_node_array(void)
     double array_nonlin[] = {-1.3, 0.0, 1.7};
     test_node_array_interpolation(3, array_nonlin);
 
+    // Test non-linear interpolation with many nodes
+    double array_many[] = {-1.5, -1.2, -1.0, -0.7, -0.6, -0.2, 0.1, 0.15,
+                            0.5,  0.9,  1.0,  1.4,  1.8};
+    test_node_array_interpolation(13, array_many);
+
     // Return
     return;
 }
@@ -267,6 +272,9 @@ void TestGSupport::test_node_array(void)
  *
  * Test the GNodeArray class interpolation method by comparing the
  * interpolation results for a linear function to the expected result.
+ * Furthermore test that the indices and weighting factors returned by the
+ * single value and batch interpolate() methods agree with those of
+ * set_value().
  ***************************************************************************/
 void TestGSupport::test_node_array_interpolation(const int&    num,
                                                  const double* nodes)
@@ -280,15 +288,46 @@ void TestGSupport::test_node_array_interpolation(const int&    num,
 
     // Setup node values
     std::vector<double> values;
-    for (int i = 0; i < 3; ++i) {
+    for (int i = 0; i < num; ++i) {
         values.push_back(nodes[i] * slope + offset);
     }
 
     // Test values
+    std::vector<double> x;
     for (double value = -2.0; value <= +2.0; value += 0.2) {
         double expected = value * slope + offset;
         double result   = array.interpolate(value, values);
         test_value(result, expected);
+        x.push_back(value);
+    }
+
+    // Get indices and weighting factors for sorted and unsorted batches
+    int                 nx = x.size();
+    std::vector<int>    inx_sorted(2*nx);
+    std::vector<int>    inx_unsorted(2*nx);
+    std::vector<double> wgt_sorted(2*nx);
+    std::vector<double> wgt_unsorted(2*nx);
+    array.interpolate(nx, &x[0], &inx_sorted[0], &wgt_sorted[0], true);
+    array.interpolate(nx, &x[0], &inx_unsorted[0], &wgt_unsorted[0], false);
+
+    // Test indices and weighting factors
+    for (int k = 0; k < nx; ++k) {
+        int    inx[2];
+        double wgt[2];
+        array.interpolate(x[k], inx, wgt);
+        array.set_value(x[k]);
+        test_value(inx[0], array.inx_left());
+        test_value(inx[1], array.inx_right());
+        test_value(wgt[0], array.wgt_left());
+        test_value(wgt[1], array.wgt_right());
+        test_value(inx_sorted[2*k],   inx[0]);
+        test_value(inx_sorted[2*k+1], inx[1]);
+        test_value(wgt_sorted[2*k],   wgt[0]);
+        test_value(wgt_sorted[2*k+1], wgt[1]);
+        test_value(inx_unsorted[2*k],   inx[0]);
+        test_value(inx_unsorted[2*k+1], inx[1]);
+        test_value(wgt_unsorted[2*k],   wgt[0]);
+        test_value(wgt_unsorted[2*k+1], wgt[1]);
     }
 
     // Return